@@ -94,6 +94,29 @@ send_thread_activity_stats(
 				wt.take_activity_stats() );
 	}
 
+void
+send_thread_activity_stats(
+	const so_5::mbox_t &,
+	const stats::prefix_t &,
+	work_thread::lock_free_work_thread_no_activity_tracking_t & )
+	{
+		/* Nothing to do */
+	}
+
+void
+send_thread_activity_stats(
+	const so_5::mbox_t & mbox,
+	const stats::prefix_t & prefix,
+	work_thread::lock_free_work_thread_with_activity_tracking_t & wt )
+	{
+		so_5::send< stats::messages::work_thread_activity >(
+				mbox,
+				prefix,
+				stats::suffixes::work_thread_activity(),
+				wt.thread_id(),
+				wt.take_activity_stats() );
+	}
+
 } /* anonymous */
 
 //
@@ -222,7 +245,7 @@ class dispatcher_template_t : public actual_disp_iface_t
 				auto thread = std::make_shared< Work_Thread >(
 						m_params.queue_params().lock_factory() );
 
-				thread->start();
+				thread->start( m_params.thread_placements().common() );
 
 				so_5::details::do_with_rollback_on_exception(
 						[&] {
@@ -481,18 +504,37 @@ class proxy_dispatcher_t : public proxy_dispatcher_base_t
 			{
 				using namespace work_thread;
 
-				using dispatcher_no_activity_tracking_t =
-						dispatcher_template_t< work_thread_no_activity_tracking_t >;
-
-				using dispatcher_with_activity_tracking_t =
-						dispatcher_template_t<
-								work_thread_with_activity_tracking_t >;
-
-				make_actual_dispatcher<
-							dispatcher_no_activity_tracking_t,
-							dispatcher_with_activity_tracking_t >(
-						env,
-						m_disp_params );
+				if( m_disp_params.queue_params().lock_free_queue() )
+					{
+						using dispatcher_no_activity_tracking_t =
+								dispatcher_template_t<
+										lock_free_work_thread_no_activity_tracking_t >;
+
+						using dispatcher_with_activity_tracking_t =
+								dispatcher_template_t<
+										lock_free_work_thread_with_activity_tracking_t >;
+
+						make_actual_dispatcher<
+									dispatcher_no_activity_tracking_t,
+									dispatcher_with_activity_tracking_t >(
+								env,
+								m_disp_params );
+					}
+				else
+					{
+						using dispatcher_no_activity_tracking_t =
+								dispatcher_template_t< work_thread_no_activity_tracking_t >;
+
+						using dispatcher_with_activity_tracking_t =
+								dispatcher_template_t<
+										work_thread_with_activity_tracking_t >;
+
+						make_actual_dispatcher<
+									dispatcher_no_activity_tracking_t,
+									dispatcher_with_activity_tracking_t >(
+								env,
+								m_disp_params );
+					}
 			}
 	};
 
@@ -26,9 +26,14 @@
 #include <so_5/rt/h/event_queue.hpp>
 #include <so_5/rt/h/disp.hpp>
 
+#include <so_5/details/h/at_scope_exit.hpp>
+
 #include <so_5/rt/stats/impl/h/activity_tracking.hpp>
 
 #include <so_5/disp/reuse/h/mpmc_ptr_queue.hpp>
+#include <so_5/disp/reuse/h/lock_free_mpmc_ptr_queue.hpp>
+#include <so_5/disp/reuse/h/demand_node_pool.hpp>
+#include <so_5/disp/reuse/h/thread_placement.hpp>
 
 #include <so_5/disp/thread_pool/impl/h/common_implementation.hpp>
 
@@ -66,7 +71,125 @@ namespace tp_stats = so_5::disp::reuse::thread_pool_stats;
 //
 // dispatcher_queue_t
 //
-using dispatcher_queue_t = so_5::disp::reuse::mpmc_ptr_queue_t< agent_queue_t >;
+/*!
+ * \brief Queue of non-empty agent queues.
+ *
+ * Uses mpmc_ptr_queue_t or lock_free_mpmc_ptr_queue_t depending on
+ * queue parameters.
+ *
+ * \since
+ * v.5.5.23
+ */
+class dispatcher_queue_t
+	{
+		using shared_queue_t =
+				so_5::disp::reuse::mpmc_ptr_queue_t< agent_queue_t >;
+		using lock_free_queue_t =
+				so_5::disp::reuse::lock_free_mpmc_ptr_queue_t< agent_queue_t >;
+
+	public :
+		dispatcher_queue_t(
+			const so_5::disp::mpmc_queue_traits::queue_params_t & queue_params,
+			std::size_t thread_count )
+			{
+				if( queue_params.lock_free_queue() )
+					m_lock_free_queue.reset(
+							new lock_free_queue_t{ queue_params, thread_count } );
+				else
+					m_shared_queue.reset(
+							new shared_queue_t{ queue_params, thread_count } );
+			}
+
+		void
+		shutdown()
+			{
+				if( m_lock_free_queue )
+					m_lock_free_queue->shutdown();
+				else
+					m_shared_queue->shutdown();
+			}
+
+		agent_queue_t *
+		pop( so_5::disp::mpmc_queue_traits::condition_t & condition )
+			{
+				return m_lock_free_queue ?
+						m_lock_free_queue->pop( condition ) :
+						m_shared_queue->pop( condition );
+			}
+
+		void
+		schedule( agent_queue_t * queue )
+			{
+				if( m_lock_free_queue )
+					m_lock_free_queue->schedule( queue );
+				else
+					m_shared_queue->schedule( queue );
+			}
+
+		so_5::disp::mpmc_queue_traits::condition_unique_ptr_t
+		allocate_condition()
+			{
+				return m_lock_free_queue ?
+						m_lock_free_queue->allocate_condition() :
+						m_shared_queue->allocate_condition();
+			}
+
+		std::size_t
+		size() const
+			{
+				return m_lock_free_queue ?
+						m_lock_free_queue->size() :
+						m_shared_queue->size();
+			}
+
+		std::size_t
+		waiting_threads() const
+			{
+				return m_lock_free_queue ?
+						m_lock_free_queue->waiting_threads() :
+						m_shared_queue->waiting_threads();
+			}
+
+		void
+		thread_added()
+			{
+				if( m_lock_free_queue )
+					m_lock_free_queue->thread_added();
+				else
+					m_shared_queue->thread_added();
+			}
+
+		void
+		thread_removed()
+			{
+				if( m_lock_free_queue )
+					m_lock_free_queue->thread_removed();
+				else
+					m_shared_queue->thread_removed();
+			}
+
+		void
+		retire_one_thread()
+			{
+				if( m_lock_free_queue )
+					m_lock_free_queue->retire_one_thread();
+				else
+					m_shared_queue->retire_one_thread();
+			}
+
+	private :
+		//! Queue for the ordinary mode.
+		/*!
+		 * Is nullptr if lock-free queue is used.
+		 */
+		std::unique_ptr< shared_queue_t > m_shared_queue;
+
+		//! Lock-free queue.
+		/*!
+		 * Is nullptr if lock-free queue isn't turned on.
+		 */
+		std::unique_ptr< lock_free_queue_t > m_lock_free_queue;
+	};
 
 //
 // agent_queue_t
@@ -134,17 +257,27 @@ class agent_queue_t
 			}
 
 		//! Push next demand to queue.
+		/*!
+		 * \note Since v.5.5.23 a node for the demand is taken from the
+		 * pool of free nodes. A new node is allocated before acquiring
+		 * the queue lock only if the pool is empty.
+		 */
 		virtual void
 		push( execution_demand_t demand )
 			{
 				bool need_schedule = false;
 				{
 					// Do memory allocation before spinlock locking.
-					auto new_demand = new demand_t( std::move( demand ) );
+					std::unique_ptr< demand_t > new_demand;
+					if( !m_free_nodes.probably_has_nodes() )
+						new_demand.reset( new demand_t( std::move( demand ) ) );
 
 					std::lock_guard< spinlock_t > lock( m_lock );
 
-					m_tail->m_next = new_demand;
+					if( !new_demand )
+						new_demand.reset( make_node( std::move( demand ) ) );
+
+					m_tail->m_next = new_demand.release();
 					m_tail = m_tail->m_next;
 
 					++m_size;
@@ -170,6 +303,70 @@ class agent_queue_t
 					m_disp_queue.schedule( this );
 			}
 
+		//! Push several demands to queue at once.
+		/*!
+		 * \since
+		 * v.5.5.23
+		 */
+		virtual void
+		push_batch(
+			execution_demand_t * demands,
+			std::size_t count ) override
+			{
+				if( !count )
+					return;
+
+				bool need_schedule = false;
+				{
+					// Do memory allocation before spinlock locking.
+					demand_t chain_head;
+					demand_t * chain_tail = &chain_head;
+					auto chain_cleaner = so_5::details::at_scope_exit(
+						[&chain_head] {
+							while( chain_head.m_next )
+								{
+									std::unique_ptr< demand_t > d{ chain_head.m_next };
+									chain_head.m_next = d->m_next;
+								}
+						} );
+
+					for( std::size_t i = 0; i != count; ++i )
+						{
+							chain_tail->m_next = new demand_t( std::move( demands[ i ] ) );
+							chain_tail = chain_tail->m_next;
+						}
+
+					std::lock_guard< spinlock_t > lock( m_lock );
+
+					const bool was_empty = empty();
+
+					m_tail->m_next = chain_head.m_next;
+					m_tail = chain_tail;
+					chain_head.m_next = nullptr;
+
+					m_size += count;
+
+					if( was_empty )
+						{
+							// Queue was empty. Need to detect
+							// necessity of queue activation.
+							if( !m_active )
+								if( !is_there_not_thread_safe_worker() )
+								{
+									need_schedule = true;
+									m_active = true;
+								}
+						}
+
+					SO_5_CHECK_INVARIANT( !empty(), this )
+					SO_5_CHECK_INVARIANT( m_active || is_there_any_worker(), this )
+					SO_5_CHECK_INVARIANT( !(need_schedule && !m_active), this )
+				}
+
+				if( need_schedule )
+					m_disp_queue.schedule( this );
+			}
+
 		//! Get the information about the front demand.
 		/*!
 		 * \attention This method must be called only on non-empty queue.
@@ -308,7 +505,42 @@ class agent_queue_t
 		 */
 		std::atomic< std::size_t > m_size = { 0 };
 
+		/*!
+		 * \brief Free nodes for new demands.
+		 *
+		 * \since
+		 * v.5.5.23
+		 */
+		so_5::disp::reuse::demand_node_pool_t< demand_t > m_free_nodes;
+
+		/*!
+		 * \brief Get a node for a new demand.
+		 *
+		 * Takes a node from the pool or allocates a new one if
+		 * the pool is empty.
+		 *
+		 * \attention Must be called when m_lock is acquired.
+		 *
+		 * \since
+		 * v.5.5.23
+		 */
+		demand_t *
+		make_node( execution_demand_t && demand )
+			{
+				auto node = m_free_nodes.try_take();
+				if( node )
+					node->m_demand = std::move( demand );
+				else
+					node = new demand_t( std::move( demand ) );
+
+				return node;
+			}
+
 		//! Helper method for deleting queue's head object.
+		/*!
+		 * \note Since v.5.5.23 the node is returned to the pool of
+		 * free nodes. It is deleted only if the pool is full.
+		 */
 		inline void
 		delete_head()
 			{
@@ -317,7 +549,11 @@ class agent_queue_t
 
 				--m_size;
 
-				delete to_be_deleted;
+				// During normal work the message is still referenced by
+				// the copy of the demand returned by peek_front(). So only
+				// the reference counter is decremented here.
+				to_be_deleted->m_demand.m_message_ref.reset();
+				delete m_free_nodes.try_put( to_be_deleted );
 			}
 	};
 
@@ -357,6 +593,13 @@ struct common_data_t
 		//! Waiting object for long wait.
 		so_5::disp::mpmc_queue_traits::condition_unique_ptr_t m_condition;
 
+		//! Is thread body finished?
+		/*!
+		 * \since
+		 * v.5.5.23
+		 */
+		std::atomic< bool > m_finished{ false };
+
 		common_data_t( dispatcher_queue_t & queue )
 			:	m_disp_queue( &queue )
 			,	m_condition{ queue.allocate_condition() }
@@ -491,10 +734,30 @@ class work_thread_template_t : public Impl
 			}
 
 		//! Launch work thread.
+		/*!
+		 * \note Since v.5.5.23 the placement of the thread is specified.
+		 * An exception is thrown if the placement can't be applied.
+		 */
 		void
-		start()
+		start( const so_5::disp::reuse::thread_placement_t & placement )
 			{
-				this->m_thread = std::thread( [this]() { body(); } );
+				this->m_finished.store( false, std::memory_order_relaxed );
+				this->m_thread = so_5::disp::reuse::make_placed_thread(
+						placement,
+						[this]() { body(); } );
+			}
+
+		//! Is thread body finished?
+		/*!
+		 * The thread must be joined anyway.
+		 *
+		 * \since
+		 * v.5.5.23
+		 */
+		bool
+		finished() const
+			{
+				return this->m_finished.load( std::memory_order_acquire );
 			}
 
 		/*!
@@ -528,6 +791,8 @@ class work_thread_template_t : public Impl
 
 						process_queue( *agent_queue );
 					}
+
+				this->m_finished.store( true, std::memory_order_release );
 			}
 
 		/*!
@@ -677,6 +942,29 @@ struct adaptation_t
 			{
 				// This type of agent_queue doesn't require waiting for emptyness.
 			}
+
+		/*!
+		 * \since
+		 * v.5.5.23
+		 */
+		static std::size_t
+		demands_at_once( const agent_queue_t & /*queue*/ )
+			{
+				// Every demand is scheduled separately in this type of
+				// dispatcher. So there is no such value.
+				return 0u;
+			}
+
+		/*!
+		 * \since
+		 * v.5.5.23
+		 */
+		static std::size_t
+		service_time( const agent_queue_t & /*queue*/ )
+			{
+				// Service time isn't measured in this type of dispatcher.
+				return 0u;
+			}
 	};
 
 //
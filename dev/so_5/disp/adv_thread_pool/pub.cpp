@@ -105,6 +105,8 @@ class proxy_dispatcher_t : public proxy_dispatcher_base_t
 							dispatcher_with_activity_tracking_t >(
 						env,
 						m_disp_params.thread_count(),
+						m_disp_params.thread_placements(),
+						so_5::disp::thread_pool::common_implementation::elastic_params_t{},
 						m_disp_params.queue_params() );
 			}
 	};
@@ -230,6 +230,38 @@ combined_lock_factory()
 SO_5_FUNC lock_factory_t
 simple_lock_factory();
 
+/*!
+ * \brief Factory for creation of futex-based lock with adaptive spinning.
+ *
+ * A worker thread spins for some time before parking on its personal
+ * futex. The time of spinning is adjusted with respect to recent waiting
+ * times. Exactly one parked worker is woken up directly via futex.
+ *
+ * \note Futexes are available on Linux only. The combined lock with
+ * the default waiting time is used on other platforms.
+ *
+ * \par Usage example:
+	\code
+	so_5::launch( []( so_5::environment_t & env ) { ... },
+		[]( so_5::environment_params_t & params ) {
+			// Add another thread_pool dispatcher with futex_lock for
+			// event queue protection.
+			using namespace so_5::disp::thread_pool;
+			params.add_named_dispatcher(
+				"helpers_disp",
+				create_disp( disp_params_t{}.tune_queue_params(
+					[]( queue_traits::queue_params_t & queue_params ) {
+						queue_params.lock_factory( queue_traits::futex_lock_factory() );
+					} ) ) );
+		} );
+	\endcode
+ *
+ * \since
+ * v.5.5.23
+ */
+SO_5_FUNC lock_factory_t
+futex_lock_factory();
+
 //
 // queue_params_t
 //
@@ -250,18 +282,24 @@ class queue_params_t
 		queue_params_t( const queue_params_t & o )
 			:	m_lock_factory{ o.m_lock_factory }
 			,	m_next_thread_wakeup_threshold{ o.m_next_thread_wakeup_threshold }
+			,	m_lock_free_queue{ o.m_lock_free_queue }
+			,	m_lock_free_queue_capacity{ o.m_lock_free_queue_capacity }
 			{}
 		//! Move constructor.
 		queue_params_t( queue_params_t && o )
 			:	m_lock_factory{ std::move(o.m_lock_factory) }
 			,	m_next_thread_wakeup_threshold{
 					std::move(o.m_next_thread_wakeup_threshold) }
+			,	m_lock_free_queue{ o.m_lock_free_queue }
+			,	m_lock_free_queue_capacity{ o.m_lock_free_queue_capacity }
 			{}
 
 		friend inline void swap( queue_params_t & a, queue_params_t & b )
 			{
 				std::swap( a.m_lock_factory, b.m_lock_factory );
 				std::swap( a.m_next_thread_wakeup_threshold, b.m_next_thread_wakeup_threshold );
+				std::swap( a.m_lock_free_queue, b.m_lock_free_queue );
+				std::swap( a.m_lock_free_queue_capacity, b.m_lock_free_queue_capacity );
 			}
 
 		//! Copy operator.
@@ -343,6 +381,79 @@ class queue_params_t
 				return m_next_thread_wakeup_threshold;
 			}
 
+		//! Setter for lock-free queue flag.
+		/*!
+		 * If this flag is set then the queue of non-empty agent queues
+		 * is a bounded lock-free ring buffer instead of std::deque
+		 * protected by the lock. Worker threads and producers don't
+		 * acquire the lock while there is work for all workers. The lock
+		 * object is used only for parking idle workers, for waking them
+		 * up and for items which don't fit into the ring buffer.
+		 *
+		 * \note This flag is used by thread_pool and adv_thread_pool
+		 * dispatchers. It is ignored by thread_pool in work stealing mode.
+		 *
+		 * \since
+		 * v.5.5.23
+		 *
+		 * \par Usage example:
+			\code
+			using namespace so_5::disp::thread_pool;
+			auto disp = create_private_disp( env, "workers",
+				disp_params_t{}
+					.thread_count( 32 )
+					.tune_queue_params(
+						[]( queue_traits::queue_params_t & qp ) {
+							qp.lock_free_queue( true );
+						} ) );
+			\endcode
+		 */
+		queue_params_t &
+		lock_free_queue( bool v )
+			{
+				m_lock_free_queue = v;
+				return *this;
+			}
+
+		//! Getter for lock-free queue flag.
+		/*!
+		 * \since
+		 * v.5.5.23
+		 */
+		bool
+		lock_free_queue() const
+			{
+				return m_lock_free_queue;
+			}
+
+		//! Setter for capacity of the lock-free queue.
+		/*!
+		 * The capacity is rounded up to a power of two. It is not
+		 * a limit for the count of non-empty agent queues: items which
+		 * don't fit into the ring buffer are stored into an overflow
+		 * queue protected by the lock.
+		 *
+		 * \since
+		 * v.5.5.23
+		 */
+		queue_params_t &
+		lock_free_queue_capacity( std::size_t v )
+			{
+				m_lock_free_queue_capacity = v;
+				return *this;
+			}
+
+		//! Getter for capacity of the lock-free queue.
+		/*!
+		 * \since
+		 * v.5.5.23
+		 */
+		std::size_t
+		lock_free_queue_capacity() const
+			{
+				return m_lock_free_queue_capacity;
+			}
+
 	private :
 		//! Lock factory to be used during queue creation.
 		lock_factory_t m_lock_factory;
@@ -355,6 +466,22 @@ class queue_params_t
 		 * v.5.5.16
 		 */
 		std::size_t m_next_thread_wakeup_threshold;
+
+		/*!
+		 * \brief Should the lock-free queue be used?
+		 *
+		 * \since
+		 * v.5.5.23
+		 */
+		bool m_lock_free_queue{ false };
+
+		/*!
+		 * \brief Capacity of the lock-free queue.
+		 *
+		 * \since
+		 * v.5.5.23
+		 */
+		std::size_t m_lock_free_queue_capacity{ 1024u };
 	};
 
 } /* namespace mpmc_queue_traits */
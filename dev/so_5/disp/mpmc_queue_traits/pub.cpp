@@ -14,6 +14,8 @@
 
 #include <so_5/h/spinlocks.hpp>
 
+#include <so_5/disp/reuse/h/futex_primitives.hpp>
+
 #include <mutex>
 #include <condition_variable>
 
@@ -285,6 +287,99 @@ class actual_lock_t : public lock_t
 
 } /* namespace simple_lock */
 
+#if defined(SO_5_DISP_REUSE_FUTEX_SUPPORTED)
+namespace futex_lock
+{
+
+using mutex_t = so_5::disp::reuse::futex_mutex_t;
+
+//
+// actual_cond_t
+//
+/*!
+ * \since
+ * v.5.5.23
+ *
+ * \brief Implementation of condition object for the case of futex lock.
+ *
+ * The owner of condition object spins at first and then parks on
+ * its personal futex. So notify() wakes up exactly this thread.
+ */
+class actual_cond_t : public condition_t
+	{
+		//! Common mutex from the parent lock.
+		mutex_t & m_mutex;
+
+		//! Personal event for condition object owner.
+		so_5::disp::reuse::futex_event_t m_event;
+
+	public :
+		//! Initializing constructor.
+		actual_cond_t(
+			//! Common mutex from the parent lock.
+			mutex_t & mutex )
+			:	m_mutex( mutex )
+			{}
+
+		virtual void
+		wait() SO_5_NOEXCEPT override
+			{
+				// Common mutex is already acquired.
+				m_event.reset();
+
+				m_mutex.unlock();
+
+				m_event.wait();
+
+				// Common mutex must be reacquired to return the parent lock
+				// in the state at the call to wait().
+				m_mutex.lock();
+			}
+
+		virtual void
+		notify() SO_5_NOEXCEPT override
+			{
+				m_event.notify();
+			}
+	};
+
+//
+// actual_lock_t
+//
+/*!
+ * \since
+ * v.5.5.23
+ *
+ * \brief Actual implementation of futex-based lock object.
+ */
+class actual_lock_t : public lock_t
+	{
+		//! Common mutex for all producers and consumers.
+		mutex_t m_mutex;
+
+	public :
+		virtual void
+		lock() SO_5_NOEXCEPT override
+			{
+				m_mutex.lock();
+			}
+
+		virtual void
+		unlock() SO_5_NOEXCEPT override
+			{
+				m_mutex.unlock();
+			}
+
+		virtual condition_unique_ptr_t
+		allocate_condition() override
+			{
+				return condition_unique_ptr_t{ new actual_cond_t{ m_mutex } };
+			}
+	};
+
+} /* namespace futex_lock */
+#endif
+
 //
 // combined_lock_factory
 //
@@ -309,6 +404,21 @@ simple_lock_factory()
 			};
 	}
 
+//
+// futex_lock_factory
+//
+SO_5_FUNC lock_factory_t
+futex_lock_factory()
+	{
+#if defined(SO_5_DISP_REUSE_FUTEX_SUPPORTED)
+		return [] {
+				return lock_unique_ptr_t{ new futex_lock::actual_lock_t{} };
+			};
+#else
+		return combined_lock_factory();
+#endif
+	}
+
 } /* namespace mpmc_queue_traits */
 
 } /* namespace disp */
@@ -196,6 +196,38 @@ combined_lock_factory()
 SO_5_FUNC lock_factory_t
 simple_lock_factory();
 
+/*!
+ * \brief Factory for creation of futex-based lock with adaptive spinning.
+ *
+ * A consumer thread spins for some time before parking on futex. The time
+ * of spinning is adjusted with respect to recent waiting times. A parked
+ * consumer is woken up directly via futex.
+ *
+ * \note Futexes are available on Linux only. The combined lock with
+ * the default waiting time is used on other platforms.
+ *
+ * \since
+ * v.5.5.23
+ *
+ * \par Usage example:
+	\code
+	so_5::launch( []( so_5::environment_t & env ) { ... },
+		[]( so_5::environment_params_t & params ) {
+			// Add another one_thread dispatcher with futex_lock for
+			// event queue protection.
+			using namespace so_5::disp::one_thread;
+			params.add_named_dispatcher(
+				"helpers_disp",
+				create_disp( disp_params_t{}.tune_queue_params(
+					[]( queue_traits::queue_params_t & queue_params ) {
+						queue_params.lock_factory( queue_traits::futex_lock_factory() );
+					} ) ) );
+		} );
+	\endcode
+ */
+SO_5_FUNC lock_factory_t
+futex_lock_factory();
+
 //
 // unique_lock_t
 //
@@ -291,16 +323,19 @@ class queue_params_t
 		//! Copy constructor.
 		queue_params_t( const queue_params_t & o )
 			:	m_lock_factory{ o.m_lock_factory }
+			,	m_lock_free_queue{ o.m_lock_free_queue }
 			{}
 		//! Move constructor.
 		queue_params_t( queue_params_t && o )
 			:	m_lock_factory{ std::move(o.m_lock_factory) }
+			,	m_lock_free_queue{ o.m_lock_free_queue }
 			{}
 
 		friend inline void swap( queue_params_t & a, queue_params_t & b )
 			{
 				using namespace std;
 				swap( a.m_lock_factory, b.m_lock_factory );
+				swap( a.m_lock_free_queue, b.m_lock_free_queue );
 			}
 
 		//! Copy operator.
@@ -334,9 +369,58 @@ class queue_params_t
 				return m_lock_factory;
 			}
 
+		//! Setter for lock-free queue flag.
+		/*!
+		 * If this flag is set then demands are stored in a lock-free
+		 * MPSC list instead of std::deque protected by the lock.
+		 * Producers don't acquire the lock on push. The lock object
+		 * is used only for parking the consumer when the queue is
+		 * empty and for waking it up when the queue becomes non-empty.
+		 *
+		 * \note This flag is used by one_thread, active_obj and
+		 * active_group dispatchers. It is ignored by other dispatchers.
+		 *
+		 * \since
+		 * v.5.5.23
+		 *
+		 * \par Usage example:
+			\code
+			using namespace so_5::disp::one_thread;
+			auto disp = create_private_disp( env, "latency_critical",
+				disp_params_t{}.tune_queue_params(
+					[]( queue_traits::queue_params_t & queue_params ) {
+						queue_params.lock_free_queue( true );
+					} ) );
+			\endcode
+		 */
+		queue_params_t &
+		lock_free_queue( bool v )
+			{
+				m_lock_free_queue = v;
+				return *this;
+			}
+
+		//! Getter for lock-free queue flag.
+		/*!
+		 * \since
+		 * v.5.5.23
+		 */
+		bool
+		lock_free_queue() const
+			{
+				return m_lock_free_queue;
+			}
+
 	private :
 		//! Lock factory to be used during queue creation.
 		lock_factory_t m_lock_factory;
+
+		//! Should lock-free queue be used?
+		/*!
+		 * \since
+		 * v.5.5.23
+		 */
+		bool m_lock_free_queue{ false };
 	};
 
 /*!
@@ -14,6 +14,8 @@
 
 #include <so_5/h/spinlocks.hpp>
 
+#include <so_5/disp/reuse/h/futex_primitives.hpp>
+
 #include <so_5/details/h/invoke_noexcept_code.hpp>
 
 #include <mutex>
@@ -202,6 +204,72 @@ class simple_lock_t : public lock_t
 		bool m_signaled = { false };
 	};
 
+#if defined(SO_5_DISP_REUSE_FUTEX_SUPPORTED)
+//
+// futex_lock_t
+//
+/*!
+ * \since
+ * v.5.5.23
+ *
+ * \brief A lock based on futexes with adaptive spinning.
+ *
+ * Spinning is limited by a count of `pause` instructions. The limit
+ * is adjusted with respect to recent waiting times. There is no polling
+ * of a clock during spinning.
+ *
+ * A consumer thread is parked on futex if a notification does not come
+ * during spinning. A producer does a system call only if the consumer
+ * thread is parked.
+ *
+ * \attention This lock can be used only for single-consumer queues!
+ */
+class futex_lock_t : public lock_t
+	{
+	public :
+		virtual void
+		lock() SO_5_NOEXCEPT override
+			{
+				m_mutex.lock();
+			}
+
+		virtual void
+		unlock() SO_5_NOEXCEPT override
+			{
+				m_mutex.unlock();
+			}
+
+	protected :
+		virtual void
+		wait_for_notify() SO_5_NOEXCEPT override
+			{
+				m_waiting = true;
+				m_event.reset();
+
+				m_mutex.unlock();
+
+				m_event.wait();
+
+				m_mutex.lock();
+
+				m_waiting = false;
+			}
+
+		virtual void
+		notify_one() SO_5_NOEXCEPT override
+			{
+				if( m_waiting )
+					m_event.notify();
+			}
+
+	private :
+		so_5::disp::reuse::futex_mutex_t m_mutex;
+		so_5::disp::reuse::futex_event_t m_event;
+
+		bool m_waiting = { false };
+	};
+#endif
+
 } /* namespace impl */
 
 //
@@ -225,6 +293,19 @@ simple_lock_factory()
 		return [] { return lock_unique_ptr_t{ new impl::simple_lock_t{} }; };
 	}
 
+//
+// futex_lock_factory
+//
+SO_5_FUNC lock_factory_t
+futex_lock_factory()
+	{
+#if defined(SO_5_DISP_REUSE_FUTEX_SUPPORTED)
+		return [] { return lock_unique_ptr_t{ new impl::futex_lock_t{} }; };
+#else
+		return combined_lock_factory();
+#endif
+	}
+
 } /* namespace mpsc_queue_traits */
 
 } /* namespace disp */
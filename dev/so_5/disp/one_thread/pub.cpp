@@ -90,6 +90,27 @@ track_activity(
 				data.m_work_thread.take_activity_stats() );
 	}
 
+inline void
+track_activity(
+	const mbox_t &,
+	const common_data_t<
+			work_thread::lock_free_work_thread_no_activity_tracking_t > & )
+	{}
+
+inline void
+track_activity(
+	const mbox_t & mbox,
+	const common_data_t<
+			work_thread::lock_free_work_thread_with_activity_tracking_t > & data )
+	{
+		so_5::send< stats::messages::work_thread_activity >(
+				mbox,
+				data.m_base_prefix,
+				stats::suffixes::work_thread_activity(),
+				data.m_work_thread.thread_id(),
+				data.m_work_thread.take_activity_stats() );
+	}
+
 } /* namespace data_source_details */
 
 /*!
@@ -217,7 +238,8 @@ class actual_dispatcher_t : public actual_disp_iface_t
 	{
 	public:
 		actual_dispatcher_t( disp_params_t params )
-			:	m_work_thread{ params.queue_params().lock_factory() }
+			:	m_thread_placement{ params.thread_placements().common() }
+			,	m_work_thread{ params.queue_params().lock_factory() }
 			,	m_data_source( m_work_thread, m_agents_bound )
 			{}
 
@@ -229,7 +251,7 @@ class actual_dispatcher_t : public actual_disp_iface_t
 				m_data_source.start( env );
 
 				so_5::details::do_with_rollback_on_exception(
-						[this] { m_work_thread.start(); },
+						[this] { m_work_thread.start( m_thread_placement ); },
 						[this] { m_data_source.stop(); } );
 			}
 
@@ -276,6 +298,13 @@ class actual_dispatcher_t : public actual_disp_iface_t
 			}
 
 	private:
+		//! Placement of the working thread.
+		/*!
+		 * \since
+		 * v.5.5.23
+		 */
+		const so_5::disp::reuse::thread_placement_t m_thread_placement;
+
 		//! Working thread for the dispatcher.
 		Work_Thread m_work_thread;
 
@@ -346,19 +375,38 @@ class proxy_dispatcher_t : public proxy_dispatcher_base_t
 		virtual void
 		do_actual_start( environment_t & env ) override
 			{
-				using dispatcher_no_activity_tracking_t =
-						actual_dispatcher_t<
-								work_thread::work_thread_no_activity_tracking_t >;
-
-				using dispatcher_with_activity_tracking_t =
-						actual_dispatcher_t<
-								work_thread::work_thread_with_activity_tracking_t >;
-
-				make_actual_dispatcher<
-							dispatcher_no_activity_tracking_t,
-							dispatcher_with_activity_tracking_t >(
-						env,
-						m_disp_params );
+				if( m_disp_params.queue_params().lock_free_queue() )
+					{
+						using dispatcher_no_activity_tracking_t =
+								actual_dispatcher_t< work_thread::
+										lock_free_work_thread_no_activity_tracking_t >;
+
+						using dispatcher_with_activity_tracking_t =
+								actual_dispatcher_t< work_thread::
+										lock_free_work_thread_with_activity_tracking_t >;
+
+						make_actual_dispatcher<
+									dispatcher_no_activity_tracking_t,
+									dispatcher_with_activity_tracking_t >(
+								env,
+								m_disp_params );
+					}
+				else
+					{
+						using dispatcher_no_activity_tracking_t =
+								actual_dispatcher_t<
+										work_thread::work_thread_no_activity_tracking_t >;
+
+						using dispatcher_with_activity_tracking_t =
+								actual_dispatcher_t<
+										work_thread::work_thread_with_activity_tracking_t >;
+
+						make_actual_dispatcher<
+									dispatcher_no_activity_tracking_t,
+									dispatcher_with_activity_tracking_t >(
+								env,
+								m_disp_params );
+					}
 			}
 	};
 
@@ -111,6 +111,7 @@ class dispatcher_template_t : public actual_disp_iface_t
 	public:
 		dispatcher_template_t( disp_params_t params )
 			:	m_data_source{ self() }
+			,	m_thread_placements{ params.thread_placements() }
 			{
 				m_threads.reserve( so_5::prio::total_priorities_count );
 				so_5::prio::for_each_priority( [&]( so_5::priority_t ) {
@@ -278,6 +279,15 @@ class dispatcher_template_t : public actual_disp_iface_t
 		//! Data source for run-time monitoring.
 		disp_data_source_t m_data_source;
 
+		//! Placements of working threads.
+		/*!
+		 * Working threads are indexed by priorities.
+		 *
+		 * \since
+		 * v.5.5.23
+		 */
+		const so_5::disp::reuse::worker_thread_placements_t m_thread_placements;
+
 		//! Working threads for every priority.
 		std::vector< std::unique_ptr< Work_Thread > > m_threads;
 
@@ -313,7 +323,8 @@ class dispatcher_template_t : public actual_disp_iface_t
 								m_agents_per_priority[ i ].store( 0,
 										std::memory_order_release );
 
-								m_threads[ i ]->start();
+								m_threads[ i ]->start(
+										m_thread_placements.for_worker( i ) );
 
 								// Thread successfully started. Pointer to it
 								// must be used on rollback.
@@ -15,6 +15,8 @@
 
 #include <so_5/h/current_thread_id.hpp>
 
+#include <so_5/disp/reuse/h/thread_placement.hpp>
+
 #include <so_5/rt/stats/h/work_thread_activity.hpp>
 #include <so_5/rt/stats/impl/h/activity_tracking.hpp>
 
@@ -172,10 +174,16 @@ class work_thread_template_t : public Work_Thread< Demand_Queue >
 			:	base_type_t( queue )
 			{}
 
+		/*!
+		 * \note Since v.5.5.23 the placement of the thread is specified.
+		 * An exception is thrown if the placement can't be applied.
+		 */
 		void
-		start()
+		start( const so_5::disp::reuse::thread_placement_t & placement )
 			{
-				this->m_thread = std::thread( [this]() { body(); } );
+				this->m_thread = so_5::disp::reuse::make_placed_thread(
+						placement,
+						[this]() { body(); } );
 			}
 
 		void
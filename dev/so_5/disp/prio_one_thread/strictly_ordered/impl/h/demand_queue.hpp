@@ -19,10 +19,14 @@
 #include <so_5/rt/h/execution_demand.hpp>
 #include <so_5/rt/h/event_queue.hpp>
 
+#include <so_5/details/h/at_scope_exit.hpp>
+
 #include <so_5/h/priority.hpp>
 
 #include <so_5/disp/mpsc_queue_traits/h/pub.hpp>
 
+#include <so_5/disp/reuse/h/demand_node_pool.hpp>
+
 namespace so_5 {
 
 namespace disp {
@@ -66,6 +70,42 @@ struct demand_t : public execution_demand_t
  */
 using demand_unique_ptr_t = std::unique_ptr< demand_t >;
 
+class demand_queue_t;
+
+//
+// demand_recycler_t
+//
+/*!
+ * \brief A deleter for demands extracted from demand_queue_t.
+ *
+ * Returns a demand to the queue instead of deletion. The queue
+ * reuses it for new demands.
+ *
+ * \attention Must be used only on the working thread of the dispatcher.
+ *
+ * \since
+ * v.5.5.23
+ */
+struct demand_recycler_t
+	{
+		demand_queue_t * m_queue;
+
+		inline void
+		operator()( demand_t * demand ) const SO_5_NOEXCEPT;
+	};
+
+//
+// extracted_demand_unique_ptr_t
+//
+/*!
+ * \brief An alias for unique_ptr to demand extracted from demand_queue_t.
+ *
+ * \since
+ * v.5.5.23
+ */
+using extracted_demand_unique_ptr_t =
+		std::unique_ptr< demand_t, demand_recycler_t >;
+
 //
 // demand_queue_t
 //
@@ -78,6 +118,7 @@ using demand_unique_ptr_t = std::unique_ptr< demand_t >;
 class demand_queue_t
 	{
 		friend struct queue_for_one_priority_t;
+		friend struct demand_recycler_t;
 
 		//! Description of queue for one priority.
 		struct queue_for_one_priority_t
@@ -108,10 +149,34 @@ class demand_queue_t
 				virtual void
 				push( execution_demand_t exec_demand ) override
 					{
-						demand_unique_ptr_t what{ new demand_t{
-								std::move( exec_demand ) } };
+						m_demand_queue->push( this, std::move( exec_demand ) );
+					}
+
+				virtual void
+				push_batch(
+					execution_demand_t * demands,
+					std::size_t count ) override
+					{
+						if( !count )
+							return;
+
+						// The whole chain of new demands is created before
+						// locking of the main demand queue.
+						demand_unique_ptr_t head{ new demand_t{
+								std::move( demands[ 0 ] ) } };
+						auto chain_cleaner = so_5::details::at_scope_exit( [&head] {
+								while( head )
+									head.reset( head->m_next );
+							} );
+
+						demand_t * tail = head.get();
+						for( std::size_t i = 1; i != count; ++i )
+							{
+								tail->m_next = new demand_t{ std::move( demands[ i ] ) };
+								tail = tail->m_next;
+							}
 
-						m_demand_queue->push( this, std::move( what ) );
+						m_demand_queue->push_chain( this, head.release(), tail, count );
 					}
 			};
 
@@ -141,6 +206,8 @@ class demand_queue_t
 			{
 				for( auto & q : m_priorities )
 					cleanup_queue( q );
+
+				delete m_processed_demand;
 			}
 
 		//! Set the shutdown signal.
@@ -160,19 +227,35 @@ class demand_queue_t
 		//! Pop demand from the queue.
 		/*!
 		 * \throw shutdown_ex_t in the case when queue is shut down.
+		 *
+		 * \note Since v.5.5.23 the demand is returned to the queue
+		 * after the destruction of the result. The previously returned
+		 * demand is stored to the pool of free nodes here.
 		 */
-		demand_unique_ptr_t
+		extracted_demand_unique_ptr_t
 		pop()
 			{
+				// The previous demand must be deleted when the lock
+				// will be released if it can't be stored to the pool.
+				demand_unique_ptr_t not_recycled;
+
 				queue_traits::unique_lock_t lock{ *m_lock };
 
+				if( m_processed_demand )
+					{
+						not_recycled.reset(
+								m_free_nodes.try_put( m_processed_demand ) );
+						m_processed_demand = nullptr;
+					}
+
 				while( !m_shutdown && !m_current_priority )
 					lock.wait_for_notify();
 
 				if( m_shutdown )
 					throw shutdown_ex_t();
 
-				demand_unique_ptr_t result{ m_current_priority->m_head };
+				extracted_demand_unique_ptr_t result{
+						m_current_priority->m_head, demand_recycler_t{ this } };
 
 				m_current_priority->m_head = result->m_next;
 				result->m_next = nullptr;
@@ -262,16 +345,72 @@ class demand_queue_t
 					}
 			}
 
+		/*!
+		 * \brief Free nodes for new demands.
+		 *
+		 * \since
+		 * v.5.5.23
+		 */
+		so_5::disp::reuse::demand_node_pool_t< demand_t > m_free_nodes;
+
+		/*!
+		 * \brief The last processed demand.
+		 *
+		 * Is stored to m_free_nodes in the next call to pop().
+		 *
+		 * \note Is used only by the working thread.
+		 *
+		 * \since
+		 * v.5.5.23
+		 */
+		demand_t * m_processed_demand = nullptr;
+
+		/*!
+		 * \brief Store a processed demand for further reuse.
+		 *
+		 * A message is released here, outside of the queue lock.
+		 *
+		 * \since
+		 * v.5.5.23
+		 */
+		void
+		recycle( demand_t * demand ) SO_5_NOEXCEPT
+			{
+				demand->m_message_ref.reset();
+
+				delete m_processed_demand;
+				m_processed_demand = demand;
+			}
+
 		//! Push a new demand to the queue.
+		/*!
+		 * \note Since v.5.5.23 a node for the demand is taken from the
+		 * pool of free nodes. A new node is allocated before acquiring
+		 * the queue lock only if the pool is empty.
+		 */
 		void
 		push(
 			//! Subqueue for the demand.
 			queue_for_one_priority_t * subqueue,
 			//! Demand to be pushed.
-			demand_unique_ptr_t demand )
+			execution_demand_t && exec_demand )
 			{
+				demand_unique_ptr_t demand;
+				if( !m_free_nodes.probably_has_nodes() )
+					demand.reset( new demand_t{ std::move( exec_demand ) } );
+
 				queue_traits::lock_guard_t lock{ *m_lock };
 
+				if( !demand )
+					{
+						demand.reset( m_free_nodes.try_take() );
+						if( demand )
+							static_cast< execution_demand_t & >( *demand ) =
+									std::move( exec_demand );
+						else
+							demand.reset( new demand_t{ std::move( exec_demand ) } );
+					}
+
 				add_demand_to_queue( *subqueue, std::move( demand ) );
 
 				if( !m_current_priority )
@@ -286,6 +425,46 @@ class demand_queue_t
 					m_current_priority = subqueue;
 			}
 
+		/*!
+		 * \brief Push a chain of new demands to the queue.
+		 *
+		 * \since
+		 * v.5.5.23
+		 */
+		void
+		push_chain(
+			//! Subqueue for the demands.
+			queue_for_one_priority_t * subqueue,
+			//! The first demand in the chain.
+			//! Ownership is transferred to the queue.
+			demand_t * head,
+			//! The last demand in the chain.
+			demand_t * tail,
+			//! Count of demands in the chain.
+			std::size_t count )
+			{
+				queue_traits::lock_guard_t lock{ *m_lock };
+
+				if( subqueue->m_tail )
+					subqueue->m_tail->m_next = head;
+				else
+					subqueue->m_head = head;
+				subqueue->m_tail = tail;
+
+				subqueue->m_demands_count += count;
+
+				if( !m_current_priority )
+					{
+						// Queue was empty. A sleeping working thread must
+						// be notified.
+						m_current_priority = subqueue;
+						lock.notify_one();
+					}
+				else if( m_current_priority < subqueue )
+					// New demands have greater priority than the previous.
+					m_current_priority = subqueue;
+			}
+
 		//! Add a new demand to the tail of the queue specified.
 		void
 		add_demand_to_queue(
@@ -309,6 +488,15 @@ class demand_queue_t
 			}
 	};
 
+//
+// demand_recycler_t implementation
+//
+inline void
+demand_recycler_t::operator()( demand_t * demand ) const SO_5_NOEXCEPT
+	{
+		m_queue->recycle( demand );
+	}
+
 } /* namespace impl */
 
 } /* namespace strictly_ordered */
@@ -112,6 +112,7 @@ class dispatcher_template_t : public actual_disp_iface_t
 	public:
 		dispatcher_template_t( disp_params_t params )
 			:	m_demand_queue{ params.queue_params().lock_factory()() }
+			,	m_thread_placement{ params.thread_placements().common() }
 			,	m_work_thread{ m_demand_queue }
 			,	m_data_source{ self() }
 			{}
@@ -122,7 +123,7 @@ class dispatcher_template_t : public actual_disp_iface_t
 				m_data_source.start( outliving_mutable(env.stats_repository()) );
 
 				so_5::details::do_with_rollback_on_exception(
-						[this] { m_work_thread.start(); },
+						[this] { m_work_thread.start( m_thread_placement ); },
 						[this] { m_data_source.stop(); } );
 			}
 
@@ -265,6 +266,13 @@ class dispatcher_template_t : public actual_disp_iface_t
 		//! Demand queue for the dispatcher.
 		demand_queue_t m_demand_queue;
 
+		//! Placement of the working thread.
+		/*!
+		 * \since
+		 * v.5.5.23
+		 */
+		const so_5::disp::reuse::thread_placement_t m_thread_placement;
+
 		//! Working thread for the dispatcher.
 		Work_Thread m_work_thread;
 
@@ -0,0 +1,603 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \file
+ * \brief Multi-producer/Multi-consumer queue of pointers with
+ * affinity of items to worker threads.
+ * \since
+ * v.5.5.23
+ */
+
+#pragma once
+
+#include <so_5/disp/mpmc_queue_traits/h/pub.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <vector>
+
+namespace so_5
+{
+
+namespace disp
+{
+
+namespace reuse
+{
+
+//
+// affinity_params_t
+//
+/*!
+ * \brief Parameters for affinity of items to worker threads.
+ *
+ * \since
+ * v.5.5.23
+ */
+struct affinity_params_t
+	{
+		//! Count of items in the local queue of a worker after that
+		//! the worker is treated as overloaded.
+		std::size_t m_overload_threshold = 4u;
+
+		//! Time after that an idle worker can take items from
+		//! local queues of busy workers.
+		std::chrono::steady_clock::duration m_idle_threshold =
+				std::chrono::microseconds( 500 );
+	};
+
+//
+// affinity_ptr_queue_t
+//
+/*!
+ * \brief Multi-producer/Multi-consumer queue of pointers with
+ * affinity of items to worker threads.
+ *
+ * Has the same interface as mpmc_ptr_queue_t but uses different
+ * scheduling scheme:
+ * - every worker thread has its own local queue;
+ * - an item is stored into the local queue of the worker which
+ *   handled it the last time. So the item is handled by the same
+ *   worker while it is possible;
+ * - an item is stored into the shared queue if it wasn't handled yet
+ *   or if the local queue of its last worker contains
+ *   affinity_params_t::m_overload_threshold items or more;
+ * - an idle worker takes items from local queues of overloaded workers
+ *   at once. Items from local queues of other busy workers are taken
+ *   only if the worker is idle longer than
+ *   affinity_params_t::m_idle_threshold;
+ * - if the last worker of an item is busy and some other worker is idle
+ *   longer than affinity_params_t::m_idle_threshold then the item is
+ *   stored into the local queue of the idle worker.
+ *
+ * The shared queue is checked by workers from time to time even if
+ * they have items in own local queues. It prevents starvation of items
+ * in the shared queue.
+ *
+ * All queues are protected by one lock. Every worker waits on its own
+ * condition variable. It allows to wake up a specific worker and to
+ * wait with a timeout while there are items in local queues of busy
+ * workers.
+ *
+ * Type T must have the following methods:
+ * \code
+ * // Get the index of the last worker.
+ * std::size_t last_worker() const;
+ * // Set the index of the last worker.
+ * void last_worker( std::size_t index );
+ * \endcode
+ * Both methods are called only when the queue's lock is acquired.
+ * An index which is not less than the count of workers means that
+ * the item wasn't handled yet.
+ *
+ * \attention Each worker thread must call pop() before any other method
+ * because worker's local queue is bound to the thread in the first call
+ * to pop().
+ *
+ * \tparam T type of object.
+ *
+ * \since
+ * v.5.5.23
+ */
+template< class T >
+class affinity_ptr_queue_t
+	{
+		using clock_type = std::chrono::steady_clock;
+
+		//! Data of one worker thread.
+		struct worker_t
+			{
+				//! Queue to which that worker belongs.
+				const affinity_ptr_queue_t * m_owner;
+
+				//! Index of worker.
+				const std::size_t m_index;
+
+				//! Local queue of the worker.
+				std::deque< T * > m_local;
+
+				//! Condition for waiting of the worker.
+				/*!
+				 * Is used with the queue's lock.
+				 */
+				std::condition_variable_any m_wakeup;
+
+				//! Is the worker idle?
+				bool m_idle = false;
+
+				//! Does the worker wait without a timeout?
+				bool m_untimed_wait = false;
+
+				//! Has the worker been notified but not woken up yet?
+				bool m_wakeup_pending = false;
+
+				//! Time when the worker became idle.
+				clock_type::time_point m_idle_since;
+
+				//! Number of items taken by the worker.
+				/*!
+				 * Is used for periodical check of the shared queue.
+				 */
+				unsigned int m_ticks = 0u;
+
+				worker_t(
+					const affinity_ptr_queue_t * owner,
+					std::size_t index )
+					:	m_owner( owner )
+					,	m_index( index )
+					{}
+			};
+
+		//! How often the shared queue must be checked before the local queue.
+		static const unsigned int shared_queue_check_period = 61u;
+
+	public :
+		affinity_ptr_queue_t(
+			const so_5::disp::mpmc_queue_traits::queue_params_t & queue_params,
+			std::size_t thread_count,
+			const affinity_params_t & affinity_params )
+			:	m_lock{ queue_params.lock_factory()() }
+			,	m_overload_threshold{
+					affinity_params.m_overload_threshold ?
+							affinity_params.m_overload_threshold : 1u }
+			,	m_idle_threshold{ affinity_params.m_idle_threshold }
+			{
+				m_workers.reserve( thread_count );
+				for( std::size_t i = 0; i != thread_count; ++i )
+					m_workers.emplace_back( new worker_t( this, i ) );
+			}
+
+		//! Initiate shutdown for working threads.
+		inline void
+		shutdown()
+			{
+				std::lock_guard< so_5::disp::mpmc_queue_traits::lock_t > lock{ *m_lock };
+
+				m_shutdown = true;
+
+				for( auto & w : m_workers )
+					w->m_wakeup.notify_one();
+			}
+
+		//! Get next active queue.
+		/*!
+		 * \note The condition isn't used because every worker
+		 * waits on its own condition variable.
+		 *
+		 * \attention Must be called only by worker threads.
+		 *
+		 * \retval nullptr is the case of dispatcher shutdown.
+		 */
+		inline T *
+		pop( so_5::disp::mpmc_queue_traits::condition_t & /*condition*/ )
+			{
+				auto & w = current_worker();
+
+				std::lock_guard< so_5::disp::mpmc_queue_traits::lock_t > lock{ *m_lock };
+
+				while( !m_shutdown )
+					{
+						if( auto r = try_take( w ) )
+							{
+								mark_busy( w );
+								m_size.fetch_sub( 1, std::memory_order_relaxed );
+
+								// There could be other items and sleeping workers.
+								if( !m_queue.empty() )
+									wakeup_one_idle_worker();
+
+								return r;
+							}
+
+						wait_for_work( w );
+					}
+
+				return nullptr;
+			}
+
+		//! Switch the current non-empty queue to another one if it is possible.
+		/*!
+		 * The current queue stays in the local queue of the worker if
+		 * the worker isn't overloaded.
+		 *
+		 * \attention Must be called only by worker threads.
+		 *
+		 * \return nullptr is the case of dispatcher shutdown.
+		 */
+		inline T *
+		try_switch_to_another( T * current ) SO_5_NOEXCEPT
+			{
+				auto & w = current_worker();
+
+				std::lock_guard< so_5::disp::mpmc_queue_traits::lock_t > lock{ *m_lock };
+
+				if( m_shutdown )
+					return nullptr;
+
+				T * r = nullptr;
+
+				++w.m_ticks;
+				if( 0 == w.m_ticks % shared_queue_check_period )
+					r = pop_shared();
+				if( !r )
+					r = pop_front( w.m_local );
+				if( !r )
+					r = pop_shared();
+
+				if( !r )
+					// There is no other work. The current queue can be
+					// processed further.
+					return current;
+
+				if( !m_queue.empty() )
+					wakeup_one_idle_worker();
+
+				r->last_worker( w.m_index );
+
+				// Size of the whole queue is not changed.
+				store_item( w, current );
+
+				return r;
+			}
+
+		//! Schedule execution of demands from the queue.
+		void
+		schedule( T * queue )
+			{
+				std::lock_guard< so_5::disp::mpmc_queue_traits::lock_t > lock{ *m_lock };
+
+				m_size.fetch_add( 1, std::memory_order_relaxed );
+
+				const auto index = queue->last_worker();
+				if( index < m_workers.size() )
+					store_item( *m_workers[ index ], queue );
+				else
+					{
+						m_queue.push_back( queue );
+						wakeup_one_idle_worker();
+					}
+			}
+
+		so_5::disp::mpmc_queue_traits::condition_unique_ptr_t
+		allocate_condition()
+			{
+				return m_lock->allocate_condition();
+			}
+
+		//! Get count of items in the shared queue and in all local queues.
+		/*!
+		 * \note The value can be out of date right after return.
+		 */
+		std::size_t
+		size() const
+			{
+				return m_size.load( std::memory_order_relaxed );
+			}
+
+		//! Get count of threads waiting for work.
+		/*!
+		 * \note The value can be out of date right after return.
+		 */
+		std::size_t
+		waiting_threads() const
+			{
+				return m_idle_count.load( std::memory_order_relaxed );
+			}
+
+	private :
+		//! Object's lock.
+		/*!
+		 * Protects the shared queue and local queues of all workers.
+		 */
+		so_5::disp::mpmc_queue_traits::lock_unique_ptr_t m_lock;
+
+		//! Count of items in local queues after that a worker is
+		//! treated as overloaded.
+		const std::size_t m_overload_threshold;
+
+		//! Time after that an idle worker can take items from
+		//! local queues of busy workers.
+		const clock_type::duration m_idle_threshold;
+
+		//! Shutdown flag.
+		bool m_shutdown{ false };
+
+		//! Data of worker threads.
+		std::vector< std::unique_ptr< worker_t > > m_workers;
+
+		//! Count of workers which already bound to their threads.
+		std::atomic< std::size_t > m_bound_workers{ 0 };
+
+		//! Shared queue.
+		std::deque< T * > m_queue;
+
+		//! Count of items in the shared queue and in all local queues.
+		/*!
+		 * Is changed only when the object's lock is acquired.
+		 */
+		std::atomic< std::size_t > m_size{ 0 };
+
+		//! Count of idle workers.
+		/*!
+		 * Is changed only when the object's lock is acquired.
+		 */
+		std::atomic< std::size_t > m_idle_count{ 0 };
+
+		//! Pointer to the worker data of the current thread.
+		static worker_t *&
+		thread_worker_ptr() SO_5_NOEXCEPT
+			{
+				static thread_local worker_t * w = nullptr;
+				return w;
+			}
+
+		//! Get worker data for the current thread.
+		/*!
+		 * Binds a free worker to the current thread if it is not bound yet.
+		 */
+		worker_t &
+		current_worker() SO_5_NOEXCEPT
+			{
+				auto & w = thread_worker_ptr();
+				if( !w || this != w->m_owner )
+					w = m_workers[ m_bound_workers.fetch_add( 1,
+							std::memory_order_relaxed ) ].get();
+
+				return *w;
+			}
+
+		static T *
+		pop_front( std::deque< T * > & queue )
+			{
+				if( queue.empty() )
+					return nullptr;
+
+				auto r = queue.front();
+				queue.pop_front();
+
+				return r;
+			}
+
+		//! Extract an item from the shared queue.
+		/*!
+		 * \attention Must be called when the object's lock is acquired.
+		 */
+		T *
+		pop_shared()
+			{
+				return pop_front( m_queue );
+			}
+
+		//! An attempt to find work for the worker.
+		/*!
+		 * \attention Must be called when the object's lock is acquired.
+		 */
+		T *
+		try_take( worker_t & w )
+			{
+				T * r = nullptr;
+
+				++w.m_ticks;
+				if( 0 == w.m_ticks % shared_queue_check_period )
+					r = pop_shared();
+				if( !r )
+					r = pop_front( w.m_local );
+				if( !r )
+					r = pop_shared();
+				if( !r )
+					r = try_steal( w );
+
+				if( r )
+					r->last_worker( w.m_index );
+
+				return r;
+			}
+
+		//! An attempt to take an item from local queues of other workers.
+		/*!
+		 * Items from an overloaded worker are taken at once. Items from
+		 * other busy workers are taken only if \a thief is idle longer than
+		 * the idle threshold.
+		 *
+		 * \attention Must be called when the object's lock is acquired.
+		 */
+		T *
+		try_steal( worker_t & thief )
+			{
+				worker_t * victim = nullptr;
+				for( auto & v : m_workers )
+					if( v.get() != &thief &&
+							v->m_local.size() >= m_overload_threshold &&
+							( !victim || victim->m_local.size() < v->m_local.size() ) )
+						victim = v.get();
+
+				if( !victim && thief.m_idle &&
+						m_idle_threshold <= clock_type::now() - thief.m_idle_since )
+					for( auto & v : m_workers )
+						if( v.get() != &thief && !v->m_idle && !v->m_local.empty() &&
+								( !victim || victim->m_local.size() < v->m_local.size() ) )
+							victim = v.get();
+
+				return victim ? pop_front( victim->m_local ) : nullptr;
+			}
+
+		//! Is there some item in local queues of busy workers?
+		/*!
+		 * \attention Must be called when the object's lock is acquired.
+		 */
+		bool
+		has_items_of_busy_workers() const
+			{
+				for( const auto & v : m_workers )
+					if( !v->m_idle && !v->m_local.empty() )
+						return true;
+
+				return false;
+			}
+
+		//! Store an item to the local queue of the worker or to
+		//! some other place if the worker can't handle it in time.
+		/*!
+		 * \attention Must be called when the object's lock is acquired.
+		 */
+		void
+		store_item( worker_t & w, T * item )
+			{
+				if( w.m_local.size() >= m_overload_threshold )
+					{
+						// The worker is overloaded. Item can be taken by anyone.
+						m_queue.push_back( item );
+						wakeup_one_idle_worker();
+					}
+				else if( w.m_idle )
+					{
+						w.m_local.push_back( item );
+						wakeup( w );
+					}
+				else if( auto idle = find_long_idle_worker() )
+					{
+						// The item migrates to the worker which is idle too long.
+						idle->m_local.push_back( item );
+						wakeup( *idle );
+					}
+				else
+					{
+						w.m_local.push_back( item );
+
+						// A worker which waits without a timeout must
+						// start waiting with a timeout.
+						for( auto & v : m_workers )
+							if( v->m_untimed_wait && !v->m_wakeup_pending )
+								{
+									wakeup( *v );
+									break;
+								}
+					}
+			}
+
+		//! Find a worker which is idle longer than the idle threshold.
+		/*!
+		 * \attention Must be called when the object's lock is acquired.
+		 */
+		worker_t *
+		find_long_idle_worker() const
+			{
+				if( !m_idle_count.load( std::memory_order_relaxed ) )
+					return nullptr;
+
+				worker_t * r = nullptr;
+				const auto now = clock_type::now();
+				for( auto & v : m_workers )
+					if( v->m_idle && !v->m_wakeup_pending &&
+							m_idle_threshold <= now - v->m_idle_since &&
+							( !r || v->m_idle_since < r->m_idle_since ) )
+						r = v.get();
+
+				return r;
+			}
+
+		/*!
+		 * \attention Must be called when the object's lock is acquired.
+		 */
+		void
+		wakeup_one_idle_worker()
+			{
+				if( !m_idle_count.load( std::memory_order_relaxed ) )
+					return;
+
+				for( auto & v : m_workers )
+					if( v->m_idle && !v->m_wakeup_pending )
+						{
+							wakeup( *v );
+							break;
+						}
+			}
+
+		static void
+		wakeup( worker_t & w )
+			{
+				if( !w.m_wakeup_pending )
+					{
+						w.m_wakeup_pending = true;
+						w.m_wakeup.notify_one();
+					}
+			}
+
+		/*!
+		 * \attention Must be called when the object's lock is acquired.
+		 */
+		void
+		mark_busy( worker_t & w )
+			{
+				if( w.m_idle )
+					{
+						w.m_idle = false;
+						m_idle_count.fetch_sub( 1, std::memory_order_relaxed );
+					}
+			}
+
+		//! Wait while some work will be available.
+		/*!
+		 * Waits with a timeout if there are items in local queues of
+		 * busy workers. Those items can be taken by this worker
+		 * after the idle threshold.
+		 *
+		 * \attention Must be called when the object's lock is acquired.
+		 */
+		void
+		wait_for_work( worker_t & w )
+			{
+				if( !w.m_idle )
+					{
+						w.m_idle = true;
+						w.m_idle_since = clock_type::now();
+						m_idle_count.fetch_add( 1, std::memory_order_relaxed );
+					}
+
+				if( has_items_of_busy_workers() )
+					{
+						const auto idle_time = clock_type::now() - w.m_idle_since;
+						if( idle_time < m_idle_threshold )
+							w.m_wakeup.wait_for( *m_lock, m_idle_threshold - idle_time );
+					}
+				else
+					{
+						w.m_untimed_wait = true;
+						w.m_wakeup.wait( *m_lock );
+						w.m_untimed_wait = false;
+					}
+
+				w.m_wakeup_pending = false;
+			}
+	};
+
+} /* namespace reuse */
+
+} /* namespace disp */
+
+} /* namespace so_5 */
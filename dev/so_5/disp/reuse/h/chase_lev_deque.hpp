@@ -0,0 +1,240 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \file
+ * \brief Work-stealing deque of pointers.
+ * \since
+ * v.5.5.23
+ */
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <cstdint>
+
+namespace so_5
+{
+
+namespace disp
+{
+
+namespace reuse
+{
+
+//
+// chase_lev_deque_t
+//
+/*!
+ * \brief Work-stealing deque of pointers.
+ *
+ * An implementation of Chase-Lev deque (with memory orders from
+ * "Correct and Efficient Work-Stealing for Weak Memory Models" by
+ * N.M. Le, A. Pop, A. Cohen and F. Zappa Nardelli).
+ *
+ * Only the owner of the deque can call push() and pop(). They work
+ * with the bottom of the deque (in LIFO order). Any thread can call
+ * steal(). It works with the top of the deque (in FIFO order).
+ *
+ * The storage grows when it is necessary. Old storages are kept until
+ * the destruction of the deque because some thief can still read from
+ * them.
+ *
+ * \tparam T type of object.
+ *
+ * \since
+ * v.5.5.23
+ */
+template< class T >
+class chase_lev_deque_t
+	{
+		//! Circular storage of items.
+		struct array_t
+			{
+				//! Size of the storage. Always a power of 2.
+				const std::int64_t m_capacity;
+				//! Items.
+				std::unique_ptr< std::atomic< T * >[] > m_items;
+
+				array_t( std::int64_t capacity )
+					:	m_capacity( capacity )
+					,	m_items( new std::atomic< T * >[
+							static_cast< std::size_t >(capacity) ] )
+					{}
+
+				T *
+				get( std::int64_t index ) const
+					{
+						return m_items[ static_cast< std::size_t >(
+								index & (m_capacity - 1) ) ]
+							.load( std::memory_order_relaxed );
+					}
+
+				void
+				put( std::int64_t index, T * item )
+					{
+						m_items[ static_cast< std::size_t >(
+								index & (m_capacity - 1) ) ]
+							.store( item, std::memory_order_relaxed );
+					}
+			};
+
+	public :
+		chase_lev_deque_t( const chase_lev_deque_t & ) = delete;
+		chase_lev_deque_t &
+		operator=( const chase_lev_deque_t & ) = delete;
+
+		chase_lev_deque_t(
+			//! Initial capacity. Must be a power of 2.
+			std::int64_t initial_capacity = 64 )
+			{
+				m_arrays.emplace_back( new array_t( initial_capacity ) );
+				m_array.store( m_arrays.back().get(), std::memory_order_relaxed );
+			}
+
+		//! Add an item to the bottom of the deque.
+		/*!
+		 * \attention Must be called only by the owner of the deque.
+		 */
+		void
+		push( T * item )
+			{
+				const auto b = m_bottom.load( std::memory_order_relaxed );
+				const auto t = m_top.load( std::memory_order_acquire );
+				auto a = m_array.load( std::memory_order_relaxed );
+
+				if( b - t > a->m_capacity - 1 )
+					a = grow( a, b, t );
+
+				a->put( b, item );
+				std::atomic_thread_fence( std::memory_order_release );
+				m_bottom.store( b + 1, std::memory_order_relaxed );
+			}
+
+		//! Extract an item from the bottom of the deque.
+		/*!
+		 * \attention Must be called only by the owner of the deque.
+		 *
+		 * \retval nullptr if the deque is empty.
+		 */
+		T *
+		pop()
+			{
+				const auto b = m_bottom.load( std::memory_order_relaxed ) - 1;
+				auto a = m_array.load( std::memory_order_relaxed );
+				m_bottom.store( b, std::memory_order_relaxed );
+				std::atomic_thread_fence( std::memory_order_seq_cst );
+				auto t = m_top.load( std::memory_order_relaxed );
+
+				T * result = nullptr;
+				if( t <= b )
+					{
+						result = a->get( b );
+						if( t == b )
+							{
+								// It is the last item. There can be a race with thieves.
+								if( !m_top.compare_exchange_strong( t, t + 1,
+										std::memory_order_seq_cst,
+										std::memory_order_relaxed ) )
+									result = nullptr;
+								m_bottom.store( b + 1, std::memory_order_relaxed );
+							}
+					}
+				else
+					m_bottom.store( b + 1, std::memory_order_relaxed );
+
+				return result;
+			}
+
+		//! Extract an item from the top of the deque.
+		/*!
+		 * Can be called by any thread.
+		 *
+		 * \retval nullptr if the deque is empty or if there was a race
+		 * with another thread.
+		 */
+		T *
+		steal()
+			{
+				auto t = m_top.load( std::memory_order_acquire );
+				std::atomic_thread_fence( std::memory_order_seq_cst );
+				const auto b = m_bottom.load( std::memory_order_acquire );
+
+				if( t < b )
+					{
+						auto a = m_array.load( std::memory_order_acquire );
+						T * result = a->get( t );
+						if( !m_top.compare_exchange_strong( t, t + 1,
+								std::memory_order_seq_cst,
+								std::memory_order_relaxed ) )
+							return nullptr;
+
+						return result;
+					}
+
+				return nullptr;
+			}
+
+		//! Is the deque empty?
+		/*!
+		 * \note The value can be out of date at the moment of return.
+		 */
+		bool
+		empty() const
+			{
+				const auto t = m_top.load( std::memory_order_seq_cst );
+				const auto b = m_bottom.load( std::memory_order_seq_cst );
+				return b <= t;
+			}
+
+		//! Count of items in the deque.
+		/*!
+		 * \note The value can be out of date at the moment of return.
+		 */
+		std::size_t
+		size() const
+			{
+				const auto t = m_top.load( std::memory_order_seq_cst );
+				const auto b = m_bottom.load( std::memory_order_seq_cst );
+				return b > t ? static_cast< std::size_t >( b - t ) : 0u;
+			}
+
+	private :
+		//! Top of the deque. Modified by thieves and by the owner.
+		std::atomic< std::int64_t > m_top{ 0 };
+		//! Bottom of the deque. Modified only by the owner.
+		std::atomic< std::int64_t > m_bottom{ 0 };
+
+		//! The current storage.
+		std::atomic< array_t * > m_array;
+
+		//! All storages created for the deque.
+		/*!
+		 * \note Is modified only by the owner.
+		 */
+		std::vector< std::unique_ptr< array_t > > m_arrays;
+
+		//! Create a new storage with twice capacity.
+		array_t *
+		grow( array_t * old, std::int64_t b, std::int64_t t )
+			{
+				std::unique_ptr< array_t > a{ new array_t( old->m_capacity * 2 ) };
+				for( auto i = t; i != b; ++i )
+					a->put( i, old->get( i ) );
+
+				m_arrays.push_back( std::move(a) );
+				auto result = m_arrays.back().get();
+				m_array.store( result, std::memory_order_release );
+
+				return result;
+			}
+	};
+
+} /* namespace reuse */
+
+} /* namespace disp */
+
+} /* namespace so_5 */
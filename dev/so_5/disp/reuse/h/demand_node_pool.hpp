@@ -0,0 +1,165 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \file
+ * \brief A pool of nodes for intrusive demand queues.
+ * \since
+ * v.5.5.23
+ */
+
+#pragma once
+
+#include <so_5/h/compiler_features.hpp>
+
+#include <atomic>
+#include <cstddef>
+
+namespace so_5
+{
+
+namespace disp
+{
+
+namespace reuse
+{
+
+//
+// default_demand_node_pool_capacity
+//
+/*!
+ * \brief Default count of free nodes to be kept in demand_node_pool_t.
+ *
+ * \since
+ * v.5.5.23
+ */
+inline std::size_t
+default_demand_node_pool_capacity()
+	{
+		return 64u;
+	}
+
+//
+// demand_node_pool_t
+//
+/*!
+ * \brief A pool of nodes for intrusive demand queues.
+ *
+ * Demand queues allocate a node for every demand and deallocate it
+ * after the demand is processed. This pool keeps deallocated nodes
+ * and gives them back for new demands. So in steady state demands
+ * are stored without memory allocations.
+ *
+ * The pool has no own lock. It must be protected by the lock of
+ * the demand queue. Producers and consumers acquire that lock anyway,
+ * so the pool adds no synchronization.
+ *
+ * Only a size hint can be read without the lock. It allows to allocate
+ * a new node before acquiring the queue lock if the pool is empty.
+ *
+ * \tparam Node type of node. Must have public `Node * m_next` member.
+ *
+ * \since
+ * v.5.5.23
+ */
+template< class Node >
+class demand_node_pool_t
+	{
+	public :
+		demand_node_pool_t( const demand_node_pool_t & ) = delete;
+		demand_node_pool_t &
+		operator=( const demand_node_pool_t & ) = delete;
+
+		demand_node_pool_t(
+			//! Max count of free nodes to be kept.
+			std::size_t capacity = default_demand_node_pool_capacity() )
+			:	m_capacity( capacity )
+			{}
+
+		~demand_node_pool_t()
+			{
+				while( m_head )
+					{
+						auto n = m_head;
+						m_head = n->m_next;
+						delete n;
+					}
+			}
+
+		//! Does the pool have some free nodes?
+		/*!
+		 * Can be called without the lock. The result can be out of date
+		 * at the moment of return.
+		 */
+		bool
+		probably_has_nodes() const SO_5_NOEXCEPT
+			{
+				return 0u != m_size.load( std::memory_order_relaxed );
+			}
+
+		//! Take a free node from the pool.
+		/*!
+		 * \attention Must be called when the queue lock is acquired.
+		 *
+		 * \retval nullptr if the pool is empty.
+		 */
+		Node *
+		try_take() SO_5_NOEXCEPT
+			{
+				auto n = m_head;
+				if( n )
+					{
+						m_head = n->m_next;
+						n->m_next = nullptr;
+						m_size.store( m_size.load( std::memory_order_relaxed ) - 1u,
+								std::memory_order_relaxed );
+					}
+
+				return n;
+			}
+
+		//! Return a node to the pool.
+		/*!
+		 * The node must not hold any resources (a message reference
+		 * must be reset before the return).
+		 *
+		 * \attention Must be called when the queue lock is acquired.
+		 *
+		 * \retval nullptr if the node is stored in the pool.
+		 * \retval node if the pool is full. The node must be deleted
+		 * by the caller (it is better to do that outside the queue lock).
+		 */
+		Node *
+		try_put( Node * node ) SO_5_NOEXCEPT
+			{
+				const auto size = m_size.load( std::memory_order_relaxed );
+				if( size >= m_capacity )
+					return node;
+
+				node->m_next = m_head;
+				m_head = node;
+				m_size.store( size + 1u, std::memory_order_relaxed );
+
+				return nullptr;
+			}
+
+	private :
+		//! Max count of free nodes.
+		const std::size_t m_capacity;
+
+		//! The first free node.
+		Node * m_head = nullptr;
+
+		//! Count of free nodes.
+		/*!
+		 * Is modified only when the queue lock is acquired.
+		 */
+		std::atomic< std::size_t > m_size{ 0u };
+	};
+
+} /* namespace reuse */
+
+} /* namespace disp */
+
+} /* namespace so_5 */
@@ -0,0 +1,296 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \file
+ * \brief Futex-based synchronization primitives for dispatcher queues.
+ * \since
+ * v.5.5.23
+ */
+
+#pragma once
+
+#include <so_5/h/compiler_features.hpp>
+#include <so_5/h/spinlocks.hpp>
+
+#include <atomic>
+
+#if defined(__linux__)
+	#define SO_5_DISP_REUSE_FUTEX_SUPPORTED
+
+	#include <linux/futex.h>
+	#include <sys/syscall.h>
+	#include <unistd.h>
+#endif
+
+namespace so_5
+{
+
+namespace disp
+{
+
+namespace reuse
+{
+
+//
+// adaptive_spinner_t
+//
+/*!
+ * \brief Spin-waiting with exponential backoff and with adaptive
+ * limit of spinning.
+ *
+ * The limit is counted in `pause` instructions. It is increased if
+ * a condition becomes true during spinning and is decreased if spinning
+ * was unsuccessful. So the spinner learns from recent waiting times
+ * without polling of a clock.
+ *
+ * \note Can be used from several threads at the same time. The limit
+ * is a hint only, so relaxed atomic operations are used for it.
+ *
+ * \since
+ * v.5.5.23
+ */
+class adaptive_spinner_t
+	{
+	public :
+		//! Min limit of spinning.
+		static const unsigned min_limit = 64u;
+		//! Max limit of spinning.
+		static const unsigned max_limit = 32u * 1024u;
+		//! Initial limit of spinning.
+		static const unsigned initial_limit = 1024u;
+		//! Max count of `pause` instructions between checks of the condition.
+		static const unsigned max_pauses_per_step = 64u;
+
+		//! Spin while \a predicate returns false.
+		/*!
+		 * \retval true if \a predicate returned true during spinning.
+		 */
+		template< typename Predicate >
+		bool
+		spin_until( Predicate && predicate ) SO_5_NOEXCEPT
+			{
+				const unsigned limit = m_limit.load( std::memory_order_relaxed );
+
+				unsigned spent = 0u;
+				unsigned pauses = 1u;
+				while( spent < limit )
+					{
+						if( predicate() )
+							{
+								adjust_limit( 2u * spent + min_limit );
+								return true;
+							}
+
+						for( unsigned i = 0u; i != pauses; ++i )
+							so_5::cpu_relax();
+
+						spent += pauses;
+						if( pauses < max_pauses_per_step )
+							pauses <<= 1;
+					}
+
+				adjust_limit( limit / 2u );
+				return false;
+			}
+
+	private :
+		std::atomic< unsigned > m_limit{ initial_limit };
+
+		void
+		adjust_limit( unsigned target ) SO_5_NOEXCEPT
+			{
+				if( target < min_limit )
+					target = min_limit;
+				else if( target > max_limit )
+					target = max_limit;
+
+				// Smoothing: only a quarter of the difference is taken.
+				const unsigned current = m_limit.load( std::memory_order_relaxed );
+				m_limit.store(
+						current - current / 4u + target / 4u,
+						std::memory_order_relaxed );
+			}
+	};
+
+#if defined(SO_5_DISP_REUSE_FUTEX_SUPPORTED)
+
+namespace futex
+{
+
+static_assert( sizeof(std::atomic< int >) == sizeof(int),
+		"std::atomic<int> must have the same size as int for usage with futex" );
+
+//! Park the current thread while \a word contains \a expected value.
+/*!
+ * \note Can return spuriously.
+ */
+inline void
+wait( std::atomic< int > & word, int expected ) SO_5_NOEXCEPT
+	{
+		::syscall( SYS_futex, reinterpret_cast< int * >(&word),
+				FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0 );
+	}
+
+//! Wake up one thread parked on \a word.
+inline void
+wake_one( std::atomic< int > & word ) SO_5_NOEXCEPT
+	{
+		::syscall( SYS_futex, reinterpret_cast< int * >(&word),
+				FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0 );
+	}
+
+} /* namespace futex */
+
+//
+// futex_mutex_t
+//
+/*!
+ * \brief A mutex with adaptive spinning and parking on futex.
+ *
+ * An implementation of "Mutex, Take 3" from "Futexes Are Tricky"
+ * by U. Drepper.
+ *
+ * \since
+ * v.5.5.23
+ */
+class futex_mutex_t
+	{
+		//! Values of state of the mutex.
+		enum : int
+			{
+				unlocked = 0,
+				locked = 1,
+				locked_with_waiters = 2
+			};
+
+	public :
+		futex_mutex_t() = default;
+		futex_mutex_t( const futex_mutex_t & ) = delete;
+		futex_mutex_t &
+		operator=( const futex_mutex_t & ) = delete;
+
+		void
+		lock() SO_5_NOEXCEPT
+			{
+				if( try_lock() )
+					return;
+
+				if( m_spinner.spin_until( [this] {
+						return unlocked == m_state.load( std::memory_order_relaxed ) &&
+								try_lock();
+					} ) )
+					return;
+
+				while( unlocked != m_state.exchange(
+						locked_with_waiters, std::memory_order_acquire ) )
+					futex::wait( m_state, locked_with_waiters );
+			}
+
+		void
+		unlock() SO_5_NOEXCEPT
+			{
+				if( locked_with_waiters == m_state.exchange(
+						unlocked, std::memory_order_release ) )
+					futex::wake_one( m_state );
+			}
+
+	private :
+		std::atomic< int > m_state{ unlocked };
+
+		adaptive_spinner_t m_spinner;
+
+		bool
+		try_lock() SO_5_NOEXCEPT
+			{
+				int expected = unlocked;
+				return m_state.compare_exchange_strong(
+						expected, locked, std::memory_order_acquire,
+						std::memory_order_relaxed );
+			}
+	};
+
+//
+// futex_event_t
+//
+/*!
+ * \brief An event for waiting of notification by just one thread.
+ *
+ * The waiting thread spins at first and parks on futex only if
+ * the notification does not come during spinning. A notifier does
+ * a system call only if the waiting thread is parked.
+ *
+ * \since
+ * v.5.5.23
+ */
+class futex_event_t
+	{
+		//! Values of state of the event.
+		enum : int
+			{
+				not_signaled = 0,
+				signaled = 1,
+				waiter_parked = 2
+			};
+
+	public :
+		futex_event_t() = default;
+		futex_event_t( const futex_event_t & ) = delete;
+		futex_event_t &
+		operator=( const futex_event_t & ) = delete;
+
+		//! Drop the signaled state.
+		/*!
+		 * \attention Must be called only by the waiting thread.
+		 */
+		void
+		reset() SO_5_NOEXCEPT
+			{
+				m_state.store( not_signaled, std::memory_order_relaxed );
+			}
+
+		//! Wait for notification.
+		/*!
+		 * \attention Only one thread can wait at the same time.
+		 */
+		void
+		wait() SO_5_NOEXCEPT
+			{
+				if( m_spinner.spin_until( [this] {
+						return signaled == m_state.load( std::memory_order_acquire );
+					} ) )
+					return;
+
+				int expected = not_signaled;
+				if( m_state.compare_exchange_strong(
+						expected, waiter_parked, std::memory_order_acquire ) )
+					do
+						{
+							futex::wait( m_state, waiter_parked );
+						}
+					while( waiter_parked == m_state.load( std::memory_order_acquire ) );
+			}
+
+		//! Notify the waiting thread.
+		void
+		notify() SO_5_NOEXCEPT
+			{
+				if( waiter_parked == m_state.exchange(
+						signaled, std::memory_order_release ) )
+					futex::wake_one( m_state );
+			}
+
+	private :
+		std::atomic< int > m_state{ not_signaled };
+
+		adaptive_spinner_t m_spinner;
+	};
+
+#endif /* SO_5_DISP_REUSE_FUTEX_SUPPORTED */
+
+} /* namespace reuse */
+
+} /* namespace disp */
+
+} /* namespace so_5 */
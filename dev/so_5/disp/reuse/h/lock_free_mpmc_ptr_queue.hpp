@@ -0,0 +1,633 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \file
+ * \brief Multi-producer/Multi-consumer queue of pointers based on
+ * lock-free ring buffer.
+ * \since
+ * v.5.5.23
+ */
+
+#pragma once
+
+#include <so_5/disp/mpmc_queue_traits/h/pub.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace so_5
+{
+
+namespace disp
+{
+
+namespace reuse
+{
+
+namespace lock_free_mpmc_details
+{
+
+//
+// ring_buffer_t
+//
+/*!
+ * \brief Bounded lock-free MPMC ring buffer of pointers.
+ *
+ * This is a variation of Dmitry Vyukov's bounded MPMC queue with
+ * per-cell sequence numbers. A producer must acquire one free slot and
+ * a consumer must acquire one available item before they touch any
+ * cell. So push and pop never wait for each other except the very
+ * short period when a cell is being filled/cleaned by another thread.
+ *
+ * \since
+ * v.5.5.23
+ */
+template< class T >
+class ring_buffer_t
+	{
+		//! Type of one cell of the buffer.
+		struct cell_t
+			{
+				//! Sequence number of the cell.
+				std::atomic< std::size_t > m_sequence;
+				//! Item stored in the cell.
+				T * m_item;
+			};
+
+	public :
+		ring_buffer_t( std::size_t capacity )
+			:	m_capacity{ round_up_capacity( capacity ) }
+			,	m_mask{ m_capacity - 1u }
+			,	m_cells{ new cell_t[ m_capacity ] }
+			,	m_free_slots{ m_capacity }
+			{
+				for( std::size_t i = 0; i != m_capacity; ++i )
+					{
+						m_cells[ i ].m_sequence.store( i, std::memory_order_relaxed );
+						m_cells[ i ].m_item = nullptr;
+					}
+			}
+
+		//! Count of items in the buffer.
+		/*!
+		 * \note The value can be out of date right after return.
+		 */
+		std::size_t
+		size() const SO_5_NOEXCEPT
+			{
+				// NOTE: seq_cst load is necessary here. The queue relies
+				// on the total order between this load and modification of
+				// the count of sleeping threads.
+				return m_available.load();
+			}
+
+		//! An attempt to store an item.
+		/*!
+		 * \retval false if the buffer is full.
+		 */
+		bool
+		try_push( T * item ) SO_5_NOEXCEPT
+			{
+				if( !try_acquire( m_free_slots ) )
+					return false;
+
+				const std::size_t pos =
+						m_tail.fetch_add( 1, std::memory_order_relaxed );
+				cell_t & cell = m_cells[ pos & m_mask ];
+
+				// Previous consumer of that cell could be still working on it.
+				wait_for_sequence( cell, pos );
+
+				cell.m_item = item;
+				cell.m_sequence.store( pos + 1, std::memory_order_release );
+
+				m_available.fetch_add( 1 );
+
+				return true;
+			}
+
+		//! An attempt to extract the oldest item.
+		/*!
+		 * \retval nullptr if the buffer is empty.
+		 */
+		T *
+		try_pop() SO_5_NOEXCEPT
+			{
+				if( !try_acquire( m_available ) )
+					return nullptr;
+
+				const std::size_t pos =
+						m_head.fetch_add( 1, std::memory_order_relaxed );
+				cell_t & cell = m_cells[ pos & m_mask ];
+
+				// Producer of that cell could be still working on it.
+				wait_for_sequence( cell, pos + 1 );
+
+				T * item = cell.m_item;
+				cell.m_sequence.store( pos + m_capacity, std::memory_order_release );
+
+				m_free_slots.fetch_add( 1 );
+
+				return item;
+			}
+
+	private :
+		//! Capacity of the buffer (always a power of two).
+		const std::size_t m_capacity;
+		//! Mask for getting index of a cell from a position.
+		const std::size_t m_mask;
+
+		//! Buffer's storage.
+		std::unique_ptr< cell_t[] > m_cells;
+
+		//! Count of free slots.
+		std::atomic< std::size_t > m_free_slots;
+
+		//! Padding to place counters to different cache lines.
+		char m_padding_1[ 64 ];
+
+		//! Count of items available for extraction.
+		std::atomic< std::size_t > m_available{ 0 };
+
+		//! Padding to place counters to different cache lines.
+		char m_padding_2[ 64 ];
+
+		//! Position for the next extraction.
+		std::atomic< std::size_t > m_head{ 0 };
+
+		//! Padding to place producers' and consumers' positions
+		//! to different cache lines.
+		char m_padding_3[ 64 ];
+
+		//! Position for the next push.
+		std::atomic< std::size_t > m_tail{ 0 };
+
+		static std::size_t
+		round_up_capacity( std::size_t capacity )
+			{
+				std::size_t r = 2u;
+				while( r < capacity )
+					r <<= 1;
+				return r;
+			}
+
+		//! Helper for decrement of non-zero counter.
+		static bool
+		try_acquire( std::atomic< std::size_t > & counter ) SO_5_NOEXCEPT
+			{
+				std::size_t current = counter.load();
+				do
+					{
+						if( !current )
+							return false;
+					}
+				while( !counter.compare_exchange_weak( current, current - 1 ) );
+
+				return true;
+			}
+
+		//! Helper for waiting on the cell which is being used by
+		//! another thread.
+		static void
+		wait_for_sequence( const cell_t & cell, std::size_t expected ) SO_5_NOEXCEPT
+			{
+				while( expected !=
+						cell.m_sequence.load( std::memory_order_acquire ) )
+					std::this_thread::yield();
+			}
+	};
+
+} /* namespace lock_free_mpmc_details */
+
+//
+// lock_free_mpmc_ptr_queue_t
+//
+/*!
+ * \brief Multi-producer/Multi-consumer queue of pointers based on
+ * lock-free ring buffer.
+ *
+ * Has the same interface as mpmc_ptr_queue_t but items are stored
+ * into a bounded lock-free ring buffer. The queue lock is acquired only:
+ * - if there are sleeping worker threads and one of them should be
+ *   woken up;
+ * - if a worker thread goes to sleep;
+ * - if the ring buffer is full. Items which don't fit into the ring buffer
+ *   are stored into an overflow queue protected by the queue lock. New
+ *   items go to the overflow queue while it is not empty and worker
+ *   threads take items from the overflow queue only when the ring buffer
+ *   is empty. It keeps FIFO order of items.
+ *
+ * Wakeup of sleeping threads is performed by the same rules as in
+ * mpmc_ptr_queue_t (including next_thread_wakeup_threshold). But
+ * a producer checks presence of sleeping threads without the lock.
+ *
+ * \tparam T type of object.
+ *
+ * \since
+ * v.5.5.23
+ */
+template< class T >
+class lock_free_mpmc_ptr_queue_t
+	{
+	public :
+		lock_free_mpmc_ptr_queue_t(
+			const so_5::disp::mpmc_queue_traits::queue_params_t & queue_params,
+			std::size_t thread_count )
+			:	m_lock{ queue_params.lock_factory()() }
+			,	m_ring{ queue_params.lock_free_queue_capacity() }
+			,	m_max_thread_count{ thread_count }
+			,	m_next_thread_wakeup_threshold{
+					queue_params.next_thread_wakeup_threshold() }
+			{
+				m_waiting_customers.reserve( thread_count );
+			}
+
+		//! Initiate shutdown for working threads.
+		inline void
+		shutdown()
+			{
+				std::lock_guard< so_5::disp::mpmc_queue_traits::lock_t > lock{ *m_lock };
+
+				m_shutdown.store( true, std::memory_order_release );
+
+				while( !m_waiting_customers.empty() )
+					pop_and_notify_one_waiting_customer();
+			}
+
+		//! Get next active queue.
+		/*!
+		 * \retval nullptr is the case of dispatcher shutdown or
+		 * the case when the calling thread must be retired
+		 * (see retire_one_thread()).
+		 */
+		inline T *
+		pop( so_5::disp::mpmc_queue_traits::condition_t & condition )
+			{
+				while( !m_shutdown.load( std::memory_order_acquire ) )
+					{
+						if( auto r = try_pop_item() )
+							{
+								// There could be non-empty queue and sleeping workers...
+								try_wakeup_someone_if_possible_unlocked();
+								return r;
+							}
+
+						bool retire = false;
+						if( auto r = wait_for_work( condition, retire ) )
+							return r;
+
+						if( retire )
+							break;
+					}
+
+				return nullptr;
+			}
+
+		//! Switch the current non-empty queue to another one if it is possible.
+		/*!
+		 * \return nullptr is the case of dispatcher shutdown.
+		 */
+		inline T *
+		try_switch_to_another( T * current ) SO_5_NOEXCEPT
+			{
+				if( m_shutdown.load( std::memory_order_acquire ) )
+					return nullptr;
+
+				auto r = try_pop_item();
+				if( !r )
+					return current;
+
+				// Old non-empty queue must be stored for further processing.
+				// No need to wakup someone because the length of the queue
+				// didn't changed.
+				push_item( current );
+
+				return r;
+			}
+
+		//! Schedule execution of demands from the queue.
+		void
+		schedule( T * queue )
+			{
+				if( push_item( queue ) )
+					{
+						// NOTE: seq_cst load is necessary here. The count of
+						// sleeping threads must be read only after the item
+						// become visible for them.
+						if( m_sleeping_count.load() )
+							{
+								std::lock_guard< so_5::disp::mpmc_queue_traits::lock_t >
+										lock{ *m_lock };
+								try_wakeup_someone_if_possible();
+							}
+					}
+				else
+					{
+						// The item is in the overflow queue and the lock
+						// is already released.
+						std::lock_guard< so_5::disp::mpmc_queue_traits::lock_t > lock{ *m_lock };
+						try_wakeup_someone_if_possible();
+					}
+			}
+
+		so_5::disp::mpmc_queue_traits::condition_unique_ptr_t
+		allocate_condition()
+			{
+				return m_lock->allocate_condition();
+			}
+
+		//! Get count of items in the queue.
+		/*!
+		 * \note The value can be out of date right after return.
+		 */
+		std::size_t
+		size() const
+			{
+				return m_ring.size() +
+						m_overflow_size.load( std::memory_order_acquire );
+			}
+
+		//! Get count of threads waiting for work.
+		/*!
+		 * \note The value can be out of date right after return.
+		 */
+		std::size_t
+		waiting_threads() const
+			{
+				return m_sleeping_count.load( std::memory_order_acquire );
+			}
+
+		//! Inform the queue about a new working thread.
+		/*!
+		 * Must be called before the start of the new thread.
+		 */
+		void
+		thread_added()
+			{
+				std::lock_guard< so_5::disp::mpmc_queue_traits::lock_t > lock{ *m_lock };
+
+				++m_max_thread_count;
+				m_waiting_customers.reserve( m_max_thread_count );
+			}
+
+		//! Inform the queue that a thread announced by thread_added()
+		//! wasn't started.
+		void
+		thread_removed()
+			{
+				std::lock_guard< so_5::disp::mpmc_queue_traits::lock_t > lock{ *m_lock };
+
+				--m_max_thread_count;
+			}
+
+		//! Ask one of working threads to finish its work.
+		/*!
+		 * The next thread which finds the queue empty gets nullptr from
+		 * pop() and must finish. One of sleeping threads (if any) is
+		 * woken up for that.
+		 */
+		void
+		retire_one_thread()
+			{
+				std::lock_guard< so_5::disp::mpmc_queue_traits::lock_t > lock{ *m_lock };
+
+				--m_max_thread_count;
+				++m_threads_to_retire;
+
+				if( !m_waiting_customers.empty() )
+					pop_and_notify_one_waiting_customer();
+			}
+
+	private :
+		//! Object's lock.
+		/*!
+		 * Protects the overflow queue and the list of waiting customers.
+		 */
+		so_5::disp::mpmc_queue_traits::lock_unique_ptr_t m_lock;
+
+		//! Shutdown flag.
+		std::atomic< bool > m_shutdown{ false };
+
+		//! Main storage for items.
+		lock_free_mpmc_details::ring_buffer_t< T > m_ring;
+
+		//! Items which don't fit into the ring buffer.
+		std::deque< T * > m_overflow;
+
+		//! Size of the overflow queue.
+		/*!
+		 * Allows to check the emptiness of the overflow queue without
+		 * acquiring the lock.
+		 */
+		std::atomic< std::size_t > m_overflow_size{ 0 };
+
+		//! Is some working thread is in wakeup process now.
+		bool	m_wakeup_in_progress{ false };
+
+		//! Maximum count of working threads to be used with that queue.
+		/*!
+		 * Can be changed by thread_added() and retire_one_thread().
+		 */
+		std::size_t m_max_thread_count;
+
+		//! Count of threads which must be retired.
+		std::size_t m_threads_to_retire{ 0 };
+
+		//! Threshold for wake up next working thread if there are
+		//! non-empty agent queues.
+		const std::size_t m_next_thread_wakeup_threshold;
+
+		//! Waiting threads.
+		std::vector< so_5::disp::mpmc_queue_traits::condition_t * > m_waiting_customers;
+
+		//! Count of waiting threads.
+		/*!
+		 * Allows to check presence of waiting threads without acquiring
+		 * the lock.
+		 */
+		std::atomic< std::size_t > m_sleeping_count{ 0 };
+
+		//! Store an item into the ring buffer or into the overflow queue.
+		/*!
+		 * \retval true if the item is stored into the ring buffer.
+		 * \retval false if the item is stored into the overflow queue.
+		 */
+		bool
+		push_item( T * item )
+			{
+				if( !m_overflow_size.load( std::memory_order_acquire ) &&
+						m_ring.try_push( item ) )
+					return true;
+
+				std::lock_guard< so_5::disp::mpmc_queue_traits::lock_t > lock{ *m_lock };
+
+				m_overflow.push_back( item );
+				m_overflow_size.store( m_overflow.size(), std::memory_order_release );
+
+				return false;
+			}
+
+		//! An attempt to get the oldest item.
+		/*!
+		 * \retval nullptr if there is no items.
+		 */
+		T *
+		try_pop_item() SO_5_NOEXCEPT
+			{
+				if( auto r = m_ring.try_pop() )
+					return r;
+
+				if( !m_overflow_size.load( std::memory_order_acquire ) )
+					return nullptr;
+
+				std::lock_guard< so_5::disp::mpmc_queue_traits::lock_t > lock{ *m_lock };
+
+				return pop_overflow_if_not_empty();
+			}
+
+		//! Extract an item from the overflow queue.
+		/*!
+		 * \attention Must be called when the object's lock is acquired.
+		 */
+		T *
+		pop_overflow_if_not_empty() SO_5_NOEXCEPT
+			{
+				if( m_overflow.empty() )
+					return nullptr;
+
+				auto r = m_overflow.front();
+				m_overflow.pop_front();
+				m_overflow_size.store( m_overflow.size(), std::memory_order_release );
+
+				return r;
+			}
+
+		//! Total count of items.
+		/*!
+		 * \attention Must be called when the object's lock is acquired.
+		 */
+		std::size_t
+		items_count() const SO_5_NOEXCEPT
+			{
+				return m_ring.size() + m_overflow.size();
+			}
+
+		//! Wait while some work will be available.
+		/*!
+		 * \retval nullptr if a new attempt to find work must be performed
+		 * or if the calling thread must be retired (\a retire is set to
+		 * true in that case).
+		 */
+		T *
+		wait_for_work(
+			so_5::disp::mpmc_queue_traits::condition_t & condition,
+			bool & retire )
+			{
+				std::lock_guard< so_5::disp::mpmc_queue_traits::lock_t > lock{ *m_lock };
+
+				if( m_shutdown.load( std::memory_order_relaxed ) )
+					return nullptr;
+
+				if( auto r = pop_overflow_if_not_empty() )
+					{
+						try_wakeup_someone_if_possible();
+						return r;
+					}
+
+				// Only a thread without work can be retired.
+				// A producer could decide not to wake anyone up because of
+				// the wakeup of this thread. So the item must be handled.
+				if( m_threads_to_retire && !m_ring.size() )
+					{
+						--m_threads_to_retire;
+						retire = true;
+						return nullptr;
+					}
+
+				m_waiting_customers.push_back( &condition );
+				m_sleeping_count.fetch_add( 1 );
+
+				// An item could be pushed to the ring buffer before the change
+				// of m_sleeping_count become visible.
+				if( m_ring.size() )
+					{
+						m_waiting_customers.erase(
+								std::find( m_waiting_customers.begin(),
+										m_waiting_customers.end(),
+										&condition ) );
+						m_sleeping_count.fetch_sub( 1, std::memory_order_relaxed );
+
+						return nullptr;
+					}
+
+				condition.wait();
+				// If we are here then the current wakeup procedure is
+				// finished.
+				m_wakeup_in_progress = false;
+
+				return nullptr;
+			}
+
+		void
+		pop_and_notify_one_waiting_customer()
+			{
+				auto & condition = *m_waiting_customers.back();
+				m_waiting_customers.pop_back();
+				m_sleeping_count.fetch_sub( 1, std::memory_order_relaxed );
+
+				m_wakeup_in_progress = true;
+				condition.notify();
+			}
+
+		/*!
+		 * \brief An attempt to wakeup another sleeping thread is this necessary
+		 * and possible.
+		 *
+		 * Uses the same conditions as mpmc_ptr_queue_t.
+		 *
+		 * \attention Must be called when the object's lock is acquired.
+		 */
+		void
+		try_wakeup_someone_if_possible()
+			{
+				if( m_waiting_customers.empty() || m_wakeup_in_progress )
+					return;
+
+				const auto size = items_count();
+				if( size &&
+						( size > m_next_thread_wakeup_threshold ||
+						m_max_thread_count == m_waiting_customers.size() ) )
+					pop_and_notify_one_waiting_customer();
+			}
+
+		/*!
+		 * \brief An attempt to wakeup another sleeping thread if there are
+		 * some items.
+		 *
+		 * Acquires the object's lock only if there are sleeping threads.
+		 */
+		void
+		try_wakeup_someone_if_possible_unlocked()
+			{
+				if( m_sleeping_count.load( std::memory_order_relaxed ) &&
+						( m_ring.size() ||
+						m_overflow_size.load( std::memory_order_relaxed ) ) )
+					{
+						std::lock_guard< so_5::disp::mpmc_queue_traits::lock_t >
+								lock{ *m_lock };
+						try_wakeup_someone_if_possible();
+					}
+			}
+	};
+
+} /* namespace reuse */
+
+} /* namespace disp */
+
+} /* namespace so_5 */
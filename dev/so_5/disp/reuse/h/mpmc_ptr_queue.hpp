@@ -13,6 +13,7 @@
 
 #include <so_5/disp/mpmc_queue_traits/h/pub.hpp>
 
+#include <atomic>
 #include <deque>
 #include <vector>
 
@@ -71,7 +72,9 @@ class mpmc_ptr_queue_t
 
 		//! Get next active queue.
 		/*!
-		 * \retval nullptr is the case of dispatcher shutdown.
+		 * \retval nullptr is the case of dispatcher shutdown or
+		 * the case when the calling thread must be retired
+		 * (see retire_one_thread()).
 		 */
 		inline T *
 		pop( so_5::disp::mpmc_queue_traits::condition_t & condition )
@@ -87,6 +90,7 @@ class mpmc_ptr_queue_t
 							{
 								auto r = m_queue.front();
 								m_queue.pop_front();
+								m_size.store( m_queue.size(), std::memory_order_relaxed );
 
 								// There could be non-empty queue and sleeping workers...
 								try_wakeup_someone_if_possible();
@@ -94,6 +98,13 @@ class mpmc_ptr_queue_t
 								return r;
 							}
 
+						// Only a thread without work can be retired.
+						if( m_threads_to_retire )
+							{
+								--m_threads_to_retire;
+								break;
+							}
+
 						m_waiting_customers.push_back( &condition );
 
 						condition.wait();
@@ -144,6 +155,7 @@ class mpmc_ptr_queue_t
 				std::lock_guard< so_5::disp::mpmc_queue_traits::lock_t > lock{ *m_lock };
 
 				m_queue.push_back( queue );
+				m_size.store( m_queue.size(), std::memory_order_relaxed );
 
 				try_wakeup_someone_if_possible();
 			}
@@ -154,6 +166,84 @@ class mpmc_ptr_queue_t
 				return m_lock->allocate_condition();
 			}
 
+		//! Get count of items in the queue.
+		/*!
+		 * Doesn't acquire the queue's lock.
+		 *
+		 * \note The value can be out of date right after return.
+		 *
+		 * \since
+		 * v.5.5.23
+		 */
+		std::size_t
+		size() const
+			{
+				return m_size.load( std::memory_order_relaxed );
+			}
+
+		//! Get count of threads waiting for work.
+		/*!
+		 * \since
+		 * v.5.5.23
+		 */
+		std::size_t
+		waiting_threads() const
+			{
+				std::lock_guard< so_5::disp::mpmc_queue_traits::lock_t > lock{ *m_lock };
+				return m_waiting_customers.size();
+			}
+
+		//! Inform the queue about a new working thread.
+		/*!
+		 * Must be called before the start of the new thread.
+		 *
+		 * \since
+		 * v.5.5.23
+		 */
+		void
+		thread_added()
+			{
+				std::lock_guard< so_5::disp::mpmc_queue_traits::lock_t > lock{ *m_lock };
+
+				++m_max_thread_count;
+				m_waiting_customers.reserve( m_max_thread_count );
+			}
+
+		//! Inform the queue that a thread announced by thread_added()
+		//! wasn't started.
+		/*!
+		 * \since
+		 * v.5.5.23
+		 */
+		void
+		thread_removed()
+			{
+				std::lock_guard< so_5::disp::mpmc_queue_traits::lock_t > lock{ *m_lock };
+
+				--m_max_thread_count;
+			}
+
+		//! Ask one of working threads to finish its work.
+		/*!
+		 * The next thread which finds the queue empty gets nullptr from
+		 * pop() and must finish. One of sleeping threads (if any) is
+		 * woken up for that.
+		 *
+		 * \since
+		 * v.5.5.23
+		 */
+		void
+		retire_one_thread()
+			{
+				std::lock_guard< so_5::disp::mpmc_queue_traits::lock_t > lock{ *m_lock };
+
+				--m_max_thread_count;
+				++m_threads_to_retire;
+
+				if( !m_waiting_customers.empty() )
+					pop_and_notify_one_waiting_customer();
+			}
+
 	private :
 		//! Object's lock.
 		so_5::disp::mpmc_queue_traits::lock_unique_ptr_t m_lock;
@@ -164,6 +254,14 @@ class mpmc_ptr_queue_t
 		//! Queue object.
 		std::deque< T * > m_queue;
 
+		/*!
+		 * \brief Size of m_queue for reading without the lock.
+		 *
+		 * \since
+		 * v.5.5.23
+		 */
+		std::atomic< std::size_t > m_size{ 0 };
+
 		/*!
 		 * \since
 		 * v.5.5.15.1
@@ -176,10 +274,21 @@ class mpmc_ptr_queue_t
 		 * \brief Maximum count of working threads to be used with
 		 * that mpmc_queue.
 		 *
+		 * \note Since v.5.5.23 this value can be changed by
+		 * thread_added() and retire_one_thread().
+		 *
 		 * \since
 		 * v.5.5.16
 		 */
-		const std::size_t m_max_thread_count;
+		std::size_t m_max_thread_count;
+
+		/*!
+		 * \brief Count of threads which must be retired.
+		 *
+		 * \since
+		 * v.5.5.23
+		 */
+		std::size_t m_threads_to_retire{ 0 };
 
 		/*!
 		 * \brief Threshold for wake up next working thread if there are
@@ -0,0 +1,331 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \file
+ * \brief Placement of dispatcher's work threads on CPUs and NUMA nodes.
+ *
+ * \since
+ * v.5.5.23
+ */
+
+#pragma once
+
+#include <so_5/h/declspec.hpp>
+
+#include <cstddef>
+#include <exception>
+#include <future>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace so_5 {
+
+namespace disp {
+
+namespace reuse {
+
+//
+// thread_placement_t
+//
+/*!
+ * \brief Description of CPUs and NUMA node for a work thread.
+ *
+ * If CPUs are specified then a work thread is allowed to run only on
+ * those CPUs.
+ *
+ * If NUMA node is specified then a work thread is allowed to run only
+ * on CPUs of that node (if CPUs are specified too then only on those
+ * of them which belong to the node). Memory allocated by the work
+ * thread is placed on that node if possible. It includes the memory
+ * of the demand queue allocated by the work thread itself.
+ *
+ * \note Thread placement is supported on Linux only. It is ignored
+ * on other platforms.
+ *
+ * \since
+ * v.5.5.23
+ *
+ * \par Usage example:
+	\code
+	using namespace so_5::disp::thread_pool;
+	create_private_disp( env, "workers",
+		disp_params_t{}
+			.thread_count( 4 )
+			// All workers on the first NUMA node.
+			.thread_placement( so_5::disp::reuse::thread_placement_t{}.numa_node( 0 ) )
+			// But the first worker on the CPU 2 only.
+			.worker_thread_placement( 0,
+					so_5::disp::reuse::thread_placement_t{}.cpus( { 2 } ) ) );
+	\endcode
+ */
+class thread_placement_t
+	{
+	public :
+		//! Type of list of CPUs.
+		using cpu_list_t = std::vector< unsigned int >;
+
+		//! Setter for list of CPUs.
+		thread_placement_t &
+		cpus( cpu_list_t v )
+			{
+				m_cpus = std::move(v);
+				return *this;
+			}
+
+		//! Add another CPU to the list of CPUs.
+		thread_placement_t &
+		add_cpu( unsigned int cpu )
+			{
+				m_cpus.push_back( cpu );
+				return *this;
+			}
+
+		//! Getter for list of CPUs.
+		const cpu_list_t &
+		cpus() const
+			{
+				return m_cpus;
+			}
+
+		//! Setter for NUMA node.
+		thread_placement_t &
+		numa_node( unsigned int node )
+			{
+				m_numa_node = node;
+				m_numa_node_specified = true;
+				return *this;
+			}
+
+		//! Is NUMA node specified?
+		bool
+		has_numa_node() const
+			{
+				return m_numa_node_specified;
+			}
+
+		//! Getter for NUMA node.
+		/*!
+		 * \attention Has sense only if has_numa_node() returns true.
+		 */
+		unsigned int
+		numa_node() const
+			{
+				return m_numa_node;
+			}
+
+		//! Is there no placement information?
+		bool
+		empty() const
+			{
+				return m_cpus.empty() && !m_numa_node_specified;
+			}
+
+	private :
+		//! CPUs for the thread.
+		cpu_list_t m_cpus;
+
+		//! NUMA node for the thread.
+		unsigned int m_numa_node{ 0u };
+
+		//! Is NUMA node specified?
+		bool m_numa_node_specified{ false };
+	};
+
+//
+// worker_thread_placements_t
+//
+/*!
+ * \brief Placements for all work threads of a dispatcher.
+ *
+ * There is a placement for every thread and placements for
+ * individual threads (by thread index). Individual placements
+ * have a priority.
+ *
+ * \since
+ * v.5.5.23
+ */
+class worker_thread_placements_t
+	{
+	public :
+		//! Setter for placement of every thread.
+		void
+		set_common( thread_placement_t v )
+			{
+				m_common = std::move(v);
+			}
+
+		//! Setter for placement of thread with the specified index.
+		void
+		set_for_worker( std::size_t index, thread_placement_t v )
+			{
+				if( m_individual.size() <= index )
+					m_individual.resize( index + 1u );
+
+				m_individual[ index ] = std::move(v);
+			}
+
+		//! Getter for placement of every thread.
+		const thread_placement_t &
+		common() const
+			{
+				return m_common;
+			}
+
+		//! Getter for placement of thread with the specified index.
+		const thread_placement_t &
+		for_worker( std::size_t index ) const
+			{
+				if( index < m_individual.size() && !m_individual[ index ].empty() )
+					return m_individual[ index ];
+
+				return m_common;
+			}
+
+		friend inline void swap(
+				worker_thread_placements_t & a,
+				worker_thread_placements_t & b )
+			{
+				using std::swap;
+				swap( a.m_common, b.m_common );
+				swap( a.m_individual, b.m_individual );
+			}
+
+	private :
+		//! Placement of every thread.
+		thread_placement_t m_common;
+
+		//! Placements of individual threads.
+		std::vector< thread_placement_t > m_individual;
+	};
+
+/*!
+ * \brief Mixin with placements of work threads.
+ *
+ * Indended to be used as mixin for various disp_params_t classes.
+ *
+ * \since
+ * v.5.5.23
+ */
+template< typename Params >
+class thread_placement_mixin_t
+	{
+		worker_thread_placements_t m_placements;
+
+	public :
+		//! Getter for placements of work threads.
+		const worker_thread_placements_t &
+		thread_placements() const
+			{
+				return m_placements;
+			}
+
+		friend inline void swap(
+				thread_placement_mixin_t & a,
+				thread_placement_mixin_t & b )
+			{
+				swap( a.m_placements, b.m_placements );
+			}
+
+		//! Setter for placement of every work thread.
+		Params &
+		thread_placement( thread_placement_t v )
+			{
+				m_placements.set_common( std::move(v) );
+				return static_cast< Params & >(*this);
+			}
+
+		//! Setter for placement of work thread with the specified index.
+		/*!
+		 * Work threads of thread pools are indexed from 0 to
+		 * thread_count-1. Work threads of prio_dedicated_threads
+		 * dispatchers are indexed by priorities. Other dispatchers
+		 * use the placement of every work thread only.
+		 */
+		Params &
+		worker_thread_placement( std::size_t index, thread_placement_t v )
+			{
+				m_placements.set_for_worker( index, std::move(v) );
+				return static_cast< Params & >(*this);
+			}
+	};
+
+//
+// apply_thread_placement
+//
+/*!
+ * \brief Apply placement to the current thread.
+ *
+ * \throw so_5::exception_t if the placement can't be applied.
+ *
+ * \since
+ * v.5.5.23
+ */
+SO_5_FUNC void
+apply_thread_placement( const thread_placement_t & placement );
+
+//
+// make_placed_thread
+//
+/*!
+ * \brief Create a thread with the specified placement.
+ *
+ * The placement is applied by the new thread itself before the call
+ * of \a body. If the placement can't be applied then \a body is not
+ * called, the new thread is joined and an exception is thrown.
+ *
+ * \since
+ * v.5.5.23
+ */
+template< typename Body >
+std::thread
+make_placed_thread(
+	const thread_placement_t & placement,
+	Body body )
+	{
+		if( placement.empty() )
+			return std::thread( std::move(body) );
+
+		std::promise< void > placed;
+		auto result = placed.get_future();
+
+		// The placement object is used only until the result is set.
+		// The creator waits for the result, so a reference can be used.
+		std::thread thread(
+				[&placement]( std::promise< void > p, Body b ) {
+					try
+						{
+							apply_thread_placement( placement );
+						}
+					catch( ... )
+						{
+							p.set_exception( std::current_exception() );
+							return;
+						}
+
+					p.set_value();
+					b();
+				},
+				std::move(placed),
+				std::move(body) );
+
+		try
+			{
+				result.get();
+			}
+		catch( ... )
+			{
+				thread.join();
+				throw;
+			}
+
+		return thread;
+	}
+
+} /* namespace reuse */
+
+} /* namespace disp */
+
+} /* namespace so_5 */
@@ -48,6 +48,25 @@ struct queue_description_t
 
 		//! Current queue size.
 		std::size_t m_queue_size;
+
+		//! Current count of demands to be processed at once.
+		/*!
+		 * Zero value means that there is no such limit for that queue.
+		 *
+		 * \since
+		 * v.5.5.23
+		 */
+		std::size_t m_demands_at_once;
+
+		//! Total service time of that queue in microseconds.
+		/*!
+		 * Zero value means that the service time isn't measured
+		 * for that queue.
+		 *
+		 * \since
+		 * v.5.5.23
+		 */
+		std::size_t m_service_time;
 	};
 
 /*!
@@ -118,6 +137,8 @@ make_queue_desc_holder(
 		result->m_desc.m_prefix = stats::prefix_t{ ss.str() };
 		result->m_desc.m_agent_count = agent_count;
 		result->m_desc.m_queue_size = 0;
+		result->m_desc.m_demands_at_once = 0;
+		result->m_desc.m_service_time = 0;
 
 		return result;
 	}
@@ -144,6 +165,8 @@ make_queue_desc_holder(
 		result->m_desc.m_prefix = stats::prefix_t{ ss.str() };
 		result->m_desc.m_agent_count = 1;
 		result->m_desc.m_queue_size = 0;
+		result->m_desc.m_demands_at_once = 0;
+		result->m_desc.m_service_time = 0;
 
 		return result;
 	}
@@ -171,6 +194,32 @@ class stats_consumer_t
 		add_queue(
 			const intrusive_ptr_t< queue_description_holder_t > & queue_desc ) = 0;
 
+		/*!
+		 * \brief Informs consumer about count of non-empty event queues
+		 * waiting for a work thread.
+		 *
+		 * \since
+		 * v.5.5.23
+		 */
+		virtual void
+		set_ready_queue_size( std::size_t value ) = 0;
+
+		/*!
+		 * \brief Informs consumer about changes of thread count made by
+		 * elastic thread pool.
+		 *
+		 * \note This method is called only for elastic thread pools.
+		 *
+		 * \since
+		 * v.5.5.23
+		 */
+		virtual void
+		set_thread_count_changes(
+			//! Count of threads started because of high load.
+			std::size_t started,
+			//! Count of idle threads retired.
+			std::size_t retired ) = 0;
+
 		/*!
 		 * \brief Informs consumer about yet another working thread
 		 * activity.
@@ -259,6 +308,27 @@ class data_source_t : public stats::manually_registered_source_t
 						stats::suffixes::disp_thread_count(),
 						collector.thread_count() );
 
+				so_5::send< stats::messages::quantity< std::size_t > >(
+						mbox,
+						m_prefix,
+						stats::suffixes::disp_ready_queue_size(),
+						collector.ready_queue_size() );
+
+				if( collector.elastic() )
+					{
+						so_5::send< stats::messages::quantity< std::size_t > >(
+								mbox,
+								m_prefix,
+								stats::suffixes::disp_thread_started_count(),
+								collector.threads_started() );
+
+						so_5::send< stats::messages::quantity< std::size_t > >(
+								mbox,
+								m_prefix,
+								stats::suffixes::disp_thread_retired_count(),
+								collector.threads_retired() );
+					}
+
 				so_5::send< stats::messages::quantity< std::size_t > >(
 						mbox,
 						m_prefix,
@@ -289,6 +359,20 @@ class data_source_t : public stats::manually_registered_source_t
 								queue.m_prefix,
 								stats::suffixes::work_thread_queue_size(),
 								queue.m_queue_size );
+
+						if( queue.m_demands_at_once )
+							so_5::send< stats::messages::quantity< std::size_t > >(
+									mbox,
+									queue.m_prefix,
+									stats::suffixes::disp_demands_at_once(),
+									queue.m_demands_at_once );
+
+						if( queue.m_service_time )
+							so_5::send< stats::messages::quantity< std::size_t > >(
+									mbox,
+									queue.m_prefix,
+									stats::suffixes::disp_service_time(),
+									queue.m_service_time );
 					} );
 			}
 
@@ -398,6 +482,23 @@ class data_source_t : public stats::manually_registered_source_t
 							}
 					}
 
+				virtual void
+				set_ready_queue_size(
+					std::size_t value ) override
+					{
+						m_ready_queue_size = value;
+					}
+
+				virtual void
+				set_thread_count_changes(
+					std::size_t started,
+					std::size_t retired ) override
+					{
+						m_elastic = true;
+						m_threads_started = started;
+						m_threads_retired = retired;
+					}
+
 				virtual void
 				add_work_thread_activity(
 					const so_5::current_thread_id_t & thread_id,
@@ -407,6 +508,30 @@ class data_source_t : public stats::manually_registered_source_t
 						m_wt_activity.emplace_back( thread_id, stats );
 					}
 
+				std::size_t
+				ready_queue_size() const
+					{
+						return m_ready_queue_size;
+					}
+
+				bool
+				elastic() const
+					{
+						return m_elastic;
+					}
+
+				std::size_t
+				threads_started() const
+					{
+						return m_threads_started;
+					}
+
+				std::size_t
+				threads_retired() const
+					{
+						return m_threads_retired;
+					}
+
 				std::size_t
 				thread_count() const
 					{
@@ -445,6 +570,11 @@ class data_source_t : public stats::manually_registered_source_t
 
 				std::size_t m_thread_count = { 0 };
 				std::size_t m_agent_count = { 0 };
+				std::size_t m_ready_queue_size = { 0 };
+
+				bool m_elastic = { false };
+				std::size_t m_threads_started = { 0 };
+				std::size_t m_threads_retired = { 0 };
 
 				wt_activity_info_container_t & m_wt_activity;
 
@@ -0,0 +1,500 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \file
+ * \brief Multi-producer/Multi-consumer queue of pointers with
+ * work stealing.
+ * \since
+ * v.5.5.23
+ */
+
+#pragma once
+
+#include <so_5/disp/mpmc_queue_traits/h/pub.hpp>
+
+#include <so_5/disp/reuse/h/chase_lev_deque.hpp>
+
+#include <algorithm>
+#include <deque>
+#include <vector>
+
+namespace so_5
+{
+
+namespace disp
+{
+
+namespace reuse
+{
+
+//
+// work_stealing_ptr_queue_t
+//
+/*!
+ * \brief Multi-producer/Multi-consumer queue of pointers with
+ * work stealing.
+ *
+ * Has the same interface as mpmc_ptr_queue_t but uses different
+ * scheduling scheme:
+ * - every worker thread has its own Chase-Lev deque;
+ * - if an item is scheduled by a worker thread it is pushed to the
+ *   worker's deque and will be taken by this worker in LIFO order;
+ * - an idle worker steals items from deques of other workers in FIFO
+ *   order;
+ * - if an item is scheduled by a thread which isn't a worker of this
+ *   queue the item is stored into the shared FIFO queue protected by
+ *   the queue lock.
+ *
+ * The shared queue is also used for items which still have something
+ * to process after try_switch_to_another(). The shared queue is checked
+ * by workers from time to time even if they have items in own deques.
+ * It prevents starvation of items in the shared queue.
+ *
+ * Waiting on empty queue is performed the same way as in mpmc_ptr_queue_t.
+ *
+ * \attention Each worker thread must call pop() before any other method
+ * because worker's deque is bound to the thread in the first call to pop().
+ *
+ * \tparam T type of object.
+ *
+ * \since
+ * v.5.5.23
+ */
+template< class T >
+class work_stealing_ptr_queue_t
+	{
+		//! Data of one worker thread.
+		struct worker_t
+			{
+				//! Queue to which that worker belongs.
+				const work_stealing_ptr_queue_t * m_owner;
+
+				//! Index of worker.
+				const std::size_t m_index;
+
+				//! Local deque of the worker.
+				chase_lev_deque_t< T > m_deque;
+
+				//! Number of items taken by the worker.
+				/*!
+				 * Is used for periodical check of the shared queue.
+				 */
+				unsigned int m_ticks = 0u;
+
+				worker_t(
+					const work_stealing_ptr_queue_t * owner,
+					std::size_t index )
+					:	m_owner( owner )
+					,	m_index( index )
+					{}
+			};
+
+		//! How often the shared queue must be checked before the local deque.
+		static const unsigned int shared_queue_check_period = 61u;
+
+	public :
+		work_stealing_ptr_queue_t(
+			const so_5::disp::mpmc_queue_traits::queue_params_t & queue_params,
+			std::size_t thread_count )
+			:	m_lock{ queue_params.lock_factory()() }
+			,	m_max_thread_count{ thread_count }
+			,	m_next_thread_wakeup_threshold{
+					queue_params.next_thread_wakeup_threshold() }
+			{
+				m_workers.reserve( thread_count );
+				for( std::size_t i = 0; i != thread_count; ++i )
+					m_workers.emplace_back( new worker_t( this, i ) );
+
+				m_waiting_customers.reserve( thread_count );
+			}
+
+		//! Initiate shutdown for working threads.
+		inline void
+		shutdown()
+			{
+				std::lock_guard< so_5::disp::mpmc_queue_traits::lock_t > lock{ *m_lock };
+
+				m_shutdown.store( true, std::memory_order_release );
+
+				while( !m_waiting_customers.empty() )
+					pop_and_notify_one_waiting_customer();
+			}
+
+		//! Get next active queue.
+		/*!
+		 * \attention Must be called only by worker threads.
+		 *
+		 * \retval nullptr is the case of dispatcher shutdown.
+		 */
+		inline T *
+		pop( so_5::disp::mpmc_queue_traits::condition_t & condition )
+			{
+				auto & w = current_worker();
+
+				while( !m_shutdown.load( std::memory_order_acquire ) )
+					{
+						++w.m_ticks;
+						if( 0 == w.m_ticks % shared_queue_check_period )
+							if( auto r = try_pop_shared() )
+								return r;
+
+						if( auto r = w.m_deque.pop() )
+							return r;
+
+						if( auto r = try_steal( w ) )
+							{
+								// There could be other items and sleeping workers.
+								try_wakeup_someone_if_possible_unlocked();
+								return r;
+							}
+
+						if( auto r = try_pop_shared() )
+							return r;
+
+						if( auto r = wait_for_work( condition ) )
+							return r;
+					}
+
+				return nullptr;
+			}
+
+		//! Switch the current non-empty queue to another one if it is possible.
+		/*!
+		 * \attention Must be called only by worker threads.
+		 *
+		 * \return nullptr is the case of dispatcher shutdown.
+		 */
+		inline T *
+		try_switch_to_another( T * current ) SO_5_NOEXCEPT
+			{
+				if( m_shutdown.load( std::memory_order_acquire ) )
+					return nullptr;
+
+				auto & w = current_worker();
+
+				T * r = w.m_deque.pop();
+				if( !r && !m_shared_size.load( std::memory_order_acquire ) )
+					// There is no other work. The current queue can be
+					// processed further.
+					return current;
+
+				std::lock_guard< so_5::disp::mpmc_queue_traits::lock_t > lock{ *m_lock };
+
+				if( !r )
+					{
+						if( m_queue.empty() )
+							return current;
+
+						r = m_queue.front();
+						m_queue.pop_front();
+						m_queue.push_back( current );
+						// Size of shared queue is not changed.
+						// No need to wakeup someone.
+					}
+				else
+					{
+						// Old non-empty queue is stored into the shared queue.
+						// It can be taken by any worker.
+						m_queue.push_back( current );
+						m_shared_size.store( m_queue.size(), std::memory_order_release );
+						try_wakeup_someone_if_possible();
+					}
+
+				return r;
+			}
+
+		//! Schedule execution of demands from the queue.
+		void
+		schedule( T * queue )
+			{
+				auto w = current_worker_if_any();
+				if( w )
+					{
+						w->m_deque.push( queue );
+
+						// The count of sleeping workers must be read only after
+						// the item become visible for thieves.
+						std::atomic_thread_fence( std::memory_order_seq_cst );
+						if( m_sleeping_count.load( std::memory_order_relaxed ) )
+							{
+								std::lock_guard< so_5::disp::mpmc_queue_traits::lock_t >
+										lock{ *m_lock };
+								if( !m_waiting_customers.empty() && !m_wakeup_in_progress )
+									pop_and_notify_one_waiting_customer();
+							}
+					}
+				else
+					{
+						std::lock_guard< so_5::disp::mpmc_queue_traits::lock_t > lock{ *m_lock };
+
+						m_queue.push_back( queue );
+						m_shared_size.store( m_queue.size(), std::memory_order_release );
+
+						try_wakeup_someone_if_possible();
+					}
+			}
+
+		so_5::disp::mpmc_queue_traits::condition_unique_ptr_t
+		allocate_condition()
+			{
+				return m_lock->allocate_condition();
+			}
+
+		//! Get count of items in the shared queue and in all deques.
+		/*!
+		 * \note The value can be out of date right after return.
+		 */
+		std::size_t
+		size() const
+			{
+				std::size_t r = m_shared_size.load( std::memory_order_acquire );
+				for( const auto & w : m_workers )
+					r += w->m_deque.size();
+
+				return r;
+			}
+
+		//! Get count of threads waiting for work.
+		/*!
+		 * \note The value can be out of date right after return.
+		 */
+		std::size_t
+		waiting_threads() const
+			{
+				return m_sleeping_count.load( std::memory_order_acquire );
+			}
+
+	private :
+		//! Object's lock.
+		/*!
+		 * Protects the shared queue and the list of waiting customers.
+		 */
+		so_5::disp::mpmc_queue_traits::lock_unique_ptr_t m_lock;
+
+		//! Shutdown flag.
+		std::atomic< bool > m_shutdown{ false };
+
+		//! Data of worker threads.
+		std::vector< std::unique_ptr< worker_t > > m_workers;
+
+		//! Count of workers which already bound to their threads.
+		std::atomic< std::size_t > m_bound_workers{ 0 };
+
+		//! Shared queue.
+		std::deque< T * > m_queue;
+
+		//! Size of the shared queue.
+		/*!
+		 * Allows to check the emptiness of the shared queue without
+		 * acquiring the lock.
+		 */
+		std::atomic< std::size_t > m_shared_size{ 0 };
+
+		//! Is some working thread is in wakeup process now.
+		bool	m_wakeup_in_progress{ false };
+
+		//! Maximum count of working threads to be used with that queue.
+		const std::size_t m_max_thread_count;
+
+		//! Threshold for wake up next working thread if there are
+		//! non-empty items in the shared queue.
+		const std::size_t m_next_thread_wakeup_threshold;
+
+		//! Waiting threads.
+		std::vector< so_5::disp::mpmc_queue_traits::condition_t * > m_waiting_customers;
+
+		//! Count of waiting threads.
+		/*!
+		 * Allows to check presence of waiting threads without acquiring
+		 * the lock.
+		 */
+		std::atomic< std::size_t > m_sleeping_count{ 0 };
+
+		//! Pointer to the worker data of the current thread.
+		static worker_t *&
+		thread_worker_ptr() SO_5_NOEXCEPT
+			{
+				static thread_local worker_t * w = nullptr;
+				return w;
+			}
+
+		//! Get worker data for the current thread.
+		/*!
+		 * Binds a free worker to the current thread if it is not bound yet.
+		 */
+		worker_t &
+		current_worker() SO_5_NOEXCEPT
+			{
+				auto & w = thread_worker_ptr();
+				if( !w || this != w->m_owner )
+					w = m_workers[ m_bound_workers.fetch_add( 1,
+							std::memory_order_relaxed ) ].get();
+
+				return *w;
+			}
+
+		//! Get worker data for the current thread.
+		/*!
+		 * \retval nullptr if the current thread isn't a worker of this queue.
+		 */
+		worker_t *
+		current_worker_if_any() const SO_5_NOEXCEPT
+			{
+				auto w = thread_worker_ptr();
+				return (w && this == w->m_owner) ? w : nullptr;
+			}
+
+		//! An attempt to steal an item from other workers.
+		T *
+		try_steal( worker_t & thief )
+			{
+				const auto count = m_workers.size();
+				for( std::size_t i = 1; i < count; ++i )
+					{
+						auto & victim = *m_workers[ (thief.m_index + i) % count ];
+						if( auto r = victim.m_deque.steal() )
+							return r;
+					}
+
+				return nullptr;
+			}
+
+		//! An attempt to get an item from the shared queue.
+		T *
+		try_pop_shared()
+			{
+				if( !m_shared_size.load( std::memory_order_acquire ) )
+					return nullptr;
+
+				std::lock_guard< so_5::disp::mpmc_queue_traits::lock_t > lock{ *m_lock };
+
+				return pop_shared_if_not_empty();
+			}
+
+		//! Extract an item from the shared queue.
+		/*!
+		 * \attention Must be called when the object's lock is acquired.
+		 */
+		T *
+		pop_shared_if_not_empty()
+			{
+				if( m_queue.empty() )
+					return nullptr;
+
+				auto r = m_queue.front();
+				m_queue.pop_front();
+				m_shared_size.store( m_queue.size(), std::memory_order_release );
+
+				// There could be non-empty queue and sleeping workers...
+				try_wakeup_someone_if_possible();
+
+				return r;
+			}
+
+		//! Is there some item in deques of workers?
+		bool
+		has_items_to_steal() const
+			{
+				return std::any_of( m_workers.begin(), m_workers.end(),
+						[]( const std::unique_ptr< worker_t > & w ) {
+							return !w->m_deque.empty();
+						} );
+			}
+
+		//! Wait while some work will be available.
+		/*!
+		 * \retval nullptr if a new attempt to find work must be performed.
+		 */
+		T *
+		wait_for_work( so_5::disp::mpmc_queue_traits::condition_t & condition )
+			{
+				std::lock_guard< so_5::disp::mpmc_queue_traits::lock_t > lock{ *m_lock };
+
+				if( m_shutdown.load( std::memory_order_relaxed ) )
+					return nullptr;
+
+				if( auto r = pop_shared_if_not_empty() )
+					return r;
+
+				m_waiting_customers.push_back( &condition );
+				m_sleeping_count.fetch_add( 1, std::memory_order_seq_cst );
+
+				// An item could be pushed to some deque before the change
+				// of m_sleeping_count become visible.
+				if( has_items_to_steal() )
+					{
+						m_waiting_customers.erase(
+								std::find( m_waiting_customers.begin(),
+										m_waiting_customers.end(),
+										&condition ) );
+						m_sleeping_count.fetch_sub( 1, std::memory_order_relaxed );
+
+						return nullptr;
+					}
+
+				condition.wait();
+				// If we are here then the current wakeup procedure is
+				// finished.
+				m_wakeup_in_progress = false;
+
+				return nullptr;
+			}
+
+		void
+		pop_and_notify_one_waiting_customer()
+			{
+				auto & condition = *m_waiting_customers.back();
+				m_waiting_customers.pop_back();
+				m_sleeping_count.fetch_sub( 1, std::memory_order_relaxed );
+
+				m_wakeup_in_progress = true;
+				condition.notify();
+			}
+
+		/*!
+		 * \brief An attempt to wakeup another sleeping thread is this necessary
+		 * and possible.
+		 *
+		 * Uses the same conditions as mpmc_ptr_queue_t but only for
+		 * items in the shared queue.
+		 *
+		 * \attention Must be called when the object's lock is acquired.
+		 */
+		void
+		try_wakeup_someone_if_possible()
+			{
+				if( !m_waiting_customers.empty() &&
+						!m_wakeup_in_progress &&
+						( ( !m_queue.empty() &&
+							( m_queue.size() > m_next_thread_wakeup_threshold ||
+							m_max_thread_count == m_waiting_customers.size() ) ) ||
+						has_items_to_steal() ) )
+					pop_and_notify_one_waiting_customer();
+			}
+
+		/*!
+		 * \brief An attempt to wakeup another sleeping thread if there are
+		 * items in deques of workers.
+		 *
+		 * Acquires the object's lock only if there are sleeping threads.
+		 */
+		void
+		try_wakeup_someone_if_possible_unlocked()
+			{
+				if( m_sleeping_count.load( std::memory_order_relaxed ) &&
+						has_items_to_steal() )
+					{
+						std::lock_guard< so_5::disp::mpmc_queue_traits::lock_t >
+								lock{ *m_lock };
+						try_wakeup_someone_if_possible();
+					}
+			}
+	};
+
+} /* namespace reuse */
+
+} /* namespace disp */
+
+} /* namespace so_5 */
@@ -0,0 +1,198 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \file
+ * \brief Placement of dispatcher's work threads on CPUs and NUMA nodes.
+ *
+ * \since
+ * v.5.5.23
+ */
+
+#include <so_5/disp/reuse/h/thread_placement.hpp>
+
+#include <so_5/h/exception.hpp>
+#include <so_5/h/ret_code.hpp>
+
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <string>
+
+#if defined(__linux__)
+	#define SO_5_THREAD_PLACEMENT_SUPPORTED
+
+	#include <fstream>
+
+	#include <errno.h>
+	#include <linux/mempolicy.h>
+	#include <sched.h>
+	#include <sys/syscall.h>
+	#include <unistd.h>
+#endif
+
+namespace so_5 {
+
+namespace disp {
+
+namespace reuse {
+
+#if defined(SO_5_THREAD_PLACEMENT_SUPPORTED)
+
+namespace
+{
+
+//! Parse list of CPUs in the format of sysfs (like "0-3,8,10-11").
+thread_placement_t::cpu_list_t
+parse_cpu_list( const std::string & text )
+	{
+		thread_placement_t::cpu_list_t result;
+
+		std::size_t pos = 0u;
+		while( pos < text.size() )
+			{
+				auto end = text.find( ',', pos );
+				if( std::string::npos == end )
+					end = text.size();
+
+				const auto item = text.substr( pos, end - pos );
+				if( !item.empty() )
+					{
+						const auto dash = item.find( '-' );
+						const auto first = static_cast< unsigned int >(
+								std::stoul( item.substr( 0u, dash ) ) );
+						const auto last = std::string::npos == dash ? first :
+								static_cast< unsigned int >(
+										std::stoul( item.substr( dash + 1u ) ) );
+
+						for( auto cpu = first; cpu <= last; ++cpu )
+							result.push_back( cpu );
+					}
+
+				pos = end + 1u;
+			}
+
+		return result;
+	}
+
+//! Get list of CPUs of NUMA node.
+thread_placement_t::cpu_list_t
+numa_node_cpus( unsigned int node )
+	{
+		const auto file_name = "/sys/devices/system/node/node" +
+				std::to_string( node ) + "/cpulist";
+
+		std::ifstream file{ file_name };
+		std::string text;
+		if( !file || !std::getline( file, text ) )
+			SO_5_THROW_EXCEPTION( rc_thread_placement_failed,
+					"unable to get CPUs of NUMA node " + std::to_string( node ) );
+
+		try
+			{
+				return parse_cpu_list( text );
+			}
+		catch( const std::exception & )
+			{
+				SO_5_THROW_EXCEPTION( rc_thread_placement_failed,
+						"unable to parse CPUs of NUMA node " +
+						std::to_string( node ) + ": " + text );
+			}
+	}
+
+//! Allow the current thread to run only on the specified CPUs.
+void
+set_cpu_affinity( const thread_placement_t::cpu_list_t & cpus )
+	{
+		const auto max_cpu = *std::max_element( cpus.begin(), cpus.end() );
+
+		auto set = CPU_ALLOC( max_cpu + 1u );
+		if( !set )
+			SO_5_THROW_EXCEPTION( rc_thread_placement_failed,
+					"unable to allocate CPU set" );
+
+		const auto set_size = CPU_ALLOC_SIZE( max_cpu + 1u );
+		CPU_ZERO_S( set_size, set );
+		for( auto cpu : cpus )
+			CPU_SET_S( cpu, set_size, set );
+
+		const auto rc = sched_setaffinity( 0, set_size, set );
+		const auto error = errno;
+		CPU_FREE( set );
+
+		if( 0 != rc )
+			SO_5_THROW_EXCEPTION( rc_thread_placement_failed,
+					std::string( "sched_setaffinity failed: " ) +
+					std::strerror( error ) );
+	}
+
+//! Make NUMA node preferred for memory allocations of the current thread.
+void
+set_preferred_numa_node( unsigned int node )
+	{
+		const std::size_t bits = sizeof(unsigned long) * CHAR_BIT;
+		std::vector< unsigned long > mask( node / bits + 1u, 0ul );
+		mask[ node / bits ] |= 1ul << (node % bits);
+
+		// ENOSYS means that the kernel is built without NUMA support.
+		// There is nothing to do in that case.
+		if( 0 != syscall( SYS_set_mempolicy,
+				MPOL_PREFERRED,
+				mask.data(),
+				static_cast< unsigned long >( mask.size() * bits + 1u ) ) &&
+				ENOSYS != errno )
+			SO_5_THROW_EXCEPTION( rc_thread_placement_failed,
+					std::string( "set_mempolicy failed: " ) +
+					std::strerror( errno ) );
+	}
+
+} /* namespace anonymous */
+
+SO_5_FUNC void
+apply_thread_placement( const thread_placement_t & placement )
+	{
+		auto cpus = placement.cpus();
+
+		if( placement.has_numa_node() )
+			{
+				const auto node_cpus = numa_node_cpus( placement.numa_node() );
+				if( cpus.empty() )
+					cpus = node_cpus;
+				else
+					cpus.erase(
+							std::remove_if( cpus.begin(), cpus.end(),
+								[&node_cpus]( unsigned int cpu ) {
+									return node_cpus.end() == std::find(
+											node_cpus.begin(), node_cpus.end(), cpu );
+								} ),
+							cpus.end() );
+
+				if( cpus.empty() )
+					SO_5_THROW_EXCEPTION( rc_thread_placement_failed,
+							"there are no CPUs for a thread on NUMA node " +
+							std::to_string( placement.numa_node() ) );
+			}
+
+		if( !cpus.empty() )
+			set_cpu_affinity( cpus );
+
+		if( placement.has_numa_node() )
+			set_preferred_numa_node( placement.numa_node() );
+	}
+
+#else
+
+SO_5_FUNC void
+apply_thread_placement( const thread_placement_t & )
+	{
+		// Thread placement is not supported on this platform.
+	}
+
+#endif
+
+} /* namespace reuse */
+
+} /* namespace disp */
+
+} /* namespace so_5 */
@@ -24,6 +24,11 @@
 
 #include <so_5/disp/mpsc_queue_traits/h/pub.hpp>
 
+#include <so_5/disp/reuse/h/demand_node_pool.hpp>
+#include <so_5/disp/reuse/h/thread_placement.hpp>
+
+#include <so_5/details/h/rollback_on_exception.hpp>
+
 #include <so_5/rt/stats/h/work_thread_activity.hpp>
 #include <so_5/rt/stats/impl/h/activity_tracking.hpp>
 
@@ -103,16 +108,281 @@ struct common_data_t
 	}
 };
 
+/*!
+ * \brief A node of lock-free demand queue.
+ *
+ * \since
+ * v.5.5.23
+ */
+struct lock_free_node_t
+{
+	//! Next node in the queue or in the list of free nodes.
+	std::atomic< lock_free_node_t * > m_next{ nullptr };
+
+	//! Demand to be processed.
+	execution_demand_t m_demand;
+
+	lock_free_node_t()
+	{}
+
+	lock_free_node_t( execution_demand_t && demand )
+		:	m_demand( std::move(demand) )
+	{}
+};
+
+/*!
+ * \brief Common data for lock-free implementation of demand_queue.
+ *
+ * Demands are stored in Vyukov-style MPSC linked list. A producer
+ * appends nodes by atomic exchange of m_head and does not acquire
+ * any lock. The single consumer takes nodes from m_tail. The first node
+ * of the list is always a dummy node whose demand is already extracted.
+ *
+ * Extracted nodes are kept in the list of free nodes and are reused
+ * for new demands. Only the consumer returns nodes to that list.
+ * Producers take nodes from the list one at a time. A producer which
+ * can't take a node at once (the list is empty or another producer
+ * is taking a node at the moment) allocates a new node.
+ *
+ * The lock object is used only when the queue becomes empty (the consumer
+ * goes to sleep) and when the queue becomes non-empty (a producer wakes
+ * the consumer up).
+ *
+ * \since
+ * v.5.5.23
+ */
+struct lock_free_common_data_t
+{
+	//! \name Objects for the thread safety.
+	//! \{
+	queue_traits::lock_unique_ptr_t m_lock;
+	//! \}
+
+	//! Service flag.
+	/*!
+		true -- shall do the service, methods push/pop must work.
+		false -- the service is stopped or will be stopped.
+	*/
+	std::atomic< bool > m_in_service{ false };
+
+	//! The last node in the queue.
+	/*!
+	 * Is modified by producers.
+	 */
+	std::atomic< lock_free_node_t * > m_head;
+
+	//! The dummy node at the beginning of the queue.
+	/*!
+	 * Is modified by the consumer only.
+	 */
+	lock_free_node_t * m_tail;
+
+	//! Count of demands in the queue.
+	/*!
+	 * Is incremented by a producer after appending nodes to the queue.
+	 * A producer which increments it from zero wakes the consumer up.
+	 */
+	std::atomic< std::size_t > m_size{ 0u };
+
+	//! The top of the list of free nodes.
+	std::atomic< lock_free_node_t * > m_free_nodes{ nullptr };
+
+	//! Approximate count of free nodes.
+	std::atomic< std::size_t > m_free_nodes_count{ 0u };
+
+	//! Is some producer taking a free node now?
+	/*!
+	 * Only one producer at a time can take nodes from the list of
+	 * free nodes. It makes the taking free from the ABA problem.
+	 */
+	std::atomic< bool > m_free_nodes_busy{ false };
+
+	//! Initializing constructor.
+	lock_free_common_data_t(
+		//! Lock object to be used by queue.
+		queue_traits::lock_unique_ptr_t lock )
+		:	m_lock( std::move(lock) )
+		,	m_head( new lock_free_node_t() )
+		,	m_tail( m_head.load( std::memory_order_relaxed ) )
+	{}
+
+	~lock_free_common_data_t()
+	{
+		drop_available_demands();
+		delete m_tail;
+
+		auto n = m_free_nodes.load( std::memory_order_acquire );
+		while( n )
+		{
+			auto next = n->m_next.load( std::memory_order_relaxed );
+			delete n;
+			n = next;
+		}
+	}
+
+	//! Get a node for a new demand.
+	/*!
+	 * Takes a node from the list of free nodes or allocates a new one.
+	 */
+	lock_free_node_t *
+	make_node( execution_demand_t && demand )
+	{
+		auto n = try_take_free_node();
+		if( n )
+			n->m_demand = std::move( demand );
+		else
+			n = new lock_free_node_t( std::move( demand ) );
+
+		return n;
+	}
+
+	//! Append a chain of nodes to the queue.
+	/*!
+	 * \retval true if the queue was empty and the consumer must be
+	 * woken up.
+	 */
+	bool
+	append(
+		lock_free_node_t * first,
+		lock_free_node_t * last,
+		std::size_t count ) SO_5_NOEXCEPT
+	{
+		auto prev = m_head.exchange( last, std::memory_order_acq_rel );
+		// The consumer can't go past prev until this store.
+		prev->m_next.store( first, std::memory_order_release );
+
+		return 0u == m_size.fetch_add( count, std::memory_order_acq_rel );
+	}
+
+	//! Extract the specified count of demands.
+	/*!
+	 * \attention Must be called only by the consumer and only if
+	 * the count of demands is not less than \a count.
+	 */
+	void
+	extract(
+		demand_container_t & demands,
+		std::size_t count )
+	{
+		for( std::size_t i = 0; i != count; ++i )
+		{
+			lock_free_node_t * next;
+			// A producer can be between the exchange of m_head and
+			// the link of its node. It will finish very soon.
+			while( nullptr ==
+					( next = m_tail->m_next.load( std::memory_order_acquire ) ) )
+				std::this_thread::yield();
+
+			demands.push_back( std::move( next->m_demand ) );
+
+			auto old = m_tail;
+			m_tail = next;
+			put_free_node( old );
+		}
+
+		m_size.fetch_sub( count, std::memory_order_acq_rel );
+	}
+
+	//! Destroy all demands which are completely appended to the queue.
+	/*!
+	 * \attention Must be called only by the consumer.
+	 */
+	void
+	drop_available_demands() SO_5_NOEXCEPT
+	{
+		std::size_t count = 0u;
+		lock_free_node_t * next;
+		while( nullptr !=
+				( next = m_tail->m_next.load( std::memory_order_acquire ) ) )
+		{
+			next->m_demand.m_message_ref.reset();
+
+			auto old = m_tail;
+			m_tail = next;
+			put_free_node( old );
+			++count;
+		}
+
+		if( count )
+			m_size.fetch_sub( count, std::memory_order_acq_rel );
+	}
+
+private :
+	//! Try to take a node from the list of free nodes.
+	/*!
+	 * \retval nullptr if there is no free node or another producer
+	 * is taking a node at the moment.
+	 */
+	lock_free_node_t *
+	try_take_free_node() SO_5_NOEXCEPT
+	{
+		if( !m_free_nodes.load( std::memory_order_relaxed ) ||
+				m_free_nodes_busy.exchange( true, std::memory_order_acquire ) )
+			return nullptr;
+
+		auto n = m_free_nodes.load( std::memory_order_acquire );
+		while( n && !m_free_nodes.compare_exchange_weak(
+				n,
+				n->m_next.load( std::memory_order_relaxed ),
+				std::memory_order_acquire,
+				std::memory_order_acquire ) )
+		{}
+
+		m_free_nodes_busy.store( false, std::memory_order_release );
+
+		if( n )
+		{
+			m_free_nodes_count.fetch_sub( 1u, std::memory_order_relaxed );
+			n->m_next.store( nullptr, std::memory_order_relaxed );
+		}
+
+		return n;
+	}
+
+	//! Return an extracted node to the list of free nodes.
+	/*!
+	 * The node is deleted if there are too many free nodes.
+	 *
+	 * \attention Must be called only by the consumer.
+	 */
+	void
+	put_free_node( lock_free_node_t * node ) SO_5_NOEXCEPT
+	{
+		if( m_free_nodes_count.load( std::memory_order_relaxed ) >=
+				default_demand_node_pool_capacity() )
+		{
+			delete node;
+			return;
+		}
+
+		m_free_nodes_count.fetch_add( 1u, std::memory_order_relaxed );
+
+		auto top = m_free_nodes.load( std::memory_order_relaxed );
+		do
+		{
+			node->m_next.store( top, std::memory_order_relaxed );
+		}
+		while( !m_free_nodes.compare_exchange_weak(
+				top, node,
+				std::memory_order_release,
+				std::memory_order_relaxed ) );
+	}
+};
+
 /*!
  * \brief A part of demand queue implementation for the case
  * when activity tracking is not used.
+ *
+ * \note Since v.5.5.23 it is a template and can be used with
+ * common_data_t and lock_free_common_data_t.
  */
-class no_activity_tracking_impl_t : protected common_data_t
+template< typename Common_Data >
+class no_activity_tracking_impl_t : protected Common_Data
 {
 public :
 	no_activity_tracking_impl_t(
 		queue_traits::lock_unique_ptr_t lock )
-		:	common_data_t( std::move(lock) )
+		:	Common_Data( std::move(lock) )
 	{}
 
 protected :
@@ -126,14 +396,18 @@ protected :
 /*!
  * \brief A part of demand queue implementation for the case
  * when activity tracking is used.
+ *
+ * \note Since v.5.5.23 it is a template and can be used with
+ * common_data_t and lock_free_common_data_t.
  */
-class with_activity_tracking_impl_t : protected common_data_t
+template< typename Common_Data >
+class with_activity_tracking_impl_t : protected Common_Data
 {
 public :
 	with_activity_tracking_impl_t(
 		queue_traits::lock_unique_ptr_t lock )
-		:	common_data_t( std::move(lock) )
-		,	m_waiting_stats( *m_lock )
+		:	Common_Data( std::move(lock) )
+		,	m_waiting_stats( *(this->m_lock) )
 	{}
 
 	so_5::stats::activity_stats_t
@@ -209,6 +483,26 @@ public:
 			}
 		}
 	}
+
+	virtual void
+	push_batch(
+		execution_demand_t * demands,
+		std::size_t count ) override
+	{
+		queue_traits::lock_guard_t guard{ *(this->m_lock) };
+
+		if( this->m_in_service && count )
+		{
+			const bool demands_empty_before_service = this->m_demands.empty();
+
+			for( std::size_t i = 0; i != count; ++i )
+				this->m_demands.push_back( std::move( demands[ i ] ) );
+
+			if( demands_empty_before_service )
+				// Only one wakeup is necessary for the whole batch.
+				guard.notify_one();
+		}
+	}
 	/*!
 	 * \}
 	 */
@@ -314,6 +608,185 @@ public:
 	}
 };
 
+//
+// lock_free_queue_template_t
+//
+
+//! Implementation of lock-free demand_queue in form of a template.
+/*!
+ * Has the same interface as queue_template_t but push() and push_batch()
+ * don't acquire the queue lock. The lock is acquired only if the queue
+ * becomes non-empty (to wake the consumer up) and by the consumer
+ * if the queue is empty.
+ *
+ * \tparam Impl no_activity_tracking_impl_t or with_activity_tracking_impl_t
+ * for lock_free_common_data_t.
+ *
+ * \since
+ * v.5.5.23
+ */
+template< typename Impl >
+class lock_free_queue_template_t
+	:	public event_queue_t
+	,	public Impl
+{
+public:
+	lock_free_queue_template_t(
+		//! Lock object to be used by queue.
+		queue_traits::lock_unique_ptr_t lock )
+		:	Impl( std::move(lock) )
+	{}
+
+	/*!
+	 * \name Implementation of event_queue interface.
+	 * \{
+	 */
+	virtual void
+	push( execution_demand_t demand ) override
+	{
+		if( this->m_in_service.load( std::memory_order_acquire ) )
+		{
+			auto node = this->make_node( std::move( demand ) );
+
+			if( this->append( node, node, 1u ) )
+				wake_up_consumer();
+		}
+	}
+
+	virtual void
+	push_batch(
+		execution_demand_t * demands,
+		std::size_t count ) override
+	{
+		if( this->m_in_service.load( std::memory_order_acquire ) && count )
+		{
+			// The chain is linked before appending to the queue.
+			// So the whole batch is appended by one atomic exchange.
+			auto first = this->make_node( std::move( demands[ 0 ] ) );
+			auto last = first;
+			try
+			{
+				for( std::size_t i = 1; i != count; ++i )
+				{
+					auto node = this->make_node( std::move( demands[ i ] ) );
+					last->m_next.store( node, std::memory_order_relaxed );
+					last = node;
+				}
+			}
+			catch( ... )
+			{
+				while( first )
+				{
+					auto next = first->m_next.load( std::memory_order_relaxed );
+					delete first;
+					first = next;
+				}
+				throw;
+			}
+
+			if( this->append( first, last, count ) )
+				// Only one wakeup is necessary for the whole batch.
+				wake_up_consumer();
+		}
+	}
+	/*!
+	 * \}
+	 */
+
+	//! Try to extract demands from the queue.
+	/*!
+		If there is no demands in queue then current thread
+		will sleep until:
+		- the new demand is put in the queue;
+		- a shutdown signal.
+	*/
+	extraction_result_t
+	pop(
+		/*! Receiver for extracted demands. */
+		demand_container_t & demands,
+		/*! External demands counter to be updated. */
+		demands_counter_t & external_counter )
+	{
+		while( true )
+		{
+			if( !this->m_in_service.load( std::memory_order_acquire ) )
+				return extraction_result_t::shutting_down;
+
+			const auto available = this->m_size.load( std::memory_order_acquire );
+			if( available )
+			{
+				this->extract( demands, available );
+
+				external_counter.store( demands.size(), std::memory_order_release );
+
+				break;
+			}
+
+			// Queue is empty. We should wait for a demand or
+			// a shutdown signal. The state is checked again under the lock
+			// because a producer acquires the lock after making the queue
+			// non-empty.
+			queue_traits::unique_lock_t lock{ *(this->m_lock) };
+			if( this->m_in_service.load( std::memory_order_acquire ) &&
+					0u == this->m_size.load( std::memory_order_acquire ) )
+			{
+				this->wait_started();
+
+				lock.wait_for_notify();
+
+				this->wait_finished();
+			}
+		}
+
+		return extraction_result_t::demand_extracted;
+	}
+
+	//! Start demands processing.
+	void
+	start_service()
+	{
+		this->m_in_service.store( true, std::memory_order_release );
+	}
+
+	//! Stop demands processing.
+	void
+	stop_service()
+	{
+		this->m_in_service.store( false, std::memory_order_release );
+
+		// Someone can wait for new demands inside pop().
+		wake_up_consumer();
+	}
+
+	//! Clear demands queue.
+	/*!
+	 * \attention Must be called after the stop of the consumer.
+	 */
+	void
+	clear()
+	{
+		this->drop_available_demands();
+	}
+
+	/*!
+	 * \brief Get the count of demands in the queue.
+	 */
+	std::size_t
+	demands_count( const demands_counter_t & external_counter )
+	{
+		return this->m_size.load( std::memory_order_acquire )
+				+ external_counter.load( std::memory_order_acquire );
+	}
+
+private :
+	void
+	wake_up_consumer()
+	{
+		queue_traits::lock_guard_t guard{ *(this->m_lock) };
+		guard.notify_one();
+	}
+};
+
 } /* namespace demand_queue_details */
 
 /*!
@@ -324,7 +797,8 @@ public:
  */
 using demand_queue_no_activity_tracking_t =
 	demand_queue_details::queue_template_t<
-		demand_queue_details::no_activity_tracking_impl_t >;
+		demand_queue_details::no_activity_tracking_impl_t<
+			demand_queue_details::common_data_t > >;
 
 /*!
  * \brief An alias for demand_queue with activity tracking.
@@ -334,7 +808,30 @@ using demand_queue_no_activity_tracking_t =
  */
 using demand_queue_with_activity_tracking_t =
 	demand_queue_details::queue_template_t<
-		demand_queue_details::with_activity_tracking_impl_t >;
+		demand_queue_details::with_activity_tracking_impl_t<
+			demand_queue_details::common_data_t > >;
+
+/*!
+ * \brief An alias for lock-free demand_queue without activity tracking.
+ *
+ * \since
+ * v.5.5.23
+ */
+using lock_free_demand_queue_no_activity_tracking_t =
+	demand_queue_details::lock_free_queue_template_t<
+		demand_queue_details::no_activity_tracking_impl_t<
+			demand_queue_details::lock_free_common_data_t > >;
+
+/*!
+ * \brief An alias for lock-free demand_queue with activity tracking.
+ *
+ * \since
+ * v.5.5.23
+ */
+using lock_free_demand_queue_with_activity_tracking_t =
+	demand_queue_details::lock_free_queue_template_t<
+		demand_queue_details::with_activity_tracking_impl_t<
+			demand_queue_details::lock_free_common_data_t > >;
 
 namespace details
 {
@@ -390,16 +887,20 @@ struct common_data_t
 /*!
  * \brief Part of implementation of work thread without activity tracking.
  *
+ * \note Since v.5.5.23 it is a template with the type of demand queue
+ * as a parameter.
+ *
  * \since
  * v.5.5.18
  */
+template< typename Demand_Queue >
 class no_activity_tracking_impl_t
-	: protected common_data_t< demand_queue_no_activity_tracking_t >
+	: protected common_data_t< Demand_Queue >
 {
 public :
 	no_activity_tracking_impl_t(
 		queue_traits::lock_factory_t queue_lock_factory )
-		:	common_data_t( std::move(queue_lock_factory) )
+		:	common_data_t< Demand_Queue >( std::move(queue_lock_factory) )
 	{}
 
 protected :
@@ -424,18 +925,22 @@ protected :
 /*!
  * \brief Part of implementation of work thread with activity tracking.
  *
+ * \note Since v.5.5.23 it is a template with the type of demand queue
+ * as a parameter.
+ *
  * \since
  * v.5.5.18
  */
+template< typename Demand_Queue >
 class activity_tracking_impl_t
-	: protected common_data_t< demand_queue_with_activity_tracking_t >
+	: protected common_data_t< Demand_Queue >
 {
 	using activity_tracking_traits = so_5::stats::activity_tracking_stuff::traits;
 
 public :
 	activity_tracking_impl_t(
 		queue_traits::lock_factory_t queue_lock_factory )
-		:	common_data_t( std::move(queue_lock_factory) )
+		:	common_data_t< Demand_Queue >( std::move(queue_lock_factory) )
 	{}
 
 	/*!
@@ -469,7 +974,7 @@ public :
 					working_started_at );
 		}
 
-		result.m_waiting_stats = m_queue.take_activity_stats();
+		result.m_waiting_stats = this->m_queue.take_activity_stats();
 
 		return result;
 	}
@@ -493,12 +998,12 @@ protected :
 		{
 			auto & demand = demands.front();
 
-			demand.call_handler( m_thread_id );
+			demand.call_handler( this->m_thread_id );
 
 			const auto activity_finished_at = so_5::stats::clock_type_t::now();
 
 			demands.pop_front();
-			--m_demands_count;
+			--(this->m_demands_count);
 
 			{
 				std::lock_guard< activity_tracking_traits::lock_t > lock{ m_stats_lock };
@@ -554,13 +1059,28 @@ public :
 	{}
 
 	//! Start the working thread.
+	/*!
+	 * \note Since v.5.5.23 the placement of the thread is specified.
+	 * An exception is thrown if the placement can't be applied.
+	 */
 	void
-	start()
+	start(
+		//! Placement of the thread on CPUs and NUMA node.
+		const so_5::disp::reuse::thread_placement_t & placement )
 	{
 		this->m_queue.start_service();
 		this->m_status = status_t::working;
 
-		this->m_thread = std::thread( [this]() { this->body(); } );
+		so_5::details::do_with_rollback_on_exception(
+				[&] {
+					this->m_thread = so_5::disp::reuse::make_placed_thread(
+							placement,
+							[this]() { this->body(); } );
+				},
+				[this] {
+					this->m_status = status_t::stopped;
+					this->m_queue.stop_service();
+				} );
 	}
 
 	//! Send the shutdown signal to the working thread.
@@ -664,7 +1184,8 @@ private :
  */
 using work_thread_no_activity_tracking_t =
 	details::work_thread_template_t<
-		details::no_activity_tracking_impl_t >;
+		details::no_activity_tracking_impl_t<
+			demand_queue_no_activity_tracking_t > >;
 
 //
 // work_thread_with_activity_tracking_t
@@ -677,7 +1198,36 @@ using work_thread_no_activity_tracking_t =
  */
 using work_thread_with_activity_tracking_t =
 	details::work_thread_template_t<
-		details::activity_tracking_impl_t >;
+		details::activity_tracking_impl_t<
+			demand_queue_with_activity_tracking_t > >;
+
+//
+// lock_free_work_thread_no_activity_tracking_t
+//
+
+//! Working thread with lock-free demand queue and without activity tracking.
+/*!
+ * \since
+ * v.5.5.23
+ */
+using lock_free_work_thread_no_activity_tracking_t =
+	details::work_thread_template_t<
+		details::no_activity_tracking_impl_t<
+			lock_free_demand_queue_no_activity_tracking_t > >;
+
+//
+// lock_free_work_thread_with_activity_tracking_t
+//
+
+//! Working thread with lock-free demand queue and with activity tracking.
+/*!
+ * \since
+ * v.5.5.23
+ */
+using lock_free_work_thread_with_activity_tracking_t =
+	details::work_thread_template_t<
+		details::activity_tracking_impl_t<
+			lock_free_demand_queue_with_activity_tracking_t > >;
 
 } /* namespace work_thread */
 
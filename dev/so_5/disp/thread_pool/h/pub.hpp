@@ -18,7 +18,9 @@
 #include <so_5/disp/mpmc_queue_traits/h/pub.hpp>
 
 #include <so_5/disp/reuse/h/work_thread_activity_tracking.hpp>
+#include <so_5/disp/reuse/h/thread_placement.hpp>
 
+#include <chrono>
 #include <utility>
 
 namespace so_5
@@ -47,9 +49,12 @@ namespace queue_traits = so_5::disp::mpmc_queue_traits;
  */
 class disp_params_t
 	:	public so_5::disp::reuse::work_thread_activity_tracking_flag_mixin_t< disp_params_t >
+	,	public so_5::disp::reuse::thread_placement_mixin_t< disp_params_t >
 	{
 		using activity_tracking_mixin_t = so_5::disp::reuse::
 				work_thread_activity_tracking_flag_mixin_t< disp_params_t >;
+		using placement_mixin_t = so_5::disp::reuse::
+				thread_placement_mixin_t< disp_params_t >;
 
 	public :
 		//! Default constructor.
@@ -57,14 +62,32 @@ class disp_params_t
 		//! Copy constructor.
 		disp_params_t( const disp_params_t & o )
 			:	activity_tracking_mixin_t( o )
+			,	placement_mixin_t( o )
 			,	m_thread_count{ o.m_thread_count }
 			,	m_queue_params{ o.m_queue_params }
+			,	m_work_stealing{ o.m_work_stealing }
+			,	m_max_thread_count{ o.m_max_thread_count }
+			,	m_idle_thread_linger{ o.m_idle_thread_linger }
+			,	m_elastic_check_period{ o.m_elastic_check_period }
+			,	m_worker_affinity{ o.m_worker_affinity }
+			,	m_affinity_overload_threshold{ o.m_affinity_overload_threshold }
+			,	m_affinity_idle_threshold{ o.m_affinity_idle_threshold }
+			,	m_fair_quantum{ o.m_fair_quantum }
 			{}
 		//! Move constructor.
 		disp_params_t( disp_params_t && o )
 			:	activity_tracking_mixin_t( std::move(o) )
+			,	placement_mixin_t( std::move(o) )
 			,	m_thread_count{ std::move(o.m_thread_count) }
 			,	m_queue_params{ std::move(o.m_queue_params) }
+			,	m_work_stealing{ o.m_work_stealing }
+			,	m_max_thread_count{ o.m_max_thread_count }
+			,	m_idle_thread_linger{ o.m_idle_thread_linger }
+			,	m_elastic_check_period{ o.m_elastic_check_period }
+			,	m_worker_affinity{ o.m_worker_affinity }
+			,	m_affinity_overload_threshold{ o.m_affinity_overload_threshold }
+			,	m_affinity_idle_threshold{ o.m_affinity_idle_threshold }
+			,	m_fair_quantum{ o.m_fair_quantum }
 			{}
 
 		friend inline void
@@ -74,9 +97,22 @@ class disp_params_t
 				swap(
 						static_cast< activity_tracking_mixin_t & >(a),
 						static_cast< activity_tracking_mixin_t & >(b) );
+				swap(
+						static_cast< placement_mixin_t & >(a),
+						static_cast< placement_mixin_t & >(b) );
 
 				std::swap( a.m_thread_count, b.m_thread_count );
 				swap( a.m_queue_params, b.m_queue_params );
+				std::swap( a.m_work_stealing, b.m_work_stealing );
+				std::swap( a.m_max_thread_count, b.m_max_thread_count );
+				std::swap( a.m_idle_thread_linger, b.m_idle_thread_linger );
+				std::swap( a.m_elastic_check_period, b.m_elastic_check_period );
+				std::swap( a.m_worker_affinity, b.m_worker_affinity );
+				std::swap( a.m_affinity_overload_threshold,
+						b.m_affinity_overload_threshold );
+				std::swap( a.m_affinity_idle_threshold,
+						b.m_affinity_idle_threshold );
+				std::swap( a.m_fair_quantum, b.m_fair_quantum );
 			}
 
 		//! Copy operator.
@@ -148,6 +184,292 @@ class disp_params_t
 				return m_queue_params;
 			}
 
+		//! Turn work stealing mode on.
+		/*!
+		 * In this mode every work thread has its own deque of non-empty
+		 * agent queues. An agent queue which becomes non-empty because of
+		 * an action on a work thread is stored into the deque of that
+		 * thread and will be handled by the same thread in LIFO order.
+		 * Idle work threads steal agent queues from deques of other threads
+		 * in FIFO order. Agent queues which become non-empty because of
+		 * actions on other threads are stored into a shared queue.
+		 *
+		 * Semantics of fifo_t::cooperation and fifo_t::individual is not
+		 * changed: demands from one agent queue are never handled on
+		 * different threads at the same time.
+		 *
+		 * \par Usage example:
+			\code
+			using namespace so_5::disp::thread_pool;
+			create_private_disp( env,
+				"workers_disp",
+				disp_params_t{}
+					.thread_count( 8 )
+					.work_stealing() );
+			\endcode
+		 *
+		 * \since
+		 * v.5.5.23
+		 */
+		disp_params_t &
+		work_stealing()
+			{
+				m_work_stealing = true;
+				return *this;
+			}
+
+		//! Is work stealing mode used?
+		/*!
+		 * \since
+		 * v.5.5.23
+		 */
+		bool
+		work_stealing_used() const
+			{
+				return m_work_stealing;
+			}
+
+		//! Turn worker affinity mode on.
+		/*!
+		 * In this mode every agent queue prefers the work thread which
+		 * handled it the last time. It keeps the agent's data in the cache
+		 * of the same CPU core. An agent queue migrates to another work
+		 * thread only if:
+		 * - there are \a overload_threshold or more agent queues waiting
+		 *   for the last work thread of the agent queue;
+		 * - the last work thread is busy and another work thread is idle
+		 *   for longer than \a idle_threshold.
+		 *
+		 * Semantics of fifo_t::cooperation and fifo_t::individual is not
+		 * changed: demands from one agent queue are never handled on
+		 * different threads at the same time.
+		 *
+		 * \note Work stealing mode has a priority over worker affinity mode.
+		 *
+		 * \note Elastic mode is not supported in worker affinity mode.
+		 * Max count of work threads is ignored in that case.
+		 *
+		 * \par Usage example:
+			\code
+			using namespace so_5::disp::thread_pool;
+			create_private_disp( env,
+				"workers_disp",
+				disp_params_t{}
+					.thread_count( 8 )
+					.worker_affinity( 4, std::chrono::microseconds(200) ) );
+			\endcode
+		 *
+		 * \since
+		 * v.5.5.23
+		 */
+		disp_params_t &
+		worker_affinity(
+			std::size_t overload_threshold = 4u,
+			std::chrono::steady_clock::duration idle_threshold =
+					std::chrono::microseconds( 500 ) )
+			{
+				m_worker_affinity = true;
+				m_affinity_overload_threshold = overload_threshold;
+				m_affinity_idle_threshold = idle_threshold;
+				return *this;
+			}
+
+		//! Is worker affinity mode used?
+		/*!
+		 * \since
+		 * v.5.5.23
+		 */
+		bool
+		worker_affinity_used() const
+			{
+				return m_worker_affinity;
+			}
+
+		//! Getter for count of waiting agent queues after that a work
+		//! thread is treated as overloaded in worker affinity mode.
+		/*!
+		 * \since
+		 * v.5.5.23
+		 */
+		std::size_t
+		affinity_overload_threshold() const
+			{
+				return m_affinity_overload_threshold;
+			}
+
+		//! Getter for time after that an idle work thread can take agent
+		//! queues of busy work threads in worker affinity mode.
+		/*!
+		 * \since
+		 * v.5.5.23
+		 */
+		std::chrono::steady_clock::duration
+		affinity_idle_threshold() const
+			{
+				return m_affinity_idle_threshold;
+			}
+
+		//! Turn weighted fair scheduling on.
+		/*!
+		 * In this mode every event queue gets a time quantum which is
+		 * \a quantum multiplied by the weight of the queue (see
+		 * bind_params_t::weight()). Demands from the queue are processed
+		 * while the quantum isn't spent. Then the queue is switched to
+		 * another non-empty queue. If the last demand takes more time than
+		 * the rest of the quantum then the excess is subtracted from the
+		 * next quantum of the queue (deficit round robin). So every
+		 * cooperation (or agent with individual FIFO) gets the time of work
+		 * threads proportional to its weight regardless of the count and
+		 * the cost of its demands.
+		 *
+		 * Values of bind_params_t::max_demands_at_once() and
+		 * bind_params_t::adaptive_demands_at_once() are ignored in
+		 * this mode.
+		 *
+		 * Total service time of every event queue is available via
+		 * run-time monitoring.
+		 *
+		 * \note Non-empty queues are visited in the order of the ready queue
+		 * of the dispatcher. Round robin order is guaranteed only if work
+		 * stealing and worker affinity modes are not used.
+		 *
+		 * \par Usage example:
+			\code
+			using namespace so_5::disp::thread_pool;
+			auto disp = create_private_disp( env,
+				disp_params_t{}
+					.thread_count( 4 )
+					.fair_scheduling( std::chrono::microseconds(500) ) );
+			env.introduce_coop(
+				disp->binder( bind_params_t{}.weight( 3 ) ),
+				[]( so_5::coop_t & coop ) {...} );
+			\endcode
+		 *
+		 * \note Zero \a quantum turns weighted fair scheduling off.
+		 *
+		 * \since
+		 * v.5.5.23
+		 */
+		disp_params_t &
+		fair_scheduling( std::chrono::steady_clock::duration quantum )
+			{
+				m_fair_quantum = quantum;
+				return *this;
+			}
+
+		//! Getter for base time quantum of weighted fair scheduling.
+		/*!
+		 * Zero value means that weighted fair scheduling is not used.
+		 *
+		 * \since
+		 * v.5.5.23
+		 */
+		std::chrono::steady_clock::duration
+		fair_scheduling_quantum() const
+			{
+				return m_fair_quantum;
+			}
+
+		//! Setter for maximum count of work threads.
+		/*!
+		 * If this value is greater than thread_count() then the
+		 * dispatcher is elastic. It starts with thread_count() work
+		 * threads and a supervisor thread checks the load of the
+		 * dispatcher every elastic_check_period():
+		 * - if all work threads are busy and there are more non-empty
+		 *   agent queues than queue_params_t::next_thread_wakeup_threshold()
+		 *   then new work threads are started (up to max_thread_count());
+		 * - if some work threads are idle during idle_thread_linger() then
+		 *   one of idle work threads is stopped (down to thread_count()).
+		 *
+		 * Count of work threads, count of started and retired threads and
+		 * count of non-empty agent queues are available via run-time
+		 * monitoring.
+		 *
+		 * \note Elastic mode is not supported in work stealing and
+		 * worker affinity modes. Max count of work threads is ignored
+		 * in that case.
+		 *
+		 * \par Usage example:
+			\code
+			using namespace so_5::disp::thread_pool;
+			create_private_disp( env,
+				"workers_disp",
+				disp_params_t{}
+					.thread_count( 2 )
+					.max_thread_count( 16 )
+					.idle_thread_linger( std::chrono::seconds(5) ) );
+			\endcode
+		 *
+		 * \since
+		 * v.5.5.23
+		 */
+		disp_params_t &
+		max_thread_count( std::size_t count )
+			{
+				m_max_thread_count = count;
+				return *this;
+			}
+
+		//! Getter for maximum count of work threads.
+		/*!
+		 * \since
+		 * v.5.5.23
+		 */
+		std::size_t
+		max_thread_count() const
+			{
+				return m_max_thread_count;
+			}
+
+		//! Setter for time after that an idle work thread of elastic
+		//! dispatcher can be stopped.
+		/*!
+		 * \since
+		 * v.5.5.23
+		 */
+		disp_params_t &
+		idle_thread_linger( std::chrono::steady_clock::duration v )
+			{
+				m_idle_thread_linger = v;
+				return *this;
+			}
+
+		//! Getter for time after that an idle work thread of elastic
+		//! dispatcher can be stopped.
+		/*!
+		 * \since
+		 * v.5.5.23
+		 */
+		std::chrono::steady_clock::duration
+		idle_thread_linger() const
+			{
+				return m_idle_thread_linger;
+			}
+
+		//! Setter for period of load checks of elastic dispatcher.
+		/*!
+		 * \since
+		 * v.5.5.23
+		 */
+		disp_params_t &
+		elastic_check_period( std::chrono::steady_clock::duration v )
+			{
+				m_elastic_check_period = v;
+				return *this;
+			}
+
+		//! Getter for period of load checks of elastic dispatcher.
+		/*!
+		 * \since
+		 * v.5.5.23
+		 */
+		std::chrono::steady_clock::duration
+		elastic_check_period() const
+			{
+				return m_elastic_check_period;
+			}
+
 	private :
 		//! Count of working threads.
 		/*!
@@ -156,6 +478,63 @@ class disp_params_t
 		std::size_t m_thread_count = { 0 };
 		//! Queue parameters.
 		queue_traits::queue_params_t m_queue_params;
+		//! Should work stealing be used?
+		/*!
+		 * \since
+		 * v.5.5.23
+		 */
+		bool m_work_stealing = { false };
+		//! Maximum count of working threads.
+		/*!
+		 * Value 0 means that the dispatcher is not elastic.
+		 *
+		 * \since
+		 * v.5.5.23
+		 */
+		std::size_t m_max_thread_count = { 0 };
+		//! Time after that an idle work thread can be stopped.
+		/*!
+		 * \since
+		 * v.5.5.23
+		 */
+		std::chrono::steady_clock::duration m_idle_thread_linger =
+				std::chrono::seconds( 1 );
+		//! Period of load checks.
+		/*!
+		 * \since
+		 * v.5.5.23
+		 */
+		std::chrono::steady_clock::duration m_elastic_check_period =
+				std::chrono::milliseconds( 10 );
+		//! Should worker affinity be used?
+		/*!
+		 * \since
+		 * v.5.5.23
+		 */
+		bool m_worker_affinity = { false };
+		//! Count of waiting agent queues for overloaded work thread.
+		/*!
+		 * \since
+		 * v.5.5.23
+		 */
+		std::size_t m_affinity_overload_threshold = { 4u };
+		//! Time after that an idle work thread can take agent queues
+		//! of busy work threads.
+		/*!
+		 * \since
+		 * v.5.5.23
+		 */
+		std::chrono::steady_clock::duration m_affinity_idle_threshold =
+				std::chrono::microseconds( 500 );
+		//! Base time quantum for weighted fair scheduling.
+		/*!
+		 * Value 0 means that weighted fair scheduling is not used.
+		 *
+		 * \since
+		 * v.5.5.23
+		 */
+		std::chrono::steady_clock::duration m_fair_quantum =
+				std::chrono::steady_clock::duration::zero();
 	};
 
 //
@@ -224,12 +603,133 @@ class bind_params_t
 				return m_max_demands_at_once;
 			}
 
+		//! Turn on adaptive count of demands to be processed at once.
+		/*!
+		 * In this mode the count of demands to be processed at once is
+		 * selected for every event queue separately. It depends on the
+		 * observed processing time of one demand from that queue and on
+		 * the count of other non-empty queues waiting for a work thread.
+		 * The count is selected so that other queues wait no longer than
+		 * \a latency_budget. But no more than \a upper_limit demands are
+		 * processed at once. And at least one demand is always processed.
+		 *
+		 * The value of max_demands_at_once() is ignored in this mode.
+		 *
+		 * Current count of demands to be processed at once for every event
+		 * queue is available via run-time monitoring.
+		 *
+		 * \par Usage example:
+			\code
+			using namespace so_5::disp::thread_pool;
+			env.introduce_coop(
+				disp->binder( bind_params_t{}
+					.fifo( fifo_t::individual )
+					.adaptive_demands_at_once(
+						std::chrono::microseconds(500), 1024 ) ),
+				[]( so_5::coop_t & coop ) {...} );
+			\endcode
+		 *
+		 * \note Zero \a latency_budget turns the adaptive mode off.
+		 *
+		 * \since
+		 * v.5.5.23
+		 */
+		bind_params_t &
+		adaptive_demands_at_once(
+			//! Max time of waiting for other non-empty queues.
+			std::chrono::steady_clock::duration latency_budget,
+			//! Max count of demands to be processed at once.
+			std::size_t upper_limit = 256 )
+			{
+				m_latency_budget = latency_budget;
+				m_adaptive_demands_limit = upper_limit;
+				return *this;
+			}
+
+		//! Get latency budget for adaptive count of demands to be
+		//! processed at once.
+		/*!
+		 * Zero value means that the adaptive mode is not used.
+		 *
+		 * \since
+		 * v.5.5.23
+		 */
+		std::chrono::steady_clock::duration
+		query_adaptive_latency_budget() const
+			{
+				return m_latency_budget;
+			}
+
+		//! Get upper limit for adaptive count of demands to be
+		//! processed at once.
+		/*!
+		 * \since
+		 * v.5.5.23
+		 */
+		std::size_t
+		query_adaptive_demands_limit() const
+			{
+				return m_adaptive_demands_limit;
+			}
+
+		//! Set weight for weighted fair scheduling.
+		/*!
+		 * Is used only if weighted fair scheduling is turned on by
+		 * disp_params_t::fair_scheduling(). An event queue with weight N
+		 * gets N times more time of work threads than an event queue
+		 * with weight 1 if both of them always have demands to process.
+		 *
+		 * \note Zero weight is treated as 1.
+		 *
+		 * \since
+		 * v.5.5.23
+		 */
+		bind_params_t &
+		weight( std::size_t v )
+			{
+				m_weight = v;
+				return *this;
+			}
+
+		//! Get weight for weighted fair scheduling.
+		/*!
+		 * \since
+		 * v.5.5.23
+		 */
+		std::size_t
+		query_weight() const
+			{
+				return m_weight;
+			}
+
 	private :
 		//! FIFO type.
 		fifo_t m_fifo = { fifo_t::cooperation };
 
 		//! Maximum count of demands to be processed at once.
 		std::size_t m_max_demands_at_once = { 4 };
+
+		//! Latency budget for adaptive count of demands.
+		/*!
+		 * \since
+		 * v.5.5.23
+		 */
+		std::chrono::steady_clock::duration m_latency_budget =
+				std::chrono::steady_clock::duration::zero();
+
+		//! Upper limit for adaptive count of demands.
+		/*!
+		 * \since
+		 * v.5.5.23
+		 */
+		std::size_t m_adaptive_demands_limit = { 256 };
+
+		//! Weight for weighted fair scheduling.
+		/*!
+		 * \since
+		 * v.5.5.23
+		 */
+		std::size_t m_weight = { 1 };
 	};
 
 //
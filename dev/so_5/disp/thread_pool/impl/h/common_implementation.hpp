@@ -17,10 +17,15 @@
 
 #include <so_5/disp/reuse/h/mpmc_ptr_queue.hpp>
 #include <so_5/disp/reuse/h/thread_pool_stats.hpp>
+#include <so_5/disp/reuse/h/thread_placement.hpp>
 
 #include <so_5/details/h/rollback_on_exception.hpp>
 
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
 #include <mutex>
+#include <thread>
 
 namespace so_5 {
 
@@ -58,11 +63,47 @@ class ext_dispatcher_iface_t : public so_5::dispatcher_t
 		unbind_agent( agent_ref_t agent ) = 0;
 	};
 
+//
+// elastic_params_t
+//
+/*!
+ * \brief Parameters of elastic thread pool.
+ *
+ * \since
+ * v.5.5.23
+ */
+struct elastic_params_t
+	{
+		//! Maximum count of work threads.
+		/*!
+		 * The pool is elastic only if this value is greater than
+		 * the initial count of work threads.
+		 */
+		std::size_t m_max_thread_count{ 0 };
+
+		//! How long a work thread can be idle before its retirement.
+		std::chrono::steady_clock::duration m_idle_thread_linger{};
+
+		//! Period of checks of the pool's load.
+		std::chrono::steady_clock::duration m_check_period{};
+	};
+
 //
 // dispatcher_t
 //
 /*!
  * \brief Reusable common implementation for thread-pool-like dispatchers.
+ *
+ * \note Since v.5.5.23 the pool can be elastic. In that case it starts
+ * with the initial count of work threads and a supervisor thread checks
+ * the load of the pool periodically:
+ * - if there is no waiting work threads but there are non-empty agent
+ *   queues (more than next_thread_wakeup_threshold) then new work threads
+ *   are started (but no more than the maximum count of work threads);
+ * - if some work threads are waiting for work for longer than the idle
+ *   linger then one of them is retired (but no less than the initial
+ *   count of work threads remains).
+ *
  * \since
  * v.5.5.4
  */
@@ -124,6 +165,10 @@ class dispatcher_t
 					{
 						m_queue_desc->m_desc.m_agent_count = m_agents;
 						m_queue_desc->m_desc.m_queue_size = m_queue->size();
+						m_queue_desc->m_desc.m_demands_at_once =
+								Adaptations::demands_at_once( *m_queue );
+						m_queue_desc->m_desc.m_service_time =
+								Adaptations::service_time( *m_queue );
 					}
 			};
 
@@ -197,6 +242,10 @@ class dispatcher_t
 					{
 						m_queue_desc->m_desc.m_agent_count = 1;
 						m_queue_desc->m_desc.m_queue_size = m_queue->size();
+						m_queue_desc->m_desc.m_demands_at_once =
+								Adaptations::demands_at_once( *m_queue );
+						m_queue_desc->m_desc.m_service_time =
+								Adaptations::service_time( *m_queue );
 					}
 			};
 
@@ -208,18 +257,38 @@ class dispatcher_t
 		dispatcher_t & operator=( const dispatcher_t & ) = delete;
 
 		//! Constructor.
+		/*!
+		 * \note Since v.5.5.23 additional arguments can be passed to
+		 * the constructor of Dispatcher_Queue.
+		 *
+		 * \note Since v.5.5.23 placements of work threads are specified.
+		 *
+		 * \note Since v.5.5.23 parameters of elastic pool are specified.
+		 */
+		template< typename... Queue_Extra_Args >
 		dispatcher_t(
 			std::size_t thread_count,
-			const so_5::disp::mpmc_queue_traits::queue_params_t & queue_params )
-			:	m_queue{ queue_params, thread_count }
+			so_5::disp::reuse::worker_thread_placements_t thread_placements,
+			elastic_params_t elastic_params,
+			const so_5::disp::mpmc_queue_traits::queue_params_t & queue_params,
+			Queue_Extra_Args &&... queue_extra_args )
+			:	m_queue{ queue_params, thread_count,
+					std::forward< Queue_Extra_Args >( queue_extra_args )... }
 			,	m_thread_count( thread_count )
+			,	m_thread_placements( std::move(thread_placements) )
+			,	m_elastic_params( std::move(elastic_params) )
+			,	m_growth_threshold( queue_params.next_thread_wakeup_threshold() )
 			,	m_data_source( stats_supplier() )
 			{
-				m_threads.reserve( thread_count );
+				const auto max_threads = std::max(
+						m_thread_count, m_elastic_params.m_max_thread_count );
 
-				for( std::size_t i = 0; i != m_thread_count; ++i )
+				m_threads.reserve( max_threads );
+				for( std::size_t i = 0; i != max_threads; ++i )
 					m_threads.emplace_back( std::unique_ptr< Work_Thread >(
 								new Work_Thread( m_queue ) ) );
+
+				m_thread_running.resize( max_threads, false );
 			}
 
 		virtual void
@@ -227,21 +296,59 @@ class dispatcher_t
 			{
 				m_data_source.start( outliving_mutable(env.stats_repository()) );
 
-				for( auto & t : m_threads )
-					t->start();
+				std::size_t started = 0u;
+				so_5::details::do_with_rollback_on_exception(
+						[&] {
+							for( ; started != m_thread_count; ++started )
+								{
+									m_threads[ started ]->start(
+											m_thread_placements.for_worker( started ) );
+									thread_started( started );
+								}
+
+							if( is_elastic() )
+								m_supervisor = std::thread{ [this] { supervisor_body(); } };
+						},
+						[&] {
+							// Already started threads must be stopped.
+							m_queue.shutdown();
+							for( std::size_t i = 0; i != started; ++i )
+								{
+									m_threads[ i ]->join();
+									thread_joined( i );
+								}
+
+							m_data_source.stop();
+						} );
 			}
 
 		virtual void
 		shutdown() override
 			{
 				m_queue.shutdown();
+
+				if( is_elastic() )
+					{
+						std::lock_guard< std::mutex > lock( m_supervisor_lock );
+						m_supervisor_shutdown = true;
+						m_supervisor_wakeup.notify_one();
+					}
 			}
 
 		virtual void
 		wait() override
 			{
-				for( auto & t : m_threads )
-					t->join();
+				// Supervisor must be stopped first because it can start
+				// new work threads.
+				if( m_supervisor.joinable() )
+					m_supervisor.join();
+
+				for( std::size_t i = 0; i != m_threads.size(); ++i )
+					if( m_thread_running[ i ] )
+						{
+							m_threads[ i ]->join();
+							thread_joined( i );
+						}
 
 				m_data_source.stop();
 			}
@@ -311,9 +418,99 @@ class dispatcher_t
 		//! Count of working threads.
 		const std::size_t m_thread_count;
 
+		//! Placements of working threads.
+		/*!
+		 * \since
+		 * v.5.5.23
+		 */
+		const so_5::disp::reuse::worker_thread_placements_t m_thread_placements;
+
+		//! Parameters of elastic pool.
+		/*!
+		 * \since
+		 * v.5.5.23
+		 */
+		const elastic_params_t m_elastic_params;
+
+		//! Count of non-empty agent queues which can wait without
+		//! a start of new work thread.
+		/*!
+		 * \since
+		 * v.5.5.23
+		 */
+		const std::size_t m_growth_threshold;
+
 		//! Pool of work threads.
+		/*!
+		 * \note Since v.5.5.23 contains objects for the maximum count
+		 * of work threads. But only some of them can be running.
+		 */
 		std::vector< std::unique_ptr< Work_Thread > > m_threads;
 
+		//! Flags of running work threads.
+		/*!
+		 * Is protected by m_lock.
+		 *
+		 * \since
+		 * v.5.5.23
+		 */
+		std::vector< bool > m_thread_running;
+
+		//! Count of running work threads.
+		/*!
+		 * Is protected by m_lock.
+		 *
+		 * \since
+		 * v.5.5.23
+		 */
+		std::size_t m_running_threads{ 0 };
+
+		//! Count of work threads started by the supervisor.
+		/*!
+		 * Is protected by m_lock.
+		 *
+		 * \since
+		 * v.5.5.23
+		 */
+		std::size_t m_threads_started{ 0 };
+
+		//! Count of work threads retired by the supervisor.
+		/*!
+		 * Is protected by m_lock.
+		 *
+		 * \since
+		 * v.5.5.23
+		 */
+		std::size_t m_threads_retired{ 0 };
+
+		//! Supervisor thread of elastic pool.
+		/*!
+		 * \since
+		 * v.5.5.23
+		 */
+		std::thread m_supervisor;
+
+		//! Lock for the supervisor's shutdown flag.
+		/*!
+		 * \since
+		 * v.5.5.23
+		 */
+		std::mutex m_supervisor_lock;
+
+		//! Condition for the supervisor's shutdown notification.
+		/*!
+		 * \since
+		 * v.5.5.23
+		 */
+		std::condition_variable m_supervisor_wakeup;
+
+		//! Supervisor's shutdown flag.
+		/*!
+		 * \since
+		 * v.5.5.23
+		 */
+		bool m_supervisor_shutdown{ false };
+
 		//! Object's lock.
 		std::mutex m_lock;
 
@@ -391,6 +588,191 @@ class dispatcher_t
 				return it->second.m_queue.get();
 			}
 
+		//! Is the pool elastic?
+		/*!
+		 * \since
+		 * v.5.5.23
+		 */
+		bool
+		is_elastic() const
+			{
+				return m_elastic_params.m_max_thread_count > m_thread_count;
+			}
+
+		//! Mark work thread as running.
+		/*!
+		 * \since
+		 * v.5.5.23
+		 */
+		void
+		thread_started( std::size_t index )
+			{
+				std::lock_guard< std::mutex > lock( m_lock );
+
+				m_thread_running[ index ] = true;
+				++m_running_threads;
+			}
+
+		//! Mark work thread as finished and joined.
+		/*!
+		 * \since
+		 * v.5.5.23
+		 */
+		void
+		thread_joined( std::size_t index )
+			{
+				std::lock_guard< std::mutex > lock( m_lock );
+
+				m_thread_running[ index ] = false;
+				--m_running_threads;
+			}
+
+		//! Body of the supervisor thread of elastic pool.
+		/*!
+		 * \since
+		 * v.5.5.23
+		 */
+		void
+		supervisor_body()
+			{
+				// Count of threads which are not retired yet.
+				std::size_t active_threads = m_thread_count;
+
+				// Time point since which there is at least one idle thread.
+				std::chrono::steady_clock::time_point idle_since;
+				bool idle = false;
+
+				std::unique_lock< std::mutex > lock( m_supervisor_lock );
+				while( !m_supervisor_shutdown )
+					{
+						m_supervisor_wakeup.wait_for(
+								lock, m_elastic_params.m_check_period );
+						if( m_supervisor_shutdown )
+							break;
+
+						lock.unlock();
+						try
+							{
+								adjust_thread_count( active_threads, idle, idle_since );
+							}
+						catch( ... )
+							{
+								// A failure of a new thread creation is not fatal.
+								// The pool works with the current thread count.
+							}
+						lock.lock();
+					}
+			}
+
+		//! Start or retire work threads depending on the load.
+		/*!
+		 * \since
+		 * v.5.5.23
+		 */
+		void
+		adjust_thread_count(
+			std::size_t & active_threads,
+			bool & idle,
+			std::chrono::steady_clock::time_point & idle_since )
+			{
+				join_finished_threads();
+
+				const auto waiting = m_queue.waiting_threads();
+				if( !waiting )
+					{
+						idle = false;
+
+						const auto ready = m_queue.size();
+						if( ready > m_growth_threshold )
+							{
+								auto to_start = std::min(
+										ready - m_growth_threshold,
+										m_elastic_params.m_max_thread_count - active_threads );
+								for( ; to_start; --to_start )
+									{
+										if( !start_new_thread() )
+											break;
+										++active_threads;
+									}
+							}
+					}
+				else
+					{
+						const auto now = std::chrono::steady_clock::now();
+						if( !idle )
+							{
+								idle = true;
+								idle_since = now;
+							}
+						else if( now - idle_since >= m_elastic_params.m_idle_thread_linger &&
+								active_threads > m_thread_count )
+							{
+								m_queue.retire_one_thread();
+								--active_threads;
+								{
+									std::lock_guard< std::mutex > lock( m_lock );
+									++m_threads_retired;
+								}
+
+								// The next retirement is possible only after
+								// another linger period.
+								idle_since = now;
+							}
+					}
+			}
+
+		//! Join all threads which have finished their work.
+		/*!
+		 * \since
+		 * v.5.5.23
+		 */
+		void
+		join_finished_threads()
+			{
+				for( std::size_t i = 0; i != m_threads.size(); ++i )
+					if( m_thread_running[ i ] && m_threads[ i ]->finished() )
+						{
+							m_threads[ i ]->join();
+							thread_joined( i );
+						}
+			}
+
+		//! Start a new work thread.
+		/*!
+		 * \retval false if there is no free place for a new thread.
+		 * A retired thread can still be running.
+		 *
+		 * \since
+		 * v.5.5.23
+		 */
+		bool
+		start_new_thread()
+			{
+				const auto it = std::find(
+						m_thread_running.begin(), m_thread_running.end(), false );
+				if( it == m_thread_running.end() )
+					return false;
+
+				const auto index = static_cast< std::size_t >(
+						std::distance( m_thread_running.begin(), it ) );
+
+				m_queue.thread_added();
+				so_5::details::do_with_rollback_on_exception(
+						[&] {
+							m_threads[ index ]->start(
+									m_thread_placements.for_worker( index ) );
+						},
+						[&] { m_queue.thread_removed(); } );
+
+				thread_started( index );
+				{
+					std::lock_guard< std::mutex > lock( m_lock );
+					++m_threads_started;
+				}
+
+				return true;
+			}
+
 		//! Helper method for creating event queue for agents/cooperations.
 		agent_queue_ref_t
 		make_new_agent_queue(
@@ -424,13 +806,22 @@ class dispatcher_t
 				// Statics must be collected on locked object.
 				std::lock_guard< std::mutex > lock( m_lock );
 
-				consumer.set_thread_count( m_threads.size() );
+				consumer.set_thread_count( m_running_threads );
+
+				consumer.set_ready_queue_size( m_queue.size() );
 
-				for( auto & t : m_threads )
+				if( is_elastic() )
+					consumer.set_thread_count_changes(
+							m_threads_started, m_threads_retired );
+
+				for( std::size_t i = 0; i != m_threads.size(); ++i )
 					{
+						if( !m_thread_running[ i ] )
+							continue;
+
 						using stats_t = so_5::stats::work_thread_activity_stats_t;
 
-						Work_Thread & wt = *t;
+						Work_Thread & wt = *m_threads[ i ];
 						wt.take_activity_stats(
 							[&wt, &consumer]( const stats_t & st ) {
 								consumer.add_work_thread_activity( wt.thread_id(), st );
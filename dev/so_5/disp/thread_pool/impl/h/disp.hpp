@@ -11,6 +11,8 @@
 
 #pragma once
 
+#include <algorithm>
+#include <chrono>
 #include <vector>
 #include <queue>
 #include <thread>
@@ -18,13 +20,21 @@
 #include <map>
 #include <iostream>
 #include <atomic>
+#include <limits>
 
 #include <so_5/rt/h/event_queue.hpp>
 #include <so_5/rt/h/disp.hpp>
 
+#include <so_5/details/h/at_scope_exit.hpp>
+
 #include <so_5/rt/stats/impl/h/activity_tracking.hpp>
 
 #include <so_5/disp/reuse/h/mpmc_ptr_queue.hpp>
+#include <so_5/disp/reuse/h/lock_free_mpmc_ptr_queue.hpp>
+#include <so_5/disp/reuse/h/work_stealing_ptr_queue.hpp>
+#include <so_5/disp/reuse/h/affinity_ptr_queue.hpp>
+#include <so_5/disp/reuse/h/demand_node_pool.hpp>
+#include <so_5/disp/reuse/h/thread_placement.hpp>
 
 #include <so_5/disp/thread_pool/impl/h/common_implementation.hpp>
 
@@ -47,7 +57,237 @@ class agent_queue_t;
 //
 // dispatcher_queue_t
 //
-using dispatcher_queue_t = so_5::disp::reuse::mpmc_ptr_queue_t< agent_queue_t >;
+/*!
+ * \brief Queue of non-empty agent queues.
+ *
+ * Uses mpmc_ptr_queue_t, lock_free_mpmc_ptr_queue_t,
+ * work_stealing_ptr_queue_t or affinity_ptr_queue_t depending on
+ * dispatcher parameters.
+ *
+ * \note Work stealing mode has a priority over worker affinity mode.
+ * Both of them have a priority over lock-free queue.
+ *
+ * \note Count of work threads can't be changed in work stealing and
+ * worker affinity modes.
+ *
+ * \since
+ * v.5.5.23
+ */
+class dispatcher_queue_t
+	{
+		using shared_queue_t =
+				so_5::disp::reuse::mpmc_ptr_queue_t< agent_queue_t >;
+		using lock_free_queue_t =
+				so_5::disp::reuse::lock_free_mpmc_ptr_queue_t< agent_queue_t >;
+		using work_stealing_queue_t =
+				so_5::disp::reuse::work_stealing_ptr_queue_t< agent_queue_t >;
+		using affinity_queue_t =
+				so_5::disp::reuse::affinity_ptr_queue_t< agent_queue_t >;
+
+	public :
+		dispatcher_queue_t(
+			const so_5::disp::mpmc_queue_traits::queue_params_t & queue_params,
+			std::size_t thread_count,
+			bool work_stealing,
+			bool worker_affinity,
+			const so_5::disp::reuse::affinity_params_t & affinity_params,
+			std::chrono::steady_clock::duration fair_quantum )
+			:	m_fair_quantum( fair_quantum )
+			{
+				if( work_stealing )
+					m_work_stealing_queue.reset(
+							new work_stealing_queue_t{ queue_params, thread_count } );
+				else if( worker_affinity )
+					m_affinity_queue.reset(
+							new affinity_queue_t{
+									queue_params, thread_count, affinity_params } );
+				else if( queue_params.lock_free_queue() )
+					m_lock_free_queue.reset(
+							new lock_free_queue_t{ queue_params, thread_count } );
+				else
+					m_shared_queue.reset(
+							new shared_queue_t{ queue_params, thread_count } );
+			}
+
+		void
+		shutdown()
+			{
+				if( m_work_stealing_queue )
+					m_work_stealing_queue->shutdown();
+				else if( m_affinity_queue )
+					m_affinity_queue->shutdown();
+				else if( m_lock_free_queue )
+					m_lock_free_queue->shutdown();
+				else
+					m_shared_queue->shutdown();
+			}
+
+		agent_queue_t *
+		pop( so_5::disp::mpmc_queue_traits::condition_t & condition )
+			{
+				return m_work_stealing_queue ?
+						m_work_stealing_queue->pop( condition ) :
+						m_affinity_queue ?
+						m_affinity_queue->pop( condition ) :
+						m_lock_free_queue ?
+						m_lock_free_queue->pop( condition ) :
+						m_shared_queue->pop( condition );
+			}
+
+		agent_queue_t *
+		try_switch_to_another( agent_queue_t * current ) SO_5_NOEXCEPT
+			{
+				return m_work_stealing_queue ?
+						m_work_stealing_queue->try_switch_to_another( current ) :
+						m_affinity_queue ?
+						m_affinity_queue->try_switch_to_another( current ) :
+						m_lock_free_queue ?
+						m_lock_free_queue->try_switch_to_another( current ) :
+						m_shared_queue->try_switch_to_another( current );
+			}
+
+		void
+		schedule( agent_queue_t * queue )
+			{
+				if( m_work_stealing_queue )
+					m_work_stealing_queue->schedule( queue );
+				else if( m_affinity_queue )
+					m_affinity_queue->schedule( queue );
+				else if( m_lock_free_queue )
+					m_lock_free_queue->schedule( queue );
+				else
+					m_shared_queue->schedule( queue );
+			}
+
+		so_5::disp::mpmc_queue_traits::condition_unique_ptr_t
+		allocate_condition()
+			{
+				return m_work_stealing_queue ?
+						m_work_stealing_queue->allocate_condition() :
+						m_affinity_queue ?
+						m_affinity_queue->allocate_condition() :
+						m_lock_free_queue ?
+						m_lock_free_queue->allocate_condition() :
+						m_shared_queue->allocate_condition();
+			}
+
+		std::size_t
+		size() const
+			{
+				return m_work_stealing_queue ?
+						m_work_stealing_queue->size() :
+						m_affinity_queue ?
+						m_affinity_queue->size() :
+						m_lock_free_queue ?
+						m_lock_free_queue->size() :
+						m_shared_queue->size();
+			}
+
+		std::size_t
+		waiting_threads() const
+			{
+				return m_work_stealing_queue ?
+						m_work_stealing_queue->waiting_threads() :
+						m_affinity_queue ?
+						m_affinity_queue->waiting_threads() :
+						m_lock_free_queue ?
+						m_lock_free_queue->waiting_threads() :
+						m_shared_queue->waiting_threads();
+			}
+
+		//! Inform the queue about a new working thread.
+		/*!
+		 * \attention Must not be used in work stealing and
+		 * worker affinity modes.
+		 */
+		void
+		thread_added()
+			{
+				if( m_lock_free_queue )
+					m_lock_free_queue->thread_added();
+				else
+					m_shared_queue->thread_added();
+			}
+
+		//! Inform the queue that a thread announced by thread_added()
+		//! wasn't started.
+		/*!
+		 * \attention Must not be used in work stealing and
+		 * worker affinity modes.
+		 */
+		void
+		thread_removed()
+			{
+				if( m_lock_free_queue )
+					m_lock_free_queue->thread_removed();
+				else
+					m_shared_queue->thread_removed();
+			}
+
+		//! Base time quantum for weighted fair scheduling.
+		/*!
+		 * Zero value means that weighted fair scheduling isn't used.
+		 *
+		 * \since
+		 * v.5.5.23
+		 */
+		std::chrono::steady_clock::duration
+		fair_quantum() const
+			{
+				return m_fair_quantum;
+			}
+
+		//! Ask one of working threads to finish its work.
+		/*!
+		 * \attention Must not be used in work stealing and
+		 * worker affinity modes.
+		 */
+		void
+		retire_one_thread()
+			{
+				if( m_lock_free_queue )
+					m_lock_free_queue->retire_one_thread();
+				else
+					m_shared_queue->retire_one_thread();
+			}
+
+	private :
+		//! Base time quantum for weighted fair scheduling.
+		/*!
+		 * \since
+		 * v.5.5.23
+		 */
+		const std::chrono::steady_clock::duration m_fair_quantum;
+
+		//! Queue for the ordinary mode.
+		/*!
+		 * Is nullptr if work stealing, worker affinity or lock-free
+		 * queue is used.
+		 */
+		std::unique_ptr< shared_queue_t > m_shared_queue;
+
+		//! Lock-free queue for the ordinary mode.
+		/*!
+		 * Is nullptr if work stealing or worker affinity is used or
+		 * lock-free queue isn't turned on.
+		 */
+		std::unique_ptr< lock_free_queue_t > m_lock_free_queue;
+
+		//! Queue for work stealing mode.
+		/*!
+		 * Is nullptr if work stealing isn't used.
+		 */
+		std::unique_ptr< work_stealing_queue_t > m_work_stealing_queue;
+
+		//! Queue for worker affinity mode.
+		/*!
+		 * Is nullptr if worker affinity isn't used.
+		 *
+		 * \since
+		 * v.5.5.23
+		 */
+		std::unique_ptr< affinity_queue_t > m_affinity_queue;
+	};
 
 //
 // agent_queue_t
@@ -87,7 +327,17 @@ class agent_queue_t
 			//! Parameters for the queue.
 			const params_t & params )
 			:	m_disp_queue( disp_queue )
-			,	m_max_demands_at_once( params.query_max_demands_at_once() )
+			,	m_fair_quantum( disp_queue.fair_quantum() *
+					static_cast< std::chrono::steady_clock::duration::rep >(
+							std::max< std::size_t >( params.query_weight(), 1u ) ) )
+			,	m_latency_budget( fair() ?
+					std::chrono::steady_clock::duration::zero() :
+					params.query_adaptive_latency_budget() )
+			,	m_max_demands_at_once( adaptive() ?
+					std::max< std::size_t >(
+							params.query_adaptive_demands_limit(), 1u ) :
+					params.query_max_demands_at_once() )
+			,	m_demands_at_once( m_max_demands_at_once )
 			,	m_tail( &m_head )
 			{}
 
@@ -98,17 +348,26 @@ class agent_queue_t
 			}
 
 		//! Push next demand to queue.
+		/*!
+		 * \note Since v.5.5.23 a node for the demand is taken from the
+		 * pool of free nodes. A new node is allocated before acquiring
+		 * the queue lock only if the pool is empty.
+		 */
 		virtual void
 		push( execution_demand_t demand )
 			{
-				std::unique_ptr< demand_t > tail_demand{
-						new demand_t( std::move( demand ) ) };
+				std::unique_ptr< demand_t > tail_demand;
+				if( !m_free_nodes.probably_has_nodes() )
+					tail_demand.reset( new demand_t( std::move( demand ) ) );
 
 				bool was_empty;
 
 				{
 					std::lock_guard< spinlock_t > lock( m_lock );
 
+					if( !tail_demand )
+						tail_demand.reset( make_node( std::move( demand ) ) );
+
 					was_empty = (nullptr == m_head.m_next);
 
 					m_tail->m_next = tail_demand.release();
@@ -123,6 +382,59 @@ class agent_queue_t
 					m_disp_queue.schedule( this );
 			}
 
+		//! Push several demands to queue at once.
+		/*!
+		 * All items are allocated before acquiring the queue lock.
+		 * Then the whole chain is appended to the queue by one operation.
+		 *
+		 * \since
+		 * v.5.5.23
+		 */
+		virtual void
+		push_batch(
+			execution_demand_t * demands,
+			std::size_t count ) override
+			{
+				if( !count )
+					return;
+
+				// Chain of new demands is built outside of the queue lock.
+				demand_t chain_head;
+				demand_t * chain_tail = &chain_head;
+				auto chain_cleaner = so_5::details::at_scope_exit( [&chain_head] {
+						while( chain_head.m_next )
+							{
+								std::unique_ptr< demand_t > d{ chain_head.m_next };
+								chain_head.m_next = d->m_next;
+							}
+					} );
+
+				for( std::size_t i = 0; i != count; ++i )
+					{
+						chain_tail->m_next = new demand_t( std::move( demands[ i ] ) );
+						chain_tail = chain_tail->m_next;
+					}
+
+				bool was_empty;
+
+				{
+					std::lock_guard< spinlock_t > lock( m_lock );
+
+					was_empty = (nullptr == m_head.m_next);
+
+					m_tail->m_next = chain_head.m_next;
+					m_tail = chain_tail;
+					chain_head.m_next = nullptr;
+
+					m_size += count;
+				}
+
+				// Scheduling of the queue must be done when queue lock
+				// is unlocked.
+				if( was_empty )
+					m_disp_queue.schedule( this );
+			}
+
 		//! Get the front demand from queue.
 		/*!
 		 * \attention This method must be called only on non-empty queue.
@@ -175,21 +487,34 @@ class agent_queue_t
 		//! Remove the front demand.
 		/*!
 		 * \note Return processing_continuation_t::disabled if
-		 * \a demands_processed exceeds m_max_demands_at_once or if
+		 * \a demands_processed exceeds m_demands_at_once or if
 		 * event queue is empty.
+		 *
+		 * \note Since v.5.5.23 the time of processing of demands is
+		 * collected for adaptive and weighted fair modes. In weighted fair
+		 * mode processing_continuation_t::disabled is returned if
+		 * \a processing_time exceeds the quantum of the queue.
 		 */
 		pop_result_t
 		pop(
 			//! Count of consequently processed demands from that queue.
-			std::size_t demands_processed )
+			std::size_t demands_processed,
+			//! Time of processing of those demands.
+			//! It is used only in adaptive and weighted fair modes.
+			std::chrono::steady_clock::duration processing_time =
+					std::chrono::steady_clock::duration::zero() )
 			{
-				// Actual deletion of old head must be performed
+				// Actual deletion of old message (and old head if it can't
+				// be returned to the pool) must be performed
 				// when m_lock will be released.
+				message_ref_t old_message;
 				std::unique_ptr< demand_t > old_head;
 				{
 					std::lock_guard< spinlock_t > lock( m_lock );
 
 					old_head = remove_head();
+					old_message = std::move( old_head->m_message_ref );
+					old_head.reset( m_free_nodes.try_put( old_head.release() ) );
 
 					const auto emptyness = m_head.m_next ?
 							emptyness_t::not_empty : emptyness_t::empty;
@@ -197,12 +522,157 @@ class agent_queue_t
 					if( emptyness_t::empty == emptyness )
 						m_tail = &m_head;
 
-					return pop_result_t{
-							detect_continuation( emptyness, demands_processed ),
-							emptyness };
+					const auto continuation = detect_continuation(
+							emptyness, demands_processed, processing_time );
+
+					if( adaptive() &&
+							processing_continuation_t::disabled == continuation )
+						{
+							// Results of the batch will be handled at the start
+							// of the next batch. The queue can be destroyed right
+							// after the return if it is empty.
+							m_last_batch_demands = demands_processed;
+							m_last_batch_time = processing_time;
+						}
+
+					if( processing_continuation_t::disabled == continuation )
+						finish_turn( emptyness, processing_time );
+
+					return pop_result_t{ continuation, emptyness };
 				}
 			}
 
+		/*!
+		 * \brief Is count of demands to be processed at once adaptive?
+		 *
+		 * \since
+		 * v.5.5.23
+		 */
+		bool
+		adaptive() const
+			{
+				return m_latency_budget > std::chrono::steady_clock::duration::zero();
+			}
+
+		/*!
+		 * \brief Is weighted fair scheduling used for this queue?
+		 *
+		 * \since
+		 * v.5.5.23
+		 */
+		bool
+		fair() const
+			{
+				return m_fair_quantum > std::chrono::steady_clock::duration::zero();
+			}
+
+		/*!
+		 * \brief Start the next turn of processing in weighted fair mode.
+		 *
+		 * The quantum of the queue is added to the deficit of the queue.
+		 * The deficit can't exceed the quantum. So the queue can't
+		 * accumulate the time it didn't use.
+		 *
+		 * Always returns true if weighted fair scheduling isn't used.
+		 *
+		 * \attention Must be called only by the work thread which is
+		 * processing this queue at the moment.
+		 *
+		 * \retval false if the queue has spent its share of time and
+		 * should skip this turn.
+		 *
+		 * \since
+		 * v.5.5.23
+		 */
+		bool
+		start_fair_turn()
+			{
+				if( !fair() )
+					return true;
+
+				m_deficit = std::min( m_deficit + m_fair_quantum, m_fair_quantum );
+
+				return m_deficit > std::chrono::steady_clock::duration::zero();
+			}
+
+		/*!
+		 * \brief Get total service time of the queue in microseconds.
+		 *
+		 * Service time is measured only in adaptive and weighted fair modes.
+		 *
+		 * \since
+		 * v.5.5.23
+		 */
+		std::size_t
+		service_time() const
+			{
+				return static_cast< std::size_t >(
+						std::chrono::duration_cast< std::chrono::microseconds >(
+								std::chrono::steady_clock::duration(
+										m_service_time_total.load(
+												std::memory_order_relaxed ) ) ).count() );
+			}
+
+		/*!
+		 * \brief Update count of demands to be processed at once.
+		 *
+		 * Processing time of one demand is smoothed over several batches.
+		 * Then count of demands is selected so that the processing of the
+		 * next batch takes no more than latency budget divided by count of
+		 * non-empty queues (including this one).
+		 *
+		 * Does nothing if adaptive mode isn't used.
+		 *
+		 * \attention Must be called only by the work thread which is
+		 * processing this queue at the moment.
+		 *
+		 * \since
+		 * v.5.5.23
+		 */
+		void
+		adjust_demands_at_once()
+			{
+				using duration_t = std::chrono::steady_clock::duration;
+
+				if( !adaptive() || !m_last_batch_demands )
+					return;
+
+				const duration_t sample = m_last_batch_time /
+						static_cast< duration_t::rep >( m_last_batch_demands );
+				m_last_batch_demands = 0;
+
+				m_service_time = duration_t::zero() == m_service_time ?
+						sample : ( m_service_time * 7 + sample ) / 8;
+
+				std::size_t v = m_max_demands_at_once;
+				if( m_service_time > duration_t::zero() )
+					{
+						const auto queues = static_cast< duration_t::rep >(
+								m_disp_queue.size() + 1 );
+						const auto fit = m_latency_budget /
+								( m_service_time * queues );
+
+						if( fit < 1 )
+							v = 1;
+						else if( static_cast< std::size_t >( fit ) < v )
+							v = static_cast< std::size_t >( fit );
+					}
+
+				m_demands_at_once.store( v, std::memory_order_relaxed );
+			}
+
+		/*!
+		 * \brief Get the current count of demands to be processed at once.
+		 *
+		 * \since
+		 * v.5.5.23
+		 */
+		std::size_t
+		demands_at_once() const
+			{
+				return m_demands_at_once.load( std::memory_order_relaxed );
+			}
+
 		/*!
 		 * \brief Wait while queue becomes empty.
 		 *
@@ -242,14 +712,140 @@ class agent_queue_t
 				return m_size.load( std::memory_order_acquire );
 			}
 
+		/*!
+		 * \brief Get the index of the work thread which handled
+		 * this queue the last time.
+		 *
+		 * \note Is used only in worker affinity mode.
+		 *
+		 * \since
+		 * v.5.5.23
+		 */
+		std::size_t
+		last_worker() const
+			{
+				return m_last_worker;
+			}
+
+		/*!
+		 * \brief Set the index of the work thread which handled
+		 * this queue the last time.
+		 *
+		 * \note Is used only in worker affinity mode.
+		 *
+		 * \since
+		 * v.5.5.23
+		 */
+		void
+		last_worker( std::size_t index )
+			{
+				m_last_worker = index;
+			}
+
 	private :
 		//! Dispatcher queue for scheduling processing of events from
 		//! this queue.
 		dispatcher_queue_t & m_disp_queue;
 
+		/*!
+		 * \brief Time quantum of this queue for weighted fair mode.
+		 *
+		 * It is the base quantum of the dispatcher multiplied by the
+		 * weight of the queue. Zero value means that weighted fair
+		 * scheduling is not used.
+		 *
+		 * \since
+		 * v.5.5.23
+		 */
+		const std::chrono::steady_clock::duration m_fair_quantum;
+
+		/*!
+		 * \brief Time which can be spent in the current turn.
+		 *
+		 * Can be negative if the last demand took more time than
+		 * the rest of the quantum.
+		 *
+		 * \since
+		 * v.5.5.23
+		 */
+		std::chrono::steady_clock::duration m_deficit =
+				std::chrono::steady_clock::duration::zero();
+
+		/*!
+		 * \brief Total time of processing of demands from this queue.
+		 *
+		 * \since
+		 * v.5.5.23
+		 */
+		std::atomic< std::chrono::steady_clock::duration::rep >
+				m_service_time_total = { 0 };
+
+		/*!
+		 * \brief Latency budget for adaptive mode.
+		 *
+		 * Zero value means that adaptive mode is not used.
+		 *
+		 * \since
+		 * v.5.5.23
+		 */
+		const std::chrono::steady_clock::duration m_latency_budget;
+
 		//! Maximum count of demands to be processed consequently.
+		/*!
+		 * \note Since v.5.5.23 it is the upper limit for adaptive mode.
+		 */
 		const std::size_t m_max_demands_at_once;
 
+		/*!
+		 * \brief Current count of demands to be processed consequently.
+		 *
+		 * Is changed only in adaptive mode.
+		 *
+		 * \since
+		 * v.5.5.23
+		 */
+		std::atomic< std::size_t > m_demands_at_once;
+
+		/*!
+		 * \brief Smoothed processing time of one demand.
+		 *
+		 * \since
+		 * v.5.5.23
+		 */
+		std::chrono::steady_clock::duration m_service_time =
+				std::chrono::steady_clock::duration::zero();
+
+		/*!
+		 * \brief Count of demands processed in the last batch.
+		 *
+		 * Zero value means that the last batch is already handled.
+		 *
+		 * \since
+		 * v.5.5.23
+		 */
+		std::size_t m_last_batch_demands = { 0 };
+
+		/*!
+		 * \brief Processing time of the last batch.
+		 *
+		 * \since
+		 * v.5.5.23
+		 */
+		std::chrono::steady_clock::duration m_last_batch_time =
+				std::chrono::steady_clock::duration::zero();
+
+		/*!
+		 * \brief Index of the work thread which handled this queue
+		 * the last time.
+		 *
+		 * Is protected by the lock of the dispatcher queue.
+		 * The initial value means that the queue wasn't handled yet.
+		 *
+		 * \since
+		 * v.5.5.23
+		 */
+		std::size_t m_last_worker = { std::numeric_limits< std::size_t >::max() };
+
 		//! Object's lock.
 		spinlock_t m_lock;
 
@@ -272,6 +868,37 @@ class agent_queue_t
 		 */
 		std::atomic< std::size_t > m_size = { 0 };
 
+		/*!
+		 * \brief Free nodes for new demands.
+		 *
+		 * \since
+		 * v.5.5.23
+		 */
+		so_5::disp::reuse::demand_node_pool_t< demand_t > m_free_nodes;
+
+		/*!
+		 * \brief Get a node for a new demand.
+		 *
+		 * Takes a node from the pool or allocates a new one if
+		 * the pool is empty.
+		 *
+		 * \attention Must be called when m_lock is acquired.
+		 *
+		 * \since
+		 * v.5.5.23
+		 */
+		demand_t *
+		make_node( execution_demand_t && demand )
+			{
+				auto node = m_free_nodes.try_take();
+				if( node )
+					static_cast< execution_demand_t & >( *node ) = std::move( demand );
+				else
+					node = new demand_t( std::move( demand ) );
+
+				return node;
+			}
+
 		//! Helper method for deleting queue's head object.
 		inline std::unique_ptr< demand_t >
 		remove_head()
@@ -285,16 +912,52 @@ class agent_queue_t
 			}
 
 		//! Can processing be continued?
+		/*!
+		 * \note Since v.5.5.23 the count of processed demands is ignored
+		 * in weighted fair mode. Processing time is checked instead.
+		 */
 		inline processing_continuation_t
 		detect_continuation(
 			emptyness_t emptyness,
-			const std::size_t processed )
+			const std::size_t processed,
+			std::chrono::steady_clock::duration processing_time )
 			{
 				return emptyness_t::not_empty == emptyness &&
-						processed < m_max_demands_at_once ? 
+						( fair() ?
+							processing_time < m_deficit :
+							processed < m_demands_at_once.load(
+									std::memory_order_relaxed ) ) ?
 						processing_continuation_t::enabled :
 						processing_continuation_t::disabled;
 			}
+
+		/*!
+		 * \brief Handle the end of processing of demands from this queue.
+		 *
+		 * Updates the service time of the queue. In weighted fair mode
+		 * the spent time is subtracted from the deficit. The deficit is
+		 * dropped if the queue is empty.
+		 *
+		 * \attention Must be called when m_lock is acquired.
+		 * The queue can be destroyed right after the release of m_lock
+		 * if it is empty.
+		 *
+		 * \since
+		 * v.5.5.23
+		 */
+		void
+		finish_turn(
+			emptyness_t emptyness,
+			std::chrono::steady_clock::duration processing_time )
+			{
+				m_service_time_total.fetch_add(
+						processing_time.count(), std::memory_order_relaxed );
+
+				if( fair() )
+					m_deficit = emptyness_t::empty == emptyness ?
+							std::chrono::steady_clock::duration::zero() :
+							m_deficit - processing_time;
+			}
 	};
 
 namespace work_thread_details
@@ -323,6 +986,13 @@ struct common_data_t
 		//! Waiting object for long wait.
 		so_5::disp::mpmc_queue_traits::condition_unique_ptr_t m_condition;
 
+		//! Is thread body finished?
+		/*!
+		 * \since
+		 * v.5.5.23
+		 */
+		std::atomic< bool > m_finished{ false };
+
 		common_data_t( dispatcher_queue_t & queue )
 			:	m_disp_queue( &queue )
 			,	m_condition{ queue.allocate_condition() }
@@ -452,10 +1122,30 @@ class work_thread_template_t : public Impl
 			}
 
 		//! Launch work thread.
+		/*!
+		 * \note Since v.5.5.23 the placement of the thread is specified.
+		 * An exception is thrown if the placement can't be applied.
+		 */
 		void
-		start()
+		start( const so_5::disp::reuse::thread_placement_t & placement )
+			{
+				this->m_finished.store( false, std::memory_order_relaxed );
+				this->m_thread = so_5::disp::reuse::make_placed_thread(
+						placement,
+						[this]() { body(); } );
+			}
+
+		//! Is thread body finished?
+		/*!
+		 * The thread must be joined anyway.
+		 *
+		 * \since
+		 * v.5.5.23
+		 */
+		bool
+		finished() const
 			{
-				this->m_thread = std::thread( [this]() { body(); } );
+				return this->m_finished.load( std::memory_order_acquire );
 			}
 
 		/*!
@@ -485,6 +1175,8 @@ class work_thread_template_t : public Impl
 					{
 						this->do_queue_processing( agent_queue );
 					}
+
+				this->m_finished.store( true, std::memory_order_release );
 			}
 
 		/*!
@@ -545,12 +1237,32 @@ class work_thread_template_t : public Impl
 
 
 		//! Processing of demands from agent queue.
+		/*!
+		 * \note Since v.5.5.23 the processing time is measured if
+		 * the queue uses adaptive count of demands to be processed at once
+		 * or weighted fair scheduling.
+		 *
+		 * \note Since v.5.5.23 no demands are processed if the queue
+		 * has spent its share of time in weighted fair mode. The queue
+		 * is reported as non-empty and will be switched to another one
+		 * if there are other non-empty queues.
+		 */
 		agent_queue_t::emptyness_t
 		process_queue( agent_queue_t & queue )
 			{
+				using clock_t = std::chrono::steady_clock;
+
 				std::size_t demands_processed = 0;
 				agent_queue_t::pop_result_t pop_result;
 
+				if( !queue.start_fair_turn() )
+					return agent_queue_t::emptyness_t::not_empty;
+
+				queue.adjust_demands_at_once();
+				const bool measured = queue.adaptive() || queue.fair();
+				const auto started_at = measured ?
+						clock_t::now() : clock_t::time_point{};
+
 				do
 					{
 						auto & d = queue.front();
@@ -562,7 +1274,10 @@ class work_thread_template_t : public Impl
 						this->work_finished();
 
 						++demands_processed;
-						pop_result = queue.pop( demands_processed );
+						pop_result = measured ?
+								queue.pop( demands_processed,
+										clock_t::now() - started_at ) :
+								queue.pop( demands_processed );
 					}
 				while( agent_queue_t::processing_continuation_t::enabled ==
 						pop_result.m_continuation );
@@ -626,6 +1341,26 @@ struct adaptation_t
 			{
 				queue.wait_for_emptyness();
 			}
+
+		/*!
+		 * \since
+		 * v.5.5.23
+		 */
+		static std::size_t
+		demands_at_once( const agent_queue_t & queue )
+			{
+				return queue.demands_at_once();
+			}
+
+		/*!
+		 * \since
+		 * v.5.5.23
+		 */
+		static std::size_t
+		service_time( const agent_queue_t & queue )
+			{
+				return queue.service_time();
+			}
 	};
 
 //
@@ -41,6 +41,45 @@ using namespace so_5::disp::thread_pool::impl;
 using actual_disp_iface_t =
 		common_implementation::ext_dispatcher_iface_t< bind_params_t >;
 
+/*!
+ * \brief Make parameters of elastic pool from dispatcher's params.
+ *
+ * \note Elastic mode isn't supported in work stealing and
+ * worker affinity modes.
+ *
+ * \since
+ * v.5.5.23
+ */
+common_implementation::elastic_params_t
+make_elastic_params( const disp_params_t & params )
+	{
+		common_implementation::elastic_params_t r;
+		if( !params.work_stealing_used() && !params.worker_affinity_used() )
+			{
+				r.m_max_thread_count = params.max_thread_count();
+				r.m_idle_thread_linger = params.idle_thread_linger();
+				r.m_check_period = params.elastic_check_period();
+			}
+
+		return r;
+	}
+
+/*!
+ * \brief Make parameters of worker affinity from dispatcher's params.
+ *
+ * \since
+ * v.5.5.23
+ */
+so_5::disp::reuse::affinity_params_t
+make_affinity_params( const disp_params_t & params )
+	{
+		so_5::disp::reuse::affinity_params_t r;
+		r.m_overload_threshold = params.affinity_overload_threshold();
+		r.m_idle_threshold = params.affinity_idle_threshold();
+
+		return r;
+	}
+
 //
 // proxy_dispatcher_t
 //
@@ -97,7 +136,13 @@ class proxy_dispatcher_t : public proxy_dispatcher_base_t
 							dispatcher_with_activity_tracking_t >(
 						env,
 						m_disp_params.thread_count(),
-						m_disp_params.queue_params() );
+						m_disp_params.thread_placements(),
+						make_elastic_params( m_disp_params ),
+						m_disp_params.queue_params(),
+						m_disp_params.work_stealing_used(),
+						m_disp_params.worker_affinity_used(),
+						make_affinity_params( m_disp_params ),
+						m_disp_params.fair_scheduling_quantum() );
 			}
 	};
 
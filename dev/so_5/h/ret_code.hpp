@@ -521,6 +521,42 @@ const int rc_negative_value_for_period = 177;
  */
 const int rc_transfer_to_state_loop = 178;
 
+/*!
+ * \brief An attempt to create size-unlimited message chain with
+ * lock-free queue.
+ *
+ * Lock-free queue for message chain is a bounded ring buffer. Because
+ * of that it can be used only for size-limited chains.
+ *
+ * \since
+ * v.5.5.23
+ */
+const int rc_lock_free_mchain_must_be_limited = 179;
+
+/*!
+ * \brief An attempt to create sharded timer thread without shards.
+ *
+ * \since
+ * v.5.5.23
+ */
+const int rc_no_timer_shards = 180;
+
+/*!
+ * \brief Unable to create file descriptors for timerfd-based timer thread.
+ *
+ * \since
+ * v.5.5.23
+ */
+const int rc_timerfd_creation_failed = 181;
+
+/*!
+ * \brief Unable to apply placement to a work thread of a dispatcher.
+ *
+ * \since
+ * v.5.5.23
+ */
+const int rc_thread_placement_failed = 182;
+
 //! \name Common error codes.
 //! \{
 
@@ -15,10 +15,40 @@
 #include <atomic>
 #include <thread>
 #include <cstdint>
+#include <cstddef>
+
+#if defined(__x86_64__) || defined(__i386__) || \
+		defined(_M_X64) || defined(_M_IX86)
+	#define SO_5_SPINLOCKS_HAVE_MM_PAUSE
+	#include <immintrin.h>
+#endif
 
 namespace so_5
 {
 
+//
+// cpu_relax
+//
+/*!
+ * \since
+ * v.5.5.23
+ *
+ * \brief A hint for CPU that the current thread is in a spin-wait loop.
+ *
+ * It is `pause` instruction on x86/x64 and `yield` instruction on ARM.
+ */
+inline void
+cpu_relax()
+	{
+#if defined(SO_5_SPINLOCKS_HAVE_MM_PAUSE)
+		_mm_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+		__asm__ __volatile__( "yield" ::: "memory" );
+#else
+		std::atomic_signal_fence( std::memory_order_seq_cst );
+#endif
+	}
+
 //
 // yield_backoff_t
 //
@@ -38,6 +68,43 @@ class yield_backoff_t
 			}
 	};
 
+//
+// pause_backoff_t
+//
+/*!
+ * \since
+ * v.5.5.23
+ *
+ * \brief A implementation of backoff object with exponential spinning
+ * on cpu_relax() and switching to std::yield after that.
+ *
+ * The count of cpu_relax() calls is doubled on every call of backoff
+ * object until it reaches max_pauses. std::this_thread::yield() is used
+ * after that. So short waits do not lead to system calls.
+ */
+class pause_backoff_t
+	{
+	public :
+		//! Max count of cpu_relax() calls for one call of backoff object.
+		static const unsigned max_pauses = 64u;
+
+		inline void
+		operator()()
+			{
+				if( m_pauses <= max_pauses )
+					{
+						for( unsigned i = 0u; i != m_pauses; ++i )
+							cpu_relax();
+						m_pauses <<= 1;
+					}
+				else
+					std::this_thread::yield();
+			}
+
+	private :
+		unsigned m_pauses = 1u;
+	};
+
 //
 // spinlock_t
 //
@@ -85,10 +152,281 @@ class spinlock_t
 		std::atomic_flag m_flag;
 	};
 
+//
+// ticket_spinlock_t
+//
+/*!
+ * \since
+ * v.5.5.23
+ *
+ * \brief A fair spinlock (analog of std::mutex).
+ *
+ * Threads acquire the lock in the order of calls to lock().
+ */
+template< class Backoff >
+class ticket_spinlock_t
+	{
+	public :
+		ticket_spinlock_t()
+			{
+				m_next_ticket.store( 0u, std::memory_order_relaxed );
+				m_now_serving.store( 0u, std::memory_order_release );
+			}
+		ticket_spinlock_t( const ticket_spinlock_t & ) = delete;
+		ticket_spinlock_t & operator=( const ticket_spinlock_t & ) = delete;
+
+		//! Lock object.
+		void
+		lock()
+			{
+				const auto ticket = m_next_ticket.fetch_add(
+						1u, std::memory_order_relaxed );
+
+				Backoff backoff;
+				while( ticket != m_now_serving.load( std::memory_order_acquire ) )
+					backoff();
+			}
+
+		//! Unlock object.
+		void
+		unlock()
+			{
+				// Only the owner of the lock modifies m_now_serving.
+				m_now_serving.store(
+						m_now_serving.load( std::memory_order_relaxed ) + 1u,
+						std::memory_order_release );
+			}
+
+	private :
+		//! Ticket for the next call to lock().
+		std::atomic_uint_fast32_t m_next_ticket;
+		//! Ticket of the current owner of the lock.
+		std::atomic_uint_fast32_t m_now_serving;
+	};
+
+namespace spinlocks_details
+{
+
+//
+// mcs_node_t
+//
+/*!
+ * \since
+ * v.5.5.23
+ *
+ * \brief A node of waiting queue for mcs_spinlock_t.
+ */
+struct mcs_node_t
+	{
+		std::atomic< mcs_node_t * > m_next;
+		std::atomic< bool > m_locked;
+
+		//! Next node in a list of free nodes.
+		mcs_node_t * m_next_free;
+	};
+
+//
+// mcs_node_pool_t
+//
+/*!
+ * \since
+ * v.5.5.23
+ *
+ * \brief A per-thread storage of free nodes for mcs_spinlock_t.
+ *
+ * A node is necessary for every lock held by a thread. Nodes are
+ * reused after unlock.
+ */
+class mcs_node_pool_t
+	{
+	public :
+		mcs_node_pool_t() = default;
+		mcs_node_pool_t( const mcs_node_pool_t & ) = delete;
+		mcs_node_pool_t & operator=( const mcs_node_pool_t & ) = delete;
+
+		~mcs_node_pool_t()
+			{
+				while( m_free )
+					delete take();
+			}
+
+		mcs_node_t *
+		take()
+			{
+				if( !m_free )
+					return new mcs_node_t;
+
+				auto node = m_free;
+				m_free = node->m_next_free;
+				return node;
+			}
+
+		void
+		put( mcs_node_t * node )
+			{
+				node->m_next_free = m_free;
+				m_free = node;
+			}
+
+	private :
+		mcs_node_t * m_free = nullptr;
+	};
+
+inline mcs_node_pool_t &
+mcs_node_pool()
+	{
+		static thread_local mcs_node_pool_t pool;
+		return pool;
+	}
+
+//
+// reader_slot_index
+//
+/*!
+ * \since
+ * v.5.5.23
+ *
+ * \brief An index of reader's slot for distributed_rw_spinlock_t
+ * for the current thread.
+ *
+ * Indexes are assigned in round-robin manner at the first call on
+ * a thread and are not changed after that.
+ */
+inline std::size_t
+reader_slot_index()
+	{
+		static std::atomic< std::size_t > s_counter{ 0u };
+		static thread_local const std::size_t s_index =
+				s_counter.fetch_add( 1u, std::memory_order_relaxed );
+		return s_index;
+	}
+
+//! Assumed size of cache line.
+const std::size_t cache_line_size = 64u;
+
+} /* namespace spinlocks_details */
+
+//
+// mcs_spinlock_t
+//
+/*!
+ * \since
+ * v.5.5.23
+ *
+ * \brief A fair queue-based spinlock (analog of std::mutex).
+ *
+ * An implementation of the lock from "Algorithms for Scalable
+ * Synchronization on Shared-Memory Multiprocessors" by J. Mellor-Crummey
+ * and M. Scott. Every waiting thread spins on its own queue node, so
+ * there is no cache line bouncing under heavy contention.
+ *
+ * Queue nodes are taken from a per-thread pool. It allows to use
+ * the lock via usual lock() and unlock() methods.
+ *
+ * \note lock() can throw std::bad_alloc if there is no free node for
+ * the current thread and a new one can't be allocated.
+ */
+template< class Backoff >
+class mcs_spinlock_t
+	{
+		using node_t = spinlocks_details::mcs_node_t;
+
+	public :
+		mcs_spinlock_t()
+			{
+				m_tail.store( nullptr, std::memory_order_release );
+			}
+		mcs_spinlock_t( const mcs_spinlock_t & ) = delete;
+		mcs_spinlock_t & operator=( const mcs_spinlock_t & ) = delete;
+
+		//! Lock object.
+		void
+		lock()
+			{
+				node_t * me = spinlocks_details::mcs_node_pool().take();
+				me->m_next.store( nullptr, std::memory_order_relaxed );
+				me->m_locked.store( true, std::memory_order_relaxed );
+
+				node_t * predecessor = m_tail.exchange(
+						me, std::memory_order_acq_rel );
+				if( predecessor )
+					{
+						predecessor->m_next.store( me, std::memory_order_release );
+
+						Backoff backoff;
+						while( me->m_locked.load( std::memory_order_acquire ) )
+							backoff();
+					}
+
+				m_owner = me;
+			}
+
+		//! Unlock object.
+		void
+		unlock()
+			{
+				node_t * me = m_owner;
+
+				node_t * successor = me->m_next.load( std::memory_order_acquire );
+				if( !successor )
+					{
+						node_t * expected = me;
+						if( m_tail.compare_exchange_strong(
+								expected, nullptr,
+								std::memory_order_acq_rel,
+								std::memory_order_relaxed ) )
+							{
+								spinlocks_details::mcs_node_pool().put( me );
+								return;
+							}
+
+						// There is a new waiting thread but it has not linked
+						// its node yet.
+						Backoff backoff;
+						while( nullptr == ( successor =
+								me->m_next.load( std::memory_order_acquire ) ) )
+							backoff();
+					}
+
+				successor->m_locked.store( false, std::memory_order_release );
+
+				// Nobody uses our node after that.
+				spinlocks_details::mcs_node_pool().put( me );
+			}
+
+	private :
+		//! The last node in the waiting queue.
+		std::atomic< node_t * > m_tail;
+
+		//! Node of the current owner of the lock.
+		/*!
+		 * Is modified and read only by the owner of the lock.
+		 */
+		node_t * m_owner = nullptr;
+	};
+
 //
 // default_spinlock_t
 //
-typedef spinlock_t< yield_backoff_t > default_spinlock_t;
+/*!
+ * \brief Type of spinlock used by SObjectizer.
+ *
+ * spinlock_t with pause_backoff_t is used by default. Another type of
+ * spinlock can be selected by definition of one of the symbols:
+ *
+ * - SO_5_USE_TICKET_SPINLOCK for ticket_spinlock_t;
+ * - SO_5_USE_MCS_SPINLOCK for mcs_spinlock_t.
+ *
+ * \attention The same symbol must be defined for compilation of
+ * SObjectizer and for compilation of all code which uses it.
+ */
+#if defined( SO_5_USE_TICKET_SPINLOCK )
+typedef ticket_spinlock_t< pause_backoff_t > default_spinlock_t;
+#elif defined( SO_5_USE_MCS_SPINLOCK )
+typedef mcs_spinlock_t< pause_backoff_t > default_spinlock_t;
+#else
+typedef spinlock_t< pause_backoff_t > default_spinlock_t;
+#endif
 
 //
 // rw_spinlock_t
@@ -187,7 +525,144 @@ class rw_spinlock_t
 			}
 	};
 
-typedef rw_spinlock_t< yield_backoff_t > default_rw_spinlock_t;
+//
+// distributed_rw_spinlock_t
+//
+/*!
+ * \since
+ * v.5.5.23
+ *
+ * \brief A multi-readers/single-writer spinlock with distributed
+ * counters of readers (analog of std::shared_mutex).
+ *
+ * Every reader thread uses its own slot (slots are selected by
+ * thread index). Slots are placed in different cache lines, so readers
+ * from different threads do not share a cache line. A writer sets
+ * the writer flag and then waits until all slots become empty.
+ *
+ * \note This lock is much bigger than rw_spinlock_t (it takes
+ * at least `(Slots+1)*64` bytes), so it makes sense only for objects
+ * which are read by many threads at the same time.
+ *
+ * \tparam Backoff type of backoff object.
+ * \tparam Slots count of slots for readers. Must be a power of 2.
+ */
+template< class Backoff, std::size_t Slots = 16u >
+class distributed_rw_spinlock_t
+	{
+		static_assert( 0u != Slots && 0u == (Slots & (Slots - 1u)),
+				"Slots must be a power of 2" );
+
+		//! Counter of readers in its own cache line.
+		struct slot_t
+			{
+				std::atomic_uint_fast32_t m_readers;
+				char m_padding[ spinlocks_details::cache_line_size -
+						sizeof(std::atomic_uint_fast32_t) ];
+			};
+
+		std::atomic< bool > m_writer;
+		char m_padding[ spinlocks_details::cache_line_size -
+				sizeof(std::atomic< bool >) ];
+
+		slot_t m_slots[ Slots ];
+
+		std::atomic_uint_fast32_t &
+		current_thread_slot()
+			{
+				return m_slots[ spinlocks_details::reader_slot_index() &
+						(Slots - 1u) ].m_readers;
+			}
+
+	public :
+		distributed_rw_spinlock_t()
+			{
+				for( auto & s : m_slots )
+					s.m_readers.store( 0u, std::memory_order_relaxed );
+				m_writer.store( false, std::memory_order_release );
+			}
+		distributed_rw_spinlock_t( const distributed_rw_spinlock_t & ) = delete;
+
+		distributed_rw_spinlock_t &
+		operator=( const distributed_rw_spinlock_t & ) = delete;
+
+		//! Lock object in shared mode.
+		inline void
+		lock_shared()
+			{
+				auto & readers = current_thread_slot();
+
+				Backoff backoff;
+				while( true )
+					{
+						readers.fetch_add( 1u, std::memory_order_seq_cst );
+						if( !m_writer.load( std::memory_order_seq_cst ) )
+							return;
+
+						// There is a writer. Step back and wait for it.
+						readers.fetch_sub( 1u, std::memory_order_relaxed );
+						while( m_writer.load( std::memory_order_relaxed ) )
+							backoff();
+					}
+			}
+
+		//! Unlock object locked in shared mode.
+		inline void
+		unlock_shared()
+			{
+				current_thread_slot().fetch_sub( 1u, std::memory_order_release );
+			}
+
+		//! Lock object in exclusive mode.
+		inline void
+		lock()
+			{
+				Backoff backoff;
+
+				bool expected = false;
+				while( !m_writer.compare_exchange_weak(
+						expected, true,
+						std::memory_order_seq_cst,
+						std::memory_order_relaxed ) )
+					{
+						expected = false;
+						backoff();
+					}
+
+				for( auto & s : m_slots )
+					{
+						Backoff readers_backoff;
+						while( 0u != s.m_readers.load( std::memory_order_seq_cst ) )
+							readers_backoff();
+					}
+			}
+
+		//! Unlock object locked in exclusive mode.
+		inline void
+		unlock()
+			{
+				m_writer.store( false, std::memory_order_release );
+			}
+	};
+
+//
+// default_rw_spinlock_t
+//
+/*!
+ * \brief Type of multi-readers/single-writer spinlock used by SObjectizer.
+ *
+ * rw_spinlock_t with pause_backoff_t is used by default.
+ * distributed_rw_spinlock_t is used if symbol
+ * SO_5_USE_DISTRIBUTED_RW_SPINLOCK is defined.
+ *
+ * \attention The same symbol must be defined for compilation of
+ * SObjectizer and for compilation of all code which uses it.
+ */
+#if defined( SO_5_USE_DISTRIBUTED_RW_SPINLOCK )
+typedef distributed_rw_spinlock_t< pause_backoff_t > default_rw_spinlock_t;
+#else
+typedef rw_spinlock_t< pause_backoff_t > default_rw_spinlock_t;
+#endif
 
 //
 // read_lock_guard_t
@@ -303,6 +303,56 @@ SO_5_FUNC timer_thread_unique_ptr_t
 create_timer_list_thread(
 	//! A logger for handling error messages inside timer_thread.
 	error_logger_shptr_t logger );
+
+/*!
+ * \brief Create timer thread based on hierarchical timer_wheel mechanism.
+ *
+ * This kind of timer thread is intended for big amount of timers
+ * with very different pauses (from milliseconds to hours).
+ *
+ * \note Default parameters will be used for timer thread.
+ *
+ * \since
+ * v.5.5.23
+ */
+SO_5_FUNC timer_thread_unique_ptr_t
+create_timer_hierarchical_wheel_thread(
+	//! A logger for handling error messages inside timer_thread.
+	error_logger_shptr_t logger );
+
+/*!
+ * \brief Create timer thread based on hierarchical timer_wheel mechanism.
+ * \note Parameters must be specified explicitely.
+ *
+ * \since
+ * v.5.5.23
+ */
+SO_5_FUNC timer_thread_unique_ptr_t
+create_timer_hierarchical_wheel_thread(
+	//! A logger for handling error messages inside timer_thread.
+	error_logger_shptr_t logger,
+	//! A size of one time step for the lowest level of the wheel.
+	std::chrono::steady_clock::duration granularity );
+
+/*!
+ * \brief Create timer thread which is driven by Linux timerfd.
+ *
+ * Timers are stored in a heap, so there is no time step granularity.
+ * The thread sleeps on a timerfd armed by the absolute deadline of the
+ * nearest timer (CLOCK_MONOTONIC) and on an eventfd which is signaled
+ * when an earlier timer is added. The timer slack of the thread is
+ * reduced to the minimal value.
+ *
+ * \note This kind of timer thread is available on Linux only. The
+ * ordinary timer_heap thread is created on other platforms.
+ *
+ * \since
+ * v.5.5.23
+ */
+SO_5_FUNC timer_thread_unique_ptr_t
+create_timer_timerfd_thread(
+	//! A logger for handling error messages inside timer_thread.
+	error_logger_shptr_t logger );
 /*!
  * \}
  */
@@ -397,10 +447,149 @@ timer_list_factory()
 	{
 		return &create_timer_list_thread;
 	}
+
+/*!
+ * \brief Factory for hierarchical timer_wheel thread with default parameters.
+ *
+ * \since
+ * v.5.5.23
+ */
+inline timer_thread_factory_t
+timer_hierarchical_wheel_factory()
+	{
+		// Use this trick because create_timer_hierarchical_wheel_thread
+		// is overloaded.
+		timer_thread_unique_ptr_t (*f)( error_logger_shptr_t ) =
+				create_timer_hierarchical_wheel_thread;
+		return f;
+	}
+
+/*!
+ * \brief Factory for hierarchical timer_wheel thread with explicitely
+ * specified parameters.
+ *
+ * \since
+ * v.5.5.23
+ */
+inline timer_thread_factory_t
+timer_hierarchical_wheel_factory(
+	//! A size of one time step for the lowest level of the wheel.
+	std::chrono::steady_clock::duration granularity )
+	{
+		// Use this trick because create_timer_hierarchical_wheel_thread
+		// is overloaded.
+		timer_thread_unique_ptr_t (*f)(
+						error_logger_shptr_t,
+						std::chrono::steady_clock::duration ) =
+				create_timer_hierarchical_wheel_thread;
+
+		using namespace std::placeholders;
+
+		return std::bind( f, _1, granularity );
+	}
+
+/*!
+ * \brief Factory for timerfd-based timer thread.
+ *
+ * \see create_timer_timerfd_thread().
+ *
+ * \since
+ * v.5.5.23
+ */
+inline timer_thread_factory_t
+timer_timerfd_factory()
+	{
+		return &create_timer_timerfd_thread;
+	}
 /*!
  * \}
  */
 
+//
+// timer_shard_selector_t
+//
+/*!
+ * \brief A way of selection of shard for a new timer in sharded
+ * timer thread.
+ *
+ * \since
+ * v.5.5.23
+ */
+enum class timer_shard_selector_t
+	{
+		//! Shard is selected by ID of the target mbox.
+		/*!
+		 * All timers for the same mbox are handled by the same shard.
+		 */
+		by_mbox,
+		//! Shard is selected by the thread which schedules a timer.
+		/*!
+		 * Threads are distributed between shards in round-robin manner.
+		 * A thread always uses the same shard.
+		 */
+		by_calling_thread
+	};
+
+/*!
+ * \brief Create timer thread which consists of several independent
+ * timer threads.
+ *
+ * Every shard has its own thread and its own lock. A shard for every new
+ * timer is selected by \a selector. Releasing of a timer is handled
+ * by the shard which has created it.
+ *
+ * Statistics for sharded timer thread is the sum of statistics of
+ * all shards.
+ *
+ * \throw so_5::exception_t if \a shards_count is zero.
+ *
+ * \since
+ * v.5.5.23
+ */
+SO_5_FUNC timer_thread_unique_ptr_t
+create_sharded_timer_thread(
+	//! A logger for handling error messages inside timer_thread.
+	error_logger_shptr_t logger,
+	//! Count of shards.
+	std::size_t shards_count,
+	//! A way of selection of shard for new timers.
+	timer_shard_selector_t selector,
+	//! A factory for every shard.
+	//! If empty then the default timer thread factory is used.
+	const timer_thread_factory_t & shard_factory );
+
+/*!
+ * \brief Factory for sharded timer thread.
+ *
+ * Usage example:
+ * \code
+ * so_5::launch( ...,
+ * 	[]( so_5::environment_params_t & params ) {
+ * 		params.timer_thread( so_5::timer_sharded_factory( 4,
+ * 				so_5::timer_shard_selector_t::by_mbox,
+ * 				so_5::timer_hierarchical_wheel_factory() ) );
+ * 	} );
+ * \endcode
+ *
+ * \since
+ * v.5.5.23
+ */
+inline timer_thread_factory_t
+timer_sharded_factory(
+	//! Count of shards.
+	std::size_t shards_count,
+	//! A way of selection of shard for new timers.
+	timer_shard_selector_t selector = timer_shard_selector_t::by_mbox,
+	//! A factory for every shard.
+	//! If empty then the default timer thread factory is used.
+	timer_thread_factory_t shard_factory = timer_thread_factory_t() )
+	{
+		using namespace std::placeholders;
+
+		return std::bind( &create_sharded_timer_thread,
+				_1, shards_count, selector, std::move(shard_factory) );
+	}
+
 //
 // timer_manager_t
 //
@@ -637,6 +826,38 @@ create_timer_list_manager(
 	//! A collector for elapsed timers.
 	outliving_reference_t< timer_manager_t::elapsed_timers_collector_t >
 		collector );
+
+/*!
+ * \brief Create timer manager based on hierarchical timer_wheel mechanism.
+ * \note Default parameters will be used for timer manager.
+ *
+ * \since
+ * v.5.5.23
+ */
+SO_5_FUNC timer_manager_unique_ptr_t
+create_timer_hierarchical_wheel_manager(
+	//! A logger for handling error messages inside timer_manager.
+	error_logger_shptr_t logger,
+	//! A collector for elapsed timers.
+	outliving_reference_t< timer_manager_t::elapsed_timers_collector_t >
+		collector );
+
+/*!
+ * \brief Create timer manager based on hierarchical timer_wheel mechanism.
+ * \note Parameters must be specified explicitely.
+ *
+ * \since
+ * v.5.5.23
+ */
+SO_5_FUNC timer_manager_unique_ptr_t
+create_timer_hierarchical_wheel_manager(
+	//! A logger for handling error messages inside timer_manager.
+	error_logger_shptr_t logger,
+	//! A collector for elapsed timers.
+	outliving_reference_t< timer_manager_t::elapsed_timers_collector_t >
+		collector,
+	//! A size of one time step for the lowest level of the wheel.
+	std::chrono::steady_clock::duration granularity );
 /*!
  * \}
  */
@@ -744,6 +965,52 @@ timer_list_manager_factory()
 	{
 		return &create_timer_list_manager;
 	}
+
+/*!
+ * \brief Factory for hierarchical timer_wheel manager with default
+ * parameters.
+ *
+ * \since
+ * v.5.5.23
+ */
+inline timer_manager_factory_t
+timer_hierarchical_wheel_manager_factory()
+	{
+		// Use this trick because create_timer_hierarchical_wheel_manager
+		// is overloaded.
+		timer_manager_unique_ptr_t (*f)(
+						error_logger_shptr_t,
+						outliving_reference_t<
+								timer_manager_t::elapsed_timers_collector_t > ) =
+				create_timer_hierarchical_wheel_manager;
+		return f;
+	}
+
+/*!
+ * \brief Factory for hierarchical timer_wheel manager with explicitely
+ * specified parameters.
+ *
+ * \since
+ * v.5.5.23
+ */
+inline timer_manager_factory_t
+timer_hierarchical_wheel_manager_factory(
+	//! A size of one time step for the lowest level of the wheel.
+	std::chrono::steady_clock::duration granularity )
+	{
+		// Use this trick because create_timer_hierarchical_wheel_manager
+		// is overloaded.
+		timer_manager_unique_ptr_t (*f)(
+						error_logger_shptr_t,
+						outliving_reference_t<
+								timer_manager_t::elapsed_timers_collector_t >,
+						std::chrono::steady_clock::duration ) =
+				create_timer_hierarchical_wheel_manager;
+
+		using namespace std::placeholders;
+
+		return std::bind( f, _1, _2, granularity );
+	}
 /*!
  * \}
  */
@@ -48,6 +48,7 @@ class Prj < MxxRu::Cpp::LibOrDllTarget
 		sources_root( 'rt' ) {
 
 			cpp_source 'message.cpp'
+			cpp_source 'message_type_id.cpp'
 
 			cpp_source 'message_limit.cpp'
 
@@ -83,10 +84,12 @@ class Prj < MxxRu::Cpp::LibOrDllTarget
 				cpp_source 'subscr_storage_vector_based.cpp'
 				cpp_source 'subscr_storage_map_based.cpp'
 				cpp_source 'subscr_storage_hash_table_based.cpp'
+				cpp_source 'subscr_storage_flat_hash_based.cpp'
 				cpp_source 'subscr_storage_adaptive.cpp'
 
 				cpp_source 'process_unhandled_exception.cpp'
 
+				cpp_source 'hazard_pointers.cpp'
 				cpp_source 'named_local_mbox.cpp'
 				cpp_source 'mbox_core.cpp'
 
@@ -117,6 +120,10 @@ class Prj < MxxRu::Cpp::LibOrDllTarget
 		}
 
 		sources_root( 'disp' ) {
+			sources_root( 'reuse' ) {
+				cpp_source 'thread_placement.cpp'
+			}
+
 			sources_root( 'mpsc_queue_traits' ) {
 				cpp_source 'pub.cpp'
 			}
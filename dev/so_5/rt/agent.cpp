@@ -14,6 +14,7 @@
 #include <so_5/rt/impl/h/message_limit_internals.hpp>
 #include <so_5/rt/impl/h/delivery_filter_storage.hpp>
 #include <so_5/rt/impl/h/msg_tracing_helpers.hpp>
+#include <so_5/rt/impl/h/hazard_pointers.hpp>
 
 #include <so_5/details/h/abort_on_fatal_error.hpp>
 
@@ -22,8 +23,10 @@
 #include <so_5/h/stdcpp.hpp>
 
 #include <algorithm>
+#include <array>
 #include <sstream>
 #include <cstdlib>
+#include <cstdint>
 
 namespace so_5
 {
@@ -494,6 +497,7 @@ agent_t::agent_t(
 				&agent_t::handler_finder_msg_tracing_disabled )
 	,	m_subscriptions(
 			ctx.options().query_subscription_storage_factory()( self_ptr() ) )
+	,	m_handler_cache()
 	,	m_message_limits(
 			message_limit::impl::info_storage_t::create_if_necessary(
 				ctx.options().giveout_message_limits() ) )
@@ -694,8 +698,6 @@ void
 agent_t::so_bind_to_dispatcher(
 	event_queue_t & queue )
 {
-	std::lock_guard< default_rw_spinlock_t > queue_lock{ m_event_queue_lock };
-
 	// Cooperation usage counter should be incremented.
 	// It will be decremented during final agent event execution.
 	coop_t::increment_usage_count( *m_agent_coop );
@@ -712,7 +714,7 @@ agent_t::so_bind_to_dispatcher(
 							&agent_t::demand_handler_on_start ) );
 			
 			// Only then pointer to the queue could be stored.
-			m_event_queue = &queue;
+			m_event_queue.store( &queue, std::memory_order_seq_cst );
 		} );
 }
 
@@ -810,8 +812,6 @@ agent_t::bind_to_coop( coop_t & coop )
 void
 agent_t::shutdown_agent() SO_5_NOEXCEPT
 {
-	std::lock_guard< default_rw_spinlock_t > queue_lock{ m_event_queue_lock };
-
 	// Since v.5.5.8 shutdown is done by two simple step:
 	// - remove actual value from m_event_queue;
 	// - pushing final demand to actual event queue.
@@ -819,11 +819,23 @@ agent_t::shutdown_agent() SO_5_NOEXCEPT
 	// No new demands will be sent to the agent, but all the subscriptions
 	// remains. They will be destroyed at the very end of agent's lifetime.
 
-	if( m_event_queue )
+	event_queue_t * queue = nullptr;
+	{
+		// This lock is necessary for pushers which have no hazard pointers.
+		std::lock_guard< default_spinlock_t > queue_lock{ m_event_queue_lock };
+		queue = m_event_queue.exchange( nullptr, std::memory_order_seq_cst );
+	}
+
+	if( queue )
 	{
+		// Pushers which have read the old value of m_event_queue
+		// must finish their work before the final demand.
+		while( impl::hazard_pointers::is_protected( &m_event_queue ) )
+			std::this_thread::yield();
+
 		// Final event must be pushed to queue.
 		so_5::details::invoke_noexcept_code( [&] {
-				m_event_queue->push(
+				queue->push(
 						execution_demand_t(
 								this,
 								message_limit::control_block_t::none(),
@@ -832,9 +844,6 @@ agent_t::shutdown_agent() SO_5_NOEXCEPT
 								message_ref_t(),
 								&agent_t::demand_handler_on_finish ) );
 			} );
-
-		// No more events will be stored to the queue.
-		m_event_queue = nullptr;
 	}
 	else
 		so_5::details::abort_on_fatal_error( [&] {
@@ -862,6 +871,7 @@ agent_t::so_create_event_subscription(
 
 	ensure_operation_is_on_working_thread( "so_create_event_subscription" );
 
+	drop_handler_cache();
 	m_subscriptions->create_event_subscription(
 			mbox_ref,
 			msg_type,
@@ -880,6 +890,7 @@ agent_t::so_create_deadletter_subscription(
 {
 	ensure_operation_is_on_working_thread( "so_create_deadletter_subscription" );
 
+	drop_handler_cache();
 	m_subscriptions->create_event_subscription(
 			mbox,
 			msg_type,
@@ -900,6 +911,7 @@ agent_t::so_destroy_deadletter_subscription(
 
 	ensure_operation_is_on_working_thread( "do_drop_deadletter_handler" );
 
+	drop_handler_cache();
 	m_subscriptions->drop_subscription( mbox, msg_type, deadletter_state );
 }
 
@@ -935,6 +947,7 @@ agent_t::do_drop_subscription(
 
 	ensure_operation_is_on_working_thread( "do_drop_subscription" );
 
+	drop_handler_cache();
 	m_subscriptions->drop_subscription( mbox, msg_type, target_state );
 }
 
@@ -950,6 +963,7 @@ agent_t::do_drop_subscription_for_all_states(
 	ensure_operation_is_on_working_thread(
 			"do_drop_subscription_for_all_states" );
 
+	drop_handler_cache();
 	m_subscriptions->drop_subscription_for_all_states( mbox, msg_type );
 }
 
@@ -960,7 +974,7 @@ agent_t::do_check_subscription_presence(
 	const state_t & target_state ) const SO_5_NOEXCEPT
 {
 	return nullptr != m_subscriptions->find_handler(
-			mbox->id(), msg_type, target_state );
+			mbox->id(), message_type_id( msg_type ), target_state );
 }
 
 bool
@@ -969,7 +983,33 @@ agent_t::do_check_deadletter_presence(
 	const std::type_index & msg_type ) const SO_5_NOEXCEPT
 {
 	return nullptr != m_subscriptions->find_handler(
-			mbox->id(), msg_type, deadletter_state );
+			mbox->id(), message_type_id( msg_type ), deadletter_state );
+}
+
+template< typename Pusher >
+void
+agent_t::push_to_event_queue( Pusher && pusher )
+{
+	impl::hazard_pointers::guard_t guard;
+	if( guard.acquired() )
+	{
+		// The address of m_event_queue must be protected before reading
+		// of m_event_queue. shutdown_agent() will wait while it is protected.
+		guard.protect_raw( &m_event_queue );
+
+		auto queue = m_event_queue.load( std::memory_order_seq_cst );
+		if( queue )
+			pusher( *queue );
+	}
+	else
+	{
+		// There is no free hazard pointer. Slow path must be used.
+		std::lock_guard< default_spinlock_t > queue_lock{ m_event_queue_lock };
+
+		auto queue = m_event_queue.load( std::memory_order_acquire );
+		if( queue )
+			pusher( *queue );
+	}
 }
 
 void
@@ -979,17 +1019,50 @@ agent_t::push_event(
 	std::type_index msg_type,
 	const message_ref_t & message )
 {
-	read_lock_guard_t< default_rw_spinlock_t > queue_lock{ m_event_queue_lock };
+	push_to_event_queue( [&]( event_queue_t & queue ) {
+			queue.push(
+					execution_demand_t(
+						this,
+						limit,
+						mbox_id,
+						msg_type,
+						message,
+						&agent_t::demand_handler_on_message ) );
+		} );
+}
+
+void
+agent_t::push_event_batch(
+	const message_limit::control_block_t * limit,
+	mbox_id_t mbox_id,
+	std::type_index msg_type,
+	const message_ref_t * messages,
+	std::size_t count )
+{
+	// Demands are prepared on the stack. It is why the count of
+	// demands passed to the queue at once is limited.
+	const std::size_t chunk_size = 16u;
+	std::array< execution_demand_t, chunk_size > demands;
 
-	if( m_event_queue )
-		m_event_queue->push(
-				execution_demand_t(
-					this,
-					limit,
-					mbox_id,
-					msg_type,
-					message,
-					&agent_t::demand_handler_on_message ) );
+	push_to_event_queue( [&]( event_queue_t & queue ) {
+			while( count )
+			{
+				const auto n = std::min( count, chunk_size );
+				for( std::size_t i = 0; i != n; ++i )
+					demands[ i ] = execution_demand_t(
+							this,
+							limit,
+							mbox_id,
+							msg_type,
+							messages[ i ],
+							&agent_t::demand_handler_on_message );
+
+				queue.push_batch( demands.data(), n );
+
+				messages += n;
+				count -= n;
+			}
+		} );
 }
 
 void
@@ -999,17 +1072,16 @@ agent_t::push_service_request(
 	std::type_index msg_type,
 	const message_ref_t & message )
 {
-	read_lock_guard_t< default_rw_spinlock_t > queue_lock{ m_event_queue_lock };
-
-	if( m_event_queue )
-		m_event_queue->push(
-				execution_demand_t(
-						this,
-						limit,
-						mbox_id,
-						msg_type,
-						message,
-						&agent_t::service_request_handler_on_message ) );
+	push_to_event_queue( [&]( event_queue_t & queue ) {
+			queue.push(
+					execution_demand_t(
+							this,
+							limit,
+							mbox_id,
+							msg_type,
+							message,
+							&agent_t::service_request_handler_on_message ) );
+		} );
 }
 
 void
@@ -1092,8 +1164,7 @@ agent_t::demand_handler_on_message(
 {
 	message_limit::control_block_t::decrement( d.m_limit );
 
-	auto handler = d.m_receiver->m_handler_finder(
-			d, "demand_handler_on_message" );
+	auto handler = find_handler_via_cache( d, "demand_handler_on_message" );
 	if( handler )
 		process_message( working_thread_id, d, handler->m_method );
 }
@@ -1295,6 +1366,50 @@ agent_t::handler_finder_msg_tracing_enabled(
 	return search_result;
 }
 
+const impl::event_handler_data_t *
+agent_t::find_handler_via_cache(
+	execution_demand_t & d,
+	const char * context_marker )
+{
+	auto & agent = *(d.m_receiver);
+
+	// Results of lookups can't be cached if message delivery tracing
+	// is enabled: every lookup must be traced.
+	if( &agent_t::handler_finder_msg_tracing_disabled !=
+			agent.m_handler_finder )
+		return agent.m_handler_finder( d, context_marker );
+
+	const state_t * current_state = agent.m_current_state_ptr;
+
+	const auto h = static_cast< std::size_t >( d.m_mbox_id ) * 31u +
+			d.m_msg_type_id * 17u +
+			( reinterpret_cast< std::uintptr_t >( current_state ) >> 4 );
+	auto & item = agent.m_handler_cache[ h & ( handler_cache_size - 1u ) ];
+
+	if( item.m_state == current_state &&
+			item.m_mbox_id == d.m_mbox_id &&
+			item.m_msg_type_id == d.m_msg_type_id )
+		return item.m_handler;
+
+	// The search includes lookups in parent states and
+	// in the deadletter state.
+	auto handler = handler_finder_msg_tracing_disabled( d, context_marker );
+
+	item.m_mbox_id = d.m_mbox_id;
+	item.m_msg_type_id = d.m_msg_type_id;
+	item.m_state = current_state;
+	item.m_handler = handler;
+
+	return handler;
+}
+
+void
+agent_t::drop_handler_cache() SO_5_NOEXCEPT
+{
+	for( auto & item : m_handler_cache )
+		item.m_state = nullptr;
+}
+
 const impl::event_handler_data_t *
 agent_t::find_event_handler_for_current_state(
 	execution_demand_t & d )
@@ -1305,7 +1420,7 @@ agent_t::find_event_handler_for_current_state(
 	do {
 		search_result = d.m_receiver->m_subscriptions->find_handler(
 				d.m_mbox_id,
-				d.m_msg_type, 
+				d.m_msg_type_id,
 				*s );
 
 		if( !search_result )
@@ -1322,7 +1437,7 @@ agent_t::find_deadletter_handler(
 {
 	return demand.m_receiver->m_subscriptions->find_handler(
 			demand.m_mbox_id,
-			demand.m_msg_type,
+			demand.m_msg_type_id,
 			deadletter_state );
 }
 
@@ -386,6 +386,20 @@ environment_t::create_mbox(
 	return m_impl->m_mbox_core->create_mbox( std::move(nonempty_name) );
 }
 
+mbox_t
+environment_t::create_snapshot_mbox()
+{
+	return m_impl->m_mbox_core->create_snapshot_mbox();
+}
+
+mbox_t
+environment_t::create_snapshot_mbox(
+	nonempty_name_t nonempty_name )
+{
+	return m_impl->m_mbox_core->create_snapshot_mbox(
+			std::move(nonempty_name) );
+}
+
 mchain_t
 environment_t::create_mchain(
 	const mchain_params_t & params )
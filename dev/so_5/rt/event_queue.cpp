@@ -23,5 +23,14 @@ event_queue_t::~event_queue_t()
 	{
 	}
 
+void
+event_queue_t::push_batch(
+	execution_demand_t * demands,
+	std::size_t count )
+	{
+		for( std::size_t i = 0; i != count; ++i )
+			push( std::move( demands[ i ] ) );
+	}
+
 } /* namespace so_5 */
 
@@ -1178,6 +1178,26 @@ class SO_5_TYPE agent_t
 			agent.push_event( limit, mbox_id, msg_type, message );
 		}
 
+		//! Push several events to the agent's event queue at once.
+		/*!
+			This method is used by SObjectizer for delivery of
+			a series of messages of the same type from one mbox.
+
+			\since
+			v.5.5.23
+		*/
+		static inline void
+		call_push_event_batch(
+			agent_t & agent,
+			const message_limit::control_block_t * limit,
+			mbox_id_t mbox_id,
+			std::type_index msg_type,
+			const message_ref_t * messages,
+			std::size_t count )
+		{
+			agent.push_event_batch( limit, mbox_id, msg_type, messages, count );
+		}
+
 		/*!
 		 * \since
 		 * v.5.3.0
@@ -2605,6 +2625,47 @@ class SO_5_TYPE agent_t
 		 */
 		impl::subscription_storage_unique_ptr_t m_subscriptions;
 
+		/*!
+		 * \since
+		 * v.5.5.23
+		 *
+		 * \brief An item of the cache of recent handler lookups.
+		 *
+		 * \note Item is empty if m_state is nullptr. A null m_handler
+		 * means that there is no handler for that key.
+		 */
+		struct handler_cache_item_t
+			{
+				mbox_id_t m_mbox_id;
+				message_type_id_t m_msg_type_id;
+				const state_t * m_state;
+				const impl::event_handler_data_t * m_handler;
+			};
+
+		/*!
+		 * \since
+		 * v.5.5.23
+		 *
+		 * \brief Size of the cache of recent handler lookups.
+		 *
+		 * \note Must be a power of 2.
+		 */
+		static const std::size_t handler_cache_size = 4u;
+
+		/*!
+		 * \since
+		 * v.5.5.23
+		 *
+		 * \brief Direct-mapped cache of recent handler lookups.
+		 *
+		 * The current state is a part of the key, so the cache is not
+		 * dropped on state change. But it is dropped on every change
+		 * of subscriptions.
+		 *
+		 * \note It is used only when message delivery tracing is disabled.
+		 */
+		handler_cache_item_t m_handler_cache[ handler_cache_size ];
+
 		/*!
 		 * \since
 		 * v.5.5.4
@@ -2638,16 +2699,17 @@ class SO_5_TYPE agent_t
 		 * nullptr in m_event_queue means that methods push_event() and
 		 * push_service_request() will throw away any new demand.
 		 *
-		 * It is necessary to provide guarantee that m_event_queue will
-		 * be reset to nullptr in shutdown_agent() only if there is no
-		 * working push_event()/push_service_request() methods. To do than
-		 * default_rw_spinlock_t is used. Methods push_event() and
-		 * push_service_request() acquire it in read-mode and shutdown_agent()
-		 * acquires it in write-mode. It means that shutdown_agent() cannot
-		 * get access to m_event_queue until there is working
-		 * push_event()/push_service_request().
+		 * Since v.5.5.23 methods push_event() and push_service_request()
+		 * do not acquire this lock. They protect the address of
+		 * m_event_queue by a hazard pointer and then read m_event_queue.
+		 * shutdown_agent() resets m_event_queue and waits while that
+		 * address is protected. So the final demand is always the last
+		 * one in the queue.
+		 *
+		 * The lock is acquired by push_event() and push_service_request()
+		 * only if there is no free hazard pointer for the current thread.
 		 */
-		default_rw_spinlock_t	m_event_queue_lock;
+		default_spinlock_t m_event_queue_lock;
 
 		/*!
 		 * \since
@@ -2661,9 +2723,9 @@ class SO_5_TYPE agent_t
 		 * After shutdown it is set to nullptr.
 		 *
 		 * \attention Access to m_event_queue value must be done only
-		 * under acquired m_event_queue_lock.
+		 * via push_to_event_queue().
 		 */
-		event_queue_t * m_event_queue;
+		std::atomic< event_queue_t * > m_event_queue;
 
 		/*!
 		 * \since
@@ -2841,6 +2903,29 @@ class SO_5_TYPE agent_t
 			//! Event message.
 			const message_ref_t & message );
 
+		/*!
+		 * \brief Push several events into the event queue at once.
+		 *
+		 * Agent's event queue is acquired only once and all events
+		 * are passed to event_queue_t::push_batch() by chunks of
+		 * fixed size.
+		 *
+		 * \since
+		 * v.5.5.23
+		 */
+		void
+		push_event_batch(
+			//! Optional message limit.
+			const message_limit::control_block_t * limit,
+			//! ID of mbox for these events.
+			mbox_id_t mbox_id,
+			//! Message type for events.
+			std::type_index msg_type,
+			//! Event messages.
+			const message_ref_t * messages,
+			//! Count of items in \a messages.
+			std::size_t count );
+
 		/*!
 		 * \since
 		 * v.5.3.0
@@ -3070,6 +3155,47 @@ class SO_5_TYPE agent_t
 			execution_demand_t & demand,
 			const char * context_marker );
 
+		/*!
+		 * \since
+		 * v.5.5.23
+		 *
+		 * \brief Handler search with the usage of the cache of recent
+		 * handler lookups.
+		 *
+		 * Calls m_handler_finder on a cache miss.
+		 *
+		 * \attention Must be called only on the agent's working thread.
+		 */
+		/*!
+		 * \since
+		 * v.5.5.23
+		 *
+		 * \brief Safe access to the event queue for pushing new demands.
+		 *
+		 * Calls \a pusher with a reference to the event queue if the agent
+		 * is bound to the queue and is not shut down yet.
+		 *
+		 * \note It is a template method, but it is used only in agent.cpp.
+		 * So it is defined there.
+		 */
+		template< typename Pusher >
+		void
+		push_to_event_queue( Pusher && pusher );
+
+		static const impl::event_handler_data_t *
+		find_handler_via_cache(
+			execution_demand_t & demand,
+			const char * context_marker );
+
+		/*!
+		 * \since
+		 * v.5.5.23
+		 *
+		 * \brief Drop the content of the cache of recent handler lookups.
+		 */
+		void
+		drop_handler_cache() SO_5_NOEXCEPT;
+
 		/*!
 		 * \since
 		 * v.5.5.15
@@ -748,6 +748,51 @@ class SO_5_TYPE environment_t
 			//! Mbox name.
 			nonempty_name_t mbox_name );
 
+		/*!
+		 * \brief Create an anonymous MPMC mbox with lock-free delivery.
+		 *
+		 * This mbox works just like mbox created by create_mbox().
+		 * But message delivery doesn't acquire any locks: subscribers
+		 * are stored in an immutable snapshot which is replaced on
+		 * every subscription change. It makes delivery cheaper for mboxes
+		 * with many concurrent senders and rare subscription changes.
+		 * But every change of subscriptions (including delivery
+		 * filters) becomes more expensive: it copies the list of
+		 * subscribers and waits for completion of deliveries
+		 * which are in progress.
+		 *
+		 * \note Always creates a new mbox.
+		 *
+		 * \par Usage sample:
+		 * \code
+			auto broadcast = env.create_snapshot_mbox();
+			...
+			so_5::send< price_changed >( broadcast, ... );
+		 * \endcode
+		 *
+		 * \since
+		 * v.5.5.23
+		 */
+		mbox_t
+		create_snapshot_mbox();
+
+		/*!
+		 * \brief Create a named MPMC mbox with lock-free delivery.
+		 *
+		 * \note If there already is a named mbox with the same name
+		 * then a reference to that mbox will be returned (regardless
+		 * of the type of that mbox).
+		 *
+		 * \see create_snapshot_mbox().
+		 *
+		 * \since
+		 * v.5.5.23
+		 */
+		mbox_t
+		create_snapshot_mbox(
+			//! Mbox name.
+			nonempty_name_t mbox_name );
+
 		/*!
 		 * \deprecated Will be removed in v.5.6.0. Use create_mbox() instead.
 		 */
@@ -14,6 +14,8 @@
 
 #include <so_5/rt/h/execution_demand.hpp>
 
+#include <cstddef>
+
 namespace so_5
 {
 
@@ -38,6 +40,27 @@ class SO_5_TYPE event_queue_t
 		//! Enqueue new event to the queue.
 		virtual void
 		push( execution_demand_t demand ) = 0;
+
+		/*!
+		 * \brief Enqueue several events to the queue at once.
+		 *
+		 * Demands are moved from \a demands array. The order of
+		 * demands is preserved.
+		 *
+		 * Default implementation simply calls push() for every demand.
+		 * Event queues of standard dispatchers redefine this method
+		 * to append all demands under one lock and to wake up the
+		 * consumer only once.
+		 *
+		 * \since
+		 * v.5.5.23
+		 */
+		virtual void
+		push_batch(
+			//! Demands to be stored.
+			execution_demand_t * demands,
+			//! Count of demands in \a demands.
+			std::size_t count );
 	};
 
 namespace rt
@@ -18,6 +18,7 @@
 #include <so_5/rt/h/fwd.hpp>
 
 #include <so_5/rt/h/message.hpp>
+#include <so_5/rt/h/message_type_id.hpp>
 
 namespace so_5
 {
@@ -68,6 +69,16 @@ struct execution_demand_t
 	mbox_id_t m_mbox_id;
 	//! Type of the message.
 	std::type_index m_msg_type;
+	/*!
+	 * \brief Identifier of the message type.
+	 *
+	 * It is used for lookups in subscription storages instead of
+	 * m_msg_type because comparison and hashing of integers is cheaper.
+	 *
+	 * \since
+	 * v.5.5.23
+	 */
+	message_type_id_t m_msg_type_id;
 	//! Event incident.
 	message_ref_t m_message_ref;
 	//! Demand handler.
@@ -79,6 +90,7 @@ struct execution_demand_t
 		,	m_limit( nullptr )
 		,	m_mbox_id( 0 )
 		,	m_msg_type( typeid(void) )
+		,	m_msg_type_id( null_message_type_id() )
 		,	m_demand_handler( nullptr )
 		{}
 
@@ -93,6 +105,7 @@ struct execution_demand_t
 		,	m_limit( limit )
 		,	m_mbox_id( mbox_id )
 		,	m_msg_type( msg_type )
+		,	m_msg_type_id( message_type_id( msg_type ) )
 		,	m_message_ref( std::move( message_ref ) )
 		,	m_demand_handler( demand_handler )
 		{}
@@ -826,6 +826,27 @@ class SO_5_TYPE abstract_message_box_t : protected atomic_refcounted_t
 				this->do_deliver_message( msg_type, message, 1 );
 			}
 
+		/*!
+		 * \brief Deliver several messages of the same type for all
+		 * subscribers.
+		 *
+		 * \note This is a just a wrapper for do_deliver_message_batch.
+		 *
+		 * \since
+		 * v.5.5.23
+		 */
+		inline void
+		deliver_message_batch(
+			//! Type of all messages.
+			const std::type_index & msg_type,
+			//! Messages to be delivered.
+			const message_ref_t * messages,
+			//! Count of items in \a messages.
+			std::size_t count ) const
+			{
+				this->do_deliver_message_batch( msg_type, messages, count, 1 );
+			}
+
 		/*!
 		 * \since
 		 * v.5.3.0.
@@ -912,6 +933,30 @@ class SO_5_TYPE abstract_message_box_t : protected atomic_refcounted_t
 			//! Current deep of overlimit reaction recursion.
 			unsigned int overlimit_reaction_deep ) const = 0;
 
+		/*!
+		 * \brief Deliver several messages of the same type for all
+		 * subscribers with respect to message limits.
+		 *
+		 * Messages are delivered in the order of \a messages array.
+		 * The default implementation simply calls do_deliver_message()
+		 * for every message. Standard mboxes redefine this method to
+		 * pass the whole series to a subscriber's event queue by one
+		 * event_queue_t::push_batch() call.
+		 *
+		 * \since
+		 * v.5.5.23
+		 */
+		virtual void
+		do_deliver_message_batch(
+			//! Type of all messages.
+			const std::type_index & msg_type,
+			//! Messages to be delivered.
+			const message_ref_t * messages,
+			//! Count of items in \a messages.
+			std::size_t count,
+			//! Current deep of overlimit reaction recursion.
+			unsigned int overlimit_reaction_deep ) const;
+
 		/*!
 		 * \since
 		 * v.5.5.4
@@ -997,6 +1042,30 @@ class SO_5_TYPE abstract_message_box_t : protected atomic_refcounted_t
 			const std::type_index & msg_type,
 			//! A message instance to be delivered.
 			const message_ref_t & message );
+
+		/*!
+		 * \brief Special method for delivery of several messages of
+		 * the same type from a timer thread.
+		 *
+		 * It is used when several timers for the same mbox elapse at
+		 * the same time.
+		 *
+		 * The default implementation simply calls
+		 * do_deliver_message_from_timer() for every message. Standard
+		 * mboxes redefine this method to pass the whole series to
+		 * do_deliver_message_batch().
+		 *
+		 * \since
+		 * v.5.5.23
+		 */
+		virtual void
+		do_deliver_message_batch_from_timer(
+			//! Type of all messages.
+			const std::type_index & msg_type,
+			//! Messages to be delivered.
+			const message_ref_t * messages,
+			//! Count of items in \a messages.
+			std::size_t count );
 };
 
 template< class Message >
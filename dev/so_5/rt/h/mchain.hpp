@@ -19,6 +19,7 @@
 #include <so_5/details/h/invoke_noexcept_code.hpp>
 #include <so_5/details/h/remaining_time_counter.hpp>
 
+#include <array>
 #include <chrono>
 #include <functional>
 
@@ -499,6 +500,32 @@ class SO_5_TYPE abstract_message_chain_t : protected so_5::abstract_message_box_
 			//! Max time to wait on empty queue.
 			mchain_props::duration_t empty_queue_timeout ) = 0;
 
+		/*!
+		 * \brief Extraction of several demands at once.
+		 *
+		 * Waits for \a empty_queue_timeout if the chain is empty. Then
+		 * extracts no more than \a max_count demands. All demands are
+		 * extracted under one acquisition of chain's lock.
+		 *
+		 * \note There is a default implementation which extracts just one
+		 * demand via ordinary extract(). It is done to keep compatibility
+		 * with previous versions.
+		 *
+		 * \since
+		 * v.5.5.23
+		 */
+		virtual mchain_props::extraction_status_t
+		extract(
+			//! Destination for extracted messages.
+			//! Must have room for at least \a max_count items.
+			mchain_props::demand_t * dest,
+			//! Max count of demands to be extracted.
+			std::size_t max_count,
+			//! Receiver for count of extracted demands.
+			std::size_t & extracted,
+			//! Max time to wait on empty queue.
+			mchain_props::duration_t empty_queue_timeout );
+
 		//! Cast message chain to message box.
 		so_5::mbox_t
 		as_mbox();
@@ -541,6 +568,30 @@ class SO_5_TYPE abstract_message_chain_t : protected so_5::abstract_message_box_
 			//! Select case to be stored for notification if mchain is empty.
 			mchain_props::select_case_t & select_case );
 
+		/*!
+		 * \brief An extraction attempt of several demands at once as
+		 * a part of multi chain select.
+		 *
+		 * \note There is a default implementation which extracts just one
+		 * demand via extract(demand, select_case).
+		 *
+		 * \note This method is intended to be used by select_case_t.
+		 *
+		 * \since
+		 * v.5.5.23
+		 */
+		virtual mchain_props::extraction_status_t
+		extract(
+			//! Destination for extracted messages.
+			//! Must have room for at least \a max_count items.
+			mchain_props::demand_t * dest,
+			//! Max count of demands to be extracted.
+			std::size_t max_count,
+			//! Receiver for count of extracted demands.
+			std::size_t & extracted,
+			//! Select case to be stored for notification if mchain is empty.
+			mchain_props::select_case_t & select_case );
+
 		/*!
 		 * \brief Removement of mchain from multi chain select.
 		 *
@@ -647,6 +698,13 @@ class mchain_params_t
 		//! Is message delivery tracing disabled explicitly?
 		bool m_msg_tracing_disabled = { false };
 
+		//! Should a lock-free queue be used for chain's demands?
+		/*!
+		 * \since
+		 * v.5.5.23
+		 */
+		bool m_lock_free_queue = { false };
+
 	public :
 		//! Initializing constructor.
 		mchain_params_t(
@@ -709,6 +767,51 @@ class mchain_params_t
 			{
 				return m_msg_tracing_disabled;
 			}
+
+		//! Use lock-free ring buffer for chain's demands.
+		/*!
+		 * Message chain with this option stores demands in a
+		 * preallocated lock-free ring buffer. Producers and consumers
+		 * do not acquire chain's mutex while the chain is neither empty nor
+		 * full. The mutex and condition variables are used only when
+		 * a consumer has to sleep on the empty chain or a producer has
+		 * to handle an overflow.
+		 *
+		 * \attention This option can be used only for size-limited chains.
+		 * An attempt to create size-unlimited chain with this option
+		 * leads to an exception. Storage for lock-free chain is always
+		 * preallocated regardless of capacity's memory_usage value.
+		 *
+		 * \par Usage example:
+			\code
+			auto chain = env.create_mchain(
+				so_5::make_limited_without_waiting_mchain_params(
+					1024,
+					so_5::mchain_props::memory_usage_t::preallocated,
+					so_5::mchain_props::overflow_reaction_t::drop_newest )
+				.lock_free_queue() );
+			\endcode
+		 *
+		 * \since
+		 * v.5.5.23
+		 */
+		mchain_params_t &
+		lock_free_queue()
+			{
+				m_lock_free_queue = true;
+				return *this;
+			}
+
+		//! Should lock-free ring buffer be used for chain's demands?
+		/*!
+		 * \since
+		 * v.5.5.23
+		 */
+		bool
+		lock_free_queue_used() const
+			{
+				return m_lock_free_queue;
+			}
 	};
 
 /*!
@@ -1263,6 +1366,59 @@ namespace mchain_props {
 
 namespace details {
 
+//
+// bulk_extraction_buffer_size
+//
+/*!
+ * \brief Max count of demands to be extracted from a mchain at once
+ * during advanced receive and multi chain select.
+ *
+ * \since
+ * v.5.5.23
+ */
+const std::size_t bulk_extraction_buffer_size = 16u;
+
+//
+// demands_to_extract_at_once
+//
+/*!
+ * \brief Detection of count of demands which can be extracted from
+ * a mchain at once.
+ *
+ * Several demands are extracted only if it doesn't change the behaviour
+ * of advanced receive and select. It means that:
+ * - there must not be a stop-predicate (it must be checked after every
+ *   handled message);
+ * - count of extracted demands must not exceed the remaining limits
+ *   for extracted and handled messages.
+ *
+ * \since
+ * v.5.5.23
+ */
+template< typename Params >
+std::size_t
+demands_to_extract_at_once(
+	//! Parameters of receive or select operation.
+	const Params & params,
+	//! Count of already extracted messages.
+	std::size_t extracted_messages,
+	//! Count of already handled messages.
+	std::size_t handled_messages )
+	{
+		if( params.stop_on() )
+			return 1u;
+
+		std::size_t result = bulk_extraction_buffer_size;
+
+		if( params.to_extract() && extracted_messages < params.to_extract() )
+			result = (std::min)( result, params.to_extract() - extracted_messages );
+
+		if( params.to_handle() && handled_messages < params.to_handle() )
+			result = (std::min)( result, params.to_handle() - handled_messages );
+
+		return result;
+	}
+
 //
 // receive_actions_performer_t
 //
@@ -1283,6 +1439,13 @@ class receive_actions_performer_t
 		std::size_t m_handled_messages = 0;
 		extraction_status_t m_status;
 
+		//! Buffer for demands extracted at once.
+		/*!
+		 * \since
+		 * v.5.5.23
+		 */
+		std::array< demand_t, bulk_extraction_buffer_size > m_demands;
+
 	public :
 		receive_actions_performer_t(
 			const mchain_receive_params_t & params,
@@ -1294,19 +1457,35 @@ class receive_actions_performer_t
 		void
 		handle_next( duration_t empty_timeout )
 			{
-				demand_t extracted_demand;
+				// Since v.5.5.23 several demands can be extracted at once.
+				std::size_t extracted = 0u;
 				m_status = m_params.chain()->extract(
-						extracted_demand, empty_timeout );
+						m_demands.data(),
+						demands_to_extract_at_once(
+								m_params,
+								m_extracted_messages,
+								m_handled_messages ),
+						extracted,
+						empty_timeout );
 
 				if( extraction_status_t::msg_extracted == m_status )
 					{
-						++m_extracted_messages;
-						const bool handled = m_bunch.handle(
-								extracted_demand.m_msg_type,
-								extracted_demand.m_message_ref,
-								extracted_demand.m_demand_type );
-						if( handled )
-							++m_handled_messages;
+						for( std::size_t i = 0u; i != extracted; ++i )
+							{
+								auto & d = m_demands[ i ];
+
+								++m_extracted_messages;
+								const bool handled = m_bunch.handle(
+										d.m_msg_type,
+										d.m_message_ref,
+										d.m_demand_type );
+								if( handled )
+									++m_handled_messages;
+
+								// Message must not be held in the buffer until
+								// the next extraction.
+								d.m_message_ref.reset();
+							}
 					}
 				// Since v.5.5.17 we must check presence of chain-closed handler.
 				// This handler must be used if chain is closed.
@@ -1451,6 +1630,12 @@ perform_receive(
  * \attention It is an error if there are more than one handler for the
  * same message type in \a handlers.
  *
+ * \note Since v.5.5.23 several messages can be extracted from the mchain
+ * at once if there is no stop-predicate (see
+ * mchain_props::details::demands_to_extract_at_once()). If a handler throws
+ * then the rest of messages extracted together with the current one
+ * are lost.
+ *
  * \par Usage examples:
 	\code
 	so_5::mchain_t chain = env.create_mchain(...);
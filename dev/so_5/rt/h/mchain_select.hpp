@@ -380,6 +380,13 @@ class select_actions_performer_t
 		extraction_status_t m_status;
 		bool m_can_continue = { true };
 
+		//! Buffer for demands extracted at once.
+		/*!
+		 * \since
+		 * v.5.5.23
+		 */
+		std::array< demand_t, bulk_extraction_buffer_size > m_demands;
+
 	public :
 		select_actions_performer_t(
 			const mchain_select_params_t & params,
@@ -435,7 +442,14 @@ class select_actions_performer_t
 						auto * current = ready_chain;
 						ready_chain = current->giveout_next();
 
-						const auto result = current->try_receive( m_notificator );
+						// Since v.5.5.23 several messages can be extracted at once.
+						const auto result = current->try_receive(
+								m_notificator,
+								m_demands.data(),
+								demands_to_extract_at_once(
+										m_params,
+										m_extracted_messages,
+										m_handled_messages ) );
 						m_status = result.status();
 
 						if( extraction_status_t::msg_extracted == m_status )
@@ -611,6 +625,12 @@ case_(
  * \attention The behaviour is not defined if a mchain is used in different
  * select_cases.
  *
+ * \note Since v.5.5.23 several messages can be extracted from a mchain
+ * at once if there is no stop-predicate (see
+ * mchain_props::details::demands_to_extract_at_once()). If a handler throws
+ * then the rest of messages extracted together with the current one
+ * are lost.
+ *
  * \par Usage examples:
 	\code
 	using namespace so_5;
@@ -192,11 +192,37 @@ class select_case_t
 		 */
 		mchain_receive_result_t
 		try_receive( select_notificator_t & notificator )
+			{
+				demand_t demand;
+				return try_receive( notificator, &demand, 1u );
+			}
+
+		//! An attempt to extract and handle several messages from mchain.
+		/*!
+		 * All messages are extracted from mchain at once and then
+		 * handled one by one.
+		 *
+		 * \note This method returns immediately if mchain is empty.
+		 * In this case select_case object will stay in select_case queue
+		 * inside mchain.
+		 *
+		 * \since
+		 * v.5.5.23
+		 */
+		mchain_receive_result_t
+		try_receive(
+			select_notificator_t & notificator,
+			//! Buffer for extracted demands.
+			//! Must have room for at least \a max_count items.
+			demand_t * demands,
+			//! Max count of demands to be extracted.
+			std::size_t max_count )
 			{
 				m_notificator = &notificator;
 
-				demand_t demand;
-				const auto status = m_chain->extract( demand, *this );
+				std::size_t extracted = 0u;
+				const auto status = m_chain->extract(
+						demands, max_count, extracted, *this );
 				// Notificator pointer must retain its value only if
 				// there is no messages in mchain.
 				// In other cases this pointer must be dropped.
@@ -204,7 +230,20 @@ class select_case_t
 					m_notificator = nullptr;
 
 				if( extraction_status_t::msg_extracted == status )
-					return try_handle_extracted_message( demand );
+					{
+						std::size_t handled = 0u;
+						for( std::size_t i = 0u; i != extracted; ++i )
+							{
+								handled += try_handle_extracted_message(
+										demands[ i ] ).handled();
+
+								// Message must not be held in the buffer until
+								// the next extraction.
+								demands[ i ].m_message_ref.reset();
+							}
+
+						return mchain_receive_result_t{ extracted, handled, status };
+					}
 
 				return mchain_receive_result_t{ 0u, 0u, status };
 			}
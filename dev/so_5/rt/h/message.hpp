@@ -15,6 +15,7 @@
 #include <so_5/h/types.hpp>
 
 #include <so_5/rt/h/agent_ref_fwd.hpp>
+#include <so_5/rt/h/message_pool.hpp>
 
 #include <type_traits>
 #include <typeindex>
@@ -760,7 +761,15 @@ struct make_message_instance_impl
 			{
 				ensure_not_signal< Msg >();
 
-				return std::unique_ptr< E >( new E( std::forward< Args >(args)... ) );
+				using actual_type = typename std::conditional<
+							is_pooled_message<
+									typename message_payload_type< Msg >::payload_type
+								>::value,
+							pooled_envelope_t< E >,
+							E >::type;
+
+				return std::unique_ptr< E >(
+						new actual_type( std::forward< Args >(args)... ) );
 			}
 	};
 
@@ -0,0 +1,391 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \file
+ * \brief Pooling of message instances.
+ * \since
+ * v.5.5.23
+ */
+
+#pragma once
+
+#include <so_5/h/compiler_features.hpp>
+
+#include <type_traits>
+#include <mutex>
+#include <new>
+#include <cstddef>
+
+namespace so_5
+{
+
+//
+// is_pooled_message
+//
+/*!
+ * \brief A trait for enabling pooling of message instances.
+ *
+ * By default every message instance is allocated by `new` and is
+ * deallocated by `delete` when the last reference to it is gone.
+ * If this trait is specialized as std::true_type for a message type
+ * then memory blocks for instances of that type are taken from
+ * a per-type pool and are returned back to that pool.
+ *
+ * Every thread has its own cache of free blocks, so in the steady state
+ * allocation and deallocation of a message instance is just an operation
+ * with a thread-local list. Blocks are moved between thread caches and
+ * a global per-type storage by batches.
+ *
+ * It makes sense for small messages which are sent with high rate.
+ *
+ * Usage example:
+ * \code
+	struct tick
+	{
+		std::uint64_t m_instrument;
+		double m_price;
+	};
+
+	namespace so_5
+	{
+		template<>
+		struct is_pooled_message< tick > : public std::true_type {};
+	}
+
+	...
+	so_5::send< tick >( mbox, instrument, price );
+	so_5::send< so_5::mutable_msg< tick > >( mbox, instrument, price );
+ * \endcode
+ *
+ * \note The trait must be specialized for a payload type. It means that
+ * the specialization for `tick` is used for `mutable_msg<tick>` too.
+ *
+ * \attention A type derived from message_t must not be marked as final
+ * if it is a pooled message.
+ *
+ * \note Signals are not allocated at all, so this trait has no
+ * effect for them.
+ *
+ * \since
+ * v.5.5.23
+ */
+template< typename Msg >
+struct is_pooled_message : public std::false_type {};
+
+namespace details
+{
+
+namespace message_pool
+{
+
+//
+// block_list_t
+//
+/*!
+ * \brief A list of free memory blocks.
+ *
+ * The pointer to the next block is stored inside a free block itself.
+ *
+ * \note It is a literal type with trivial destructor. It allows to
+ * use it in a thread_local variable without a dynamic initialization
+ * and destruction.
+ *
+ * \since
+ * v.5.5.23
+ */
+class block_list_t
+	{
+		//! Header of a free block.
+		struct free_block_t
+			{
+				free_block_t * m_next;
+			};
+
+	public :
+		bool
+		empty() const SO_5_NOEXCEPT { return nullptr == m_head; }
+
+		std::size_t
+		size() const SO_5_NOEXCEPT { return m_size; }
+
+		void
+		push( void * block ) SO_5_NOEXCEPT
+			{
+				auto b = static_cast< free_block_t * >(block);
+				b->m_next = m_head;
+				m_head = b;
+				++m_size;
+			}
+
+		void *
+		pop() SO_5_NOEXCEPT
+			{
+				auto b = m_head;
+				m_head = b->m_next;
+				--m_size;
+				return b;
+			}
+
+		//! Move at most \a count blocks from \a from to this list.
+		void
+		take_from( block_list_t & from, std::size_t count ) SO_5_NOEXCEPT
+			{
+				for( ; count && !from.empty(); --count )
+					push( from.pop() );
+			}
+
+		//! Deallocate all blocks.
+		void
+		release_all() SO_5_NOEXCEPT
+			{
+				while( !empty() )
+					::operator delete( pop() );
+			}
+
+	private :
+		free_block_t * m_head = nullptr;
+		std::size_t m_size = 0u;
+	};
+
+//! Count of blocks to be moved between a thread cache and
+//! the global storage at once.
+const std::size_t batch_size = 32u;
+
+//! Max count of free blocks in a thread cache.
+const std::size_t max_thread_cache_size = 2u * batch_size;
+
+//! Max count of free blocks in the global storage of one type.
+const std::size_t max_global_storage_size = 64u * batch_size;
+
+//
+// global_storage_t
+//
+/*!
+ * \brief Global storage of free blocks for one type of blocks.
+ *
+ * \tparam Block type of block.
+ *
+ * \since
+ * v.5.5.23
+ */
+template< typename Block >
+class global_storage_t
+	{
+		global_storage_t() = default;
+
+	public :
+		global_storage_t( const global_storage_t & ) = delete;
+		global_storage_t &
+		operator=( const global_storage_t & ) = delete;
+
+		~global_storage_t()
+			{
+				m_blocks.release_all();
+			}
+
+		static global_storage_t &
+		instance()
+			{
+				static global_storage_t storage;
+				return storage;
+			}
+
+		//! Move a batch of blocks to \a to.
+		void
+		get_batch( block_list_t & to )
+			{
+				std::lock_guard< std::mutex > lock{ m_lock };
+				to.take_from( m_blocks, batch_size );
+			}
+
+		//! Move a batch of blocks from \a from.
+		/*!
+		 * Blocks which do not fit into the storage are deallocated.
+		 *
+		 * \note All blocks are taken if \a count is greater
+		 * than the size of \a from.
+		 */
+		void
+		put_batch( block_list_t & from, std::size_t count )
+			{
+				block_list_t extra;
+				{
+					std::lock_guard< std::mutex > lock{ m_lock };
+					const auto free_space =
+							max_global_storage_size - m_blocks.size();
+					if( count > free_space )
+						{
+							extra.take_from( from, count - free_space );
+							count = free_space;
+						}
+					m_blocks.take_from( from, count );
+				}
+
+				extra.release_all();
+			}
+
+	private :
+		std::mutex m_lock;
+		block_list_t m_blocks;
+	};
+
+//
+// thread_cache_t
+//
+/*!
+ * \brief A cache of free blocks for the current thread.
+ *
+ * \note It has trivial destructor. Its content is flushed to the global
+ * storage by thread_cache_finalizer_t. The cache is marked as finished
+ * after that and all subsequent allocations and deallocations on that
+ * thread go directly to ::operator new and ::operator delete.
+ *
+ * \since
+ * v.5.5.23
+ */
+struct thread_cache_t
+	{
+		block_list_t m_blocks;
+		bool m_finalizer_registered = false;
+		bool m_finished = false;
+	};
+
+template< typename Block >
+thread_cache_t &
+thread_cache()
+	{
+		static thread_local thread_cache_t cache;
+		return cache;
+	}
+
+//
+// thread_cache_finalizer_t
+//
+/*!
+ * \brief An object for flushing a thread cache at thread exit.
+ *
+ * \since
+ * v.5.5.23
+ */
+template< typename Block >
+struct thread_cache_finalizer_t
+	{
+		~thread_cache_finalizer_t()
+			{
+				auto & cache = thread_cache< Block >();
+				cache.m_finished = true;
+				global_storage_t< Block >::instance().put_batch(
+						cache.m_blocks, cache.m_blocks.size() );
+			}
+	};
+
+template< typename Block >
+void
+ensure_finalizer_registered( thread_cache_t & cache )
+	{
+		if( !cache.m_finalizer_registered )
+			{
+				static thread_local thread_cache_finalizer_t< Block > finalizer;
+				(void)finalizer;
+				cache.m_finalizer_registered = true;
+			}
+	}
+
+//! Allocate a memory block for an instance of Block.
+template< typename Block >
+void *
+allocate()
+	{
+		auto & cache = thread_cache< Block >();
+		if( !cache.m_finished )
+			{
+				ensure_finalizer_registered< Block >( cache );
+
+				if( cache.m_blocks.empty() )
+					global_storage_t< Block >::instance().get_batch(
+							cache.m_blocks );
+
+				if( !cache.m_blocks.empty() )
+					return cache.m_blocks.pop();
+			}
+
+		return ::operator new( sizeof(Block) );
+	}
+
+//! Return a memory block for an instance of Block.
+template< typename Block >
+void
+deallocate( void * block ) SO_5_NOEXCEPT
+	{
+		auto & cache = thread_cache< Block >();
+		if( cache.m_finished )
+			{
+				::operator delete( block );
+				return;
+			}
+
+		ensure_finalizer_registered< Block >( cache );
+
+		cache.m_blocks.push( block );
+		if( cache.m_blocks.size() > max_thread_cache_size )
+			global_storage_t< Block >::instance().put_batch(
+					cache.m_blocks, batch_size );
+	}
+
+} /* namespace message_pool */
+
+//
+// pooled_envelope_t
+//
+/*!
+ * \brief An actual type of pooled message instance.
+ *
+ * Memory for instances of that type is allocated from
+ * the message pool. Because message_t has a virtual destructor
+ * the class-specific operator delete is used when the last reference
+ * to the message is gone.
+ *
+ * \tparam Envelope type of message envelope (a type derived from
+ * message_t or user_type_message_t<T>).
+ *
+ * \since
+ * v.5.5.23
+ */
+template< typename Envelope >
+class pooled_envelope_t final : public Envelope
+	{
+		static_assert( alignof(Envelope) <= alignof(std::max_align_t),
+				"overaligned message types can't be pooled" );
+
+	public :
+		template< typename... Args >
+		pooled_envelope_t( Args &&... args )
+			:	Envelope( std::forward< Args >(args)... )
+			{}
+
+		static void *
+		operator new( std::size_t size )
+			{
+				// A size can differ only in the case of a derived type.
+				// It is impossible because the class is final, but
+				// the check is cheap.
+				if( sizeof(pooled_envelope_t) == size )
+					return message_pool::allocate< pooled_envelope_t >();
+				return ::operator new( size );
+			}
+
+		static void
+		operator delete( void * block, std::size_t size ) SO_5_NOEXCEPT
+			{
+				if( sizeof(pooled_envelope_t) == size )
+					message_pool::deallocate< pooled_envelope_t >( block );
+				else
+					::operator delete( block );
+			}
+	};
+
+} /* namespace details */
+
+} /* namespace so_5 */
@@ -0,0 +1,80 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \file
+ * \brief Dense integer identifiers for message types.
+ * \since
+ * v.5.5.23
+ */
+
+#pragma once
+
+#include <so_5/h/declspec.hpp>
+
+#include <typeindex>
+#include <typeinfo>
+#include <cstddef>
+
+namespace so_5
+{
+
+//
+// message_type_id_t
+//
+/*!
+ * \brief A type for dense integer identifier of message type.
+ *
+ * Identifiers are assigned at run-time in the order of the first use
+ * of a type. They are unique only inside the current process and must not
+ * be stored or transferred outside of it.
+ *
+ * \since
+ * v.5.5.23
+ */
+using message_type_id_t = std::size_t;
+
+/*!
+ * \brief Identifier of void type.
+ *
+ * It is used as a value for uninitialized objects.
+ *
+ * \since
+ * v.5.5.23
+ */
+inline message_type_id_t
+null_message_type_id()
+	{
+		return 0u;
+	}
+
+/*!
+ * \brief Get the identifier for a message type.
+ *
+ * An identifier is assigned to a type at the first call for that type.
+ * The subsequent calls usually take the identifier from a small
+ * thread-local cache without locking and without comparison of type names.
+ *
+ * \since
+ * v.5.5.23
+ */
+SO_5_FUNC message_type_id_t
+message_type_id( const std::type_index & msg_type );
+
+/*!
+ * \brief Get the identifier for a message type known at compile-time.
+ *
+ * \since
+ * v.5.5.23
+ */
+template< typename Msg >
+message_type_id_t
+message_type_id()
+	{
+		static const message_type_id_t id =
+				message_type_id( std::type_index( typeid(Msg) ) );
+		return id;
+	}
+
+} /* namespace so_5 */
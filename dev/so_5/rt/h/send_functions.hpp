@@ -16,6 +16,8 @@
 
 #include <so_5/h/compiler_features.hpp>
 
+#include <vector>
+
 namespace so_5
 {
 
@@ -305,6 +307,65 @@ send( Target && to, mhood_t< Message > /*what*/ )
 						typename message_payload_type<Message>::subscription_type >();
 	}
 
+/*!
+ * \brief A utility function for creating and delivering a series of
+ * messages of the same type to one destination.
+ *
+ * A new instance of Message is created for every item from
+ * [\a first, \a last) range. The item is passed to Message's constructor
+ * as the single argument. Then all instances are delivered by one
+ * call to abstract_message_box_t::deliver_message_batch(). It allows
+ * standard mboxes to pass the whole series to the receiver's event queue
+ * at once (with one queue lock and one wakeup of a worker thread).
+ *
+ * \note The order of messages is preserved.
+ *
+ * \attention This function can't be used for signals.
+ *
+ * \tparam Message type of message to be sent.
+ * \tparam Target identification of message receiver. The same types
+ * as for so_5::send() are allowed.
+ * \tparam Input_It type of iterator for the source range.
+ *
+ * \par Usage sample:
+ * \code
+	struct price_update { double m_price; price_update(double p) : m_price(p) {} };
+
+	std::vector<double> prices{ ... };
+	so_5::send_batch< price_update >( dest_mbox, prices.begin(), prices.end() );
+ * \endcode
+ *
+ * \since
+ * v.5.5.23
+ */
+template< typename Message, typename Target, typename Input_It >
+void
+send_batch( Target && to, Input_It first, Input_It last )
+	{
+		ensure_not_signal< Message >();
+
+		using envelope_type =
+				typename message_payload_type< Message >::envelope_type;
+		ensure_classical_message< envelope_type >();
+
+		std::vector< message_ref_t > messages;
+		for(; first != last; ++first )
+			{
+				auto msg = so_5::details::make_message_instance< Message >( *first );
+				change_message_mutability(
+						*msg, message_payload_type< Message >::mutability() );
+
+				messages.emplace_back( msg.release() );
+			}
+
+		if( !messages.empty() )
+			send_functions_details::arg_to_mbox( std::forward<Target>(to) )->
+					deliver_message_batch(
+							message_payload_type< Message >::subscription_type_index(),
+							messages.data(),
+							messages.size() );
+	}
+
 /*!
  * \since
  * v.5.5.1
@@ -82,6 +82,26 @@ default_subscription_storage_factory();
 SO_5_FUNC subscription_storage_factory_t
 hash_table_based_subscription_storage_factory();
 
+/*!
+ * \brief Factory for subscription storage based on open-addressing
+ * hash table.
+ *
+ * \note Event handlers are stored inside a flat hash table with linear
+ * probing. It means that a lookup for an event handler usually touches
+ * one or two cache lines. This storage is intended for agents with
+ * large amount of subscriptions (hundreds or more) which receive
+ * messages with high rate.
+ *
+ * \par More about subscription storage tuning
+ * See \ref so_5_5_3__subscr_storage_selection for more details about selection
+ * of appropriate subscription storage type.
+ *
+ * \since
+ * v.5.5.23
+ */
+SO_5_FUNC subscription_storage_factory_t
+flat_hash_subscription_storage_factory();
+
 /*!
  * \since
  * v.5.5.3
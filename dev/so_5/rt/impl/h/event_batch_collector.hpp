@@ -0,0 +1,137 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \file
+ * \brief A helper for collecting a series of events for one agent.
+ *
+ * \since
+ * v.5.5.23
+ */
+
+#pragma once
+
+#include <so_5/rt/h/agent.hpp>
+#include <so_5/rt/h/message_limit.hpp>
+
+#include <array>
+
+namespace so_5
+{
+
+namespace impl
+{
+
+//
+// event_batch_collector_t
+//
+/*!
+ * \brief A helper for collecting a series of events for one agent.
+ *
+ * Messages are collected in a small fixed-size buffer and are passed
+ * to the agent's event queue by agent_t::call_push_event_batch().
+ *
+ * It is assumed that message limit counter (if any) is already
+ * incremented for every message passed to add(). If messages can't
+ * be pushed to the agent's queue the counter is decremented back.
+ *
+ * \attention flush() must be called explicitly after the last add().
+ *
+ * \since
+ * v.5.5.23
+ */
+class event_batch_collector_t
+	{
+		//! Max count of messages to be collected before pushing.
+		static const std::size_t capacity = 16u;
+
+		agent_t & m_receiver;
+		const so_5::message_limit::control_block_t * m_limit;
+		const mbox_id_t m_mbox_id;
+		const std::type_index & m_msg_type;
+
+		std::array< message_ref_t, capacity > m_messages;
+		std::size_t m_size = 0u;
+
+		//! Drop collected messages and return message limit counter back.
+		void
+		drop_collected() SO_5_NOEXCEPT
+			{
+				if( m_limit )
+					m_limit->m_count -= static_cast< unsigned int >(m_size);
+
+				for( std::size_t i = 0; i != m_size; ++i )
+					m_messages[ i ].reset();
+				m_size = 0u;
+			}
+
+	public :
+		event_batch_collector_t( const event_batch_collector_t & ) = delete;
+		event_batch_collector_t &
+		operator=( const event_batch_collector_t & ) = delete;
+
+		event_batch_collector_t(
+			agent_t & receiver,
+			const so_5::message_limit::control_block_t * limit,
+			mbox_id_t mbox_id,
+			const std::type_index & msg_type )
+			:	m_receiver( receiver )
+			,	m_limit( limit )
+			,	m_mbox_id( mbox_id )
+			,	m_msg_type( msg_type )
+			{}
+
+		~event_batch_collector_t()
+			{
+				// Messages are still here only if there was an exception.
+				drop_collected();
+			}
+
+		//! Store the next message.
+		/*!
+		 * Collected messages are pushed to the agent's event queue
+		 * before storing the next message if the buffer is full.
+		 */
+		void
+		add( const message_ref_t & message )
+			{
+				if( capacity == m_size )
+					flush();
+
+				m_messages[ m_size ] = message;
+				++m_size;
+			}
+
+		//! Push all collected messages to the agent's event queue.
+		void
+		flush()
+			{
+				if( !m_size )
+					return;
+
+				try
+					{
+						agent_t::call_push_event_batch(
+								m_receiver,
+								m_limit,
+								m_mbox_id,
+								m_msg_type,
+								m_messages.data(),
+								m_size );
+					}
+				catch( ... )
+					{
+						drop_collected();
+						throw;
+					}
+
+				for( std::size_t i = 0; i != m_size; ++i )
+					m_messages[ i ].reset();
+				m_size = 0u;
+			}
+	};
+
+} /* namespace impl */
+
+} /* namespace so_5 */
@@ -0,0 +1,125 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \file
+ * \brief A very simple implementation of hazard pointers.
+ *
+ * \since
+ * v.5.5.23
+ */
+
+#pragma once
+
+#include <so_5/h/compiler_features.hpp>
+
+#include <atomic>
+
+namespace so_5
+{
+
+namespace impl
+{
+
+namespace hazard_pointers
+{
+
+//
+// guard_t
+//
+/*!
+ * \brief A guard which protects one pointer from destruction.
+ *
+ * Every thread has a small fixed set of hazard slots. A guard occupies
+ * one slot for its lifetime. Guards must be created and destroyed in
+ * LIFO order (it is guaranteed if guards are local variables).
+ *
+ * If there is no free slot for the current thread (it is possible
+ * only in the case of very deep nesting) then acquired() returns false
+ * and the guard can't be used. A caller must use some other way for
+ * the object protection in that case.
+ *
+ * \since
+ * v.5.5.23
+ */
+class guard_t
+	{
+		//! Slot occupied by this guard.
+		/*!
+		 * Can be nullptr if there is no free slot.
+		 */
+		std::atomic< const void * > * m_slot;
+
+	public :
+		guard_t( const guard_t & ) = delete;
+		guard_t &
+		operator=( const guard_t & ) = delete;
+
+		guard_t() SO_5_NOEXCEPT;
+		~guard_t() SO_5_NOEXCEPT;
+
+		//! Has a slot been acquired by this guard?
+		bool
+		acquired() const SO_5_NOEXCEPT { return nullptr != m_slot; }
+
+		//! Read a pointer and protect it by the guard.
+		/*!
+		 * \attention This method can be called only if acquired()
+		 * returned true.
+		 */
+		template< typename T >
+		T *
+		protect( const std::atomic< T * > & source ) SO_5_NOEXCEPT
+			{
+				T * ptr = source.load( std::memory_order_acquire );
+				for(;;)
+					{
+						m_slot->store( ptr, std::memory_order_seq_cst );
+
+						// Pointer must be read again because it can be
+						// replaced and retired before our slot become visible.
+						T * actual = source.load( std::memory_order_seq_cst );
+						if( actual == ptr )
+							return ptr;
+
+						ptr = actual;
+					}
+			}
+
+		//! Protect an object identified by \a ptr.
+		/*!
+		 * Can be used when an object is not accessed via a shared
+		 * pointer but some shared state must not be changed while
+		 * the guard is active. The caller must check that shared state
+		 * after the call to this method.
+		 *
+		 * \attention This method can be called only if acquired()
+		 * returned true.
+		 */
+		void
+		protect_raw( const void * ptr ) SO_5_NOEXCEPT
+			{
+				m_slot->store( ptr, std::memory_order_seq_cst );
+			}
+	};
+
+/*!
+ * \brief Is the pointer protected by some guard?
+ *
+ * \note This function scans slots of all threads.
+ *
+ * \attention The pointer must be removed from the shared place
+ * before the call to that function.
+ *
+ * \since
+ * v.5.5.23
+ */
+bool
+is_protected( const void * ptr ) SO_5_NOEXCEPT;
+
+} /* namespace hazard_pointers */
+
+} /* namespace impl */
+
+} /* namespace so_5 */
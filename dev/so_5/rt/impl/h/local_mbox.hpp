@@ -11,6 +11,9 @@
 
 #include <map>
 #include <vector>
+#include <memory>
+#include <mutex>
+#include <thread>
 
 #include <so_5/h/types.hpp>
 #include <so_5/h/exception.hpp>
@@ -25,6 +28,8 @@
 #include <so_5/rt/impl/h/agent_ptr_compare.hpp>
 #include <so_5/rt/impl/h/message_limit_internals.hpp>
 #include <so_5/rt/impl/h/msg_tracing_helpers.hpp>
+#include <so_5/rt/impl/h/event_batch_collector.hpp>
+#include <so_5/rt/impl/h/hazard_pointers.hpp>
 
 namespace so_5
 {
@@ -703,6 +708,206 @@ struct data_t
 
 		//! Map of subscribers to messages.
 		messages_table_t m_subscribers;
+
+		/*!
+		 * \brief Modify the list of subscribers for the message type.
+		 *
+		 * Lambda receives a reference to subscriber_adaptive_container_t.
+		 * The container is removed if it becomes empty.
+		 *
+		 * \since
+		 * v.5.5.23
+		 */
+		template< typename Lambda >
+		void
+		modify_subscribers(
+			const std::type_index & msg_type,
+			Lambda && lambda )
+			{
+				std::unique_lock< default_rw_spinlock_t > lock( m_lock );
+
+				auto it = m_subscribers.find( msg_type );
+				if( it == m_subscribers.end() )
+				{
+					// There isn't such message type yet.
+					subscriber_adaptive_container_t container;
+					lambda( container );
+
+					if( !container.empty() )
+						m_subscribers.emplace( msg_type, std::move( container ) );
+				}
+				else
+				{
+					lambda( it->second );
+
+					if( it->second.empty() )
+						m_subscribers.erase( it );
+				}
+			}
+
+		/*!
+		 * \brief Access to the list of subscribers for the message type.
+		 *
+		 * Lambda receives a pointer to const subscriber_adaptive_container_t.
+		 * This pointer is nullptr if there is no subscribers.
+		 *
+		 * \since
+		 * v.5.5.23
+		 */
+		template< typename Lambda >
+		void
+		read_subscribers(
+			const std::type_index & msg_type,
+			Lambda && lambda ) const
+			{
+				read_lock_guard_t< default_rw_spinlock_t > lock( m_lock );
+
+				auto it = m_subscribers.find( msg_type );
+				lambda( it != m_subscribers.end() ? &(it->second) : nullptr );
+			}
+	};
+
+//
+// snapshot_data_t
+//
+
+/*!
+ * \brief A collection of data for local mbox with lock-free delivery.
+ *
+ * Subscribers are stored in an immutable table. Every modification
+ * creates a new copy of the table and replaces the current one.
+ * Lists of subscribers for different message types are shared between
+ * table copies, only the list for the modified message type is copied.
+ *
+ * Message delivery doesn't acquire any lock. The current table is
+ * protected from destruction by a hazard pointer. If the current
+ * thread has no free hazard slot (it is possible only for very deep
+ * nesting of deliveries) then the table is acquired via shared_ptr
+ * under a short spinlock.
+ *
+ * Modification waits while all deliveries which use the old table
+ * are finished. It is necessary because message limits and delivery
+ * filters of a subscriber can be destroyed right after unsubscription
+ * or removal of a delivery filter.
+ *
+ * \since
+ * v.5.5.23
+ */
+struct snapshot_data_t
+	{
+		//! Immutable list of subscribers for one message type.
+		using container_shptr_t =
+				std::shared_ptr< const subscriber_adaptive_container_t >;
+
+		//! Map from message type to subscribers.
+		using messages_table_t = std::map< std::type_index, container_shptr_t >;
+
+		using table_shptr_t = std::shared_ptr< const messages_table_t >;
+
+		snapshot_data_t( mbox_id_t id )
+			:	m_id{ id }
+			,	m_table_owner{ std::make_shared< messages_table_t >() }
+			,	m_table{ m_table_owner.get() }
+			{}
+
+		//! ID of this mbox.
+		const mbox_id_t m_id;
+
+		//! Lock for serialization of modifications.
+		std::mutex m_modification_lock;
+
+		//! Lock for protection of m_table_owner.
+		mutable default_spinlock_t m_owner_lock;
+
+		//! The owner of the current table.
+		table_shptr_t m_table_owner;
+
+		//! The current table to be used for message delivery.
+		std::atomic< const messages_table_t * > m_table;
+
+		template< typename Lambda >
+		void
+		modify_subscribers(
+			const std::type_index & msg_type,
+			Lambda && lambda )
+			{
+				std::lock_guard< std::mutex > lock( m_modification_lock );
+
+				// Note: m_table_owner can be changed only under
+				// m_modification_lock. So there is no need to acquire
+				// m_owner_lock here.
+				const messages_table_t & current = *m_table_owner;
+
+				subscriber_adaptive_container_t container;
+				auto it = current.find( msg_type );
+				if( it != current.end() )
+					container = *(it->second);
+
+				lambda( container );
+
+				if( it == current.end() && container.empty() )
+					// Nothing has been changed.
+					return;
+
+				auto new_table = std::make_shared< messages_table_t >( current );
+				if( container.empty() )
+					new_table->erase( msg_type );
+				else
+					(*new_table)[ msg_type ] =
+							std::make_shared< const subscriber_adaptive_container_t >(
+									std::move( container ) );
+
+				replace_table( std::move( new_table ) );
+			}
+
+		template< typename Lambda >
+		void
+		read_subscribers(
+			const std::type_index & msg_type,
+			Lambda && lambda ) const
+			{
+				hazard_pointers::guard_t guard;
+				if( guard.acquired() )
+					read_subscribers_from( *(guard.protect( m_table )), msg_type, lambda );
+				else
+					{
+						table_shptr_t table;
+						{
+							std::lock_guard< default_spinlock_t > lock( m_owner_lock );
+							table = m_table_owner;
+						}
+						read_subscribers_from( *table, msg_type, lambda );
+					}
+			}
+
+	private :
+		template< typename Lambda >
+		static void
+		read_subscribers_from(
+			const messages_table_t & table,
+			const std::type_index & msg_type,
+			Lambda & lambda )
+			{
+				auto it = table.find( msg_type );
+				lambda( it != table.end() ? it->second.get() : nullptr );
+			}
+
+		void
+		replace_table( table_shptr_t new_table )
+			{
+				{
+					std::lock_guard< default_spinlock_t > lock( m_owner_lock );
+
+					m_table_owner.swap( new_table );
+					m_table.store( m_table_owner.get(), std::memory_order_seq_cst );
+				}
+
+				// new_table holds the old table now.
+				// All deliveries which use it must be finished.
+				while( hazard_pointers::is_protected( new_table.get() ) ||
+						1 != new_table.use_count() )
+					std::this_thread::yield();
+			}
 	};
 
 } /* namespace local_mbox_details */
@@ -718,11 +923,16 @@ struct data_t
  *
  * \tparam Tracing_Base base class with implementation of message
  * delivery tracing methods.
+ *
+ * \tparam Data type of storage for subscribers (since v.5.5.23).
+ * It must be local_mbox_details::data_t or local_mbox_details::snapshot_data_t.
  */
-template< typename Tracing_Base >
+template<
+	typename Tracing_Base,
+	typename Data = local_mbox_details::data_t >
 class local_mbox_template
 	:	public abstract_message_box_t
-	,	private local_mbox_details::data_t
+	,	private Data
 	,	private Tracing_Base
 	{
 	public:
@@ -732,14 +942,14 @@ class local_mbox_template
 			mbox_id_t id,
 			//! Optional parameters for Tracing_Base's constructor.
 			Tracing_Args &&... args )
-			:	local_mbox_details::data_t{ id }
+			:	Data{ id }
 			,	Tracing_Base{ std::forward< Tracing_Args >(args)... }
 			{}
 
 		virtual mbox_id_t
 		id() const override
 			{
-				return m_id;
+				return this->m_id;
 			}
 
 		virtual void
@@ -777,7 +987,7 @@ class local_mbox_template
 		query_name() const override
 			{
 				std::ostringstream s;
-				s << "<mbox:type=MPMC:id=" << m_id << ">";
+				s << "<mbox:type=MPMC:id=" << this->m_id << ">";
 
 				return s.str();
 			}
@@ -809,6 +1019,51 @@ class local_mbox_template
 						overlimit_reaction_deep );
 			}
 
+		virtual void
+		do_deliver_message_batch(
+			const std::type_index & msg_type,
+			const message_ref_t * messages,
+			std::size_t count,
+			unsigned int overlimit_reaction_deep ) const override
+			{
+				for( std::size_t i = 0; i != count; ++i )
+					ensure_immutable_message( msg_type, messages[ i ] );
+
+				this->read_subscribers( msg_type,
+					[&]( const local_mbox_details::subscriber_adaptive_container_t * subscribers ) {
+						if( subscribers )
+							{
+								for( const auto & a : *subscribers )
+									do_deliver_message_batch_to_subscriber(
+											a,
+											msg_type,
+											messages,
+											count,
+											overlimit_reaction_deep );
+							}
+						else
+							for( std::size_t i = 0; i != count; ++i )
+								{
+									typename Tracing_Base::deliver_op_tracer tracer{
+											*this, // as Tracing_base
+											*this, // as abstract_message_box_t
+											"deliver_message",
+											msg_type, messages[ i ], overlimit_reaction_deep };
+
+									tracer.no_subscribers();
+								}
+					} );
+			}
+
+		virtual void
+		do_deliver_message_batch_from_timer(
+			const std::type_index & msg_type,
+			const message_ref_t * messages,
+			std::size_t count ) override
+			{
+				this->do_deliver_message_batch( msg_type, messages, count, 1 );
+			}
+
 		virtual void
 		do_deliver_service_request(
 			const std::type_index & msg_type,
@@ -868,33 +1123,20 @@ class local_mbox_template
 			Info_Maker maker,
 			Info_Changer changer )
 			{
-				std::unique_lock< default_rw_spinlock_t > lock( m_lock );
-
-				auto it = m_subscribers.find( type_wrapper );
-				if( it == m_subscribers.end() )
-				{
-					// There isn't such message type yet.
-					local_mbox_details::subscriber_adaptive_container_t container;
-					container.insert( maker() );
-
-					m_subscribers.emplace( type_wrapper, std::move( container ) );
-				}
-				else
-				{
-					auto & agents = it->second;
-
-					auto pos = agents.find( subscriber );
-					if( pos != agents.end() )
-					{
-						// Agent is already in subscribers list.
-						// But its state must be updated.
-						changer( *pos );
-					}
-					else
-						// There is no subscriber in the container.
-						// It must be added.
-						agents.insert( maker() );
-				}
+				this->modify_subscribers( type_wrapper,
+					[&]( local_mbox_details::subscriber_adaptive_container_t & agents ) {
+						auto pos = agents.find( subscriber );
+						if( pos != agents.end() )
+						{
+							// Agent is already in subscribers list.
+							// But its state must be updated.
+							changer( *pos );
+						}
+						else
+							// There is no subscriber in the container.
+							// It must be added.
+							agents.insert( maker() );
+					} );
 			}
 
 		template< typename Info_Changer >
@@ -904,28 +1146,22 @@ class local_mbox_template
 			agent_t * subscriber,
 			Info_Changer changer )
 			{
-				std::unique_lock< default_rw_spinlock_t > lock( m_lock );
-
-				auto it = m_subscribers.find( type_wrapper );
-				if( it != m_subscribers.end() )
-				{
-					auto & agents = it->second;
-
-					auto pos = agents.find( subscriber );
-					if( pos != agents.end() )
-					{
-						// Subscriber is found and must be modified.
-						changer( *pos );
-
-						// If info about subscriber becomes empty after modification
-						// then subscriber info must be removed.
-						if( pos->empty() )
-							agents.erase( pos );
-					}
-
-					if( agents.empty() )
-						m_subscribers.erase( it );
-				}
+				// Note: empty list of subscribers will be removed by
+				// modify_subscribers().
+				this->modify_subscribers( type_wrapper,
+					[&]( local_mbox_details::subscriber_adaptive_container_t & agents ) {
+						auto pos = agents.find( subscriber );
+						if( pos != agents.end() )
+						{
+							// Subscriber is found and must be modified.
+							changer( *pos );
+
+							// If info about subscriber becomes empty after modification
+							// then subscriber info must be removed.
+							if( pos->empty() )
+								agents.erase( pos );
+						}
+					} );
 			}
 
 		void
@@ -935,21 +1171,21 @@ class local_mbox_template
 			const message_ref_t & message,
 			unsigned int overlimit_reaction_deep ) const
 			{
-				read_lock_guard_t< default_rw_spinlock_t > lock( m_lock );
-
-				auto it = m_subscribers.find( msg_type );
-				if( it != m_subscribers.end() )
-					{
-						for( const auto & a : it->second )
-							do_deliver_message_to_subscriber(
-									a,
-									tracer,
-									msg_type,
-									message,
-									overlimit_reaction_deep );
-					}
-				else
-					tracer.no_subscribers();
+				this->read_subscribers( msg_type,
+					[&]( const local_mbox_details::subscriber_adaptive_container_t * subscribers ) {
+						if( subscribers )
+							{
+								for( const auto & a : *subscribers )
+									do_deliver_message_to_subscriber(
+											a,
+											tracer,
+											msg_type,
+											message,
+											overlimit_reaction_deep );
+							}
+						else
+							tracer.no_subscribers();
+					} );
 			}
 
 		void
@@ -981,7 +1217,7 @@ class local_mbox_template
 									agent_t::call_push_event(
 											agent_info.subscriber_reference(),
 											agent_info.limit(),
-											m_id,
+											this->m_id,
 											msg_type,
 											message );
 								} );
@@ -992,42 +1228,94 @@ class local_mbox_template
 			}
 
 		void
-		do_deliver_service_request_impl(
-			typename Tracing_Base::deliver_op_tracer const & tracer,
+		do_deliver_message_batch_to_subscriber(
+			const local_mbox_details::subscriber_info_t & agent_info,
 			const std::type_index & msg_type,
-			const message_ref_t & message,
+			const message_ref_t * messages,
+			std::size_t count,
 			unsigned int overlimit_reaction_deep ) const
 			{
-				using namespace so_5::message_limit::impl;
+				event_batch_collector_t collector{
+						agent_info.subscriber_reference(),
+						agent_info.limit(),
+						this->m_id,
+						msg_type };
 
-				msg_service_request_base_t::dispatch_wrapper( message,
-					[&] {
-						read_lock_guard_t< default_rw_spinlock_t > lock( m_lock );
+				for( std::size_t i = 0; i != count; ++i )
+					{
+						const message_ref_t & message = messages[ i ];
 
-						auto it = m_subscribers.find( msg_type );
+						typename Tracing_Base::deliver_op_tracer tracer{
+								*this, // as Tracing_base
+								*this, // as abstract_message_box_t
+								"deliver_message",
+								msg_type, message, overlimit_reaction_deep };
 
-						if( it == m_subscribers.end() )
-							{
-								tracer.no_subscribers();
+						const auto delivery_status =
+								agent_info.must_be_delivered( *(message.get()) );
 
-								SO_5_THROW_EXCEPTION(
-										so_5::rc_no_svc_handlers,
-										std::string( "no service handlers (no subscribers for message)"
-										", msg_type: " ) + msg_type.name() );
+						if( delivery_possibility_t::must_be_delivered == delivery_status )
+							{
+								using namespace so_5::message_limit::impl;
+
+								try_to_deliver_to_agent(
+										invocation_type_t::event,
+										agent_info.subscriber_reference(),
+										agent_info.limit(),
+										msg_type,
+										message,
+										overlimit_reaction_deep,
+										tracer.overlimit_tracer(),
+										[&] {
+											tracer.push_to_queue( agent_info.subscriber_pointer() );
+
+											collector.add( message );
+										} );
 							}
+						else
+							tracer.message_rejected(
+									agent_info.subscriber_pointer(), delivery_status );
+					}
 
-						if( 1 != it->second.size() )
-							SO_5_THROW_EXCEPTION(
-									so_5::rc_more_than_one_svc_handler,
-									std::string( "more than one service handler found"
-											", msg_type: " ) + msg_type.name() );
+				collector.flush();
+			}
 
-						do_deliver_service_request_to_subscriber(
-								tracer,
-								*(it->second.begin()),
-								msg_type,
-								message,
-								overlimit_reaction_deep );
+		void
+		do_deliver_service_request_impl(
+			typename Tracing_Base::deliver_op_tracer const & tracer,
+			const std::type_index & msg_type,
+			const message_ref_t & message,
+			unsigned int overlimit_reaction_deep ) const
+			{
+				using namespace so_5::message_limit::impl;
+
+				msg_service_request_base_t::dispatch_wrapper( message,
+					[&] {
+						this->read_subscribers( msg_type,
+							[&]( const local_mbox_details::subscriber_adaptive_container_t * subscribers ) {
+								if( !subscribers )
+									{
+										tracer.no_subscribers();
+
+										SO_5_THROW_EXCEPTION(
+												so_5::rc_no_svc_handlers,
+												std::string( "no service handlers (no subscribers for message)"
+												", msg_type: " ) + msg_type.name() );
+									}
+
+								if( 1 != subscribers->size() )
+									SO_5_THROW_EXCEPTION(
+											so_5::rc_more_than_one_svc_handler,
+											std::string( "more than one service handler found"
+													", msg_type: " ) + msg_type.name() );
+
+								do_deliver_service_request_to_subscriber(
+										tracer,
+										*(subscribers->begin()),
+										msg_type,
+										message,
+										overlimit_reaction_deep );
+							} );
 					} );
 			}
 
@@ -1064,7 +1352,7 @@ class local_mbox_template
 									agent_t::call_push_service_request(
 											agent_info.subscriber_reference(),
 											agent_info.limit(),
-											m_id,
+											this->m_id,
 											msg_type,
 											message );
 								} );
@@ -1125,6 +1413,30 @@ using local_mbox_without_tracing =
 using local_mbox_with_tracing =
 	local_mbox_template< msg_tracing_helpers::tracing_enabled_base >;
 
+/*!
+ * \brief Alias for local mbox with lock-free delivery and without
+ * message delivery tracing.
+ *
+ * \since
+ * v.5.5.23
+ */
+using snapshot_local_mbox_without_tracing =
+	local_mbox_template<
+			msg_tracing_helpers::tracing_disabled_base,
+			local_mbox_details::snapshot_data_t >;
+
+/*!
+ * \brief Alias for local mbox with lock-free delivery and with
+ * message delivery tracing.
+ *
+ * \since
+ * v.5.5.23
+ */
+using snapshot_local_mbox_with_tracing =
+	local_mbox_template<
+			msg_tracing_helpers::tracing_enabled_base,
+			local_mbox_details::snapshot_data_t >;
+
 } /* namespace impl */
 
 } /* namespace so_5 */
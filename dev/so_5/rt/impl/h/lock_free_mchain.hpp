@@ -0,0 +1,859 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \since
+ * v.5.5.23
+ *
+ * \file
+ * \brief Implementation of message chain with lock-free ring buffer.
+ */
+
+#pragma once
+
+#include <so_5/rt/impl/h/mchain_details.hpp>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+
+namespace so_5 {
+
+namespace mchain_props {
+
+namespace details {
+
+//
+// lock_free_demand_queue
+//
+/*!
+ * \since
+ * v.5.5.23
+ *
+ * \brief Implementation of bounded lock-free MPMC demands queue.
+ *
+ * This is a ring buffer with per-cell sequence numbers (a variation
+ * of Dmitry Vyukov's bounded MPMC queue). Access to cells is guarded
+ * by two counters:
+ * - count of free slots. A producer must acquire one free slot before
+ *   storing a demand into the queue;
+ * - count of available demands. A consumer must acquire one available
+ *   demand before extraction of it from the queue.
+ *
+ * Because of that push and pop operations never wait for each other
+ * except the very short period when a cell is being
+ * filled/cleaned by another thread.
+ *
+ * \note Count of available demands is incremented only after
+ * the demand is stored into a cell. It means that transition of
+ * that counter from 0 to 1 is a reliable sign of the "chain becomes
+ * not empty" condition.
+ */
+class lock_free_demand_queue
+	{
+		//! Type of one cell of ring buffer.
+		struct cell_t
+			{
+				//! Sequence number of the cell.
+				std::atomic< std::size_t > m_sequence;
+				//! Demand stored in the cell.
+				demand_t m_demand;
+			};
+
+	public :
+		//! Initializing constructor.
+		lock_free_demand_queue(
+			const capacity_t & capacity )
+			:	m_max_size{ capacity.max_size() }
+			,	m_cells{ new cell_t[ capacity.max_size() ] }
+			,	m_free_slots{ capacity.max_size() }
+			,	m_available{ 0 }
+			,	m_head{ 0 }
+			,	m_tail{ 0 }
+			{
+				for( std::size_t i = 0; i != m_max_size; ++i )
+					m_cells[ i ].m_sequence.store( i, std::memory_order_relaxed );
+			}
+
+		//! Is queue full?
+		/*!
+		 * \note The value can be out of date right after return.
+		 */
+		bool
+		is_full() const
+			{
+				return 0 == m_free_slots.load( std::memory_order_acquire );
+			}
+
+		//! Is queue empty?
+		/*!
+		 * \note The value can be out of date right after return.
+		 */
+		bool
+		is_empty() const
+			{
+				return 0 == m_available.load( std::memory_order_acquire );
+			}
+
+		//! Size of the queue.
+		/*!
+		 * \note The value can be out of date right after return.
+		 */
+		std::size_t
+		size() const
+			{
+				return m_available.load( std::memory_order_acquire );
+			}
+
+		//! An attempt to add a new item to the end of the queue.
+		/*!
+		 * \retval true if demand has been stored. The content of \a demand
+		 * is moved into the queue in that case.
+		 * \retval false if the queue is full. The content of \a demand is
+		 * not changed in that case.
+		 */
+		bool
+		try_push(
+			//! Demand to be stored.
+			demand_t & demand,
+			//! Receiver for "queue was empty" flag.
+			bool & was_empty )
+			{
+				if( !try_acquire( m_free_slots ) )
+					return false;
+
+				const std::size_t pos =
+						m_tail.fetch_add( 1, std::memory_order_relaxed );
+				cell_t & cell = m_cells[ pos % m_max_size ];
+
+				// Previous consumer of that cell could be still working on it.
+				wait_for_sequence( cell, pos );
+
+				cell.m_demand = std::move( demand );
+				cell.m_sequence.store( pos + 1, std::memory_order_release );
+
+				was_empty = 0 == m_available.fetch_add( 1 );
+
+				return true;
+			}
+
+		//! An attempt to extract the front item from the queue.
+		/*!
+		 * \retval true if demand has been extracted.
+		 * \retval false if the queue is empty.
+		 */
+		bool
+		try_pop( demand_t & dest )
+			{
+				if( !try_acquire( m_available ) )
+					return false;
+
+				const std::size_t pos =
+						m_head.fetch_add( 1, std::memory_order_relaxed );
+				cell_t & cell = m_cells[ pos % m_max_size ];
+
+				// Producer of that cell could be still working on it.
+				wait_for_sequence( cell, pos + 1 );
+
+				dest = std::move( cell.m_demand );
+				cell.m_demand = demand_t{};
+				cell.m_sequence.store( pos + m_max_size, std::memory_order_release );
+
+				m_free_slots.fetch_add( 1 );
+
+				return true;
+			}
+
+	private :
+		//! Maximum size of the queue.
+		const std::size_t m_max_size;
+
+		//! Queue's storage.
+		std::unique_ptr< cell_t[] > m_cells;
+
+		//! Count of free slots.
+		std::atomic< std::size_t > m_free_slots;
+		//! Count of demands available for extraction.
+		std::atomic< std::size_t > m_available;
+
+		//! Position for the next extraction.
+		std::atomic< std::size_t > m_head;
+
+		//! Padding to place producers' and consumers' positions
+		//! to different cache lines.
+		char m_padding[ 64 ];
+
+		//! Position for the next push.
+		std::atomic< std::size_t > m_tail;
+
+		//! Helper for decrement of non-zero counter.
+		static bool
+		try_acquire( std::atomic< std::size_t > & counter )
+			{
+				// NOTE: seq_cst load is necessary here. The chain relies
+				// on the total order between this load and modification of
+				// counters of sleeping threads.
+				std::size_t current = counter.load();
+				do
+					{
+						if( !current )
+							return false;
+					}
+				while( !counter.compare_exchange_weak( current, current - 1 ) );
+
+				return true;
+			}
+
+		//! Helper for waiting on the cell which is being used by
+		//! another thread.
+		static void
+		wait_for_sequence( const cell_t & cell, std::size_t expected )
+			{
+				while( expected !=
+						cell.m_sequence.load( std::memory_order_acquire ) )
+					std::this_thread::yield();
+			}
+	};
+
+} /* namespace details */
+
+//
+// lock_free_mchain_template
+//
+/*!
+ * \since
+ * v.5.5.23
+ *
+ * \brief Template-based implementation of message chain with lock-free
+ * queue of demands.
+ *
+ * Message storing and extraction do not use chain's lock if the chain is
+ * neither empty nor full. The lock is acquired only when:
+ * - the chain becomes not empty (not_empty_notificator and multi chain
+ *   selects must be notified);
+ * - there are consumers sleeping on the empty chain;
+ * - the chain is full and overflow reaction must be performed;
+ * - there are producers sleeping on the full chain;
+ * - the chain is being closed.
+ *
+ * \tparam Tracing_Base type with message tracing implementation details.
+ */
+template< typename Tracing_Base >
+class lock_free_mchain_template
+	:	public abstract_message_chain_t
+	,	private Tracing_Base
+	{
+	public :
+		//! Initializing constructor.
+		template< typename... Tracing_Args >
+		lock_free_mchain_template(
+			//! SObjectizer Environment for which message chain is created.
+			so_5::environment_t & env,
+			//! Mbox ID for this chain.
+			mbox_id_t id,
+			//! Chain parameters.
+			const mchain_params_t & params,
+			//! Arguments for Tracing_Base's constructor.
+			Tracing_Args &&... tracing_args )
+			:	Tracing_Base( std::forward<Tracing_Args>(tracing_args)... )
+			,	m_env( env )
+			,	m_id( id )
+			,	m_capacity( params.capacity() )
+			,	m_not_empty_notificator( params.not_empty_notificator() )
+			,	m_queue( params.capacity() )
+			{}
+
+		virtual mbox_id_t
+		id() const override
+			{
+				return m_id;
+			}
+
+		virtual void
+		subscribe_event_handler(
+			const std::type_index & /*msg_type*/,
+			const so_5::message_limit::control_block_t * /*limit*/,
+			agent_t * /*subscriber*/ ) override
+			{
+				SO_5_THROW_EXCEPTION(
+						rc_msg_chain_doesnt_support_subscriptions,
+						"mchain doesn't suppor subscription" );
+			}
+
+		virtual void
+		unsubscribe_event_handlers(
+			const std::type_index & /*msg_type*/,
+			agent_t * /*subscriber*/ ) override
+			{}
+
+		virtual std::string
+		query_name() const override
+			{
+				std::ostringstream s;
+				s << "<mchain:id=" << m_id << ">";
+
+				return s.str();
+			}
+
+		virtual mbox_type_t
+		type() const override
+			{
+				return mbox_type_t::multi_producer_single_consumer;
+			}
+
+		virtual void
+		do_deliver_message(
+			const std::type_index & msg_type,
+			const message_ref_t & message,
+			unsigned int /*overlimit_reaction_deep*/ ) const override
+			{
+				// Constness must be removed explicitly.
+				// Until do_deliver_message() lost const in v.5.6.0.
+				const_cast< lock_free_mchain_template * >(this)->
+					try_to_store_message_to_queue(
+							msg_type,
+							message,
+							invocation_type_t::event,
+							overflow_context_t::ordinary_send );
+			}
+
+		virtual void
+		do_deliver_service_request(
+			const std::type_index & msg_type,
+			const message_ref_t & message,
+			unsigned int /*overlimit_reaction_deep*/ ) const override
+			{
+				// Constness must be removed explicitly.
+				// Until do_deliver_service_request() lost const in v.5.6.0.
+				const_cast< lock_free_mchain_template * >(this)->
+					try_to_store_message_to_queue(
+							msg_type,
+							message,
+							invocation_type_t::service_request,
+							overflow_context_t::ordinary_send );
+			}
+
+		/*!
+		 * \attention Will throw an exception because delivery
+		 * filter is not applicable to MPSC-mboxes.
+		 */
+		virtual void
+		set_delivery_filter(
+			const std::type_index & /*msg_type*/,
+			const delivery_filter_t & /*filter*/,
+			agent_t & /*subscriber*/ ) override
+			{
+				SO_5_THROW_EXCEPTION(
+						rc_msg_chain_doesnt_support_delivery_filters,
+						"set_delivery_filter is called for mchain" );
+			}
+
+		virtual void
+		drop_delivery_filter(
+			const std::type_index & /*msg_type*/,
+			agent_t & /*subscriber*/ ) SO_5_NOEXCEPT override
+			{}
+
+		virtual extraction_status_t
+		extract(
+			demand_t & dest,
+			duration_t empty_queue_timeout ) override
+			{
+				std::size_t extracted = 0u;
+				return extract( &dest, 1u, extracted, empty_queue_timeout );
+			}
+
+		virtual extraction_status_t
+		extract(
+			demand_t * dest,
+			std::size_t max_count,
+			std::size_t & extracted,
+			duration_t empty_queue_timeout ) override
+			{
+				extracted = 0u;
+
+				// Fast path: there is no need to acquire the lock
+				// if the chain is not empty.
+				if( m_queue.try_pop( *dest ) )
+					return complete_extraction( dest, max_count, extracted );
+
+				if( details::is_no_wait_timevalue( empty_queue_timeout ) )
+					return is_closed() ?
+							extraction_status_t::chain_closed :
+							extraction_status_t::no_messages;
+
+				std::unique_lock< std::mutex > lock{ m_lock };
+
+				bool first_extracted = m_queue.try_pop( *dest );
+				if( !first_extracted )
+					{
+						if( is_closed() )
+							// Waiting for new messages has no sence because
+							// chain is closed.
+							return extraction_status_t::chain_closed;
+
+						auto predicate = [this, &first_extracted, dest]() -> bool {
+								first_extracted = m_queue.try_pop( *dest );
+								return first_extracted || is_closed();
+							};
+
+						// Count of sleeping thread must be incremented before
+						// going to sleep and decremented right after.
+						// Producers check this counter after storing a demand.
+						++m_threads_to_wakeup;
+						auto decrement_threads = so_5::details::at_scope_exit(
+								[this] { --m_threads_to_wakeup; } );
+
+						if( !details::is_infinite_wait_timevalue( empty_queue_timeout ) )
+							// A wait with finite timeout must be performed.
+							m_underflow_cond.wait_for(
+									lock, empty_queue_timeout, predicate );
+						else
+							// Wait until arrival of any message or closing of chain.
+							m_underflow_cond.wait( lock, predicate );
+					}
+
+				lock.unlock();
+
+				// If queue is still empty nothing can be extracted and
+				// we must stop operation.
+				if( !first_extracted )
+					return is_closed() ?
+							// The chain is closed and there must be different result
+							extraction_status_t::chain_closed :
+							// The chain is still open so there must be this result
+							extraction_status_t::no_messages;
+
+				return complete_extraction( dest, max_count, extracted );
+			}
+
+		virtual bool
+		empty() const override
+			{
+				return m_queue.is_empty();
+			}
+
+		virtual std::size_t
+		size() const override
+			{
+				return m_queue.size();
+			}
+
+		virtual void
+		close( close_mode_t mode ) override
+			{
+				std::lock_guard< std::mutex > lock{ m_lock };
+
+				if( is_closed() )
+					return;
+
+				m_status.store( details::status::closed );
+
+				// Producers on the fast path must finish their work.
+				// They do not hold the lock, so there is no risk of deadlock.
+				while( m_active_pushers.load() )
+					std::this_thread::yield();
+
+				if( close_mode_t::drop_content == mode )
+					{
+						demand_t dropped;
+						while( m_queue.try_pop( dropped ) )
+							this->trace_demand_drop_on_close( *this, dropped );
+					}
+
+				// If queue is empty now and there is any multi chain select
+				// than select_tail must be handled.
+				if( m_queue.is_empty() )
+					notify_multi_chain_select_ops();
+
+				if( m_threads_to_wakeup.load() )
+					// Someone is waiting on empty chain for new messages.
+					// It must be informed that no new messages will be here.
+					m_underflow_cond.notify_all();
+
+				if( m_overflow_waiters.load() )
+					// Someone can wait on full chain for free place for new message.
+					// It must be informed that the chain is closed.
+					m_overflow_cond.notify_all();
+			}
+
+		virtual environment_t &
+		environment() const override
+			{
+				return m_env;
+			}
+
+	protected :
+		virtual extraction_status_t
+		extract(
+			demand_t & dest,
+			select_case_t & select_case ) override
+			{
+				std::size_t extracted = 0u;
+				return extract( &dest, 1u, extracted, select_case );
+			}
+
+		virtual extraction_status_t
+		extract(
+			demand_t * dest,
+			std::size_t max_count,
+			std::size_t & extracted,
+			select_case_t & select_case ) override
+			{
+				extracted = 0u;
+
+				if( m_queue.try_pop( *dest ) )
+					return complete_extraction( dest, max_count, extracted );
+
+				std::unique_lock< std::mutex > lock{ m_lock };
+
+				if( !m_queue.try_pop( *dest ) )
+					{
+						if( is_closed() )
+							// There is no need to wait for something.
+							return extraction_status_t::chain_closed;
+
+						// In other cases select_tail must be modified.
+						// A producer will notify select_case when
+						// the chain becomes not empty.
+						select_case.set_next( m_select_tail );
+						m_select_tail = &select_case;
+
+						return extraction_status_t::no_messages;
+					}
+
+				lock.unlock();
+
+				return complete_extraction( dest, max_count, extracted );
+			}
+
+		virtual void
+		remove_from_select(
+			select_case_t & select_case ) override
+			{
+				std::lock_guard< std::mutex > lock{ m_lock };
+
+				select_case_t * c = m_select_tail;
+				select_case_t * prev = nullptr;
+				while( c )
+					{
+						select_case_t * const next = c->query_next();
+						if( c == &select_case )
+							{
+								if( prev )
+									prev->set_next( next );
+								else
+									m_select_tail = next;
+
+								return;
+							}
+
+						prev = c;
+						c = next;
+					}
+			}
+
+		virtual void
+		do_deliver_message_from_timer(
+			const std::type_index & msg_type,
+			const message_ref_t & message ) override
+			{
+				try_to_store_message_to_queue(
+						msg_type,
+						message,
+						invocation_type_t::event,
+						overflow_context_t::timer_thread );
+			}
+
+	private :
+		//! A context in which the overflow is handled.
+		enum class overflow_context_t
+			{
+				//! Ordinary send. Waiting on full chain and exception
+				//! are allowed.
+				ordinary_send,
+				//! Delivery from timer thread. There is no waiting on
+				//! full chain and throw_exception is replaced by drop_newest.
+				timer_thread
+			};
+
+		//! SObjectizer Environment for which message chain is created.
+		environment_t & m_env;
+
+		//! Status of the chain.
+		std::atomic< details::status > m_status = { details::status::open };
+
+		//! Mbox ID for chain.
+		const mbox_id_t m_id;
+
+		//! Chain capacity.
+		const capacity_t m_capacity;
+
+		//! Optional notificator for 'not_empty' condition.
+		const not_empty_notification_func_t m_not_empty_notificator;
+
+		//! Chain's demands queue.
+		details::lock_free_demand_queue m_queue;
+
+		//! Chain's lock.
+		/*!
+		 * Protects m_select_tail and is used for sleeping on
+		 * condition variables.
+		 */
+		mutable std::mutex m_lock;
+
+		//! Condition variable for waiting on empty queue.
+		std::condition_variable m_underflow_cond;
+		//! Condition variable for waiting on full queue.
+		std::condition_variable m_overflow_cond;
+
+		//! Count of threads sleeping on empty mchain.
+		std::atomic< std::size_t > m_threads_to_wakeup = { 0 };
+
+		//! Count of producers sleeping on full mchain.
+		std::atomic< std::size_t > m_overflow_waiters = { 0 };
+
+		//! Count of producers which are storing demands without the lock.
+		/*!
+		 * close() waits while this counter become zero.
+		 */
+		std::atomic< std::size_t > m_active_pushers = { 0 };
+
+		//! A queue of multi-chain selects in which this chain is used.
+		select_case_t * m_select_tail = nullptr;
+
+		bool
+		is_closed() const
+			{
+				return details::status::closed == m_status.load();
+			}
+
+		//! Actual implementation of pushing message to the queue.
+		void
+		try_to_store_message_to_queue(
+			const std::type_index & msg_type,
+			const message_ref_t & message,
+			invocation_type_t demand_type,
+			overflow_context_t context )
+			{
+				typename Tracing_Base::deliver_op_tracer tracer{
+						*this, // as tracing base.
+						*this, // as chain.
+						msg_type,
+						message,
+						demand_type };
+
+				demand_t demand{ msg_type, message, demand_type };
+				bool was_empty = false;
+				bool stored = false;
+
+				// Fast path: an attempt to store demand without the lock.
+				// NOTE: m_active_pushers must be decremented before
+				// an attempt to acquire the lock because close() waits
+				// for zero value of m_active_pushers under the lock.
+				{
+					++m_active_pushers;
+					auto decrement_pushers = so_5::details::at_scope_exit(
+							[this] { --m_active_pushers; } );
+
+					// Message cannot be stored to closed chain.
+					if( is_closed() )
+						return;
+
+					stored = m_queue.try_push( demand, was_empty );
+				}
+
+				if( stored )
+					{
+						tracer.stored( m_queue );
+						// Lock will be acquired only if it is really necessary.
+						if( was_empty || m_threads_to_wakeup.load() )
+							{
+								std::lock_guard< std::mutex > lock{ m_lock };
+								notify_consumers( was_empty );
+							}
+						return;
+					}
+
+				// Slow path: the chain is full.
+				std::unique_lock< std::mutex > lock{ m_lock };
+
+				if( !try_store_to_full_queue(
+						lock, tracer, msg_type, demand, context, was_empty ) )
+					return;
+
+				tracer.stored( m_queue );
+				notify_consumers( was_empty );
+			}
+
+		//! Handling of the overflow of the chain.
+		/*!
+		 * \attention Must be called when the chain's lock is acquired.
+		 *
+		 * \retval true if demand has been stored.
+		 */
+		bool
+		try_store_to_full_queue(
+			std::unique_lock< std::mutex > & lock,
+			typename Tracing_Base::deliver_op_tracer & tracer,
+			const std::type_index & msg_type,
+			demand_t & demand,
+			overflow_context_t context,
+			bool & was_empty )
+			{
+				// Message cannot be stored to closed chain.
+				if( is_closed() )
+					return false;
+
+				bool stored = m_queue.try_push( demand, was_empty );
+
+				// If queue full and waiting on full queue is enabled we
+				// must wait for some time until there will be some space in
+				// the queue.
+				if( !stored && overflow_context_t::ordinary_send == context &&
+						m_capacity.is_overflow_timeout_defined() )
+					{
+						// Consumers check this counter after extraction of a demand.
+						++m_overflow_waiters;
+						auto decrement_waiters = so_5::details::at_scope_exit(
+								[this] { --m_overflow_waiters; } );
+
+						m_overflow_cond.wait_for(
+								lock,
+								m_capacity.overflow_timeout(),
+								[&] {
+									stored = m_queue.try_push( demand, was_empty );
+									return stored || is_closed();
+								} );
+
+						if( !stored && is_closed() )
+							return false;
+					}
+
+				if( stored )
+					return true;
+
+				// Queue is still full. Some reaction must be performed.
+				const auto reaction = m_capacity.overflow_reaction();
+				if( overflow_reaction_t::drop_newest == reaction ||
+						( overflow_reaction_t::throw_exception == reaction &&
+							overflow_context_t::timer_thread == context ) )
+					{
+						// New message must be simply ignored.
+						tracer.overflow_drop_newest();
+						return false;
+					}
+				else if( overflow_reaction_t::remove_oldest == reaction )
+					{
+						// The oldest messages must be removed until there
+						// will be free place for the new one.
+						do
+							{
+								demand_t oldest;
+								if( m_queue.try_pop( oldest ) )
+									tracer.overflow_remove_oldest( oldest );
+								stored = m_queue.try_push( demand, was_empty );
+							}
+						while( !stored );
+					}
+				else if( overflow_reaction_t::throw_exception == reaction )
+					{
+						tracer.overflow_throw_exception();
+						SO_5_THROW_EXCEPTION(
+								rc_msg_chain_overflow,
+								"an attempt to push message to full mchain "
+								"with overflow_reaction_t::throw_exception policy" );
+					}
+				else
+					{
+						so_5::details::abort_on_fatal_error( [&] {
+								tracer.overflow_throw_exception();
+								SO_5_LOG_ERROR( m_env, log_stream ) {
+									log_stream << "overflow_reaction_t::abort_app "
+											"will be performed for mchain (id="
+											<< m_id << "), msg_type: "
+											<< msg_type.name()
+											<< ". Application will be aborted"
+											<< std::endl;
+								}
+							} );
+					}
+
+				return stored;
+			}
+
+		/*!
+		 * \brief Notification of consumers about a new demand.
+		 *
+		 * \attention Must be called when the chain's lock is acquired.
+		 */
+		void
+		notify_consumers( bool was_empty )
+			{
+				// If chain was empty then multi-chain cases must be notified.
+				// And if not_empty_notificator is defined then it must be used too.
+				if( was_empty )
+					{
+						if( m_not_empty_notificator )
+							so_5::details::invoke_noexcept_code(
+								[this] { m_not_empty_notificator(); } );
+
+						notify_multi_chain_select_ops();
+					}
+
+				if( m_threads_to_wakeup.load() )
+					// Someone is waiting on empty queue.
+					m_underflow_cond.notify_one();
+			}
+
+		/*!
+		 * \brief Final actions of successful extraction of a demand.
+		 *
+		 * The first demand is already extracted to dest[0]. Extracts
+		 * up to \a max_count-1 additional demands if they are present.
+		 *
+		 * \attention Must be called when the chain's lock is not acquired.
+		 */
+		extraction_status_t
+		complete_extraction(
+			demand_t * dest,
+			std::size_t max_count,
+			std::size_t & extracted )
+			{
+				extracted = 1u;
+				while( extracted < max_count && m_queue.try_pop( dest[ extracted ] ) )
+					++extracted;
+
+				for( std::size_t i = 0u; i != extracted; ++i )
+					this->trace_extracted_demand( *this, dest[ i ] );
+
+				// Someone can wait on full queue.
+				if( m_overflow_waiters.load() )
+					{
+						std::lock_guard< std::mutex > lock{ m_lock };
+						m_overflow_cond.notify_all();
+					}
+
+				return extraction_status_t::msg_extracted;
+			}
+
+		/*!
+		 * \attention Must be called when the chain's lock is acquired.
+		 */
+		void
+		notify_multi_chain_select_ops() SO_5_NOEXCEPT
+			{
+				if( m_select_tail )
+					{
+						auto old = m_select_tail;
+						m_select_tail = nullptr;
+						old->notify();
+					}
+			}
+	};
+
+} /* namespace mchain_props */
+
+} /* namespace so_5 */
+
@@ -95,6 +95,29 @@ class mbox_core_t
 			//! Mbox name.
 			nonempty_name_t mbox_name );
 
+		/*!
+		 * \brief Create local anonymous mbox with lock-free delivery.
+		 *
+		 * \since
+		 * v.5.5.23
+		 */
+		mbox_t
+		create_snapshot_mbox();
+
+		/*!
+		 * \brief Create local named mbox with lock-free delivery.
+		 *
+		 * \note If mbox with name \a mbox_name is already present then
+		 * the existing mbox will be returned (regardless of its type).
+		 *
+		 * \since
+		 * v.5.5.23
+		 */
+		mbox_t
+		create_snapshot_mbox(
+			//! Mbox name.
+			nonempty_name_t mbox_name );
+
 		/*!
 		 * \since
 		 * v.5.4.0
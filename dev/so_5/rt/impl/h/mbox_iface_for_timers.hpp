@@ -45,6 +45,23 @@ class mbox_iface_for_timers_t
 				m_mb.do_deliver_message_from_timer( msg_type, message );
 			}
 
+		/*!
+		 * \since
+		 * v.5.5.23
+		 */
+		inline void
+		deliver_message_batch_from_timer(
+			//! Type of all messages.
+			const std::type_index & msg_type,
+			//! Messages to be delivered.
+			const message_ref_t * messages,
+			//! Count of items in \a messages.
+			std::size_t count )
+			{
+				m_mb.do_deliver_message_batch_from_timer(
+						msg_type, messages, count );
+			}
+
 	private :
 		abstract_message_box_t & m_mb;
 	};
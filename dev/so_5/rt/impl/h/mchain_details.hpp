@@ -418,6 +418,19 @@ class mchain_template
 			demand_t & dest,
 			duration_t empty_queue_timeout ) override
 			{
+				std::size_t extracted = 0u;
+				return extract( &dest, 1u, extracted, empty_queue_timeout );
+			}
+
+		virtual extraction_status_t
+		extract(
+			demand_t * dest,
+			std::size_t max_count,
+			std::size_t & extracted,
+			duration_t empty_queue_timeout ) override
+			{
+				extracted = 0u;
+
 				std::unique_lock< std::mutex > lock{ m_lock };
 
 				// If queue is empty we must wait for some time.
@@ -459,7 +472,8 @@ class mchain_template
 							// The chain is closed and there must be different result
 							extraction_status_t::chain_closed;
 
-				return extract_demand_from_not_empty_queue( dest );
+				return extract_demands_from_not_empty_queue(
+						dest, max_count, extracted );
 			}
 
 		virtual bool
@@ -524,6 +538,19 @@ class mchain_template
 			demand_t & dest,
 			select_case_t & select_case ) override
 			{
+				std::size_t extracted = 0u;
+				return extract( &dest, 1u, extracted, select_case );
+			}
+
+		virtual extraction_status_t
+		extract(
+			demand_t * dest,
+			std::size_t max_count,
+			std::size_t & extracted,
+			select_case_t & select_case ) override
+			{
+				extracted = 0u;
+
 				std::unique_lock< std::mutex > lock{ m_lock };
 
 				const bool queue_empty = m_queue.is_empty();
@@ -540,7 +567,8 @@ class mchain_template
 						return extraction_status_t::no_messages;
 					}
 				else
-					return extract_demand_from_not_empty_queue( dest );
+					return extract_demands_from_not_empty_queue(
+							dest, max_count, extracted );
 			}
 
 		virtual void
@@ -801,19 +829,29 @@ class mchain_template
 		 * \attention This helper method must be called when chain object
 		 * is locked in some hi-level method.
 		 *
+		 * \note Since v.5.5.23 extracts up to \a max_count demands.
+		 *
 		 * \since
 		 * v.5.5.16
 		 */
 		extraction_status_t
-		extract_demand_from_not_empty_queue(
-			demand_t & dest )
+		extract_demands_from_not_empty_queue(
+			demand_t * dest,
+			std::size_t max_count,
+			std::size_t & extracted )
 			{
 				// If queue was full then someone can wait on it.
 				const bool queue_was_full = m_queue.is_full();
-				dest = std::move( m_queue.front() );
-				m_queue.pop_front();
+				do
+					{
+						demand_t & d = dest[ extracted ];
+						d = std::move( m_queue.front() );
+						m_queue.pop_front();
+						++extracted;
 
-				this->trace_extracted_demand( *this, dest );
+						this->trace_extracted_demand( *this, d );
+					}
+				while( extracted < max_count && !m_queue.is_empty() );
 
 				if( queue_was_full )
 					m_overflow_cond.notify_all();
@@ -22,6 +22,7 @@
 
 #include <so_5/rt/impl/h/msg_tracing_helpers.hpp>
 #include <so_5/rt/impl/h/message_limit_internals.hpp>
+#include <so_5/rt/impl/h/event_batch_collector.hpp>
 
 namespace so_5
 {
@@ -137,6 +138,50 @@ class limitless_mpsc_mbox_template
 				} );
 			}
 
+		virtual void
+		do_deliver_message_batch(
+			const std::type_index & msg_type,
+			const message_ref_t * messages,
+			std::size_t count,
+			unsigned int overlimit_reaction_deep ) const override
+			{
+				read_lock_guard_t< default_rw_spinlock_t > lock{ m_lock };
+
+				for( std::size_t i = 0; i != count; ++i )
+					{
+						typename Tracing_Base::deliver_op_tracer tracer{
+								*this, // as Tracing_Base
+								*this, // as abstract_message_box_t
+								"deliver_message",
+								msg_type, messages[ i ], overlimit_reaction_deep };
+
+						if( m_subscriptions_count )
+							tracer.push_to_queue( m_single_consumer );
+						else
+							tracer.no_subscribers();
+					}
+
+				// There is no message limits, so all messages can be
+				// pushed to the agent's queue as is.
+				if( m_subscriptions_count )
+					agent_t::call_push_event_batch(
+							*m_single_consumer,
+							message_limit::control_block_t::none(),
+							m_id,
+							msg_type,
+							messages,
+							count );
+			}
+
+		virtual void
+		do_deliver_message_batch_from_timer(
+			const std::type_index & msg_type,
+			const message_ref_t * messages,
+			std::size_t count ) override
+			{
+				this->do_deliver_message_batch( msg_type, messages, count, 1 );
+			}
+
 		virtual void
 		do_deliver_service_request(
 			const std::type_index & msg_type,
@@ -336,6 +381,59 @@ class limitful_mpsc_mbox_template
 				} );
 			}
 
+		virtual void
+		do_deliver_message_batch(
+			const std::type_index & msg_type,
+			const message_ref_t * messages,
+			std::size_t count,
+			unsigned int overlimit_reaction_deep ) const override
+			{
+				read_lock_guard_t< default_rw_spinlock_t > lock{ this->m_lock };
+
+				using namespace so_5::message_limit::impl;
+
+				auto limit = m_limits.find( msg_type );
+
+				event_batch_collector_t collector{
+						*(this->m_single_consumer),
+						limit,
+						this->m_id,
+						msg_type };
+
+				for( std::size_t i = 0; i != count; ++i )
+					{
+						const message_ref_t & message = messages[ i ];
+
+						typename Tracing_Base::deliver_op_tracer tracer{
+								*this, // as Tracing_Base
+								*this, // as abstract_message_box_t
+								"deliver_message",
+								msg_type, message, overlimit_reaction_deep };
+
+						if( !this->m_subscriptions_count )
+							{
+								tracer.no_subscribers();
+								continue;
+							}
+
+						try_to_deliver_to_agent(
+								invocation_type_t::event,
+								*(this->m_single_consumer),
+								limit,
+								msg_type,
+								message,
+								overlimit_reaction_deep,
+								tracer.overlimit_tracer(),
+								[&] {
+									tracer.push_to_queue( this->m_single_consumer );
+
+									collector.add( message );
+								} );
+					}
+
+				collector.flush();
+			}
+
 		virtual void
 		do_deliver_service_request(
 			const std::type_index & msg_type,
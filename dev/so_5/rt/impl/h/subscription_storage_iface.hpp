@@ -78,6 +78,12 @@ struct subscr_info_t
 		 */
 		mbox_t m_mbox;
 		std::type_index m_msg_type;
+		//! Identifier of message type.
+		/*!
+		 * \since
+		 * v.5.5.23
+		 */
+		message_type_id_t m_msg_type_id;
 		const state_t * m_state;
 		event_handler_data_t m_handler;
 
@@ -89,6 +95,7 @@ struct subscr_info_t
 			thread_safety_t thread_safety )
 			:	m_mbox( std::move( mbox ) )
 			,	m_msg_type( std::move( msg_type ) )
+			,	m_msg_type_id( message_type_id( m_msg_type ) )
 			,	m_state( &state )
 			,	m_handler( method, thread_safety )
 			{}
@@ -167,10 +174,14 @@ class subscription_storage_t
 			const mbox_t & mbox,
 			const std::type_index & msg_type ) = 0;
 
+		/*!
+		 * \note Since v.5.5.23 message type is specified by its
+		 * identifier. It makes lookup cheaper.
+		 */
 		virtual const event_handler_data_t *
 		find_handler(
 			mbox_id_t mbox_id,
-			const std::type_index & msg_type,
+			message_type_id_t msg_type_id,
 			const state_t & current_state ) const SO_5_NOEXCEPT = 0;
 
 		virtual void
@@ -0,0 +1,176 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \file
+ * \brief A very simple implementation of hazard pointers.
+ *
+ * \since
+ * v.5.5.23
+ */
+
+#include <so_5/rt/impl/h/hazard_pointers.hpp>
+
+#include <new>
+
+namespace so_5
+{
+
+namespace impl
+{
+
+namespace hazard_pointers
+{
+
+namespace
+{
+
+//! Count of hazard slots for one thread.
+const std::size_t slots_per_thread = 8u;
+
+//
+// record_t
+//
+/*!
+ * \brief Hazard slots of one thread.
+ *
+ * Records are never deallocated. When a thread finishes its record
+ * becomes free and can be reused by another thread.
+ */
+struct record_t
+	{
+		//! Is this record owned by some thread?
+		std::atomic< bool > m_in_use;
+
+		//! Hazard slots.
+		std::atomic< const void * > m_slots[ slots_per_thread ];
+
+		//! Count of occupied slots.
+		/*!
+		 * \note Is used only by the owner thread.
+		 */
+		std::size_t m_slots_used = 0u;
+
+		//! The next record in the global list.
+		record_t * m_next = nullptr;
+
+		record_t()
+			:	m_in_use{ true }
+			{
+				for( auto & s : m_slots )
+					s.store( nullptr, std::memory_order_relaxed );
+			}
+	};
+
+//! Head of the global list of records.
+std::atomic< record_t * > g_records{ nullptr };
+
+//! Find a free record or create a new one.
+record_t *
+acquire_record()
+	{
+		for( auto r = g_records.load( std::memory_order_acquire );
+				r; r = r->m_next )
+			{
+				bool expected = false;
+				if( !r->m_in_use.load( std::memory_order_relaxed ) &&
+						r->m_in_use.compare_exchange_strong( expected, true,
+								std::memory_order_acq_rel ) )
+					return r;
+			}
+
+		auto r = new record_t();
+		auto head = g_records.load( std::memory_order_relaxed );
+		do
+			{
+				r->m_next = head;
+			}
+		while( !g_records.compare_exchange_weak( head, r,
+				std::memory_order_release,
+				std::memory_order_relaxed ) );
+
+		return r;
+	}
+
+//
+// thread_record_holder_t
+//
+//! A holder of record for the current thread.
+class thread_record_holder_t
+	{
+		record_t * m_record = nullptr;
+
+	public :
+		~thread_record_holder_t()
+			{
+				if( m_record )
+					m_record->m_in_use.store( false, std::memory_order_release );
+			}
+
+		//! Get the record for the current thread.
+		/*!
+		 * \return nullptr if a new record can't be allocated.
+		 */
+		record_t *
+		get() SO_5_NOEXCEPT
+			{
+				if( !m_record )
+					try
+						{
+							m_record = acquire_record();
+						}
+					catch( const std::bad_alloc & )
+						{}
+
+				return m_record;
+			}
+	};
+
+thread_local thread_record_holder_t t_record;
+
+} /* namespace anonymous */
+
+//
+// guard_t
+//
+guard_t::guard_t() SO_5_NOEXCEPT
+	:	m_slot{ nullptr }
+	{
+		auto r = t_record.get();
+		if( r && r->m_slots_used < slots_per_thread )
+			{
+				m_slot = &(r->m_slots[ r->m_slots_used ]);
+				++(r->m_slots_used);
+			}
+	}
+
+guard_t::~guard_t() SO_5_NOEXCEPT
+	{
+		if( m_slot )
+			{
+				m_slot->store( nullptr, std::memory_order_release );
+				--(t_record.get()->m_slots_used);
+			}
+	}
+
+//
+// is_protected
+//
+bool
+is_protected( const void * ptr ) SO_5_NOEXCEPT
+	{
+		for( auto r = g_records.load( std::memory_order_acquire );
+				r; r = r->m_next )
+			for( const auto & s : r->m_slots )
+				if( ptr == s.load( std::memory_order_seq_cst ) )
+					return true;
+
+		return false;
+	}
+
+} /* namespace hazard_pointers */
+
+} /* namespace impl */
+
+} /* namespace so_5 */
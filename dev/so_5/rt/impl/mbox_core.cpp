@@ -11,6 +11,7 @@
 #include <so_5/rt/impl/h/mpsc_mbox.hpp>
 #include <so_5/rt/impl/h/mbox_core.hpp>
 #include <so_5/rt/impl/h/mchain_details.hpp>
+#include <so_5/rt/impl/h/lock_free_mchain.hpp>
 
 namespace so_5
 {
@@ -53,6 +54,26 @@ mbox_core_t::create_mbox(
 			[this]() { return create_mbox(); } );
 }
 
+mbox_t
+mbox_core_t::create_snapshot_mbox()
+{
+	auto id = ++m_mbox_id_counter;
+	if( !m_msg_tracing_stuff.get().is_msg_tracing_enabled() )
+		return mbox_t{ new snapshot_local_mbox_without_tracing{ id } };
+	else
+		return mbox_t{ new snapshot_local_mbox_with_tracing{
+				id, m_msg_tracing_stuff } };
+}
+
+mbox_t
+mbox_core_t::create_snapshot_mbox(
+	nonempty_name_t mbox_name )
+{
+	return create_named_mbox(
+			std::move(mbox_name),
+			[this]() { return create_snapshot_mbox(); } );
+}
+
 namespace {
 
 template< typename M1, typename M2, typename... A >
@@ -161,6 +182,36 @@ make_mchain(
 						std::forward<A>(args)..., params } };
 	}
 
+/*!
+ * \since
+ * v.5.5.23
+ */
+mchain_t
+make_lock_free_mchain(
+	outliving_reference_t< so_5::msg_tracing::holder_t > tracer,
+	const mchain_params_t & params,
+	environment_t & env,
+	mbox_id_t id )
+	{
+		using namespace so_5::mchain_props;
+		using namespace so_5::impl::msg_tracing_helpers;
+		using D = mchain_tracing_disabled_base;
+		using E = mchain_tracing_enabled_base;
+
+		if( params.capacity().unlimited() )
+			SO_5_THROW_EXCEPTION( rc_lock_free_mchain_must_be_limited,
+					"lock-free queue can't be used for size-unlimited mchain" );
+
+		if( tracer.get().is_msg_tracing_enabled()
+				&& !params.msg_tracing_disabled() )
+			return mchain_t{
+					new lock_free_mchain_template< E >{
+						env, id, params, tracer } };
+		else
+			return mchain_t{
+					new lock_free_mchain_template< D >{ env, id, params } };
+	}
+
 } /* namespace anonymous */
 
 mchain_t
@@ -173,7 +224,10 @@ mbox_core_t::create_mchain(
 
 	auto id = ++m_mbox_id_counter;
 
-	if( params.capacity().unlimited() )
+	if( params.lock_free_queue_used() )
+		return make_lock_free_mchain(
+				m_msg_tracing_stuff, params, env, id );
+	else if( params.capacity().unlimited() )
 		return make_mchain< unlimited_demand_queue >(
 				m_msg_tracing_stuff, params, env, id );
 	else if( memory_usage_t::dynamic == params.capacity().memory_usage() )
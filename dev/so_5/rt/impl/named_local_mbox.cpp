@@ -76,6 +76,26 @@ named_local_mbox_t::do_deliver_message(
 	m_mbox->do_deliver_message( msg_type, message, overlimit_reaction_deep );
 }
 
+void
+named_local_mbox_t::do_deliver_message_batch(
+	const std::type_index & msg_type,
+	const message_ref_t * messages,
+	std::size_t count,
+	unsigned int overlimit_reaction_deep ) const
+{
+	m_mbox->do_deliver_message_batch(
+			msg_type, messages, count, overlimit_reaction_deep );
+}
+
+void
+named_local_mbox_t::do_deliver_message_batch_from_timer(
+	const std::type_index & msg_type,
+	const message_ref_t * messages,
+	std::size_t count )
+{
+	m_mbox->do_deliver_message_batch( msg_type, messages, count, 1 );
+}
+
 void
 named_local_mbox_t::do_deliver_service_request(
 	const std::type_index & msg_type,
@@ -76,7 +76,7 @@ class storage_t : public subscription_storage_t
 		const event_handler_data_t *
 		find_handler(
 			mbox_id_t mbox_id,
-			const std::type_index & msg_type,
+			message_type_id_t msg_type_id,
 			const state_t & current_state ) const SO_5_NOEXCEPT override;
 
 		void
@@ -181,12 +181,12 @@ storage_t::drop_subscription_for_all_states(
 const event_handler_data_t *
 storage_t::find_handler(
 	mbox_id_t mbox_id,
-	const std::type_index & msg_type,
+	message_type_id_t msg_type_id,
 	const state_t & current_state ) const SO_5_NOEXCEPT
 	{
 		return m_current_storage->find_handler(
 				mbox_id,
-				msg_type,
+				msg_type_id,
 				current_state );
 	}
 
@@ -0,0 +1,598 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \file
+ * \brief A flat hash-table based storage for agent's subscriptions
+ * information.
+ *
+ * \since
+ * v.5.5.23
+ */
+
+#include <so_5/rt/impl/h/subscription_storage_iface.hpp>
+
+#include <algorithm>
+#include <map>
+#include <vector>
+#include <iterator>
+#include <cstdint>
+
+#include <so_5/details/h/rollback_on_exception.hpp>
+
+namespace so_5
+{
+
+namespace impl
+{
+
+/*!
+ * \brief A flat hash-table based storage for agent's subscriptions
+ * information.
+ *
+ * \since
+ * v.5.5.23
+ */
+namespace flat_hash_subscr_storage
+{
+
+//
+// slot_t
+//
+/*!
+ * \brief A slot of open-addressing hash table.
+ *
+ * Contains everything necessary for event handler lookup. Event handler
+ * data is stored inside the slot, so a successful lookup usually touches
+ * only one cache line.
+ *
+ * Empty slot has nullptr in m_state.
+ */
+struct slot_t
+	{
+		mbox_id_t m_mbox_id = null_mbox_id();
+		message_type_id_t m_msg_type_id = null_message_type_id();
+		const state_t * m_state = nullptr;
+		event_handler_data_t m_handler{
+				event_handler_method_t{}, thread_safety_t::unsafe };
+
+		bool
+		empty() const SO_5_NOEXCEPT { return nullptr == m_state; }
+
+		bool
+		is_same(
+			mbox_id_t mbox_id,
+			message_type_id_t msg_type_id,
+			const state_t * state ) const SO_5_NOEXCEPT
+			{
+				return m_state == state &&
+						m_msg_type_id == msg_type_id &&
+						m_mbox_id == mbox_id;
+			}
+	};
+
+//
+// mbox_msg_key_t
+//
+/*!
+ * \brief A key for (mbox, msg_type) pair.
+ */
+struct mbox_msg_key_t
+	{
+		mbox_id_t m_mbox_id;
+		message_type_id_t m_msg_type_id;
+
+		bool
+		operator<( const mbox_msg_key_t & o ) const
+			{
+				return m_mbox_id < o.m_mbox_id ||
+						( m_mbox_id == o.m_mbox_id &&
+								m_msg_type_id < o.m_msg_type_id );
+			}
+	};
+
+//
+// mbox_msg_info_t
+//
+/*!
+ * \brief Information about subscriptions for (mbox, msg_type) pair.
+ */
+struct mbox_msg_info_t
+	{
+		//! Reference to mbox.
+		/*!
+		 * Reference must be stored because we must have
+		 * access to mbox during destroyment of all
+		 * subscriptions in destructor.
+		 */
+		mbox_t m_mbox;
+		//! Type of message.
+		std::type_index m_msg_type;
+		//! Count of subscriptions in different states.
+		std::size_t m_subscriptions;
+	};
+
+//! Type of map for (mbox, msg_type) pairs.
+using mbox_msg_map_t = std::map< mbox_msg_key_t, mbox_msg_info_t >;
+
+//
+// table_t
+//
+/*!
+ * \brief Open-addressing hash table with linear probing.
+ *
+ * Capacity is always a power of 2. The table is kept at most half full,
+ * so a lookup for a missing key (it is a usual case for lookups in
+ * parent states) stops after a couple of probes.
+ *
+ * Backward shift deletion is used, so there are no tombstones.
+ */
+class table_t
+	{
+	public :
+		//! Value for absent index.
+		static const std::size_t npos = static_cast< std::size_t >(-1);
+
+		std::size_t
+		size() const SO_5_NOEXCEPT { return m_size; }
+
+		bool
+		empty() const SO_5_NOEXCEPT { return 0u == m_size; }
+
+		std::size_t
+		find(
+			mbox_id_t mbox_id,
+			message_type_id_t msg_type_id,
+			const state_t * state ) const SO_5_NOEXCEPT
+			{
+				if( m_slots.empty() )
+					return npos;
+
+				for( auto i = home_index( mbox_id, msg_type_id, state );
+						;
+						i = next_index( i ) )
+					{
+						const auto & s = m_slots[ i ];
+						if( s.empty() )
+							return npos;
+						if( s.is_same( mbox_id, msg_type_id, state ) )
+							return i;
+					}
+			}
+
+		const slot_t &
+		slot( std::size_t index ) const SO_5_NOEXCEPT
+			{
+				return m_slots[ index ];
+			}
+
+		//! Add a new item.
+		/*!
+		 * \attention The key must not be present in the table.
+		 */
+		void
+		insert(
+			mbox_id_t mbox_id,
+			message_type_id_t msg_type_id,
+			const state_t * state,
+			const event_handler_data_t & handler )
+			{
+				// The copy can throw. So it is made before any modification.
+				event_handler_data_t handler_copy{ handler };
+
+				if( (m_size + 1u) * 2u > m_slots.size() )
+					rehash( m_slots.empty() ? min_capacity : m_slots.size() * 2u );
+
+				place( mbox_id, msg_type_id, state, std::move( handler_copy ) );
+			}
+
+		//! Remove item at the specified index.
+		void
+		erase( std::size_t index ) SO_5_NOEXCEPT
+			{
+				auto hole = index;
+				for( auto i = next_index( hole ); !m_slots[ i ].empty();
+						i = next_index( i ) )
+					{
+						auto & s = m_slots[ i ];
+						const auto home = home_index(
+								s.m_mbox_id, s.m_msg_type_id, s.m_state );
+
+						// The item can be moved to the hole only if its home
+						// is not in the cyclic range (hole, i].
+						const bool can_be_moved = hole < i ?
+								( home <= hole || home > i ) :
+								( home <= hole && home > i );
+						if( can_be_moved )
+							{
+								m_slots[ hole ] = std::move( s );
+								hole = i;
+							}
+					}
+
+				m_slots[ hole ] = slot_t{};
+				--m_size;
+			}
+
+		template< typename Lambda >
+		void
+		for_each( Lambda && lambda ) const
+			{
+				for( const auto & s : m_slots )
+					if( !s.empty() )
+						lambda( s );
+			}
+
+		void
+		swap( table_t & o ) SO_5_NOEXCEPT
+			{
+				m_slots.swap( o.m_slots );
+				std::swap( m_size, o.m_size );
+			}
+
+	private :
+		static const std::size_t min_capacity = 16u;
+
+		std::vector< slot_t > m_slots;
+		std::size_t m_size = 0u;
+
+		std::size_t
+		home_index(
+			mbox_id_t mbox_id,
+			message_type_id_t msg_type_id,
+			const state_t * state ) const SO_5_NOEXCEPT
+			{
+				std::uint64_t h = static_cast< std::uint64_t >( mbox_id ) *
+						0x9e3779b97f4a7c15ull;
+				h ^= static_cast< std::uint64_t >( msg_type_id ) *
+						0xbf58476d1ce4e5b9ull;
+				h ^= static_cast< std::uint64_t >(
+						reinterpret_cast< std::uintptr_t >( state ) ) *
+						0x94d049bb133111ebull;
+				h ^= h >> 31;
+
+				return static_cast< std::size_t >( h ) & (m_slots.size() - 1u);
+			}
+
+		std::size_t
+		next_index( std::size_t index ) const SO_5_NOEXCEPT
+			{
+				return (index + 1u) & (m_slots.size() - 1u);
+			}
+
+		void
+		place(
+			mbox_id_t mbox_id,
+			message_type_id_t msg_type_id,
+			const state_t * state,
+			event_handler_data_t && handler ) SO_5_NOEXCEPT
+			{
+				auto i = home_index( mbox_id, msg_type_id, state );
+				while( !m_slots[ i ].empty() )
+					i = next_index( i );
+
+				auto & s = m_slots[ i ];
+				s.m_mbox_id = mbox_id;
+				s.m_msg_type_id = msg_type_id;
+				s.m_state = state;
+				s.m_handler = std::move( handler );
+
+				++m_size;
+			}
+
+		void
+		rehash( std::size_t new_capacity )
+			{
+				std::vector< slot_t > old_slots( new_capacity );
+				old_slots.swap( m_slots );
+				m_size = 0u;
+
+				for( auto & s : old_slots )
+					if( !s.empty() )
+						place( s.m_mbox_id, s.m_msg_type_id, s.m_state,
+								std::move( s.m_handler ) );
+			}
+	};
+
+//
+// storage_t
+//
+/*!
+ * \brief A storage for agent's subscriptions information.
+ *
+ * Event handler lookup is performed in an open-addressing hash table
+ * keyed by (mbox_id, msg_type_id, state). Event handler data is stored
+ * inside the table. It makes lookup cache-friendly even for agents with
+ * hundreds of subscriptions.
+ *
+ * Information which is necessary only for subscription management
+ * (references to mboxes and types of messages) is stored separately
+ * for every (mbox, msg_type) pair.
+ */
+class storage_t : public subscription_storage_t
+	{
+	public :
+		storage_t( agent_t * owner );
+		~storage_t() override;
+
+		virtual void
+		create_event_subscription(
+			const mbox_t & mbox_ref,
+			const std::type_index & type_index,
+			const message_limit::control_block_t * limit,
+			const state_t & target_state,
+			const event_handler_method_t & method,
+			thread_safety_t thread_safety ) override;
+
+		virtual void
+		drop_subscription(
+			const mbox_t & mbox_ref,
+			const std::type_index & type_index,
+			const state_t & target_state ) override;
+
+		void
+		drop_subscription_for_all_states(
+			const mbox_t & mbox_ref,
+			const std::type_index & type_index ) override;
+
+		const event_handler_data_t *
+		find_handler(
+			mbox_id_t mbox_id,
+			message_type_id_t msg_type_id,
+			const state_t & current_state ) const SO_5_NOEXCEPT override;
+
+		void
+		debug_dump( std::ostream & to ) const override;
+
+		void
+		drop_content() override;
+
+		subscription_storage_common::subscr_info_vector_t
+		query_content() const override;
+
+		void
+		setup_content(
+			subscription_storage_common::subscr_info_vector_t && info ) override;
+
+		std::size_t
+		query_subscriptions_count() const override;
+
+	private :
+		//! Event handlers.
+		table_t m_table;
+
+		//! Information about (mbox, msg_type) pairs.
+		mbox_msg_map_t m_mbox_msgs;
+
+		void
+		destroy_all_subscriptions();
+	};
+
+storage_t::storage_t( agent_t * owner )
+	:	subscription_storage_t( owner )
+	{}
+
+storage_t::~storage_t()
+	{
+		destroy_all_subscriptions();
+	}
+
+void
+storage_t::create_event_subscription(
+	const mbox_t & mbox_ref,
+	const std::type_index & type_index,
+	const message_limit::control_block_t * limit,
+	const state_t & target_state,
+	const event_handler_method_t & method,
+	thread_safety_t thread_safety )
+	{
+		using namespace subscription_storage_common;
+
+		const mbox_msg_key_t key{ mbox_ref->id(), message_type_id( type_index ) };
+
+		if( table_t::npos != m_table.find(
+				key.m_mbox_id, key.m_msg_type_id, &target_state ) )
+			SO_5_THROW_EXCEPTION(
+				rc_evt_handler_already_provided,
+				"agent is already subscribed to message, " +
+				make_subscription_description( mbox_ref, type_index, target_state ) );
+
+		m_table.insert( key.m_mbox_id, key.m_msg_type_id, &target_state,
+				event_handler_data_t( method, thread_safety ) );
+
+		so_5::details::do_with_rollback_on_exception(
+			[&] {
+				auto it = m_mbox_msgs.find( key );
+				if( it != m_mbox_msgs.end() )
+					++(it->second.m_subscriptions);
+				else
+					{
+						// It is the first subscription for that pair.
+						// Mbox must create subscription.
+						it = m_mbox_msgs.emplace( key,
+								mbox_msg_info_t{ mbox_ref, type_index, 1u } ).first;
+
+						so_5::details::do_with_rollback_on_exception(
+							[&] {
+								mbox_ref->subscribe_event_handler(
+										type_index, limit, owner() );
+							},
+							[&] { m_mbox_msgs.erase( it ); } );
+					}
+			},
+			[&] {
+				m_table.erase( m_table.find(
+						key.m_mbox_id, key.m_msg_type_id, &target_state ) );
+			} );
+	}
+
+void
+storage_t::drop_subscription(
+	const mbox_t & mbox_ref,
+	const std::type_index & type_index,
+	const state_t & target_state )
+	{
+		const mbox_msg_key_t key{ mbox_ref->id(), message_type_id( type_index ) };
+
+		const auto index = m_table.find(
+				key.m_mbox_id, key.m_msg_type_id, &target_state );
+		if( table_t::npos != index )
+			{
+				m_table.erase( index );
+
+				auto it = m_mbox_msgs.find( key );
+				if( 0u == --(it->second.m_subscriptions) )
+					{
+						m_mbox_msgs.erase( it );
+						mbox_ref->unsubscribe_event_handlers( type_index, owner() );
+					}
+			}
+	}
+
+void
+storage_t::drop_subscription_for_all_states(
+	const mbox_t & mbox_ref,
+	const std::type_index & type_index )
+	{
+		const mbox_msg_key_t key{ mbox_ref->id(), message_type_id( type_index ) };
+
+		auto it = m_mbox_msgs.find( key );
+		if( it != m_mbox_msgs.end() )
+			{
+				// States are collected first because erase() moves
+				// items inside the table.
+				std::vector< const state_t * > states;
+				states.reserve( it->second.m_subscriptions );
+				m_table.for_each( [&]( const slot_t & s ) {
+						if( s.m_mbox_id == key.m_mbox_id &&
+								s.m_msg_type_id == key.m_msg_type_id )
+							states.push_back( s.m_state );
+					} );
+
+				for( auto s : states )
+					m_table.erase( m_table.find(
+							key.m_mbox_id, key.m_msg_type_id, s ) );
+
+				m_mbox_msgs.erase( it );
+				mbox_ref->unsubscribe_event_handlers( type_index, owner() );
+			}
+	}
+
+const event_handler_data_t *
+storage_t::find_handler(
+	mbox_id_t mbox_id,
+	message_type_id_t msg_type_id,
+	const state_t & current_state ) const SO_5_NOEXCEPT
+	{
+		const auto index = m_table.find( mbox_id, msg_type_id, &current_state );
+		if( table_t::npos != index )
+			return &(m_table.slot( index ).m_handler);
+		else
+			return nullptr;
+	}
+
+void
+storage_t::debug_dump( std::ostream & to ) const
+	{
+		m_table.for_each( [&]( const slot_t & s ) {
+				const auto & info = m_mbox_msgs.find(
+						mbox_msg_key_t{ s.m_mbox_id, s.m_msg_type_id } )->second;
+
+				to << "{" << s.m_mbox_id << ", "
+						<< info.m_msg_type.name() << ", "
+						<< s.m_state->query_name() << "}"
+						<< std::endl;
+			} );
+	}
+
+void
+storage_t::destroy_all_subscriptions()
+	{
+		for( const auto & p : m_mbox_msgs )
+			p.second.m_mbox->unsubscribe_event_handlers(
+					p.second.m_msg_type,
+					owner() );
+
+		drop_content();
+	}
+
+void
+storage_t::drop_content()
+	{
+		table_t empty_table;
+		m_table.swap( empty_table );
+
+		mbox_msg_map_t empty_map;
+		m_mbox_msgs.swap( empty_map );
+	}
+
+subscription_storage_common::subscr_info_vector_t
+storage_t::query_content() const
+	{
+		using namespace subscription_storage_common;
+
+		subscr_info_vector_t events;
+		events.reserve( m_table.size() );
+
+		m_table.for_each( [&]( const slot_t & s ) {
+				const auto & info = m_mbox_msgs.find(
+						mbox_msg_key_t{ s.m_mbox_id, s.m_msg_type_id } )->second;
+
+				events.emplace_back(
+						info.m_mbox,
+						info.m_msg_type,
+						*(s.m_state),
+						s.m_handler.m_method,
+						s.m_handler.m_thread_safety );
+			} );
+
+		return events;
+	}
+
+void
+storage_t::setup_content(
+	subscription_storage_common::subscr_info_vector_t && info )
+	{
+		table_t fresh_table;
+		mbox_msg_map_t fresh_map;
+
+		for( const auto & i : info )
+			{
+				const mbox_msg_key_t key{ i.m_mbox->id(), i.m_msg_type_id };
+
+				fresh_table.insert( key.m_mbox_id, key.m_msg_type_id, i.m_state,
+						i.m_handler );
+
+				auto it = fresh_map.find( key );
+				if( it != fresh_map.end() )
+					++(it->second.m_subscriptions);
+				else
+					fresh_map.emplace( key,
+							mbox_msg_info_t{ i.m_mbox, i.m_msg_type, 1u } );
+			}
+
+		m_table.swap( fresh_table );
+		m_mbox_msgs.swap( fresh_map );
+	}
+
+std::size_t
+storage_t::query_subscriptions_count() const
+	{
+		return m_table.size();
+	}
+
+} /* namespace flat_hash_subscr_storage */
+
+} /* namespace impl */
+
+SO_5_FUNC subscription_storage_factory_t
+flat_hash_subscription_storage_factory()
+	{
+		return []( agent_t * owner ) {
+			return impl::subscription_storage_unique_ptr_t(
+					new impl::flat_hash_subscr_storage::storage_t( owner ) );
+		};
+	}
+
+} /* namespace so_5 */
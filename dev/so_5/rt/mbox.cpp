@@ -39,6 +39,17 @@ abstract_message_box_t::operator<( const abstract_message_box_t & o ) const
 	return id() < o.id();
 }
 
+void
+abstract_message_box_t::do_deliver_message_batch(
+	const std::type_index & msg_type,
+	const message_ref_t * messages,
+	std::size_t count,
+	unsigned int overlimit_reaction_deep ) const
+{
+	for( std::size_t i = 0; i != count; ++i )
+		this->do_deliver_message( msg_type, messages[ i ], overlimit_reaction_deep );
+}
+
 void
 abstract_message_box_t::do_deliver_message_from_timer(
 	const std::type_index & msg_type,
@@ -47,5 +58,15 @@ abstract_message_box_t::do_deliver_message_from_timer(
 	this->do_deliver_message( msg_type, message, 1 );
 }
 
+void
+abstract_message_box_t::do_deliver_message_batch_from_timer(
+	const std::type_index & msg_type,
+	const message_ref_t * messages,
+	std::size_t count )
+{
+	for( std::size_t i = 0; i != count; ++i )
+		this->do_deliver_message_from_timer( msg_type, messages[ i ] );
+}
+
 } /* namespace so_5 */
 
@@ -22,6 +22,20 @@ abstract_message_chain_t::abstract_message_chain_t()
 abstract_message_chain_t::~abstract_message_chain_t()
 	{}
 
+mchain_props::extraction_status_t
+abstract_message_chain_t::extract(
+	mchain_props::demand_t * dest,
+	std::size_t /*max_count*/,
+	std::size_t & extracted,
+	mchain_props::duration_t empty_queue_timeout )
+	{
+		const auto status = extract( *dest, empty_queue_timeout );
+		extracted = mchain_props::extraction_status_t::msg_extracted == status ?
+				1u : 0u;
+
+		return status;
+	}
+
 mbox_t
 abstract_message_chain_t::as_mbox()
 	{
@@ -41,6 +55,20 @@ abstract_message_chain_t::extract(
 		return mchain_props::extraction_status_t::no_messages;
 	}
 
+mchain_props::extraction_status_t
+abstract_message_chain_t::extract(
+	mchain_props::demand_t * dest,
+	std::size_t /*max_count*/,
+	std::size_t & extracted,
+	mchain_props::select_case_t & select_case )
+	{
+		const auto status = extract( *dest, select_case );
+		extracted = mchain_props::extraction_status_t::msg_extracted == status ?
+				1u : 0u;
+
+		return status;
+	}
+
 void
 abstract_message_chain_t::remove_from_select(
 	mchain_props::select_case_t & /*select_case*/ )
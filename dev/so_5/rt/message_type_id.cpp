@@ -0,0 +1,104 @@
+/*
+ * SObjectizer-5
+ */
+
+/*!
+ * \file
+ * \brief Dense integer identifiers for message types.
+ * \since
+ * v.5.5.23
+ */
+
+#include <so_5/rt/h/message_type_id.hpp>
+
+#include <mutex>
+#include <unordered_map>
+#include <cstdint>
+
+namespace so_5
+{
+
+namespace
+{
+
+//
+// registry_t
+//
+/*!
+ * \brief Global registry of message type identifiers.
+ */
+class registry_t
+	{
+	public :
+		registry_t()
+			{
+				m_ids.emplace( std::type_index( typeid(void) ),
+						null_message_type_id() );
+			}
+
+		message_type_id_t
+		id_for( const std::type_index & msg_type )
+			{
+				std::lock_guard< std::mutex > lock{ m_lock };
+
+				return m_ids.emplace( msg_type, m_ids.size() ).first->second;
+			}
+
+	private :
+		std::mutex m_lock;
+		std::unordered_map< std::type_index, message_type_id_t > m_ids;
+	};
+
+registry_t &
+registry()
+	{
+		static registry_t instance;
+		return instance;
+	}
+
+//
+// cache_item_t
+//
+/*!
+ * \brief An item of thread-local cache of identifiers.
+ *
+ * The pointer to type name is used as a key. Different types can't have
+ * the same pointer. The same type can have different pointers (for
+ * example in different shared libraries), but it only leads to a cache
+ * miss.
+ */
+struct cache_item_t
+	{
+		const char * m_name;
+		message_type_id_t m_id;
+	};
+
+//! Size of thread-local cache. Must be a power of 2.
+const std::size_t cache_size = 64u;
+
+thread_local cache_item_t g_cache[ cache_size ];
+
+inline std::size_t
+cache_index( const char * name )
+	{
+		const auto v = reinterpret_cast< std::uintptr_t >( name );
+		return static_cast< std::size_t >( (v ^ (v >> 6)) & (cache_size - 1u) );
+	}
+
+} /* namespace anonymous */
+
+SO_5_FUNC message_type_id_t
+message_type_id( const std::type_index & msg_type )
+	{
+		const char * name = msg_type.name();
+		auto & item = g_cache[ cache_index( name ) ];
+		if( item.m_name != name )
+			{
+				item.m_id = registry().id_for( msg_type );
+				item.m_name = name;
+			}
+
+		return item.m_id;
+	}
+
+} /* namespace so_5 */
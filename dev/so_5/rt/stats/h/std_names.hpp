@@ -138,6 +138,56 @@ work_thread_activity();
 SO_5_FUNC suffix_t
 disp_thread_count();
 
+/*!
+ * \since
+ * v.5.5.23
+ *
+ * \brief Suffix for data source with count of non-empty event queues
+ * waiting for a work thread of thread-pool-like dispatcher.
+ */
+SO_5_FUNC suffix_t
+disp_ready_queue_size();
+
+/*!
+ * \since
+ * v.5.5.23
+ *
+ * \brief Suffix for data source with count of work threads started
+ * by elastic thread pool dispatcher because of high load.
+ */
+SO_5_FUNC suffix_t
+disp_thread_started_count();
+
+/*!
+ * \since
+ * v.5.5.23
+ *
+ * \brief Suffix for data source with count of idle work threads
+ * retired by elastic thread pool dispatcher.
+ */
+SO_5_FUNC suffix_t
+disp_thread_retired_count();
+
+/*!
+ * \since
+ * v.5.5.23
+ *
+ * \brief Suffix for data source with current count of demands to be
+ * processed at once from an event queue of thread pool dispatcher.
+ */
+SO_5_FUNC suffix_t
+disp_demands_at_once();
+
+/*!
+ * \since
+ * v.5.5.23
+ *
+ * \brief Suffix for data source with total service time (in microseconds)
+ * of an event queue of thread pool dispatcher.
+ */
+SO_5_FUNC suffix_t
+disp_service_time();
+
 /*!
  * \since
  * v.5.5.4
@@ -98,6 +98,36 @@ disp_thread_count()
 		IMPL_SUFFIX( "/threads.count" )
 	}
 
+SO_5_FUNC suffix_t
+disp_ready_queue_size()
+	{
+		IMPL_SUFFIX( "/ready_queues.count" )
+	}
+
+SO_5_FUNC suffix_t
+disp_thread_started_count()
+	{
+		IMPL_SUFFIX( "/threads.started" )
+	}
+
+SO_5_FUNC suffix_t
+disp_thread_retired_count()
+	{
+		IMPL_SUFFIX( "/threads.retired" )
+	}
+
+SO_5_FUNC suffix_t
+disp_demands_at_once()
+	{
+		IMPL_SUFFIX( "/demands_at_once" )
+	}
+
+SO_5_FUNC suffix_t
+disp_service_time()
+	{
+		IMPL_SUFFIX( "/service_time.us" )
+	}
+
 SO_5_FUNC suffix_t
 timer_single_shot_count()
 	{
@@ -15,11 +15,34 @@
 #include <so_5/rt/impl/h/mbox_iface_for_timers.hpp>
 
 #include <so_5/h/stdcpp.hpp>
+#include <so_5/h/exception.hpp>
+#include <so_5/h/ret_code.hpp>
 
 #include <so_5/h/timers.hpp>
 
 #include <timertt/all.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+	#define SO_5_TIMERFD_SUPPORTED
+
+	#include <cerrno>
+	#include <cstdint>
+
+	#include <poll.h>
+	#include <sys/eventfd.h>
+	#include <sys/prctl.h>
+	#include <sys/timerfd.h>
+	#include <unistd.h>
+#endif
+
 namespace so_5
 {
 
@@ -143,6 +166,9 @@ class actual_timer_t : public timer_t
 		using timer_holder_t = timertt::timer_object_holder<
 				typename Timer::thread_safety >;
 
+		//! Type of pool for memory of timers.
+		using pool_t = timertt::details::timer_object_pool;
+
 		//! Initialized constructor.
 		actual_timer_t(
 			Timer * thread )
@@ -177,7 +203,57 @@ class actual_timer_t : public timer_t
 				}
 			}
 
+		/*!
+		 * \brief Allocate memory for a timer from the pool.
+		 *
+		 * A pointer to the pool is stored just before the object.
+		 *
+		 * \since
+		 * v.5.5.23
+		 */
+		static void *
+		operator new( std::size_t size, pool_t & pool )
+			{
+				auto block = static_cast< char * >(
+						pool.acquire( size + header_size() ) );
+				*reinterpret_cast< pool_t ** >( block ) = &pool;
+
+				return block + header_size();
+			}
+
+		/*!
+		 * \brief Return memory of a timer to the pool.
+		 *
+		 * \since
+		 * v.5.5.23
+		 */
+		static void
+		operator delete( void * ptr ) SO_5_NOEXCEPT
+			{
+				auto block = static_cast< char * >( ptr ) - header_size();
+				(*reinterpret_cast< pool_t ** >( block ))->release( block );
+			}
+
+		/*!
+		 * \brief Return memory to the pool if constructor throws.
+		 *
+		 * \since
+		 * v.5.5.23
+		 */
+		static void
+		operator delete( void * ptr, pool_t & ) SO_5_NOEXCEPT
+			{
+				operator delete( ptr );
+			}
+
 	private :
+		//! Size of the space for a pointer to the pool.
+		static SO_5_CONSTEXPR std::size_t
+		header_size() SO_5_NOEXCEPT
+			{
+				return alignof( std::max_align_t );
+			}
+
 		//! Timer thread for the timer.
 		/*!
 		 * nullptr means that timer is deactivated.
@@ -200,6 +276,8 @@ class actual_timer_t : public timer_t
  */
 class timer_action_for_timer_thread_t
 	{
+		friend class timer_action_batch_t;
+
 		std::type_index m_type_index;
 		mbox_t m_mbox;
 		message_ref_t m_msg;
@@ -222,6 +300,96 @@ class timer_action_for_timer_thread_t
 			}
 	};
 
+//
+// timer_action_batch_t
+//
+/*!
+ * \brief A collector of timer actions elapsed at the same time step.
+ *
+ * Actions are grouped by the target mbox. A series of messages of
+ * the same type for the same mbox is delivered by one
+ * deliver_message_batch_from_timer() call. It allows a mbox to lock
+ * itself and the subscriber's event queue only once for the whole
+ * series.
+ *
+ * The order of messages for the same mbox is preserved.
+ *
+ * \since
+ * v.5.5.23
+ */
+class timer_action_batch_t
+	{
+		//! Actions to be performed.
+		std::vector< timer_action_for_timer_thread_t * > m_actions;
+
+		//! Index of the first action which is not performed yet.
+		std::size_t m_first_unprocessed = 0;
+
+		//! Buffer for messages of the current series.
+		std::vector< message_ref_t > m_messages;
+
+		static bool
+		same_destination(
+			const timer_action_for_timer_thread_t & a,
+			const timer_action_for_timer_thread_t & b )
+			{
+				return a.m_mbox == b.m_mbox && a.m_type_index == b.m_type_index;
+			}
+
+	public :
+		void
+		exec( timer_action_for_timer_thread_t & action )
+			{
+				m_actions.push_back( &action );
+			}
+
+		void
+		flush()
+			{
+				const auto total = m_actions.size();
+
+				if( 1 < total && 0 == m_first_unprocessed )
+					// The order of actions for different mboxes is not
+					// important, so a pointer value can be used as a key.
+					std::stable_sort( m_actions.begin(), m_actions.end(),
+						[]( const timer_action_for_timer_thread_t * a,
+							const timer_action_for_timer_thread_t * b ) {
+							return std::less< const abstract_message_box_t * >{}(
+									a->m_mbox.get(), b->m_mbox.get() );
+						} );
+
+				while( m_first_unprocessed != total )
+					{
+						auto & head = *m_actions[ m_first_unprocessed ];
+
+						auto last = m_first_unprocessed + 1;
+						while( last != total &&
+								same_destination( head, *m_actions[ last ] ) )
+							++last;
+
+						const auto first = m_first_unprocessed;
+						// Actions must be marked as processed before the
+						// delivery because it can throw.
+						m_first_unprocessed = last;
+
+						if( 1 == last - first )
+							head();
+						else
+							{
+								m_messages.clear();
+								for( auto i = first; i != last; ++i )
+									m_messages.push_back( m_actions[ i ]->m_msg );
+
+								::so_5::rt::impl::mbox_iface_for_timers_t{ head.m_mbox }
+										.deliver_message_batch_from_timer(
+												head.m_type_index,
+												m_messages.data(),
+												m_messages.size() );
+							}
+					}
+			}
+	};
+
 //
 // actual_thread_t
 //
@@ -266,7 +434,8 @@ class actual_thread_t : public timer_thread_t
 			std::chrono::steady_clock::duration pause,
 			std::chrono::steady_clock::duration period ) override
 			{
-				auto timer = stdcpp::make_unique< timer_demand_t >( m_thread.get() );
+				std::unique_ptr< timer_demand_t > timer{
+						new( *m_timer_pool ) timer_demand_t( m_thread.get() ) };
 
 				m_thread->activate( timer->timer_holder(),
 						pause,
@@ -303,6 +472,136 @@ class actual_thread_t : public timer_thread_t
 
 	private :
 		std::unique_ptr< Timer_Thread > m_thread;
+
+		//! Pool for memory of timer_t objects.
+		/*!
+		 * \since
+		 * v.5.5.23
+		 */
+		timertt::details::timer_object_pool::unique_ptr m_timer_pool{
+				timertt::details::timer_object_pool::make() };
+	};
+
+//
+// calling_thread_index
+//
+/*!
+ * \brief An index of the current thread for selection of timer shard.
+ *
+ * Indexes are assigned in round-robin manner at the first call on
+ * a thread and are not changed after that.
+ *
+ * \since
+ * v.5.5.23
+ */
+inline std::size_t
+calling_thread_index()
+	{
+		static std::atomic< std::size_t > s_counter{ 0u };
+		static thread_local const std::size_t s_index =
+				s_counter.fetch_add( 1u, std::memory_order_relaxed );
+		return s_index;
+	}
+
+//
+// sharded_thread_t
+//
+/*!
+ * \brief An implementation of timer thread with several independent
+ * timer threads inside.
+ *
+ * \since
+ * v.5.5.23
+ */
+class sharded_thread_t : public timer_thread_t
+	{
+	public :
+		//! Initializing constructor.
+		sharded_thread_t(
+			//! Shards. Must not be empty.
+			std::vector< timer_thread_unique_ptr_t > shards,
+			//! A way of selection of shard for new timers.
+			timer_shard_selector_t selector )
+			:	m_shards( std::move( shards ) )
+			,	m_selector( selector )
+			{}
+
+		virtual void
+		start() override
+			{
+				std::size_t started = 0;
+				try
+					{
+						for( ; started != m_shards.size(); ++started )
+							m_shards[ started ]->start();
+					}
+				catch( ... )
+					{
+						while( started )
+							m_shards[ --started ]->finish();
+						throw;
+					}
+			}
+
+		virtual void
+		finish() override
+			{
+				for( auto & s : m_shards )
+					s->finish();
+			}
+
+		virtual timer_id_t
+		schedule(
+			const std::type_index & type_index,
+			const mbox_t & mbox,
+			const message_ref_t & msg,
+			std::chrono::steady_clock::duration pause,
+			std::chrono::steady_clock::duration period ) override
+			{
+				return select_shard( mbox ).schedule(
+						type_index, mbox, msg, pause, period );
+			}
+
+		virtual void
+		schedule_anonymous(
+			const std::type_index & type_index,
+			const mbox_t & mbox,
+			const message_ref_t & msg,
+			std::chrono::steady_clock::duration pause,
+			std::chrono::steady_clock::duration period ) override
+			{
+				select_shard( mbox ).schedule_anonymous(
+						type_index, mbox, msg, pause, period );
+			}
+
+		virtual timer_thread_stats_t
+		query_stats() override
+			{
+				timer_thread_stats_t result{ 0u, 0u };
+				for( auto & s : m_shards )
+					{
+						const auto stats = s->query_stats();
+						result.m_single_shot_count += stats.m_single_shot_count;
+						result.m_periodic_count += stats.m_periodic_count;
+					}
+
+				return result;
+			}
+
+	private :
+		const std::vector< timer_thread_unique_ptr_t > m_shards;
+		const timer_shard_selector_t m_selector;
+
+		timer_thread_t &
+		select_shard( const mbox_t & mbox ) const
+			{
+				const std::size_t index =
+						timer_shard_selector_t::by_mbox == m_selector ?
+						static_cast< std::size_t >( mbox->id() % m_shards.size() ) :
+						calling_thread_index() % m_shards.size();
+
+				return *m_shards[ index ];
+			}
 	};
 
 //
@@ -392,7 +691,8 @@ class actual_manager_t : public timer_manager_t
 			std::chrono::steady_clock::duration pause,
 			std::chrono::steady_clock::duration period ) override
 			{
-				auto timer = stdcpp::make_unique< timer_demand_t >( m_manager.get() );
+				std::unique_ptr< timer_demand_t > timer{
+						new( *m_timer_pool ) timer_demand_t( m_manager.get() ) };
 
 				m_manager->activate( timer->timer_holder(),
 						pause,
@@ -439,6 +739,14 @@ class actual_manager_t : public timer_manager_t
 		std::unique_ptr< Timer_Manager > m_manager;
 		outliving_reference_t< timer_manager_t::elapsed_timers_collector_t >
 				m_collector;
+
+		//! Pool for memory of timer_t objects.
+		/*!
+		 * \since
+		 * v.5.5.23
+		 */
+		timertt::details::timer_object_pool::unique_ptr m_timer_pool{
+				timertt::details::timer_object_pool::make() };
 	};
 
 //
@@ -549,6 +857,17 @@ using timer_list_thread_t = timertt::timer_list_thread_template<
 		error_logger_for_timertt_t,
 		exception_handler_for_timertt_t >;
 
+//! hierarchical timer_wheel thread type.
+/*!
+ * \since
+ * v.5.5.23
+ */
+using timer_hierarchical_wheel_thread_t =
+		timertt::hierarchical_wheel_thread_template<
+				timer_action_for_timer_thread_t,
+				error_logger_for_timertt_t,
+				exception_handler_for_timertt_t >;
+
 //! timer_wheel manager type.
 using timer_wheel_manager_t = timertt::timer_wheel_manager_template<
 		timertt::thread_safety::unsafe,
@@ -569,12 +888,327 @@ using timer_list_manager_t = timertt::timer_list_manager_template<
 		timer_action_for_timer_manager_t,
 		error_logger_for_timertt_t,
 		exception_handler_for_timertt_t >;
+
+//! hierarchical timer_wheel manager type.
+/*!
+ * \since
+ * v.5.5.23
+ */
+using timer_hierarchical_wheel_manager_t =
+		timertt::hierarchical_wheel_manager_template<
+				timertt::thread_safety::unsafe,
+				timer_action_for_timer_manager_t,
+				error_logger_for_timertt_t,
+				exception_handler_for_timertt_t >;
 /*!
  * \}
  */
 
+#if defined(SO_5_TIMERFD_SUPPORTED)
+//
+// timerfd_thread_t
+//
+/*!
+ * \brief An implementation of timer thread which waits for timers
+ * by using Linux timerfd.
+ *
+ * Timers are stored in thread-safe timertt's timer_heap manager.
+ * The thread waits in poll() for a timerfd armed by the absolute
+ * deadline of the nearest timer and for an eventfd. The eventfd is
+ * signaled when a timer earlier than the armed deadline is added
+ * and on shutdown.
+ *
+ * \since
+ * v.5.5.23
+ */
+class timerfd_thread_t : public timer_thread_t
+	{
+		//! Type of storage for timers.
+		using manager_t = timertt::timer_heap_manager_template<
+				timertt::thread_safety::safe,
+				timer_action_for_timer_thread_t,
+				error_logger_for_timertt_t,
+				exception_handler_for_timertt_t >;
+
+		using timer_demand_t = actual_timer_t< manager_t >;
+
+		using clock_type = std::chrono::steady_clock;
+
+		//! Value of m_armed_deadline when there is no armed deadline.
+		/*!
+		 * Any new timer must wake up the thread in that case.
+		 */
+		static SO_5_CONSTEXPR clock_type::rep
+		not_armed() SO_5_NOEXCEPT
+			{
+				return std::numeric_limits< clock_type::rep >::max();
+			}
+
+	public :
+		timerfd_thread_t(
+			error_logger_shptr_t logger )
+			:	m_logger( logger )
+			,	m_manager( new manager_t(
+					manager_t::default_initial_heap_capacity(),
+					create_error_logger_for_timertt( logger ),
+					create_exception_handler_for_timertt_thread( logger ) ) )
+			,	m_timerfd( ::timerfd_create( CLOCK_MONOTONIC, TFD_CLOEXEC ) )
+			,	m_eventfd( ::eventfd( 0, EFD_CLOEXEC ) )
+			{
+				if( -1 == m_timerfd || -1 == m_eventfd )
+					{
+						const int error_code = errno;
+						close_descriptors();
+
+						SO_5_THROW_EXCEPTION( rc_timerfd_creation_failed,
+								"unable to create timerfd or eventfd, errno: " +
+								std::to_string( error_code ) );
+					}
+			}
+
+		~timerfd_thread_t() SO_5_NOEXCEPT override
+			{
+				if( m_thread.joinable() )
+					{
+						m_shutdown.store( true, std::memory_order_release );
+						wake_up();
+						m_thread.join();
+					}
+
+				close_descriptors();
+			}
+
+		virtual void
+		start() override
+			{
+				m_shutdown.store( false, std::memory_order_release );
+				m_thread = std::thread{ [this] { body(); } };
+			}
+
+		virtual void
+		finish() override
+			{
+				m_shutdown.store( true, std::memory_order_release );
+				wake_up();
+
+				if( m_thread.joinable() )
+					m_thread.join();
+
+				m_manager->reset();
+			}
+
+		virtual timer_id_t
+		schedule(
+			const std::type_index & type_index,
+			const mbox_t & mbox,
+			const message_ref_t & msg,
+			std::chrono::steady_clock::duration pause,
+			std::chrono::steady_clock::duration period ) override
+			{
+				std::unique_ptr< timer_demand_t > timer{
+						new( *m_timer_pool ) timer_demand_t( m_manager.get() ) };
+
+				const auto now = clock_type::now();
+				m_manager->activate( timer->timer_holder(),
+						pause,
+						period,
+						timer_action_for_timer_thread_t( type_index, mbox, msg ) );
+				wake_up_if_earlier( now + pause );
+
+				return timer_id_t( timer.release() );
+			}
+
+		virtual void
+		schedule_anonymous(
+			const std::type_index & type_index,
+			const mbox_t & mbox,
+			const message_ref_t & msg,
+			std::chrono::steady_clock::duration pause,
+			std::chrono::steady_clock::duration period ) override
+			{
+				const auto now = clock_type::now();
+				m_manager->activate(
+						pause,
+						period,
+						timer_action_for_timer_thread_t( type_index, mbox, msg ) );
+				wake_up_if_earlier( now + pause );
+			}
+
+		virtual timer_thread_stats_t
+		query_stats() override
+			{
+				auto d = m_manager->get_timer_quantities();
+
+				return timer_thread_stats_t{
+						d.m_single_shot_count,
+						d.m_periodic_count
+					};
+			}
+
+	private :
+		const error_logger_shptr_t m_logger;
+
+		std::unique_ptr< manager_t > m_manager;
+
+		int m_timerfd;
+		int m_eventfd;
+
+		std::thread m_thread;
+
+		std::atomic< bool > m_shutdown{ false };
+
+		//! Deadline the timerfd is armed for.
+		/*!
+		 * It is a count of clock ticks since the epoch of steady_clock.
+		 */
+		std::atomic< clock_type::rep > m_armed_deadline{ not_armed() };
+
+		//! Pool for memory of timer_t objects.
+		timertt::details::timer_object_pool::unique_ptr m_timer_pool{
+				timertt::details::timer_object_pool::make() };
+
+		void
+		close_descriptors() SO_5_NOEXCEPT
+			{
+				if( -1 != m_timerfd )
+					::close( m_timerfd );
+				if( -1 != m_eventfd )
+					::close( m_eventfd );
+				m_timerfd = m_eventfd = -1;
+			}
+
+		void
+		wake_up() SO_5_NOEXCEPT
+			{
+				const std::uint64_t v = 1;
+				// An error can be ignored: the counter can overflow only
+				// if the thread doesn't read it at all.
+				const auto r = ::write( m_eventfd, &v, sizeof(v) );
+				(void)r;
+			}
+
+		void
+		wake_up_if_earlier( clock_type::time_point deadline ) SO_5_NOEXCEPT
+			{
+				// The deadline is calculated before activation of the timer.
+				// So it can't be later than the actual deadline and
+				// a wake-up can't be missed.
+				if( deadline.time_since_epoch().count() <
+						m_armed_deadline.load( std::memory_order_seq_cst ) )
+					wake_up();
+			}
+
+		void
+		arm( clock_type::time_point deadline )
+			{
+				using namespace std::chrono;
+
+				const auto since_epoch = deadline.time_since_epoch();
+				const auto secs = duration_cast< seconds >( since_epoch );
+				const auto nsecs = duration_cast< nanoseconds >( since_epoch - secs );
+
+				itimerspec spec{};
+				spec.it_value.tv_sec = static_cast< time_t >( secs.count() );
+				spec.it_value.tv_nsec = static_cast< long >( nsecs.count() );
+				// Zero value disarms the timer. The deadline is already in
+				// the past in that case, so the smallest value is used.
+				if( 0 == spec.it_value.tv_sec && 0 == spec.it_value.tv_nsec )
+					spec.it_value.tv_nsec = 1;
+
+				if( -1 == ::timerfd_settime(
+						m_timerfd, TFD_TIMER_ABSTIME, &spec, nullptr ) )
+					fatal_error( "timerfd_settime failed", errno );
+			}
+
+		void
+		drain( int fd ) SO_5_NOEXCEPT
+			{
+				std::uint64_t v;
+				const auto r = ::read( fd, &v, sizeof(v) );
+				(void)r;
+			}
+
+		void
+		fatal_error( const char * what, int error_code ) SO_5_NOEXCEPT
+			{
+				so_5::details::abort_on_fatal_error( [&] {
+					SO_5_LOG_ERROR( *m_logger, stream ) {
+						stream << "error inside timer_thread: " << what
+								<< ", errno: " << error_code
+								<< ", application will be aborted";
+					}
+				} );
+			}
+
+		void
+		body()
+			{
+				// The default timer slack (50us) is too big for precise
+				// wake-ups.
+				::prctl( PR_SET_TIMERSLACK, 1UL, 0UL, 0UL, 0UL );
+
+				pollfd fds[ 2 ] = {
+						{ m_timerfd, POLLIN, 0 },
+						{ m_eventfd, POLLIN, 0 } };
+
+				while( !m_shutdown.load( std::memory_order_acquire ) )
+					{
+						m_manager->process_expired_timers();
+
+						// Every new timer will wake up the thread until
+						// the deadline is armed.
+						m_armed_deadline.store( not_armed(), std::memory_order_seq_cst );
+
+						const auto nearest = m_manager->nearest_time_point();
+						if( std::get<0>( nearest ) )
+							{
+								const auto deadline = std::get<1>( nearest );
+								m_armed_deadline.store(
+										deadline.time_since_epoch().count(),
+										std::memory_order_seq_cst );
+								arm( deadline );
+							}
+
+						fds[ 0 ].revents = fds[ 1 ].revents = 0;
+						if( -1 == ::poll( fds, 2, -1 ) )
+							{
+								if( EINTR != errno )
+									fatal_error( "poll failed", errno );
+								continue;
+							}
+
+						if( fds[ 0 ].revents & POLLIN )
+							drain( m_timerfd );
+						if( fds[ 1 ].revents & POLLIN )
+							drain( m_eventfd );
+					}
+			}
+	};
+#endif /* SO_5_TIMERFD_SUPPORTED */
+
 } /* namespace timers_details */
 
+} /* namespace so_5 */
+
+namespace timertt
+{
+
+/*!
+ * \brief Batch delivery of messages from elapsed timers.
+ *
+ * \since
+ * v.5.5.23
+ */
+template<>
+class timer_action_batch< so_5::timers_details::timer_action_for_timer_thread_t >
+	:	public so_5::timers_details::timer_action_batch_t
+	{};
+
+} /* namespace timertt */
+
+namespace so_5
+{
+
 SO_5_FUNC timer_thread_unique_ptr_t
 create_timer_wheel_thread(
 	error_logger_shptr_t logger )
@@ -652,6 +1286,69 @@ create_timer_list_thread(
 				new actual_thread_t< timertt_thread_t >( std::move( thread ) ) );
 	}
 
+SO_5_FUNC timer_thread_unique_ptr_t
+create_timer_hierarchical_wheel_thread(
+	error_logger_shptr_t logger )
+	{
+		using timertt_thread_t = timers_details::timer_hierarchical_wheel_thread_t;
+
+		return create_timer_hierarchical_wheel_thread(
+				logger,
+				timertt_thread_t::default_granularity() );
+	}
+
+SO_5_FUNC timer_thread_unique_ptr_t
+create_timer_hierarchical_wheel_thread(
+	error_logger_shptr_t logger,
+	std::chrono::steady_clock::duration granularity )
+	{
+		using timertt_thread_t = timers_details::timer_hierarchical_wheel_thread_t;
+		using namespace timers_details;
+
+		std::unique_ptr< timertt_thread_t > thread(
+				new timertt_thread_t(
+						granularity,
+						create_error_logger_for_timertt( logger ),
+						create_exception_handler_for_timertt_thread( logger ) ) );
+
+		return timer_thread_unique_ptr_t(
+				new actual_thread_t< timertt_thread_t >( std::move( thread ) ) );
+	}
+
+SO_5_FUNC timer_thread_unique_ptr_t
+create_timer_timerfd_thread(
+	error_logger_shptr_t logger )
+	{
+#if defined(SO_5_TIMERFD_SUPPORTED)
+		return timer_thread_unique_ptr_t(
+				new timers_details::timerfd_thread_t( std::move( logger ) ) );
+#else
+		return create_timer_heap_thread( std::move( logger ) );
+#endif
+	}
+
+SO_5_FUNC timer_thread_unique_ptr_t
+create_sharded_timer_thread(
+	error_logger_shptr_t logger,
+	std::size_t shards_count,
+	timer_shard_selector_t selector,
+	const timer_thread_factory_t & shard_factory )
+	{
+		if( !shards_count )
+			SO_5_THROW_EXCEPTION( rc_no_timer_shards,
+					"sharded timer thread must have at least one shard" );
+
+		std::vector< timer_thread_unique_ptr_t > shards;
+		shards.reserve( shards_count );
+		for( std::size_t i = 0; i != shards_count; ++i )
+			shards.push_back(
+					internal_timer_helpers::create_appropriate_timer_thread(
+							logger, shard_factory ) );
+
+		return stdcpp::make_unique< timers_details::sharded_thread_t >(
+				std::move( shards ), selector );
+	}
+
 SO_5_FUNC timer_manager_unique_ptr_t
 create_timer_wheel_manager(
 	error_logger_shptr_t logger,
@@ -741,5 +1438,41 @@ create_timer_list_manager(
 				std::move( collector ) );
 	}
 
+SO_5_FUNC timer_manager_unique_ptr_t
+create_timer_hierarchical_wheel_manager(
+	error_logger_shptr_t logger,
+	outliving_reference_t<
+			timer_manager_t::elapsed_timers_collector_t > collector )
+	{
+		using timertt_manager_t =
+				timers_details::timer_hierarchical_wheel_manager_t;
+
+		return create_timer_hierarchical_wheel_manager(
+				logger,
+				std::move(collector),
+				timertt_manager_t::default_granularity() );
+	}
+
+SO_5_FUNC timer_manager_unique_ptr_t
+create_timer_hierarchical_wheel_manager(
+	error_logger_shptr_t logger,
+	outliving_reference_t<
+			timer_manager_t::elapsed_timers_collector_t > collector,
+	std::chrono::steady_clock::duration granularity )
+	{
+		using timertt_manager_t =
+				timers_details::timer_hierarchical_wheel_manager_t;
+		using namespace timers_details;
+
+		auto manager = stdcpp::make_unique< timertt_manager_t >(
+				granularity,
+				create_error_logger_for_timertt( logger ),
+				create_exception_handler_for_timertt_manager( logger ) );
+
+		return stdcpp::make_unique< actual_manager_t< timertt_manager_t > >(
+				std::move( manager ),
+				std::move( collector ) );
+	}
+
 } /* namespace so_5 */
 
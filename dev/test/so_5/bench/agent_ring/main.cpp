@@ -23,7 +23,8 @@ enum class dispatcher_type_t
 enum class queue_lock_type_t
 {
 	combined,
-	simple
+	simple,
+	futex
 };
 
 enum class pool_fifo_t
@@ -73,7 +74,7 @@ try_parse_cmdline(
 							"                     adv_thread_pool,\n"
 							"                     prio_ot_strictly_ordered\n"
 							"-L, --queue-lock     type of queue lock to be used:\n"
-							"                     combined, simple\n"
+							"                     combined, simple, futex\n"
 							"-f, --fifo           type of fifo for dispatcher with "
 								"thread pool:\n"
 							"                     cooperation, individual (default)\n"
@@ -121,6 +122,8 @@ try_parse_cmdline(
 						tmp_cfg.m_queue_lock_type = queue_lock_type_t::combined;
 					else if( "simple" == name )
 						tmp_cfg.m_queue_lock_type = queue_lock_type_t::simple;
+					else if( "futex" == name )
+						tmp_cfg.m_queue_lock_type = queue_lock_type_t::futex;
 					else
 						throw std::runtime_error( "unsupported queue lock type: " + name );
 				}
@@ -249,8 +252,10 @@ queue_lock_type_name( queue_lock_type_t t )
 	{
 		if( queue_lock_type_t::combined == t )
 			return "combined";
-		else
+		else if( queue_lock_type_t::simple == t )
 			return "simple";
+		else
+			return "futex";
 	}
 
 const char *
@@ -308,12 +313,14 @@ template<
 	typename DISP_PARAMS,
 	typename COMBINED_FACTORY,
 	typename SIMPLE_FACTORY,
+	typename FUTEX_FACTORY,
 	typename QUEUE_PARAMS_TUNER >
 DISP_PARAMS
 make_disp_params(
 	const cfg_t & cfg,
 	COMBINED_FACTORY combined_factory,
 	SIMPLE_FACTORY simple_factory,
+	FUTEX_FACTORY futex_factory,
 	QUEUE_PARAMS_TUNER queue_params_tuner )
 	{
 		DISP_PARAMS disp_params;
@@ -323,6 +330,8 @@ make_disp_params(
 		disp_params.tune_queue_params( [&]( queue_params_t & p ) {
 				if( queue_lock_type_t::simple == cfg.m_queue_lock_type )
 					p.lock_factory( simple_factory() );
+				else if( queue_lock_type_t::futex == cfg.m_queue_lock_type )
+					p.lock_factory( futex_factory() );
 				else
 					p.lock_factory( combined_factory() );
 				queue_params_tuner( p );
@@ -343,6 +352,7 @@ create_disp_binder(
 					cfg,
 					[]{ return queue_traits::combined_lock_factory(); },
 					[]{ return queue_traits::simple_lock_factory(); },
+					[]{ return queue_traits::futex_lock_factory(); },
 					[]( queue_traits::queue_params_t & ) {} );
 			return create_private_disp( env, "disp", disp_params )->binder();
 		}
@@ -353,6 +363,7 @@ create_disp_binder(
 					cfg,
 					[]{ return queue_traits::combined_lock_factory(); },
 					[]{ return queue_traits::simple_lock_factory(); },
+					[]{ return queue_traits::futex_lock_factory(); },
 					[&cfg]( queue_traits::queue_params_t & qp ) {
 						qp.next_thread_wakeup_threshold(
 								cfg.m_next_thread_wakeup_threshold );
@@ -370,6 +381,7 @@ create_disp_binder(
 					cfg,
 					[]{ return queue_traits::combined_lock_factory(); },
 					[]{ return queue_traits::simple_lock_factory(); },
+					[]{ return queue_traits::futex_lock_factory(); },
 					[&cfg]( queue_traits::queue_params_t & qp ) {
 						qp.next_thread_wakeup_threshold(
 								cfg.m_next_thread_wakeup_threshold );
@@ -387,6 +399,7 @@ create_disp_binder(
 					cfg,
 					[]{ return queue_traits::combined_lock_factory(); },
 					[]{ return queue_traits::simple_lock_factory(); },
+					[]{ return queue_traits::futex_lock_factory(); },
 					[]( queue_traits::queue_params_t & ) {} );
 			return create_private_disp( env, "disp", disp_params )->binder();
 		}
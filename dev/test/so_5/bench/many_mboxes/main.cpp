@@ -19,7 +19,8 @@ enum class subscr_storage_type_t
 	{
 		vector_based,
 		map_based,
-		hash_table_based
+		hash_table_based,
+		flat_hash_based
 	};
 
 const char *
@@ -29,8 +30,10 @@ subscr_storage_name( subscr_storage_type_t type )
 			return "vector_based";
 		else if( subscr_storage_type_t::map_based == type )
 			return "map_based";
-		else
+		else if( subscr_storage_type_t::hash_table_based == type )
 			return "hash_table_based";
+		else
+			return "flat_hash_based";
 	}
 
 struct cfg_t
@@ -68,7 +71,7 @@ try_parse_cmdline(
 							"-i, --iterations       count of iterations for every "
 									"message type\n"
 							"-s, --storage-type     type of subscription storage\n"
-							"                       allowed values: vector, map, hash\n"
+							"                       allowed values: vector, map, hash, flat\n"
 							"-V, --vector-capacity  initial capacity of vector-based"
 									"subscription storage\n"
 							"-h, --help        show this description\n"
@@ -107,6 +110,8 @@ try_parse_cmdline(
 						tmp_cfg.m_subscr_storage = subscr_storage_type_t::map_based;
 					else if( "hash" == type )
 						tmp_cfg.m_subscr_storage = subscr_storage_type_t::hash_table_based;
+					else if( "flat" == type )
+						tmp_cfg.m_subscr_storage = subscr_storage_type_t::flat_hash_based;
 					else
 						throw std::runtime_error(
 								std::string( "unsupported subscription storage type: " ) +
@@ -453,8 +458,10 @@ factory_by_cfg( const cfg_t & cfg )
 					cfg.m_vector_subscr_storage_capacity );
 		else if( subscr_storage_type_t::map_based == type )
 			return map_based_subscription_storage_factory();
-		else
+		else if( subscr_storage_type_t::hash_table_based == type )
 			return hash_table_based_subscription_storage_factory();
+		else
+			return flat_hash_subscription_storage_factory();
 	}
 
 int
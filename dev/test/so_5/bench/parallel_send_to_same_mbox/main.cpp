@@ -73,9 +73,11 @@ void
 init(
 	so_5::environment_t & env,
 	unsigned int agent_count,
-	unsigned int send_count )
+	unsigned int send_count,
+	bool snapshot_mbox )
 	{
-		auto mbox = env.create_mbox();
+		auto mbox = snapshot_mbox ?
+				env.create_snapshot_mbox() : env.create_mbox();
 
 		auto coop = env.create_coop( "benchmark",
 				so_5::disp::active_obj::create_disp_binder( "active_obj" ) );
@@ -92,8 +94,9 @@ init(
 void
 print_usage()
 {
-	std::cout << "Usage: parallel_sent_to_same_mbox <agent_count> <send_count>\n\n"
-			"<agent_count> and <send_count> must not be 0"
+	std::cout << "Usage: parallel_sent_to_same_mbox <agent_count> <send_count> [snapshot]\n\n"
+			"<agent_count> and <send_count> must not be 0\n"
+			"snapshot: use mbox with lock-free delivery"
 			<< std::endl;
 }
 
@@ -112,7 +115,8 @@ main( int argc, char ** argv )
 		auto ensure_args_validity = []( bool p, const char * msg ) {
 			if( !p ) throw cmd_line_exception( msg );
 		};
-		ensure_args_validity( 3 == argc, "wrong number of arguments" );
+		ensure_args_validity( 3 == argc || 4 == argc,
+				"wrong number of arguments" );
 
 		const unsigned int agent_count = static_cast< unsigned int >(std::atoi( argv[1] ));
 		ensure_args_validity( agent_count != 0, "agent_count must not be 0" );
@@ -120,13 +124,18 @@ main( int argc, char ** argv )
 		const unsigned int send_count = static_cast< unsigned int >(std::atoi( argv[2] ));
 		ensure_args_validity( send_count != 0, "send_count must not be 0" );
 
+		const bool snapshot_mbox = ( 4 == argc );
+		if( snapshot_mbox )
+			ensure_args_validity( std::string( "snapshot" ) == argv[3],
+					"unknown mbox type" );
+
 		benchmarker_t benchmark;
 		benchmark.start();
 
 		so_5::launch(
-			[agent_count, send_count]( so_5::environment_t & env )
+			[agent_count, send_count, snapshot_mbox]( so_5::environment_t & env )
 			{
-				init( env, agent_count, send_count );
+				init( env, agent_count, send_count, snapshot_mbox );
 			},
 			[]( so_5::environment_params_t & params )
 			{
@@ -78,6 +78,37 @@ prepared_receive_case( so_5::environment_t & env )
 	bench.finish_and_show_stats( iterations, "prepared_receive_case" );
 }
 
+void
+bulk_prepared_receive_case( so_5::environment_t & env )
+{
+	const std::size_t bulk_size = 100u;
+
+	auto ch1 = so_5::create_mchain( env, bulk_size,
+			so_5::mchain_props::memory_usage_t::preallocated,
+			so_5::mchain_props::overflow_reaction_t::throw_exception );
+
+	unsigned long long iterations = 0u;
+	const unsigned long long max_bulk_iterations = 1000000u;
+
+	const auto prepared = so_5::prepare_receive(
+			from( ch1 ).handle_n( bulk_size ).no_wait_on_empty(),
+			[]( one ) {} );
+
+	benchmarker_t bench;
+	bench.start();
+
+	while( iterations < max_bulk_iterations )
+	{
+		for( std::size_t i = 0; i != bulk_size; ++i )
+			so_5::send< one >( ch1 );
+
+		so_5::receive( prepared );
+		iterations += bulk_size;
+	}
+
+	bench.finish_and_show_stats( iterations, "bulk_prepared_receive_case" );
+}
+
 int
 main()
 {
@@ -88,6 +119,7 @@ main()
 			{
 				raw_receive_case( env );
 				prepared_receive_case( env );
+				bulk_prepared_receive_case( env );
 			} );
 	}
 	catch( const std::exception & ex )
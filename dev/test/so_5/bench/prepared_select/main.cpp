@@ -78,6 +78,40 @@ prepared_select_case( so_5::environment_t & env )
 	bench.finish_and_show_stats( iterations, "prepared_select_case" );
 }
 
+void
+bulk_prepared_select_case( so_5::environment_t & env )
+{
+	const std::size_t bulk_size = 100u;
+
+	auto ch1 = so_5::create_mchain( env, bulk_size,
+			so_5::mchain_props::memory_usage_t::preallocated,
+			so_5::mchain_props::overflow_reaction_t::throw_exception );
+	auto ch2 = make_mchain( env );
+
+	unsigned long long iterations = 0u;
+	const unsigned long long max_iterations = 1000000u;
+
+	auto prepared = so_5::prepare_select(
+			so_5::from_all().handle_n( bulk_size ).empty_timeout(
+					std::chrono::milliseconds( 100 ) ),
+			case_( ch1, []( int ) {} ),
+			case_( ch2, []( int ) {} ) );
+
+	benchmarker_t bench;
+	bench.start();
+
+	while( iterations < max_iterations )
+	{
+		for( std::size_t i = 0; i != bulk_size; ++i )
+			so_5::send< int >( ch1, static_cast< int >(i) );
+
+		select( prepared );
+		iterations += bulk_size;
+	}
+
+	bench.finish_and_show_stats( iterations, "bulk_prepared_select_case" );
+}
+
 int
 main()
 {
@@ -88,6 +122,7 @@ main()
 			{
 				raw_select_case( env );
 				prepared_select_case( env );
+				bulk_prepared_select_case( env );
 			} );
 	}
 	catch( const std::exception & ex )
@@ -1,5 +1,6 @@
 #include <iostream>
 #include <chrono>
+#include <cstring>
 
 #include <so_5/all.hpp>
 
@@ -83,15 +84,22 @@ size_t pool_size()
 	return c > 1 ? c - 1 : 1;
 }
 
-int main()
+int main( int argc, char ** argv )
 {
+	const bool work_stealing = argc > 1 && 0 == std::strcmp( argv[ 1 ], "-w" );
+
 	number result = 0;
 
 	using clock_type = std::chrono::high_resolution_clock;
 	const auto start_at = clock_type::now();
 
-	so_5::launch( [&result]( environment_t & env ) {
-		auto tp_disp = disp::thread_pool::create_private_disp( env, pool_size() );
+	so_5::launch( [&result, work_stealing]( environment_t & env ) {
+		disp::thread_pool::disp_params_t params;
+		params.thread_count( pool_size() );
+		if( work_stealing )
+			params.work_stealing();
+
+		auto tp_disp = disp::thread_pool::create_private_disp( env, params, std::string() );
 
 		auto result_ch = env.create_mchain( make_unlimited_mchain_params() );
 
@@ -39,6 +39,8 @@ struct cfg_t
 		std::size_t m_messages_to_send_at_start = 1;
 		lock_type_t m_lock_type = lock_type_t::combined_lock;
 		bool m_track_activity = false;
+		bool m_work_stealing = false;
+		bool m_lock_free_queue = false;
 	};
 
 cfg_t
@@ -67,6 +69,8 @@ try_parse_cmdline(
 							"-P, --adv-thread-pool   use adv_thread_pool dispatcher\n"
 							"-s, --simple-lock       use simple_lock_factory for MPMC queue\n"
 							"-T, --track-activity    turn work thread activity tracking on\n"
+							"-w, --work-stealing     use work stealing mode of thread_pool\n"
+							"-l, --lock-free-queue   use lock-free MPMC queue\n"
 							"-h, --help              show this description\n"
 							<< std::endl;
 					std::exit(1);
@@ -113,6 +117,12 @@ try_parse_cmdline(
 			else if( is_arg( *current, "-T", "--track-activity" ) )
 				tmp_cfg.m_track_activity = true;
 
+			else if( is_arg( *current, "-w", "--work-stealing" ) )
+				tmp_cfg.m_work_stealing = true;
+
+			else if( is_arg( *current, "-l", "--lock-free-queue" ) )
+				tmp_cfg.m_lock_free_queue = true;
+
 			else
 				throw std::runtime_error(
 						std::string( "unknown argument: " ) + *current );
@@ -328,9 +338,14 @@ show_cfg( const cfg_t & cfg )
 			<< (lock_type_t::combined_lock == cfg.m_lock_type ?
 					"combined" : "simple")
 			<< std::endl;
+	std::cout << "  lock-free MPMC queue: "
+			<< (cfg.m_lock_free_queue ? "on" : "off") << std::endl;
 
 	if( dispatcher_t::thread_pool == cfg.m_dispatcher ) 
 	{
+		std::cout << "  work stealing: "
+				<< (cfg.m_work_stealing ? "on" : "off") << std::endl;
+
 		std::cout << "\n*** demands_at_once: ";
 		if( cfg.m_demands_at_once )
 			std::cout << cfg.m_demands_at_once;
@@ -381,6 +396,10 @@ create_dispatcher( const cfg_t & cfg )
 		if( lock_type_t::simple_lock == cfg.m_lock_type )
 			params.set_queue_params( queue_traits::queue_params_t{}
 					.lock_factory( queue_traits::simple_lock_factory() ) );
+		if( cfg.m_lock_free_queue )
+			params.tune_queue_params( []( queue_traits::queue_params_t & p ) {
+					p.lock_free_queue( true );
+				} );
 
 		return create_disp( params );
 	}
@@ -392,6 +411,12 @@ create_dispatcher( const cfg_t & cfg )
 		if( lock_type_t::simple_lock == cfg.m_lock_type )
 			params.set_queue_params( queue_traits::queue_params_t{}
 					.lock_factory( queue_traits::simple_lock_factory() ) );
+		if( cfg.m_lock_free_queue )
+			params.tune_queue_params( []( queue_traits::queue_params_t & p ) {
+					p.lock_free_queue( true );
+				} );
+		if( cfg.m_work_stealing )
+			params.work_stealing();
 
 		return create_disp( params );
 	}
@@ -23,4 +23,5 @@ MxxRu::Cpp::composite_target {
 	required_prj( "#{path}/user_resource/prj.ut.rb" )
 	required_prj( "#{path}/introduce_coop/prj.ut.rb" )
 	required_prj( "#{path}/create_child_coop_5_5_8/prj.ut.rb" )
+	required_prj( "#{path}/push_during_shutdown/prj.ut.rb" )
 }
@@ -0,0 +1,113 @@
+/*
+ * A test for pushing events to an agent while the agent is being
+ * deregistered.
+ *
+ * Several threads send messages to an agent all the time. The agent
+ * deregisters its cooperation. No events must be handled after
+ * so_evt_finish().
+ */
+
+#include <so_5/all.hpp>
+
+#include <various_helpers_1/time_limited_execution.hpp>
+
+#include <utest_helper_1/h/helper.hpp>
+
+#include <atomic>
+#include <future>
+#include <thread>
+#include <vector>
+
+const int iterations = 50;
+const int senders_count = 4;
+
+struct sig : public so_5::signal_t {};
+
+class a_test_t final : public so_5::agent_t
+{
+public :
+	a_test_t(
+		context_t ctx,
+		so_5::mbox_t mbox,
+		std::promise< void > & finished )
+		:	so_5::agent_t{ ctx }
+		,	m_mbox{ std::move(mbox) }
+		,	m_finished{ finished }
+	{}
+
+	virtual void
+	so_define_agent() override
+	{
+		so_subscribe( m_mbox ).event( &a_test_t::evt_sig );
+	}
+
+	virtual void
+	so_evt_finish() override
+	{
+		m_finish_called = true;
+		m_finished.set_value();
+	}
+
+private :
+	const so_5::mbox_t m_mbox;
+	std::promise< void > & m_finished;
+
+	bool m_finish_called = false;
+	int m_received = 0;
+
+	void
+	evt_sig( mhood_t< sig > )
+	{
+		UT_CHECK_CONDITION( !m_finish_called );
+
+		if( 1000 == ++m_received )
+			so_deregister_agent_coop_normally();
+	}
+};
+
+void
+run_iteration( so_5::environment_t & env )
+{
+	auto mbox = env.create_mbox();
+
+	std::promise< void > finished;
+	auto finished_future = finished.get_future();
+
+	env.introduce_coop( [&]( so_5::coop_t & coop ) {
+			coop.make_agent< a_test_t >( mbox, finished );
+		} );
+
+	std::atomic< bool > stop{ false };
+	std::vector< std::thread > senders;
+	for( int i = 0; i != senders_count; ++i )
+		senders.emplace_back( [&] {
+				while( !stop.load( std::memory_order_acquire ) )
+					so_5::send< sig >( mbox );
+			} );
+
+	finished_future.wait();
+
+	// Messages are still sent for some time after so_evt_finish.
+	std::this_thread::sleep_for( std::chrono::milliseconds(10) );
+
+	stop.store( true, std::memory_order_release );
+	for( auto & t : senders )
+		t.join();
+}
+
+int
+main()
+{
+	run_with_time_limit(
+		[]()
+		{
+			so_5::wrapped_env_t env;
+
+			for( int i = 0; i != iterations; ++i )
+				run_iteration( env.environment() );
+		},
+		60,
+		"push during shutdown" );
+
+	return 0;
+}
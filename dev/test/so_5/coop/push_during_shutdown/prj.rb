@@ -0,0 +1,10 @@
+require 'mxx_ru/cpp'
+MxxRu::Cpp::exe_target {
+
+	required_prj( "so_5/prj.rb" )
+
+	target( "_unit.test.coop.push_during_shutdown" )
+
+	cpp_source( "main.cpp" )
+}
+
@@ -12,6 +12,8 @@ MxxRu::Cpp::composite_target {
 
 	add_test[ 'private_dispatchers/build_tests.rb' ]
 
+	add_test[ 'thread_placement/prj.ut.rb' ]
+
 	add_test[ 'prio_ot_strictly_ordered/build_tests.rb' ]
 	add_test[ 'prio_ot_quoted_round_robin/build_tests.rb' ]
 
@@ -0,0 +1,200 @@
+/*
+ * A test for placement of work threads of dispatchers.
+ *
+ * Work threads of every dispatcher are bound to the first CPU available
+ * for the test. Agents check that they are running on that CPU.
+ * Creation of a dispatcher with wrong placement must fail.
+ */
+
+#include <so_5/all.hpp>
+
+#include <various_helpers_1/time_limited_execution.hpp>
+
+#include <utest_helper_1/h/helper.hpp>
+
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+	#include <sched.h>
+#endif
+
+using so_5::disp::reuse::thread_placement_t;
+
+struct msg_check final : public so_5::signal_t {};
+
+class a_test_t final : public so_5::agent_t
+{
+public :
+	a_test_t( context_t ctx, int cpu )
+		:	so_5::agent_t{ ctx }
+		,	m_cpu{ cpu }
+	{
+		so_subscribe_self().event< msg_check >( &a_test_t::evt_check );
+	}
+
+	virtual void
+	so_evt_start() override
+	{
+		so_5::send< msg_check >( *this );
+	}
+
+private :
+	const int m_cpu;
+
+	void
+	evt_check()
+	{
+#if defined(__linux__)
+		UT_CHECK_EQ( m_cpu, sched_getcpu() );
+#endif
+		so_deregister_agent_coop_normally();
+	}
+};
+
+int
+first_available_cpu()
+{
+#if defined(__linux__)
+	cpu_set_t set;
+	CPU_ZERO( &set );
+	if( 0 == sched_getaffinity( 0, sizeof(set), &set ) )
+		for( int i = 0; i != CPU_SETSIZE; ++i )
+			if( CPU_ISSET( i, &set ) )
+				return i;
+#endif
+	return 0;
+}
+
+using binder_maker_t = std::function<
+	so_5::disp_binder_unique_ptr_t(
+		so_5::environment_t &, const thread_placement_t & ) >;
+
+template< typename Disp_Params >
+Disp_Params
+make_params( const thread_placement_t & placement )
+{
+	Disp_Params params;
+	params.thread_placement( placement );
+	return params;
+}
+
+void
+run_test(
+	const std::string & name,
+	const binder_maker_t & binder_maker )
+{
+	std::cout << name << " -> " << std::flush;
+
+	const int cpu = first_available_cpu();
+
+	run_with_time_limit(
+		[&]()
+		{
+			so_5::launch( [&]( so_5::environment_t & env ) {
+					env.introduce_coop(
+						binder_maker( env, thread_placement_t{}.add_cpu(
+								static_cast< unsigned int >( cpu ) ) ),
+						[cpu]( so_5::coop_t & coop ) {
+							coop.make_agent< a_test_t >( cpu );
+						} );
+				} );
+		},
+		20,
+		name );
+
+#if defined(__linux__)
+	// There is no such CPU. Some dispatchers create work threads at start,
+	// others create them during binding of an agent.
+	bool thrown = false;
+	so_5::launch( [&]( so_5::environment_t & env ) {
+			try
+			{
+				env.introduce_coop(
+					binder_maker( env, thread_placement_t{}.add_cpu( 100000u ) ),
+					[cpu]( so_5::coop_t & coop ) {
+						coop.make_agent< a_test_t >( cpu );
+					} );
+			}
+			catch( const so_5::exception_t & )
+			{
+				thrown = true;
+			}
+			env.stop();
+		} );
+	UT_CHECK_CONDITION( thrown );
+#endif
+
+	std::cout << "OK" << std::endl;
+}
+
+int
+main()
+{
+	run_test( "one_thread",
+		[]( so_5::environment_t & env, const thread_placement_t & p ) {
+			using namespace so_5::disp::one_thread;
+			return create_private_disp( env, "one_thread",
+					make_params< disp_params_t >( p ) )->binder();
+		} );
+
+	run_test( "active_obj",
+		[]( so_5::environment_t & env, const thread_placement_t & p ) {
+			using namespace so_5::disp::active_obj;
+			return create_private_disp( env, "active_obj",
+					make_params< disp_params_t >( p ) )->binder();
+		} );
+
+	run_test( "active_group",
+		[]( so_5::environment_t & env, const thread_placement_t & p ) {
+			using namespace so_5::disp::active_group;
+			return create_private_disp( env, "active_group",
+					make_params< disp_params_t >( p ) )->binder( "group" );
+		} );
+
+	run_test( "thread_pool",
+		[]( so_5::environment_t & env, const thread_placement_t & p ) {
+			using namespace so_5::disp::thread_pool;
+			// The common placement is overridden for the second thread.
+			return create_private_disp( env, "thread_pool",
+					disp_params_t{}
+						.thread_count( 2 )
+						.thread_placement( thread_placement_t{}.add_cpu( 100000u ) )
+						.worker_thread_placement( 0, p )
+						.worker_thread_placement( 1, p ) )
+				->binder( bind_params_t{} );
+		} );
+
+	run_test( "adv_thread_pool",
+		[]( so_5::environment_t & env, const thread_placement_t & p ) {
+			using namespace so_5::disp::adv_thread_pool;
+			return create_private_disp( env, "adv_thread_pool",
+					make_params< disp_params_t >( p ).thread_count( 2 ) )
+				->binder( bind_params_t{} );
+		} );
+
+	run_test( "prio_one_thread::strictly_ordered",
+		[]( so_5::environment_t & env, const thread_placement_t & p ) {
+			using namespace so_5::disp::prio_one_thread::strictly_ordered;
+			return create_private_disp( env, "strictly_ordered",
+					make_params< disp_params_t >( p ) )->binder();
+		} );
+
+	run_test( "prio_one_thread::quoted_round_robin",
+		[]( so_5::environment_t & env, const thread_placement_t & p ) {
+			using namespace so_5::disp::prio_one_thread::quoted_round_robin;
+			return create_private_disp( env, quotes_t{ 10 }, "quoted_round_robin",
+					make_params< disp_params_t >( p ) )->binder();
+		} );
+
+	run_test( "prio_dedicated_threads::one_per_prio",
+		[]( so_5::environment_t & env, const thread_placement_t & p ) {
+			using namespace so_5::disp::prio_dedicated_threads::one_per_prio;
+			return create_private_disp( env, "one_per_prio",
+					make_params< disp_params_t >( p ) )->binder();
+		} );
+
+	return 0;
+}
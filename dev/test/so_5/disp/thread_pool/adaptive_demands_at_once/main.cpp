@@ -0,0 +1,167 @@
+/*
+ * A test for adaptive count of demands to be processed at once
+ * in thread_pool dispatcher.
+ *
+ * There are two agents with individual FIFO on a dispatcher with one
+ * work thread. One agent has very fast event handlers, another one
+ * has slow event handlers. The fast agent must get the upper limit
+ * of demands to be processed at once. The slow agent must get a small
+ * value because the processing of its demands would exceed the latency
+ * budget.
+ *
+ * Current values are checked via run-time monitoring.
+ */
+
+#include <iostream>
+#include <chrono>
+#include <thread>
+#include <exception>
+#include <stdexcept>
+#include <string>
+
+#include <so_5/all.hpp>
+
+#include <various_helpers_1/time_limited_execution.hpp>
+
+namespace tp_disp = so_5::disp::thread_pool;
+
+const std::size_t upper_limit = 64;
+
+class a_worker_t : public so_5::agent_t
+{
+	struct next : public so_5::signal_t {};
+
+public :
+	a_worker_t(
+		context_t ctx,
+		std::chrono::steady_clock::duration work_time )
+		:	so_5::agent_t( ctx )
+		,	m_work_time( work_time )
+	{}
+
+	virtual void
+	so_define_agent() override
+	{
+		so_subscribe_self().event< next >( &a_worker_t::evt_next );
+	}
+
+	virtual void
+	so_evt_start() override
+	{
+		// Several demands are always in the queue.
+		for( int i = 0; i != 10; ++i )
+			so_5::send< next >( *this );
+	}
+
+private :
+	const std::chrono::steady_clock::duration m_work_time;
+
+	void
+	evt_next()
+	{
+		if( m_work_time > std::chrono::steady_clock::duration::zero() )
+			std::this_thread::sleep_for( m_work_time );
+
+		so_5::send< next >( *this );
+	}
+};
+
+class a_monitor_t : public so_5::agent_t
+{
+public :
+	a_monitor_t( context_t ctx )
+		:	so_5::agent_t( ctx )
+	{}
+
+	virtual void
+	so_define_agent() override
+	{
+		so_subscribe( so_environment().stats_controller().mbox() )
+			.event( &a_monitor_t::evt_monitor_quantity );
+	}
+
+	virtual void
+	so_evt_start() override
+	{
+		auto disp = tp_disp::create_private_disp(
+				so_environment(),
+				tp_disp::disp_params_t{}.thread_count( 1 ),
+				"adaptive" );
+
+		so_environment().introduce_coop(
+				disp->binder( tp_disp::bind_params_t{}
+						.fifo( tp_disp::fifo_t::individual )
+						.adaptive_demands_at_once(
+								std::chrono::milliseconds( 10 ),
+								upper_limit ) ),
+				[]( so_5::coop_t & coop ) {
+					coop.make_agent< a_worker_t >(
+							std::chrono::steady_clock::duration::zero() );
+					coop.make_agent< a_worker_t >(
+							std::chrono::milliseconds( 2 ) );
+				} );
+
+		so_environment().stats_controller().set_distribution_period(
+				std::chrono::milliseconds( 50 ) );
+		so_environment().stats_controller().turn_on();
+	}
+
+private :
+	bool m_fast_found = false;
+	bool m_slow_found = false;
+
+	void
+	evt_monitor_quantity(
+		const so_5::stats::messages::quantity< std::size_t > & evt )
+	{
+		namespace stats = so_5::stats;
+
+		if( stats::suffixes::disp_demands_at_once() != evt.m_suffix )
+			return;
+
+		const std::string prefix = evt.m_prefix.c_str();
+		if( 0 != prefix.find( "disp/tp/adaptive/aq/" ) )
+			throw std::runtime_error( "unexpected prefix: " + prefix );
+
+		if( !evt.m_value || evt.m_value > upper_limit )
+			throw std::runtime_error( "unexpected value: " +
+					std::to_string( evt.m_value ) );
+
+		if( upper_limit == evt.m_value )
+			m_fast_found = true;
+		// Processing of 5 demands takes 10ms.
+		else if( evt.m_value <= 5u )
+			m_slow_found = true;
+
+		if( m_fast_found && m_slow_found )
+		{
+			std::cout << "OK" << std::endl;
+			so_environment().stop();
+		}
+	}
+};
+
+int
+main()
+{
+	try
+	{
+		run_with_time_limit(
+			[]()
+			{
+				so_5::launch( []( so_5::environment_t & env ) {
+						env.register_agent_as_coop( so_5::autoname,
+								env.make_agent< a_monitor_t >() );
+					} );
+			},
+			20,
+			"adaptive demands_at_once test" );
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
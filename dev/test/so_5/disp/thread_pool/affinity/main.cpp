@@ -0,0 +1,416 @@
+/*
+ * A test for worker affinity mode of thread_pool dispatcher.
+ *
+ * The first part checks that an agent is always handled on the same
+ * work thread if there is no overload.
+ *
+ * The second part checks that an agent migrates to another work thread
+ * if its last work thread is busy and another work thread is idle.
+ */
+
+#include <iostream>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <thread>
+#include <exception>
+#include <stdexcept>
+#include <string>
+
+#include <so_5/all.hpp>
+
+#include <various_helpers_1/time_limited_execution.hpp>
+
+namespace tp_disp = so_5::disp::thread_pool;
+
+struct ping : public so_5::signal_t {};
+
+struct pong : public so_5::message_t
+{
+	const so_5::agent_t * m_who;
+	std::thread::id m_thread;
+	bool m_blocker_busy;
+
+	pong(
+		const so_5::agent_t * who,
+		std::thread::id thread,
+		bool blocker_busy )
+		:	m_who( who )
+		,	m_thread( thread )
+		,	m_blocker_busy( blocker_busy )
+	{}
+};
+
+//
+// Sticky test.
+//
+
+class a_pinger_t : public so_5::agent_t
+{
+public :
+	a_pinger_t( context_t ctx, so_5::mbox_t monitor )
+		:	so_5::agent_t( ctx )
+		,	m_monitor( std::move(monitor) )
+	{}
+
+	virtual void
+	so_define_agent() override
+	{
+		so_subscribe_self().event< ping >( [this] {
+				so_5::send< pong >( m_monitor,
+						this, std::this_thread::get_id(), false );
+			} );
+	}
+
+private :
+	const so_5::mbox_t m_monitor;
+};
+
+class a_sticky_monitor_t : public so_5::agent_t
+{
+public :
+	a_sticky_monitor_t( context_t ctx )
+		:	so_5::agent_t( ctx )
+	{}
+
+	virtual void
+	so_define_agent() override
+	{
+		so_subscribe_self().event( &a_sticky_monitor_t::evt_pong );
+	}
+
+	virtual void
+	so_evt_start() override
+	{
+		auto disp = tp_disp::create_private_disp(
+				so_environment(),
+				tp_disp::disp_params_t{}
+					.thread_count( agent_count )
+					// All agents can be bound to the same thread.
+					// That thread must not be treated as overloaded.
+					.worker_affinity( agent_count * 2, std::chrono::hours( 1 ) ),
+				"sticky" );
+
+		so_environment().introduce_coop(
+				disp->binder( tp_disp::bind_params_t{}
+						.fifo( tp_disp::fifo_t::individual ) ),
+				[this]( so_5::coop_t & coop ) {
+					for( std::size_t i = 0; i != agent_count; ++i )
+						m_agents[ i ] = coop.make_agent< a_pinger_t >(
+								so_direct_mbox() )->so_direct_mbox();
+				} );
+
+		next_round();
+	}
+
+private :
+	static const std::size_t agent_count = 4;
+	static const int rounds = 100;
+
+	so_5::mbox_t m_agents[ agent_count ];
+
+	std::map< const so_5::agent_t *, std::thread::id > m_threads;
+
+	int m_round = 0;
+	std::size_t m_pongs = 0;
+
+	void
+	next_round()
+	{
+		m_pongs = 0;
+		for( const auto & m : m_agents )
+			so_5::send< ping >( m );
+	}
+
+	void
+	evt_pong( const pong & evt )
+	{
+		auto it = m_threads.find( evt.m_who );
+		if( it == m_threads.end() )
+			m_threads[ evt.m_who ] = evt.m_thread;
+		else if( it->second != evt.m_thread )
+			throw std::runtime_error( "agent migrated to another thread, round: " +
+					std::to_string( m_round ) );
+
+		if( agent_count == ++m_pongs )
+		{
+			if( rounds == ++m_round )
+				so_environment().stop();
+			else
+				next_round();
+		}
+	}
+};
+
+//
+// Migration test.
+//
+
+struct hold : public so_5::signal_t {};
+
+struct held : public so_5::message_t
+{
+	std::thread::id m_thread;
+
+	held( std::thread::id thread ) : m_thread( thread ) {}
+};
+
+struct released : public so_5::signal_t {};
+
+struct block : public so_5::signal_t {};
+
+// Occupies its work thread until release.
+class a_holder_t : public so_5::agent_t
+{
+public :
+	a_holder_t(
+		context_t ctx,
+		so_5::mbox_t monitor,
+		const std::atomic< bool > & release )
+		:	so_5::agent_t( ctx )
+		,	m_monitor( std::move(monitor) )
+		,	m_release( release )
+	{}
+
+	virtual void
+	so_define_agent() override
+	{
+		so_subscribe_self().event< hold >( [this] {
+				so_5::send< held >( m_monitor, std::this_thread::get_id() );
+
+				while( !m_release.load() )
+					std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+
+				so_5::send< released >( m_monitor );
+			} );
+	}
+
+private :
+	const so_5::mbox_t m_monitor;
+	const std::atomic< bool > & m_release;
+};
+
+// Blocks its work thread until ping is handled by another agent.
+class a_blocker_t : public so_5::agent_t
+{
+public :
+	a_blocker_t(
+		context_t ctx,
+		so_5::mbox_t monitor,
+		std::atomic< bool > & busy,
+		const std::atomic< bool > & pinged )
+		:	so_5::agent_t( ctx )
+		,	m_monitor( std::move(monitor) )
+		,	m_busy( busy )
+		,	m_pinged( pinged )
+	{}
+
+	void
+	set_target( so_5::mbox_t target )
+	{
+		m_target = std::move(target);
+	}
+
+	virtual void
+	so_define_agent() override
+	{
+		so_subscribe_self()
+			.event< ping >( [this] {
+				so_5::send< pong >( m_monitor,
+						this, std::this_thread::get_id(), false );
+			} )
+			.event< block >( [this] {
+				m_busy = true;
+				so_5::send< ping >( m_target );
+
+				const auto deadline = std::chrono::steady_clock::now() +
+						std::chrono::seconds( 2 );
+				while( !m_pinged.load() &&
+						std::chrono::steady_clock::now() < deadline )
+					std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+
+				m_busy = false;
+			} );
+	}
+
+private :
+	const so_5::mbox_t m_monitor;
+	std::atomic< bool > & m_busy;
+	const std::atomic< bool > & m_pinged;
+
+	so_5::mbox_t m_target;
+};
+
+class a_migration_target_t : public so_5::agent_t
+{
+public :
+	a_migration_target_t(
+		context_t ctx,
+		so_5::mbox_t monitor,
+		const std::atomic< bool > & blocker_busy,
+		std::atomic< bool > & pinged )
+		:	so_5::agent_t( ctx )
+		,	m_monitor( std::move(monitor) )
+		,	m_blocker_busy( blocker_busy )
+		,	m_pinged( pinged )
+	{}
+
+	virtual void
+	so_define_agent() override
+	{
+		so_subscribe_self().event< ping >( [this] {
+				so_5::send< pong >( m_monitor,
+						this, std::this_thread::get_id(), m_blocker_busy.load() );
+				m_pinged = true;
+			} );
+	}
+
+private :
+	const so_5::mbox_t m_monitor;
+	const std::atomic< bool > & m_blocker_busy;
+	std::atomic< bool > & m_pinged;
+};
+
+class a_migration_monitor_t : public so_5::agent_t
+{
+	enum class stage_t { warm_up, migration };
+
+public :
+	a_migration_monitor_t( context_t ctx )
+		:	so_5::agent_t( ctx )
+	{}
+
+	virtual void
+	so_define_agent() override
+	{
+		so_subscribe_self()
+			.event( &a_migration_monitor_t::evt_held )
+			.event( &a_migration_monitor_t::evt_pong )
+			.event< released >( &a_migration_monitor_t::evt_released );
+	}
+
+	virtual void
+	so_evt_start() override
+	{
+		auto disp = tp_disp::create_private_disp(
+				so_environment(),
+				tp_disp::disp_params_t{}
+					.thread_count( 2 )
+					.worker_affinity( 4u, std::chrono::milliseconds( 1 ) ),
+				"migration" );
+
+		so_environment().introduce_coop(
+				disp->binder( tp_disp::bind_params_t{}
+						.fifo( tp_disp::fifo_t::individual ) ),
+				[this]( so_5::coop_t & coop ) {
+					m_holder = coop.make_agent< a_holder_t >(
+							so_direct_mbox(), m_release )->so_direct_mbox();
+
+					auto blocker = coop.make_agent< a_blocker_t >(
+							so_direct_mbox(), m_blocker_busy, m_pinged );
+					m_blocker = blocker;
+
+					m_target = coop.make_agent< a_migration_target_t >(
+							so_direct_mbox(), m_blocker_busy, m_pinged );
+
+					blocker->set_target( m_target->so_direct_mbox() );
+				} );
+
+		// One work thread is occupied. Both agents must be handled
+		// on another thread.
+		so_5::send< hold >( m_holder );
+	}
+
+private :
+	std::atomic< bool > m_release{ false };
+	std::atomic< bool > m_blocker_busy{ false };
+	std::atomic< bool > m_pinged{ false };
+
+	so_5::mbox_t m_holder;
+	const so_5::agent_t * m_blocker = nullptr;
+	const so_5::agent_t * m_target = nullptr;
+
+	stage_t m_stage = stage_t::warm_up;
+
+	std::thread::id m_holder_thread;
+	std::thread::id m_free_thread;
+	std::size_t m_warm_pongs = 0;
+
+	void
+	evt_held( const held & evt )
+	{
+		m_holder_thread = evt.m_thread;
+
+		so_5::send< ping >( m_blocker->so_direct_mbox() );
+		so_5::send< ping >( m_target->so_direct_mbox() );
+	}
+
+	void
+	evt_pong( const pong & evt )
+	{
+		if( stage_t::warm_up == m_stage )
+		{
+			if( m_holder_thread == evt.m_thread )
+				throw std::runtime_error( "agent is handled on busy thread" );
+
+			m_free_thread = evt.m_thread;
+			if( 2u == ++m_warm_pongs )
+				// Both agents are handled on the same thread now.
+				m_release = true;
+		}
+		else
+		{
+			if( evt.m_who != m_target )
+				throw std::runtime_error( "unexpected pong" );
+
+			if( !evt.m_blocker_busy )
+				throw std::runtime_error( "agent didn't migrate from busy thread" );
+
+			if( m_free_thread == evt.m_thread )
+				throw std::runtime_error( "agent is handled on blocked thread" );
+
+			so_environment().stop();
+		}
+	}
+
+	void
+	evt_released()
+	{
+		m_stage = stage_t::migration;
+		m_pinged = false;
+
+		// The blocker is handled on its last thread and sends ping to
+		// the target which has the same last thread.
+		so_5::send< block >( m_blocker->so_direct_mbox() );
+	}
+};
+
+int
+main()
+{
+	try
+	{
+		run_with_time_limit(
+			[]()
+			{
+				so_5::launch( []( so_5::environment_t & env ) {
+						env.register_agent_as_coop( so_5::autoname,
+								env.make_agent< a_sticky_monitor_t >() );
+					} );
+
+				so_5::launch( []( so_5::environment_t & env ) {
+						env.register_agent_as_coop( so_5::autoname,
+								env.make_agent< a_migration_monitor_t >() );
+					} );
+			},
+			20,
+			"thread_pool worker affinity test" );
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
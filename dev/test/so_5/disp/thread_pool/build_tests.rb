@@ -9,4 +9,10 @@ MxxRu::Cpp::composite_target {
 	required_prj( "#{path}/cooperation_fifo/prj.ut.rb" )
 	required_prj( "#{path}/individual_fifo/prj.ut.rb" )
 	required_prj( "#{path}/threshold/prj.ut.rb" )
+	required_prj( "#{path}/work_stealing/prj.ut.rb" )
+	required_prj( "#{path}/lock_free_queue/prj.ut.rb" )
+	required_prj( "#{path}/elastic/prj.ut.rb" )
+	required_prj( "#{path}/adaptive_demands_at_once/prj.ut.rb" )
+	required_prj( "#{path}/affinity/prj.ut.rb" )
+	required_prj( "#{path}/fair_scheduling/prj.ut.rb" )
 }
@@ -0,0 +1,231 @@
+/*
+ * A test for elastic thread_pool dispatcher.
+ *
+ * The dispatcher starts with one work thread. Several agents block
+ * their work threads for some time. The dispatcher must start new work
+ * threads and then retire them when the load is gone.
+ *
+ * Count of work threads and count of started and retired threads are
+ * checked via run-time monitoring.
+ */
+
+#include <iostream>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <exception>
+#include <stdexcept>
+#include <string>
+
+#include <so_5/all.hpp>
+
+#include <various_helpers_1/time_limited_execution.hpp>
+
+namespace tp_disp = so_5::disp::thread_pool;
+
+const std::size_t worker_count = 4;
+const int work_steps = 3;
+
+struct work_finished : public so_5::signal_t {};
+
+class a_worker_t : public so_5::agent_t
+{
+	struct do_work : public so_5::signal_t {};
+
+public :
+	a_worker_t(
+		context_t ctx,
+		so_5::mbox_t monitor,
+		std::atomic< std::size_t > & in_work,
+		std::atomic< std::size_t > & max_in_work )
+		:	so_5::agent_t( ctx )
+		,	m_monitor( std::move(monitor) )
+		,	m_in_work( in_work )
+		,	m_max_in_work( max_in_work )
+	{}
+
+	virtual void
+	so_define_agent() override
+	{
+		so_subscribe_self().event< do_work >( &a_worker_t::evt_do_work );
+	}
+
+	virtual void
+	so_evt_start() override
+	{
+		so_5::send< do_work >( *this );
+	}
+
+private :
+	const so_5::mbox_t m_monitor;
+	std::atomic< std::size_t > & m_in_work;
+	std::atomic< std::size_t > & m_max_in_work;
+
+	int m_steps = 0;
+
+	void
+	evt_do_work()
+	{
+		const auto current = ++m_in_work;
+		auto max = m_max_in_work.load();
+		while( max < current &&
+				!m_max_in_work.compare_exchange_weak( max, current ) )
+		{}
+
+		// Work thread is blocked for some time.
+		std::this_thread::sleep_for( std::chrono::milliseconds( 150 ) );
+
+		--m_in_work;
+
+		if( ++m_steps < work_steps )
+			so_5::send< do_work >( *this );
+		else
+			so_5::send< work_finished >( m_monitor );
+	}
+};
+
+class a_monitor_t : public so_5::agent_t
+{
+public :
+	a_monitor_t(
+		context_t ctx,
+		tp_disp::queue_traits::queue_params_t queue_params )
+		:	so_5::agent_t( ctx )
+		,	m_queue_params( std::move(queue_params) )
+	{}
+
+	virtual void
+	so_define_agent() override
+	{
+		so_subscribe_self().event< work_finished >(
+				&a_monitor_t::evt_work_finished );
+
+		so_subscribe( so_environment().stats_controller().mbox() )
+			.event( &a_monitor_t::evt_monitor_quantity );
+	}
+
+	virtual void
+	so_evt_start() override
+	{
+		auto disp = tp_disp::create_private_disp(
+				so_environment(),
+				tp_disp::disp_params_t{}
+					.thread_count( 1 )
+					.max_thread_count( worker_count )
+					.idle_thread_linger( std::chrono::milliseconds( 100 ) )
+					.elastic_check_period( std::chrono::milliseconds( 5 ) )
+					.set_queue_params( m_queue_params ),
+				"elastic" );
+
+		so_environment().introduce_coop(
+				disp->binder( tp_disp::bind_params_t{}
+						.fifo( tp_disp::fifo_t::individual ) ),
+				[this]( so_5::coop_t & coop ) {
+					for( std::size_t i = 0; i != worker_count; ++i )
+						coop.make_agent< a_worker_t >(
+								so_direct_mbox(), m_in_work, m_max_in_work );
+				} );
+
+		so_environment().stats_controller().set_distribution_period(
+				std::chrono::milliseconds( 50 ) );
+		so_environment().stats_controller().turn_on();
+	}
+
+private :
+	const tp_disp::queue_traits::queue_params_t m_queue_params;
+
+	std::atomic< std::size_t > m_in_work{ 0 };
+	std::atomic< std::size_t > m_max_in_work{ 0 };
+
+	std::size_t m_finished_workers = 0;
+
+	std::size_t m_max_thread_count = 0;
+	std::size_t m_thread_count = 0;
+	std::size_t m_threads_started = 0;
+	std::size_t m_threads_retired = 0;
+
+	void
+	evt_work_finished()
+	{
+		++m_finished_workers;
+	}
+
+	void
+	evt_monitor_quantity(
+		const so_5::stats::messages::quantity< std::size_t > & evt )
+	{
+		namespace stats = so_5::stats;
+
+		if( stats::prefix_t{ "disp/tp/elastic" } != evt.m_prefix )
+			return;
+
+		if( stats::suffixes::disp_thread_count() == evt.m_suffix )
+		{
+			m_thread_count = evt.m_value;
+			if( m_thread_count > m_max_thread_count )
+				m_max_thread_count = m_thread_count;
+
+			if( m_thread_count > worker_count )
+				throw std::runtime_error( "too many work threads: " +
+						std::to_string( m_thread_count ) );
+		}
+		else if( stats::suffixes::disp_thread_started_count() == evt.m_suffix )
+			m_threads_started = evt.m_value;
+		else if( stats::suffixes::disp_thread_retired_count() == evt.m_suffix )
+			m_threads_retired = evt.m_value;
+		else
+			return;
+
+		if( worker_count == m_finished_workers &&
+				1u == m_thread_count &&
+				0u != m_threads_started &&
+				m_threads_started == m_threads_retired )
+		{
+			std::cout << "max threads: " << m_max_thread_count
+					<< ", started: " << m_threads_started
+					<< ", max parallel work: " << m_max_in_work.load()
+					<< std::endl;
+
+			if( m_max_in_work.load() < 2u )
+				throw std::runtime_error( "work wasn't performed in parallel" );
+
+			so_environment().stop();
+		}
+	}
+};
+
+void
+run_test( tp_disp::queue_traits::queue_params_t queue_params )
+{
+	so_5::launch( [&]( so_5::environment_t & env ) {
+			env.register_agent_as_coop( so_5::autoname,
+					env.make_agent< a_monitor_t >( std::move(queue_params) ) );
+		} );
+}
+
+int
+main()
+{
+	try
+	{
+		run_with_time_limit(
+			[]()
+			{
+				std::cout << "ordinary queue: " << std::flush;
+				run_test( tp_disp::queue_traits::queue_params_t{} );
+
+				std::cout << "lock-free queue: " << std::flush;
+				run_test( tp_disp::queue_traits::queue_params_t{}
+						.lock_free_queue( true ) );
+			},
+			20,
+			"elastic thread_pool test" );
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,182 @@
+/*
+ * A test for weighted fair scheduling in thread_pool dispatcher.
+ *
+ * There are two cooperations on a dispatcher with one work thread.
+ * Agents from both cooperations always have demands to be processed.
+ * Demands from the "heavy" cooperation are processed ten times longer
+ * than demands from the "light" cooperation. But the "light" cooperation
+ * has weight 3 and the "heavy" cooperation has weight 1.
+ *
+ * Service times of cooperations are received via run-time monitoring.
+ * The "light" cooperation must get approximately three times more
+ * service time than the "heavy" one.
+ */
+
+#include <iostream>
+#include <chrono>
+#include <thread>
+#include <exception>
+#include <stdexcept>
+#include <string>
+
+#include <so_5/all.hpp>
+
+#include <various_helpers_1/time_limited_execution.hpp>
+
+namespace tp_disp = so_5::disp::thread_pool;
+
+class a_worker_t : public so_5::agent_t
+{
+	struct next : public so_5::signal_t {};
+
+public :
+	a_worker_t(
+		context_t ctx,
+		std::chrono::steady_clock::duration work_time )
+		:	so_5::agent_t( ctx )
+		,	m_work_time( work_time )
+	{}
+
+	virtual void
+	so_define_agent() override
+	{
+		so_subscribe_self().event< next >( &a_worker_t::evt_next );
+	}
+
+	virtual void
+	so_evt_start() override
+	{
+		// Several demands are always in the queue.
+		for( int i = 0; i != 10; ++i )
+			so_5::send< next >( *this );
+	}
+
+private :
+	const std::chrono::steady_clock::duration m_work_time;
+
+	void
+	evt_next()
+	{
+		std::this_thread::sleep_for( m_work_time );
+
+		so_5::send< next >( *this );
+	}
+};
+
+class a_monitor_t : public so_5::agent_t
+{
+public :
+	a_monitor_t( context_t ctx )
+		:	so_5::agent_t( ctx )
+	{}
+
+	virtual void
+	so_define_agent() override
+	{
+		so_subscribe( so_environment().stats_controller().mbox() )
+			.event( &a_monitor_t::evt_monitor_quantity )
+			.event( &a_monitor_t::evt_distribution_finished );
+	}
+
+	virtual void
+	so_evt_start() override
+	{
+		auto disp = tp_disp::create_private_disp(
+				so_environment(),
+				tp_disp::disp_params_t{}
+					.thread_count( 1 )
+					.fair_scheduling( std::chrono::milliseconds( 2 ) ),
+				"fair" );
+
+		make_coop( *disp, "heavy", 1, std::chrono::milliseconds( 2 ) );
+		make_coop( *disp, "light", 3, std::chrono::microseconds( 200 ) );
+
+		so_environment().stats_controller().set_distribution_period(
+				std::chrono::milliseconds( 250 ) );
+		so_environment().stats_controller().turn_on();
+	}
+
+private :
+	std::size_t m_heavy_time = 0;
+	std::size_t m_light_time = 0;
+
+	void
+	make_coop(
+		tp_disp::private_dispatcher_t & disp,
+		const std::string & name,
+		std::size_t weight,
+		std::chrono::steady_clock::duration work_time )
+	{
+		auto coop = so_environment().create_coop( name,
+				disp.binder( tp_disp::bind_params_t{}
+						.fifo( tp_disp::fifo_t::cooperation )
+						.weight( weight ) ) );
+
+		for( int i = 0; i != 2; ++i )
+			coop->make_agent< a_worker_t >( work_time );
+
+		so_environment().register_coop( std::move( coop ) );
+	}
+
+	void
+	evt_monitor_quantity(
+		const so_5::stats::messages::quantity< std::size_t > & evt )
+	{
+		namespace stats = so_5::stats;
+
+		if( stats::suffixes::disp_service_time() != evt.m_suffix )
+			return;
+
+		if( stats::prefix_t{ "disp/tp/fair/cq/heavy" } == evt.m_prefix )
+			m_heavy_time = evt.m_value;
+		else if( stats::prefix_t{ "disp/tp/fair/cq/light" } == evt.m_prefix )
+			m_light_time = evt.m_value;
+	}
+
+	void
+	evt_distribution_finished(
+		const so_5::stats::messages::distribution_finished & )
+	{
+		// Results are checked when both cooperations are served
+		// long enough.
+		if( m_heavy_time < 200000u || m_light_time < 200000u )
+			return;
+
+		const double ratio = static_cast< double >( m_light_time ) /
+				static_cast< double >( m_heavy_time );
+
+		std::cout << "heavy: " << m_heavy_time << "us, light: "
+				<< m_light_time << "us, ratio: " << ratio << std::endl;
+
+		if( ratio < 2.0 || ratio > 4.5 )
+			throw std::runtime_error( "unexpected ratio of service times: " +
+					std::to_string( ratio ) );
+
+		so_environment().stop();
+	}
+};
+
+int
+main()
+{
+	try
+	{
+		run_with_time_limit(
+			[]()
+			{
+				so_5::launch( []( so_5::environment_t & env ) {
+						env.register_agent_as_coop( so_5::autoname,
+								env.make_agent< a_monitor_t >() );
+					} );
+			},
+			20,
+			"weighted fair scheduling test" );
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,197 @@
+/*
+ * A test for thread_pool dispatcher in work stealing mode.
+ */
+
+#include <iostream>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <exception>
+#include <stdexcept>
+
+#include <so_5/all.hpp>
+
+#include <various_helpers_1/time_limited_execution.hpp>
+
+#include <utest_helper_1/h/helper.hpp>
+
+#include "../for_each_lock_factory.hpp"
+
+namespace tp_disp = so_5::disp::thread_pool;
+
+const std::size_t cooperation_count = 64;
+const std::size_t cooperation_size = 8;
+const int values_count = 200;
+
+using busy_flag_t = std::shared_ptr< std::atomic< bool > >;
+
+struct value : public so_5::message_t
+{
+	int m_v;
+
+	value( int v ) : m_v( v ) {}
+};
+
+struct poke : public so_5::signal_t {};
+
+/*
+ * Every agent sends a sequence of values to itself and pokes
+ * an agent from another cooperation on every value.
+ *
+ * Busy flag is shared between agents with the same event queue.
+ * It allows to check that events from one queue are never handled
+ * on different threads at the same time.
+ */
+class a_test_t : public so_5::agent_t
+{
+public :
+	a_test_t(
+		context_t ctx,
+		busy_flag_t busy,
+		std::atomic< std::size_t > & working_agents )
+		:	so_5::agent_t( ctx )
+		,	m_busy( std::move(busy) )
+		,	m_working_agents( working_agents )
+	{}
+
+	void
+	set_neighbour( so_5::mbox_t neighbour )
+	{
+		m_neighbour = std::move(neighbour);
+	}
+
+	virtual void
+	so_define_agent() override
+	{
+		so_subscribe_self()
+			.event( &a_test_t::evt_value )
+			.event< poke >( &a_test_t::evt_poke );
+	}
+
+	virtual void
+	so_evt_start() override
+	{
+		so_5::send< value >( *this, 0 );
+	}
+
+private :
+	const busy_flag_t m_busy;
+	std::atomic< std::size_t > & m_working_agents;
+	so_5::mbox_t m_neighbour;
+
+	int m_expected = 0;
+
+	void
+	enter()
+	{
+		UT_CHECK_CONDITION( !m_busy->exchange( true ) );
+	}
+
+	void
+	leave()
+	{
+		m_busy->store( false );
+	}
+
+	void
+	evt_value( const value & v )
+	{
+		enter();
+
+		UT_CHECK_CONDITION( m_expected == v.m_v );
+		++m_expected;
+
+		so_5::send< poke >( m_neighbour );
+
+		if( m_expected < values_count )
+			so_5::send< value >( *this, m_expected );
+		else if( 0 == --m_working_agents )
+			so_environment().stop();
+
+		leave();
+	}
+
+	void
+	evt_poke()
+	{
+		enter();
+		leave();
+	}
+};
+
+void
+run_test(
+	tp_disp::queue_traits::lock_factory_t factory,
+	tp_disp::fifo_t fifo )
+{
+	std::atomic< std::size_t > working_agents{
+			cooperation_count * cooperation_size };
+
+	so_5::launch( [&]( so_5::environment_t & env ) {
+			auto disp = tp_disp::create_private_disp( env,
+					tp_disp::disp_params_t{}
+						.thread_count( 4 )
+						.work_stealing()
+						.set_queue_params( tp_disp::queue_traits::queue_params_t{}
+							.lock_factory( factory ) ),
+					std::string() );
+
+			std::vector< std::vector< a_test_t * > > agents( cooperation_count );
+			std::vector< so_5::coop_unique_ptr_t > coops;
+
+			for( std::size_t i = 0; i != cooperation_count; ++i )
+			{
+				coops.push_back( env.create_coop( so_5::autoname,
+						disp->binder( tp_disp::bind_params_t{}
+								.fifo( fifo )
+								.max_demands_at_once( 4 ) ) ) );
+
+				auto coop_busy = std::make_shared< std::atomic< bool > >( false );
+				for( std::size_t a = 0; a != cooperation_size; ++a )
+					agents[ i ].push_back( coops.back()->make_agent< a_test_t >(
+							tp_disp::fifo_t::cooperation == fifo ?
+								coop_busy :
+								std::make_shared< std::atomic< bool > >( false ),
+							working_agents ) );
+			}
+
+			for( std::size_t i = 0; i != cooperation_count; ++i )
+				for( std::size_t a = 0; a != cooperation_size; ++a )
+					agents[ i ][ a ]->set_neighbour(
+							agents[ (i + 1) % cooperation_count ][ a ]->
+									so_direct_mbox() );
+
+			for( auto & c : coops )
+				env.register_coop( std::move(c) );
+		} );
+}
+
+int
+main()
+{
+	try
+	{
+		for_each_lock_factory( []( tp_disp::queue_traits::lock_factory_t factory ) {
+			run_with_time_limit(
+				[&]()
+				{
+					std::cout << "cooperation fifo: " << std::flush;
+					run_test( factory, tp_disp::fifo_t::cooperation );
+					std::cout << "OK" << std::endl;
+
+					std::cout << "individual fifo: " << std::flush;
+					run_test( factory, tp_disp::fifo_t::individual );
+					std::cout << "OK" << std::endl;
+				},
+				60,
+				"work_stealing test" );
+			} );
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
@@ -61,7 +61,9 @@ main()
 		timer_info_t timers[] = {
 			{ "timer_wheel", so_5::timer_wheel_manager_factory() },
 			{ "timer_heap", so_5::timer_heap_manager_factory() },
-			{ "timer_list", so_5::timer_list_manager_factory() }
+			{ "timer_list", so_5::timer_list_manager_factory() },
+			{ "timer_hierarchical_wheel",
+					so_5::timer_hierarchical_wheel_manager_factory() }
 		};
 
 		for( const auto & t : timers )
@@ -0,0 +1,159 @@
+/*
+ * A test for getting count of timers from run-time monitoring messages
+ * for sharded timer thread.
+ *
+ * Timers are sent to different mboxes from different threads so they
+ * are handled by different shards. Monitoring messages must contain
+ * total count of timers.
+ */
+
+#include <iostream>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <chrono>
+#include <vector>
+
+#include <so_5/all.hpp>
+
+#include <various_helpers_1/time_limited_execution.hpp>
+
+const unsigned int shards_count = 4;
+
+class a_test_t : public so_5::agent_t
+	{
+	public :
+		struct msg_delayed : so_5::signal_t {};
+		struct msg_fast : so_5::signal_t {};
+
+		a_test_t( context_t ctx )
+			:	so_5::agent_t( ctx )
+			{}
+
+		virtual void
+		so_define_agent() override
+			{
+				so_default_state()
+					.event(
+						so_environment().stats_controller().mbox(),
+						&a_test_t::evt_monitor_quantity )
+					.event< msg_fast >( &a_test_t::evt_fast );
+			}
+
+		virtual void
+		so_evt_start() override
+			{
+				using namespace std::chrono;
+
+				// Timers are scheduled from several threads.
+				m_periodic.resize( shards_count );
+				std::vector< std::thread > threads;
+				for( auto & ids : m_periodic )
+					threads.emplace_back( [this, &ids] {
+							for( int j = 0; j != 2; ++j )
+								so_5::send_delayed< msg_delayed >(
+										so_environment(),
+										so_environment().create_mbox(),
+										seconds( 10 ) );
+
+							for( int j = 0; j != 3; ++j )
+								ids.push_back( so_5::send_periodic< msg_delayed >(
+										so_environment(),
+										so_environment().create_mbox(),
+										seconds( 10 ), seconds( 10 ) ) );
+						} );
+				for( auto & t : threads )
+					t.join();
+
+				// Timers must also work.
+				so_5::send_delayed< msg_fast >( *this, milliseconds( 50 ) );
+			}
+
+	private :
+		std::vector< std::vector< so_5::timer_id_t > > m_periodic;
+
+		bool m_fast_received = false;
+		unsigned int m_actual_values = { 0 };
+
+		void
+		evt_fast()
+			{
+				m_fast_received = true;
+
+				so_environment().stats_controller().turn_on();
+			}
+
+		void
+		evt_monitor_quantity(
+			const so_5::stats::messages::quantity< std::size_t > & evt )
+			{
+				namespace stats = so_5::stats;
+
+				if( stats::prefixes::timer_thread() == evt.m_prefix )
+					{
+						std::cout << evt.m_prefix.c_str()
+								<< evt.m_suffix.c_str()
+								<< ": " << evt.m_value << std::endl;
+
+						if( stats::suffixes::timer_single_shot_count() == evt.m_suffix )
+							{
+								if( 2 * shards_count != evt.m_value )
+									throw std::runtime_error( "unexpected count of "
+											"single-shot timers: " +
+											std::to_string( evt.m_value ) );
+								else
+									++m_actual_values;
+							}
+						else if( stats::suffixes::timer_periodic_count() == evt.m_suffix )
+							{
+								if( 3 * shards_count != evt.m_value )
+									throw std::runtime_error( "unexpected count of "
+											"periodic timers: " +
+											std::to_string( evt.m_value ) );
+								else
+									++m_actual_values;
+							}
+					}
+
+				if( 2 == m_actual_values && m_fast_received )
+					so_deregister_agent_coop_normally();
+			}
+	};
+
+void
+run_test( so_5::timer_shard_selector_t selector )
+	{
+		so_5::launch(
+			[]( so_5::environment_t & env ) {
+				env.register_agent_as_coop( so_5::autoname,
+						env.make_agent< a_test_t >() );
+			},
+			[selector]( so_5::environment_params_t & params ) {
+				params.timer_thread(
+						so_5::timer_sharded_factory( shards_count, selector ) );
+			} );
+	}
+
+int
+main()
+{
+	try
+	{
+		run_with_time_limit(
+			[]()
+			{
+				run_test( so_5::timer_shard_selector_t::by_mbox );
+				run_test( so_5::timer_shard_selector_t::by_calling_thread );
+			},
+			20,
+			"sharded timer thread monitoring test" );
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
@@ -326,6 +326,16 @@ do_test()
 					threshold,
 					hash_table_based_subscription_storage_factory(),
 					map_based_subscription_storage_factory() ) }
+	,	{ "vector+flat_hash",
+			adaptive_subscription_storage_factory(
+					threshold,
+					vector_based_subscription_storage_factory( threshold ),
+					flat_hash_subscription_storage_factory() ) }
+	,	{ "flat_hash+map",
+			adaptive_subscription_storage_factory(
+					threshold,
+					flat_hash_subscription_storage_factory(),
+					map_based_subscription_storage_factory() ) }
 	,	{ "vector+map",
 			adaptive_subscription_storage_factory(
 					threshold,
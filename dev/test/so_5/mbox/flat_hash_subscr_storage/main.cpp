@@ -0,0 +1,165 @@
+/*
+ * A test for flat hash subscription storage with many subscriptions.
+ *
+ * Subscriptions are created and dropped in pseudo-random order. After
+ * every change the presence of all possible subscriptions is compared
+ * with a reference set.
+ */
+
+#include <so_5/all.hpp>
+
+#include <various_helpers_1/time_limited_execution.hpp>
+
+#include <utest_helper_1/h/helper.hpp>
+
+#include <memory>
+#include <random>
+#include <set>
+#include <tuple>
+#include <vector>
+
+const std::size_t states_count = 200;
+const std::size_t mboxes_count = 4;
+const int operations_count = 3000;
+
+struct msg_a : public so_5::signal_t {};
+struct msg_b : public so_5::signal_t {};
+
+class a_test_t : public so_5::agent_t
+{
+	using key_t = std::tuple< std::size_t, int, std::size_t >;
+
+public :
+	a_test_t( context_t ctx )
+		:	so_5::agent_t( ctx + so_5::flat_hash_subscription_storage_factory() )
+	{
+		for( std::size_t i = 0; i != states_count; ++i )
+			m_states.emplace_back( new state_t( this ) );
+
+		for( std::size_t i = 0; i != mboxes_count; ++i )
+			m_mboxes.push_back( so_environment().create_mbox() );
+	}
+
+	virtual void
+	so_evt_start() override
+	{
+		std::mt19937 rng{ 42u };
+		std::uniform_int_distribution< std::size_t > mbox_dist{
+				0u, mboxes_count - 1u };
+		std::uniform_int_distribution< int > type_dist{ 0, 1 };
+		std::uniform_int_distribution< std::size_t > state_dist{
+				0u, states_count - 1u };
+		std::uniform_int_distribution< int > drop_all_dist{ 0, 99 };
+
+		for( int i = 0; i != operations_count; ++i )
+		{
+			const key_t key{ mbox_dist( rng ), type_dist( rng ), state_dist( rng ) };
+
+			if( 0 == drop_all_dist( rng ) )
+				drop_for_all_states( std::get<0>( key ), std::get<1>( key ) );
+			else if( m_expected.count( key ) )
+				drop( key );
+			else
+				subscribe( key );
+
+			if( 0 == i % 10 )
+				check_all();
+		}
+
+		check_all();
+
+		so_deregister_agent_coop_normally();
+	}
+
+private :
+	std::vector< std::unique_ptr< state_t > > m_states;
+	std::vector< so_5::mbox_t > m_mboxes;
+
+	std::set< key_t > m_expected;
+
+	void
+	evt_a( mhood_t< msg_a > ) {}
+
+	void
+	evt_b( mhood_t< msg_b > ) {}
+
+	void
+	subscribe( const key_t & key )
+	{
+		auto & mbox = m_mboxes[ std::get<0>( key ) ];
+		auto & state = *m_states[ std::get<2>( key ) ];
+
+		if( 0 == std::get<1>( key ) )
+			so_subscribe( mbox ).in( state ).event( &a_test_t::evt_a );
+		else
+			so_subscribe( mbox ).in( state ).event( &a_test_t::evt_b );
+
+		m_expected.insert( key );
+	}
+
+	void
+	drop( const key_t & key )
+	{
+		auto & mbox = m_mboxes[ std::get<0>( key ) ];
+		auto & state = *m_states[ std::get<2>( key ) ];
+
+		if( 0 == std::get<1>( key ) )
+			so_drop_subscription< msg_a >( mbox, state );
+		else
+			so_drop_subscription< msg_b >( mbox, state );
+
+		m_expected.erase( key );
+	}
+
+	void
+	drop_for_all_states( std::size_t mbox_index, int type )
+	{
+		auto & mbox = m_mboxes[ mbox_index ];
+
+		if( 0 == type )
+			so_drop_subscription_for_all_states< msg_a >( mbox );
+		else
+			so_drop_subscription_for_all_states< msg_b >( mbox );
+
+		for( auto it = m_expected.begin(); it != m_expected.end(); )
+			if( std::get<0>( *it ) == mbox_index && std::get<1>( *it ) == type )
+				it = m_expected.erase( it );
+			else
+				++it;
+	}
+
+	void
+	check_all()
+	{
+		for( std::size_t m = 0; m != mboxes_count; ++m )
+			for( std::size_t s = 0; s != states_count; ++s )
+			{
+				const auto & state = *m_states[ s ];
+
+				UT_CHECK_CONDITION(
+						so_has_subscription< msg_a >( m_mboxes[ m ], state ) ==
+						( 0u != m_expected.count( key_t{ m, 0, s } ) ) );
+				UT_CHECK_CONDITION(
+						so_has_subscription< msg_b >( m_mboxes[ m ], state ) ==
+						( 0u != m_expected.count( key_t{ m, 1, s } ) ) );
+			}
+	}
+};
+
+int
+main()
+{
+	run_with_time_limit(
+		[]()
+		{
+			so_5::launch( []( so_5::environment_t & env ) {
+					env.introduce_coop( []( so_5::coop_t & coop ) {
+							coop.make_agent< a_test_t >();
+						} );
+				} );
+		},
+		60,
+		"flat hash subscription storage" );
+
+	return 0;
+}
@@ -0,0 +1,186 @@
+/*
+ * A test for MPMC mbox with lock-free delivery.
+ */
+
+#include <so_5/all.hpp>
+
+#include <various_helpers_1/time_limited_execution.hpp>
+
+#include <utest_helper_1/h/helper.hpp>
+
+#include <thread>
+#include <atomic>
+
+using namespace std;
+
+struct value : public so_5::message_t
+{
+	int m_v;
+
+	value( int v ) : m_v( v ) {}
+};
+
+struct churn : public so_5::signal_t {};
+struct next_turn : public so_5::signal_t {};
+struct get_received : public so_5::signal_t {};
+
+// Receives all values from the mbox.
+class a_receiver_t : public so_5::agent_t
+{
+public :
+	a_receiver_t( context_t ctx, so_5::mbox_t mbox )
+		:	so_5::agent_t( ctx )
+		,	m_mbox( std::move(mbox) )
+	{}
+
+	virtual void
+	so_define_agent() override
+	{
+		so_subscribe( m_mbox )
+			.event( [this]( const value & ) { ++m_received; } )
+			.event< get_received >( [this]() -> int { return m_received; } );
+	}
+
+private :
+	const so_5::mbox_t m_mbox;
+	int m_received = 0;
+};
+
+// Changes its subscriptions and delivery filter all the time.
+class a_churner_t : public so_5::agent_t
+{
+public :
+	a_churner_t( context_t ctx, so_5::mbox_t mbox )
+		:	so_5::agent_t( ctx )
+		,	m_mbox( std::move(mbox) )
+	{}
+
+	virtual void
+	so_define_agent() override
+	{
+		so_subscribe_self().event< next_turn >( &a_churner_t::evt_next_turn );
+	}
+
+	virtual void
+	so_evt_start() override
+	{
+		so_5::send< next_turn >( *this );
+	}
+
+private :
+	const so_5::mbox_t m_mbox;
+	int m_turns = 0;
+
+	void
+	evt_next_turn()
+	{
+		++m_turns;
+
+		if( m_turns % 2 )
+		{
+			so_set_delivery_filter( m_mbox, []( const value & v ) {
+					return 0 == v.m_v % 3;
+				} );
+			so_subscribe( m_mbox )
+				.event( []( const value & ) {} )
+				.event< churn >( [] {} );
+		}
+		else
+		{
+			so_drop_subscription_for_all_states< churn >( m_mbox );
+			so_drop_subscription_for_all_states< value >( m_mbox );
+			so_drop_delivery_filter< value >( m_mbox );
+		}
+
+		so_5::send< next_turn >( *this );
+	}
+};
+
+void
+do_stress_test( so_5::environment_t & env, const so_5::mbox_t & mbox )
+{
+	const int senders_count = 4;
+	const int messages_per_sender = 20000;
+
+	env.introduce_coop(
+		so_5::disp::active_obj::create_private_disp( env )->binder(),
+		[&]( so_5::coop_t & coop ) {
+			coop.make_agent< a_receiver_t >( mbox );
+			coop.make_agent< a_churner_t >( mbox );
+		} );
+
+	vector< thread > senders;
+	for( int i = 0; i != senders_count; ++i )
+		senders.emplace_back( [&mbox] {
+				for( int v = 0; v != messages_per_sender; ++v )
+				{
+					so_5::send< value >( mbox, v );
+					so_5::send< churn >( mbox );
+				}
+			} );
+
+	for( auto & t : senders )
+		t.join();
+
+	const auto received = mbox->get_one< int >()
+			.wait_forever().sync_get< get_received >();
+	UT_CHECK_CONDITION( senders_count * messages_per_sender == received );
+}
+
+class a_svc_handler_t : public so_5::agent_t
+{
+public :
+	a_svc_handler_t( context_t ctx, so_5::mbox_t mbox )
+		:	so_5::agent_t( ctx )
+	{
+		so_subscribe( mbox ).event( []( const value & v ) { return v.m_v * 2; } );
+	}
+};
+
+void
+do_svc_test( so_5::environment_t & env )
+{
+	auto mbox = env.create_snapshot_mbox( "svc" );
+
+	env.introduce_coop( [&]( so_5::coop_t & coop ) {
+			coop.make_agent< a_svc_handler_t >( mbox );
+		} );
+
+	const auto r = mbox->get_one< int >()
+			.wait_forever().make_sync_get< value >( 21 );
+	UT_CHECK_CONDITION( 42 == r );
+
+	// The same named mbox must be returned.
+	UT_CHECK_CONDITION( mbox->id() == env.create_mbox( "svc" )->id() );
+}
+
+int
+main()
+{
+	try
+	{
+		run_with_time_limit(
+			[]()
+			{
+				so_5::wrapped_env_t env;
+
+				cout << "stress: " << flush;
+				do_stress_test( env.environment(),
+						env.environment().create_snapshot_mbox() );
+				cout << "OK" << endl;
+
+				cout << "svc: " << flush;
+				do_svc_test( env.environment() );
+				cout << "OK" << endl;
+			},
+			60,
+			"mbox with lock-free delivery" );
+	}
+	catch( const exception & ex )
+	{
+		cerr << "Error: " << ex.what() << endl;
+		return 1;
+	}
+
+	return 0;
+}
@@ -18,6 +18,8 @@ MxxRu::Cpp::composite_target {
 	required_prj( "#{path}/not_empty_notify/prj.ut.rb" )
 	required_prj( "#{path}/multithread_receive/prj.ut.rb" )
 	required_prj( "#{path}/multithread_receive_close/prj.ut.rb" )
+	required_prj( "#{path}/lock_free_mpmc/prj.ut.rb" )
+	required_prj( "#{path}/bulk_extraction/prj.ut.rb" )
 
 	required_prj( "#{path}/select_simple/prj.ut.rb" )
 	required_prj( "#{path}/prepared_select_simple/prj.ut.rb" )
@@ -0,0 +1,116 @@
+/*
+ * A test for extraction of several messages at once in advanced
+ * receive and select.
+ */
+
+#include <so_5/all.hpp>
+
+#include <various_helpers_1/time_limited_execution.hpp>
+
+#include <utest_helper_1/h/helper.hpp>
+
+using namespace std;
+
+namespace props = so_5::mchain_props;
+
+const std::size_t messages_count = 40u;
+
+std::vector< std::pair< std::string, so_5::mchain_params_t > >
+build_params()
+{
+	std::vector< std::pair< std::string, so_5::mchain_params_t > > params;
+	params.emplace_back( "unlimited",
+			so_5::make_unlimited_mchain_params() );
+	params.emplace_back( "limited(dynamic)",
+			so_5::make_limited_without_waiting_mchain_params(
+					messages_count,
+					props::memory_usage_t::dynamic,
+					props::overflow_reaction_t::throw_exception ) );
+	params.emplace_back( "limited(preallocated)",
+			so_5::make_limited_without_waiting_mchain_params(
+					messages_count,
+					props::memory_usage_t::preallocated,
+					props::overflow_reaction_t::throw_exception ) );
+	params.emplace_back( "limited(lock_free)",
+			so_5::make_limited_without_waiting_mchain_params(
+					messages_count,
+					props::memory_usage_t::preallocated,
+					props::overflow_reaction_t::throw_exception )
+				.lock_free_queue() );
+
+	return params;
+}
+
+void
+do_test( const so_5::mchain_t & ch )
+{
+	for( std::size_t i = 0; i != messages_count; ++i )
+		so_5::send< int >( ch, static_cast< int >(i) );
+
+	int expected = 0;
+	auto handler = [&expected]( int v ) {
+		UT_CHECK_CONDITION( expected == v );
+		++expected;
+	};
+
+	auto r = receive( from(ch).handle_n( 5 ).no_wait_on_empty(), handler );
+	UT_CHECK_CONDITION( 5u == r.handled() );
+	UT_CHECK_CONDITION( messages_count - 5u == ch->size() );
+
+	r = receive( from(ch).extract_n( 3 ).no_wait_on_empty(),
+			[]( const std::string & ) {} );
+	UT_CHECK_CONDITION( 3u == r.extracted() );
+	UT_CHECK_CONDITION( 0u == r.handled() );
+	UT_CHECK_CONDITION( messages_count - 8u == ch->size() );
+	expected += 3;
+
+	std::size_t stop_counter = 0u;
+	r = receive(
+			from(ch).no_wait_on_empty().stop_on(
+					[&stop_counter] { return 2u == ++stop_counter; } ),
+			handler );
+	UT_CHECK_CONDITION( 2u == r.handled() );
+	UT_CHECK_CONDITION( messages_count - 10u == ch->size() );
+
+	r = so_5::select(
+			so_5::from_all().handle_n( 20 ).empty_timeout(
+					std::chrono::milliseconds( 100 ) ),
+			case_( ch, handler ) );
+	UT_CHECK_CONDITION( 20u == r.handled() );
+	UT_CHECK_CONDITION( messages_count - 30u == ch->size() );
+
+	r = receive( from(ch).no_wait_on_empty(), handler );
+	UT_CHECK_CONDITION( messages_count - 30u == r.handled() );
+	UT_CHECK_CONDITION( 0u == ch->size() );
+	UT_CHECK_CONDITION( static_cast< int >(messages_count) == expected );
+}
+
+int
+main()
+{
+	try
+	{
+		run_with_time_limit(
+			[]()
+			{
+				so_5::wrapped_env_t env;
+
+				for( const auto & p : build_params() )
+				{
+					cout << "=== " << p.first << " ===" << endl;
+
+					do_test( env.environment().create_mchain( p.second ) );
+				}
+			},
+			20,
+			"bulk extraction from mchain" );
+	}
+	catch( const exception & ex )
+	{
+		cerr << "Error: " << ex.what() << endl;
+		return 1;
+	}
+
+	return 0;
+}
+
@@ -0,0 +1,132 @@
+/*
+ * A test for mchain with lock-free queue and several producers and
+ * consumers.
+ */
+
+#include <so_5/all.hpp>
+
+#include <various_helpers_1/time_limited_execution.hpp>
+#include <various_helpers_1/ensure.hpp>
+
+#include <utest_helper_1/h/helper.hpp>
+
+using namespace std;
+
+namespace props = so_5::mchain_props;
+
+void
+do_test(
+	so_5::environment_t & env,
+	const char * case_name,
+	so_5::mchain_params_t params )
+{
+	cout << case_name << ": " << std::flush;
+
+	const size_t PRODUCERS_COUNT = 4;
+	const size_t CONSUMERS_COUNT = 3;
+	const int MESSAGES_PER_PRODUCER = 10000;
+
+	auto ch = env.create_mchain( params );
+
+	atomic< long long > received_sum{ 0 };
+	atomic< size_t > received_count{ 0 };
+
+	vector< thread > consumers;
+	consumers.reserve( CONSUMERS_COUNT );
+	for( size_t i = 0; i != CONSUMERS_COUNT; ++i )
+		consumers.emplace_back( thread{ [&] {
+				receive( from(ch), [&]( int v ) {
+						received_sum += v;
+						++received_count;
+					} );
+			} } );
+
+	vector< thread > producers;
+	producers.reserve( PRODUCERS_COUNT );
+	for( size_t i = 0; i != PRODUCERS_COUNT; ++i )
+		producers.emplace_back( thread{ [&ch] {
+				for( int v = 1; v <= MESSAGES_PER_PRODUCER; ++v )
+					so_5::send< int >( ch, v );
+			} } );
+
+	for( auto & t : producers )
+		t.join();
+
+	close_retain_content( ch );
+
+	for( auto & t : consumers )
+		t.join();
+
+	const long long expected_sum = static_cast< long long >(PRODUCERS_COUNT) *
+			MESSAGES_PER_PRODUCER * (MESSAGES_PER_PRODUCER + 1) / 2;
+
+	UT_CHECK_CONDITION(
+			PRODUCERS_COUNT * MESSAGES_PER_PRODUCER == received_count.load() );
+	UT_CHECK_CONDITION( expected_sum == received_sum.load() );
+
+	cout << "OK" << std::endl;
+}
+
+void
+do_check_unlimited_chain( so_5::environment_t & env )
+{
+	cout << "unlimited: " << std::flush;
+
+	bool exception_thrown = false;
+	try
+	{
+		env.create_mchain(
+				so_5::make_unlimited_mchain_params().lock_free_queue() );
+	}
+	catch( const so_5::exception_t & x )
+	{
+		exception_thrown = true;
+		UT_CHECK_CONDITION(
+				so_5::rc_lock_free_mchain_must_be_limited == x.error_code() );
+	}
+
+	UT_CHECK_CONDITION( exception_thrown );
+
+	cout << "OK" << std::endl;
+}
+
+int
+main()
+{
+	try
+	{
+		run_with_time_limit(
+			[]()
+			{
+				so_5::wrapped_env_t env;
+
+				do_test( env.environment(), "wait",
+						so_5::make_limited_with_waiting_mchain_params(
+								16,
+								props::memory_usage_t::preallocated,
+								props::overflow_reaction_t::throw_exception,
+								chrono::seconds(5) )
+							.lock_free_queue() );
+
+				do_test( env.environment(), "wait(capacity=1)",
+						so_5::make_limited_with_waiting_mchain_params(
+								1,
+								props::memory_usage_t::preallocated,
+								props::overflow_reaction_t::throw_exception,
+								chrono::seconds(5) )
+							.lock_free_queue() );
+
+				do_check_unlimited_chain( env.environment() );
+			},
+			60,
+			"mchain with lock-free queue" );
+	}
+	catch( const exception & ex )
+	{
+		cerr << "Error: " << ex.what() << endl;
+		return 1;
+	}
+
+	return 0;
+}
+
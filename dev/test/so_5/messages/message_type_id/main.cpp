@@ -0,0 +1,56 @@
+/*
+ * A test for message type identifiers.
+ */
+
+#include <so_5/all.hpp>
+
+#include <various_helpers_1/time_limited_execution.hpp>
+
+#include <utest_helper_1/h/helper.hpp>
+
+#include <thread>
+
+struct first : public so_5::message_t {};
+struct second : public so_5::signal_t {};
+struct third { int m_v; };
+
+int
+main()
+{
+	run_with_time_limit(
+		[]()
+		{
+			UT_CHECK_CONDITION( so_5::null_message_type_id() ==
+					so_5::message_type_id( typeid(void) ) );
+
+			const auto id1 = so_5::message_type_id< first >();
+			const auto id2 = so_5::message_type_id< second >();
+			const auto id3 = so_5::message_type_id< third >();
+
+			UT_CHECK_CONDITION( so_5::null_message_type_id() != id1 );
+			UT_CHECK_CONDITION( id1 != id2 );
+			UT_CHECK_CONDITION( id1 != id3 );
+			UT_CHECK_CONDITION( id2 != id3 );
+
+			UT_CHECK_CONDITION( id1 == so_5::message_type_id( typeid(first) ) );
+			UT_CHECK_CONDITION( id2 == so_5::message_type_id( typeid(second) ) );
+			UT_CHECK_CONDITION( id3 == so_5::message_type_id( typeid(third) ) );
+
+			// Identifiers must be the same on another thread.
+			so_5::message_type_id_t other_ids[ 3 ];
+			std::thread other{ [&] {
+					other_ids[ 2 ] = so_5::message_type_id( typeid(third) );
+					other_ids[ 1 ] = so_5::message_type_id( typeid(second) );
+					other_ids[ 0 ] = so_5::message_type_id( typeid(first) );
+				} };
+			other.join();
+
+			UT_CHECK_CONDITION( id1 == other_ids[ 0 ] );
+			UT_CHECK_CONDITION( id2 == other_ids[ 1 ] );
+			UT_CHECK_CONDITION( id3 == other_ids[ 2 ] );
+		},
+		20,
+		"message type identifiers" );
+
+	return 0;
+}
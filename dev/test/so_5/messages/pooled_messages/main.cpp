@@ -0,0 +1,247 @@
+/*
+ * A test for pooled message instances.
+ */
+
+#include <so_5/all.hpp>
+
+#include <various_helpers_1/time_limited_execution.hpp>
+
+#include <utest_helper_1/h/helper.hpp>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+const int messages_count = 10000;
+
+std::atomic< int > g_live_instances{ 0 };
+
+// Payloads have unusual sizes. It allows to count allocations of
+// message instances by their size.
+struct sample
+{
+	int m_index;
+	char m_padding[ 500 ];
+
+	sample( int index ) : m_index( index )
+	{
+		++g_live_instances;
+	}
+
+	sample( const sample & o ) : m_index( o.m_index )
+	{
+		++g_live_instances;
+	}
+
+	~sample()
+	{
+		--g_live_instances;
+	}
+};
+
+struct reply : public so_5::message_t
+{
+	int m_index;
+	char m_padding[ 700 ];
+
+	reply( int index ) : m_index( index )
+	{
+		++g_live_instances;
+	}
+
+	~reply()
+	{
+		--g_live_instances;
+	}
+};
+
+namespace so_5
+{
+
+template<>
+struct is_pooled_message< sample > : public std::true_type {};
+
+template<>
+struct is_pooled_message< reply > : public std::true_type {};
+
+} /* namespace so_5 */
+
+const std::size_t sample_size = sizeof(
+		so_5::details::pooled_envelope_t< so_5::user_type_message_t< sample > > );
+const std::size_t reply_size = sizeof(
+		so_5::details::pooled_envelope_t< reply > );
+
+std::atomic< int > g_sample_allocations{ 0 };
+std::atomic< int > g_reply_allocations{ 0 };
+
+void *
+operator new( std::size_t size )
+{
+	if( sample_size == size )
+		++g_sample_allocations;
+	else if( reply_size == size )
+		++g_reply_allocations;
+
+	auto r = std::malloc( size ? size : 1u );
+	if( !r )
+		throw std::bad_alloc();
+	return r;
+}
+
+void
+operator delete( void * p ) SO_5_NOEXCEPT
+{
+	std::free( p );
+}
+
+void
+operator delete( void * p, std::size_t ) SO_5_NOEXCEPT
+{
+	std::free( p );
+}
+
+// Sends messages to itself. Memory blocks are reused on the same thread.
+class a_self_sender_t : public so_5::agent_t
+{
+public :
+	a_self_sender_t( context_t ctx ) : so_5::agent_t( ctx )
+	{}
+
+	virtual void
+	so_define_agent() override
+	{
+		so_subscribe_self()
+			.event( &a_self_sender_t::evt_sample )
+			.event( &a_self_sender_t::evt_reply );
+	}
+
+	virtual void
+	so_evt_start() override
+	{
+		so_5::send< so_5::mutable_msg< sample > >( *this, 0 );
+	}
+
+private :
+	void
+	evt_sample( mutable_mhood_t< sample > cmd )
+	{
+		UT_CHECK_CONDITION( m_expected == cmd->m_index );
+		so_5::send< reply >( *this, cmd->m_index );
+	}
+
+	void
+	evt_reply( const reply & cmd )
+	{
+		UT_CHECK_CONDITION( m_expected == cmd.m_index );
+		if( ++m_expected < messages_count )
+			so_5::send< so_5::mutable_msg< sample > >( *this, m_expected );
+		else
+			so_deregister_agent_coop_normally();
+	}
+
+	int m_expected = 0;
+};
+
+// Receives samples from another thread and replies to them.
+// Memory blocks are allocated on one thread and deallocated on another.
+class a_consumer_t : public so_5::agent_t
+{
+public :
+	a_consumer_t( context_t ctx ) : so_5::agent_t( ctx )
+	{}
+
+	void
+	set_producer( so_5::mbox_t producer )
+	{
+		m_producer = std::move(producer);
+	}
+
+	virtual void
+	so_define_agent() override
+	{
+		so_subscribe_self().event( [this]( const sample & cmd ) {
+				so_5::send< reply >( m_producer, cmd.m_index );
+			} );
+	}
+
+private :
+	so_5::mbox_t m_producer;
+};
+
+class a_producer_t : public so_5::agent_t
+{
+public :
+	a_producer_t( context_t ctx, so_5::mbox_t consumer )
+		:	so_5::agent_t( ctx )
+		,	m_consumer( std::move(consumer) )
+	{}
+
+	virtual void
+	so_define_agent() override
+	{
+		so_subscribe_self().event( &a_producer_t::evt_reply );
+	}
+
+	virtual void
+	so_evt_start() override
+	{
+		so_5::send< sample >( m_consumer, 0 );
+	}
+
+private :
+	const so_5::mbox_t m_consumer;
+
+	int m_expected = 0;
+
+	void
+	evt_reply( const reply & cmd )
+	{
+		UT_CHECK_CONDITION( m_expected == cmd.m_index );
+		if( ++m_expected < messages_count )
+			so_5::send< sample >( m_consumer, m_expected );
+		else
+			so_deregister_agent_coop_normally();
+	}
+};
+
+void
+check_allocations()
+{
+	UT_CHECK_CONDITION( 0 == g_live_instances.load() );
+	UT_CHECK_CONDITION( g_sample_allocations.load() < messages_count / 10 );
+	UT_CHECK_CONDITION( g_reply_allocations.load() < messages_count / 10 );
+
+	g_sample_allocations = 0;
+	g_reply_allocations = 0;
+}
+
+int
+main()
+{
+	run_with_time_limit(
+		[]()
+		{
+			so_5::launch( []( so_5::environment_t & env ) {
+					env.introduce_coop( []( so_5::coop_t & coop ) {
+							coop.make_agent< a_self_sender_t >();
+						} );
+				} );
+			check_allocations();
+
+			so_5::launch( []( so_5::environment_t & env ) {
+					env.introduce_coop(
+						so_5::disp::active_obj::create_private_disp( env )->binder(),
+						[]( so_5::coop_t & coop ) {
+							auto consumer = coop.make_agent< a_consumer_t >();
+							auto producer = coop.make_agent< a_producer_t >(
+									consumer->so_direct_mbox() );
+							consumer->set_producer( producer->so_direct_mbox() );
+						} );
+				} );
+			check_allocations();
+		},
+		20,
+		"pooled messages" );
+
+	return 0;
+}
@@ -0,0 +1,189 @@
+/*
+ * A test for so_5::send_batch with different dispatchers and mboxes.
+ */
+
+#include <so_5/all.hpp>
+
+#include <various_helpers_1/time_limited_execution.hpp>
+
+#include <utest_helper_1/h/helper.hpp>
+
+using namespace std;
+
+const int messages_count = 100;
+
+struct value : public so_5::message_t
+{
+	int m_v;
+
+	value( int v ) : m_v( v ) {}
+};
+
+struct finish : public so_5::signal_t {};
+
+vector< int >
+make_values()
+{
+	vector< int > values;
+	for( int i = 0; i != messages_count; ++i )
+		values.push_back( i );
+	return values;
+}
+
+class a_receiver_t : public so_5::agent_t
+{
+public :
+	a_receiver_t( context_t ctx )
+		:	so_5::agent_t( ctx )
+		,	m_mpmc( so_environment().create_mbox() )
+	{}
+
+	virtual void
+	so_define_agent() override
+	{
+		so_subscribe_self()
+			.event( [this]( const value & v ) {
+				UT_CHECK_CONDITION( m_direct_received == v.m_v );
+				++m_direct_received;
+			} )
+			.event< finish >( &a_receiver_t::evt_finish );
+
+		so_set_delivery_filter( m_mpmc, []( const value & v ) {
+				return 0 == v.m_v % 2;
+			} );
+		so_subscribe( m_mpmc ).event( [this]( const value & v ) {
+				UT_CHECK_CONDITION( m_mpmc_received * 2 == v.m_v );
+				++m_mpmc_received;
+			} );
+	}
+
+	virtual void
+	so_evt_start() override
+	{
+		const auto values = make_values();
+
+		so_5::send_batch< value >( *this, values.begin(), values.end() );
+		so_5::send_batch< value >( m_mpmc, values.begin(), values.end() );
+		so_5::send< finish >( *this );
+	}
+
+private :
+	const so_5::mbox_t m_mpmc;
+
+	int m_direct_received = 0;
+	int m_mpmc_received = 0;
+
+	void
+	evt_finish()
+	{
+		UT_CHECK_CONDITION( messages_count == m_direct_received );
+		UT_CHECK_CONDITION( messages_count / 2 == m_mpmc_received );
+
+		so_deregister_agent_coop_normally();
+	}
+};
+
+class a_limited_receiver_t : public so_5::agent_t
+{
+public :
+	a_limited_receiver_t( context_t ctx )
+		:	so_5::agent_t( ctx
+				+ limit_then_drop< value >( 10 )
+				+ limit_then_drop< finish >( 1 ) )
+	{}
+
+	virtual void
+	so_define_agent() override
+	{
+		so_subscribe_self()
+			.event( [this]( const value & v ) {
+				UT_CHECK_CONDITION( m_received == v.m_v );
+				++m_received;
+			} )
+			.event< finish >( [this] {
+				UT_CHECK_CONDITION( 10 == m_received );
+				so_deregister_agent_coop_normally();
+			} );
+	}
+
+	virtual void
+	so_evt_start() override
+	{
+		const auto values = make_values();
+
+		// Agent's queue can't be processed until so_evt_start returns.
+		// So only the first 10 messages must be received.
+		so_5::send_batch< value >( *this, values.begin(), values.end() );
+		so_5::send< finish >( *this );
+	}
+
+private :
+	int m_received = 0;
+};
+
+void
+run_test(
+	const char * case_name,
+	function< so_5::disp_binder_unique_ptr_t(so_5::environment_t &) > binder_maker )
+{
+	cout << case_name << ": " << flush;
+
+	so_5::launch( [&]( so_5::environment_t & env ) {
+			env.introduce_coop( binder_maker( env ),
+				[]( so_5::coop_t & coop ) {
+					coop.make_agent< a_receiver_t >();
+				} );
+			env.introduce_coop( binder_maker( env ),
+				[]( so_5::coop_t & coop ) {
+					coop.make_agent< a_limited_receiver_t >();
+				} );
+		} );
+
+	cout << "OK" << endl;
+}
+
+int
+main()
+{
+	try
+	{
+		run_with_time_limit(
+			[]()
+			{
+				run_test( "one_thread", []( so_5::environment_t & env ) {
+						return so_5::disp::one_thread::create_private_disp( env )->binder();
+					} );
+				run_test( "active_obj", []( so_5::environment_t & env ) {
+						return so_5::disp::active_obj::create_private_disp( env )->binder();
+					} );
+				run_test( "thread_pool", []( so_5::environment_t & env ) {
+						return so_5::disp::thread_pool::create_private_disp( env, 3 )->
+								binder( so_5::disp::thread_pool::bind_params_t{} );
+					} );
+				run_test( "adv_thread_pool", []( so_5::environment_t & env ) {
+						return so_5::disp::adv_thread_pool::create_private_disp( env, 3 )->
+								binder( so_5::disp::adv_thread_pool::bind_params_t{} );
+					} );
+				run_test( "prio_one_thread::strictly_ordered",
+					[]( so_5::environment_t & env ) {
+						return so_5::disp::prio_one_thread::strictly_ordered::
+								create_private_disp( env )->binder();
+					} );
+				run_test( "prio_one_thread::quoted_round_robin",
+					[]( so_5::environment_t & env ) {
+						return so_5::disp::prio_one_thread::quoted_round_robin::
+								create_private_disp( env, so_5::disp::prio_one_thread::
+										quoted_round_robin::quotes_t{ 5 } )->binder();
+					} );
+			},
+			20,
+			"send_batch test" );
+	}
+	catch( const exception & ex )
+	{
+		cerr << "Error: " << ex.what() << endl;
+		return 1;
+	}
+
+	return 0;
+}
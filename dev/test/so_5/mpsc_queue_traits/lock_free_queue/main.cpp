@@ -0,0 +1,215 @@
+/*
+ * A test for lock-free demand queue of one_thread, active_obj and
+ * active_group dispatchers.
+ *
+ * Several threads send messages to an agent. The agent's queue becomes
+ * empty and non-empty many times. Every message must arrive and the order
+ * of messages from every thread must be preserved. Then a batch of delayed
+ * messages is delivered to the agent.
+ */
+
+#include <so_5/all.hpp>
+
+#include <various_helpers_1/time_limited_execution.hpp>
+
+#include <utest_helper_1/h/helper.hpp>
+
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+const unsigned int producers_count = 4;
+const unsigned int messages_count = 5000;
+const unsigned int delayed_count = 100;
+
+struct msg_seq final : public so_5::message_t
+{
+	unsigned int m_producer;
+	unsigned int m_seq;
+
+	msg_seq( unsigned int producer, unsigned int seq )
+		:	m_producer{ producer }
+		,	m_seq{ seq }
+	{}
+};
+
+struct msg_delayed final : public so_5::message_t
+{
+	unsigned int m_seq;
+
+	msg_delayed( unsigned int seq ) : m_seq{ seq } {}
+};
+
+class a_test_t final : public so_5::agent_t
+{
+public :
+	a_test_t( context_t ctx )
+		:	so_5::agent_t{ ctx }
+		,	m_received( producers_count, 0u )
+	{
+		so_subscribe_self()
+			.event( &a_test_t::evt_seq )
+			.event( &a_test_t::evt_delayed );
+	}
+
+	virtual void
+	so_evt_start() override
+	{
+		const auto mbox = so_direct_mbox();
+		for( unsigned int p = 0; p != producers_count; ++p )
+			m_producers.emplace_back( [mbox, p] {
+					for( unsigned int i = 0; i != messages_count; ++i )
+					{
+						so_5::send< msg_seq >( mbox, p, i );
+						// Let the queue become empty from time to time.
+						if( 0 == i % 500 )
+							std::this_thread::sleep_for(
+									std::chrono::milliseconds(1) );
+					}
+				} );
+	}
+
+	virtual void
+	so_evt_finish() override
+	{
+		for( auto & t : m_producers )
+			t.join();
+	}
+
+private :
+	std::vector< std::thread > m_producers;
+
+	std::vector< unsigned int > m_received;
+	unsigned int m_total_received = 0;
+	unsigned int m_delayed_received = 0;
+
+	void
+	evt_seq( const msg_seq & msg )
+	{
+		UT_CHECK_EQ( m_received[ msg.m_producer ], msg.m_seq );
+		++m_received[ msg.m_producer ];
+
+		if( producers_count * messages_count == ++m_total_received )
+			// Those messages should be delivered by one batch.
+			for( unsigned int i = 0; i != delayed_count; ++i )
+				so_5::send_delayed< msg_delayed >(
+						*this, std::chrono::milliseconds(20), i );
+	}
+
+	void
+	evt_delayed( const msg_delayed & msg )
+	{
+		UT_CHECK_EQ( m_delayed_received, msg.m_seq );
+
+		if( delayed_count == ++m_delayed_received )
+			so_deregister_agent_coop_normally();
+	}
+};
+
+using queue_params_t = so_5::disp::mpsc_queue_traits::queue_params_t;
+using lock_factory_t = so_5::disp::mpsc_queue_traits::lock_factory_t;
+
+template< typename Disp_Params >
+Disp_Params
+make_disp_params( const lock_factory_t & lock_factory )
+{
+	Disp_Params params;
+	params.tune_queue_params( [&]( queue_params_t & p ) {
+			p.lock_factory( lock_factory );
+			p.lock_free_queue( true );
+		} );
+
+	return params;
+}
+
+using binder_maker_t = std::function<
+	so_5::disp_binder_unique_ptr_t(
+		so_5::environment_t &, const lock_factory_t & ) >;
+
+void
+run_test(
+	const std::string & name,
+	const lock_factory_t & lock_factory,
+	bool activity_tracking,
+	const binder_maker_t & binder_maker )
+{
+	std::cout << name << " -> " << std::flush;
+
+	run_with_time_limit(
+		[&]()
+		{
+			so_5::launch(
+				[&]( so_5::environment_t & env ) {
+					env.introduce_coop(
+						binder_maker( env, lock_factory ),
+						[]( so_5::coop_t & coop ) {
+							coop.make_agent< a_test_t >();
+						} );
+				},
+				[&]( so_5::environment_params_t & params ) {
+					if( activity_tracking )
+						params.turn_work_thread_activity_tracking_on();
+				} );
+		},
+		20,
+		name );
+
+	std::cout << "OK" << std::endl;
+}
+
+int
+main()
+{
+	struct binder_info_t
+	{
+		std::string m_name;
+		binder_maker_t m_maker;
+	};
+	const std::vector< binder_info_t > binders{
+		{ "one_thread",
+			[]( so_5::environment_t & env, const lock_factory_t & lf ) {
+				using namespace so_5::disp::one_thread;
+				return create_private_disp( env, "one_thread",
+						make_disp_params< disp_params_t >( lf ) )->binder();
+			} },
+		{ "active_obj",
+			[]( so_5::environment_t & env, const lock_factory_t & lf ) {
+				using namespace so_5::disp::active_obj;
+				return create_private_disp( env, "active_obj",
+						make_disp_params< disp_params_t >( lf ) )->binder();
+			} },
+		{ "active_group",
+			[]( so_5::environment_t & env, const lock_factory_t & lf ) {
+				using namespace so_5::disp::active_group;
+				return create_private_disp( env, "active_group",
+						make_disp_params< disp_params_t >( lf ) )->binder( "group" );
+			} } };
+
+	struct lock_factory_info_t
+	{
+		std::string m_name;
+		lock_factory_t m_factory;
+	};
+	const std::vector< lock_factory_info_t > factories{
+		{ "combined_lock",
+			so_5::disp::mpsc_queue_traits::combined_lock_factory() },
+		{ "simple_lock",
+			so_5::disp::mpsc_queue_traits::simple_lock_factory() },
+		{ "futex_lock",
+			so_5::disp::mpsc_queue_traits::futex_lock_factory() } };
+
+	for( const auto & b : binders )
+		for( const auto & f : factories )
+			for( bool tracking : { false, true } )
+				run_test(
+						b.m_name + "+" + f.m_name +
+							(tracking ? "+activity_tracking" : ""),
+						f.m_factory,
+						tracking,
+						b.m_maker );
+
+	return 0;
+}
@@ -101,6 +101,52 @@ UT_UNIT_TEST(Spinlock_Write) {
 	run_test_threads( write_mutex_thread< decltype(data) >, &data );
 }
 
+template< typename M >
+void
+run_write_test()
+{
+	M lock;
+	TestData< M, std::lock_guard< M >, std::lock_guard< M > > data( lock );
+
+	run_test_threads( write_mutex_thread< decltype(data) >, &data );
+}
+
+UT_UNIT_TEST(YieldSpinlock_Write) {
+	run_write_test< so_5::spinlock_t< so_5::yield_backoff_t > >();
+}
+
+UT_UNIT_TEST(TicketSpinlock_Write) {
+	run_write_test< so_5::ticket_spinlock_t< so_5::pause_backoff_t > >();
+}
+
+UT_UNIT_TEST(McsSpinlock_Write) {
+	run_write_test< so_5::mcs_spinlock_t< so_5::pause_backoff_t > >();
+}
+
+// Several MCS locks are held by a thread at the same time.
+UT_UNIT_TEST(McsSpinlock_Nested) {
+	using lock_t = so_5::mcs_spinlock_t< so_5::pause_backoff_t >;
+	lock_t outer;
+	lock_t inner;
+	std::int64_t outer_counter = 0;
+	std::int64_t inner_counter = 0;
+
+	auto thread_func = [&]( int * ) {
+		for( int i = 0; i < kIters; i++ ) {
+			std::lock_guard< lock_t > outer_lock( outer );
+			++outer_counter;
+			{
+				std::lock_guard< lock_t > inner_lock( inner );
+				++inner_counter;
+			}
+		}
+	};
+	run_test_threads( thread_func, static_cast< int * >(nullptr) );
+
+	UT_CHECK_EQ( outer_counter, kThreads * kIters );
+	UT_CHECK_EQ( inner_counter, kThreads * kIters );
+}
+
 UT_UNIT_TEST(RWSpinlock_ReadWrite) {
 	so_5::default_rw_spinlock_t lock;
 	TestData< so_5::default_rw_spinlock_t,
@@ -110,9 +156,26 @@ UT_UNIT_TEST(RWSpinlock_ReadWrite) {
 	run_test_threads( read_mutex_thread< decltype(data) >, &data );
 }
 
+UT_UNIT_TEST(DistributedRWSpinlock_ReadWrite) {
+	// Count of slots is less than count of threads. So some slots
+	// are shared by several threads.
+	using lock_t = so_5::distributed_rw_spinlock_t< so_5::pause_backoff_t, 4 >;
+	lock_t lock;
+	TestData< lock_t,
+			std::lock_guard< lock_t >,
+			so_5::read_lock_guard_t< lock_t > > data( lock );
+
+	run_test_threads( read_mutex_thread< decltype(data) >, &data );
+}
+
 int main()
 {
 	UT_RUN_UNIT_TEST( Spinlock_Write )
+	UT_RUN_UNIT_TEST( YieldSpinlock_Write )
+	UT_RUN_UNIT_TEST( TicketSpinlock_Write )
+	UT_RUN_UNIT_TEST( McsSpinlock_Write )
+	UT_RUN_UNIT_TEST( McsSpinlock_Nested )
 	UT_RUN_UNIT_TEST( RWSpinlock_ReadWrite )
+	UT_RUN_UNIT_TEST( DistributedRWSpinlock_ReadWrite )
 }
 
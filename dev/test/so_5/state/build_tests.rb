@@ -23,4 +23,5 @@ MxxRu::Cpp::composite_target {
 	required_prj "#{path}/just_switch_to/prj.ut.rb"
 	required_prj "#{path}/state_switch_guard/prj.ut.rb"
 	required_prj "#{path}/time_limit/build_tests.rb"
+	required_prj "#{path}/handler_cache/prj.ut.rb"
 }
@@ -0,0 +1,137 @@
+/*
+ * A test for the cache of recent handler lookups.
+ *
+ * The same signal is handled again and again while subscriptions
+ * and the current state are changed between deliveries. Handlers from
+ * the current state, from a parent state and the deadletter handler
+ * must be found every time.
+ */
+
+#include <so_5/all.hpp>
+
+#include <various_helpers_1/time_limited_execution.hpp>
+
+#include <utest_helper_1/h/helper.hpp>
+
+#include <functional>
+#include <string>
+#include <vector>
+
+class a_test_t final : public so_5::agent_t
+{
+	struct sig : public so_5::signal_t {};
+
+	state_t st_parent{ this, "parent" };
+	state_t st_child{ initial_substate_of{ st_parent }, "child" };
+	state_t st_other{ this, "other" };
+
+public :
+	a_test_t( context_t ctx )
+		:	so_5::agent_t{ ctx }
+	{
+		this >>= st_child;
+
+		st_parent.event( &a_test_t::evt_parent );
+		st_other.event( &a_test_t::evt_other );
+		so_subscribe_deadletter_handler(
+				so_direct_mbox(), &a_test_t::evt_deadletter );
+
+		m_steps = {
+			[this] { st_child.event( &a_test_t::evt_child ); },
+			[this] { so_drop_subscription< sig >( so_direct_mbox(), st_child ); },
+			[this] { so_drop_subscription< sig >( so_direct_mbox(), st_parent ); },
+			[this] { this >>= st_other; },
+			[this] { this >>= st_child; },
+			[this] { st_parent.event( &a_test_t::evt_parent ); },
+		};
+	}
+
+	virtual void
+	so_evt_start() override
+	{
+		next_step();
+	}
+
+	virtual void
+	so_evt_finish() override
+	{
+		UT_CHECK_EQ(
+				std::string( "parent,parent,child,child,parent,parent,"
+					"deadletter,deadletter,other,other,deadletter,deadletter,"
+					"parent,parent," ),
+				m_trace );
+	}
+
+private :
+	std::vector< std::function< void() > > m_steps;
+	std::size_t m_current_step = 0;
+
+	std::string m_trace;
+
+	void
+	next_step()
+	{
+		if( m_current_step )
+		{
+			// Every result is checked twice: with an empty cache and
+			// with a cached result.
+			if( 0 != m_current_step % 2 )
+			{
+				++m_current_step;
+				so_5::send< sig >( *this );
+				return;
+			}
+
+			const auto index = m_current_step / 2 - 1;
+			if( index == m_steps.size() )
+			{
+				so_deregister_agent_coop_normally();
+				return;
+			}
+
+			m_steps[ index ]();
+		}
+
+		++m_current_step;
+		so_5::send< sig >( *this );
+	}
+
+	void
+	handled( const char * who )
+	{
+		m_trace += who;
+		m_trace += ",";
+
+		next_step();
+	}
+
+	void
+	evt_parent( mhood_t< sig > ) { handled( "parent" ); }
+
+	void
+	evt_child( mhood_t< sig > ) { handled( "child" ); }
+
+	void
+	evt_other( mhood_t< sig > ) { handled( "other" ); }
+
+	void
+	evt_deadletter( mhood_t< sig > ) { handled( "deadletter" ); }
+};
+
+int
+main()
+{
+	run_with_time_limit(
+		[]()
+		{
+			so_5::launch( []( so_5::environment_t & env ) {
+					env.introduce_coop( []( so_5::coop_t & coop ) {
+							coop.make_agent< a_test_t >();
+						} );
+				} );
+		},
+		20,
+		"handler cache" );
+
+	return 0;
+}
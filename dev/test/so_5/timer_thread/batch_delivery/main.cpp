@@ -0,0 +1,157 @@
+/*
+ * A test for delivery of messages from timers elapsed at the same time.
+ *
+ * A lot of delayed messages with the same pause are sent to several
+ * mboxes of different types. Those messages are delivered by a batch.
+ * Every message must arrive and the order of messages for every
+ * mbox must be preserved.
+ */
+
+#include <so_5/all.hpp>
+
+#include <various_helpers_1/time_limited_execution.hpp>
+
+#include <utest_helper_1/h/helper.hpp>
+
+#include <array>
+#include <chrono>
+#include <iostream>
+#include <string>
+
+const unsigned int messages_count = 200;
+
+const auto pause = std::chrono::milliseconds(25);
+
+struct msg_seq final : public so_5::message_t
+{
+	std::size_t m_mbox;
+	unsigned int m_seq;
+
+	msg_seq( std::size_t mbox, unsigned int seq )
+		:	m_mbox{ mbox }
+		,	m_seq{ seq }
+	{}
+};
+
+struct msg_other final : public so_5::signal_t {};
+
+struct msg_finish final : public so_5::signal_t {};
+
+class a_test_t final : public so_5::agent_t
+{
+public :
+	a_test_t( context_t ctx )
+		:	so_5::agent_t{ ctx }
+		,	m_mboxes{ {
+				so_direct_mbox(),
+				so_environment().create_mbox(),
+				so_environment().create_mbox( "batch_delivery" ) } }
+		,	m_chain{ so_environment().create_mchain(
+				so_5::make_unlimited_mchain_params() ) }
+	{
+		for( const auto & mbox : m_mboxes )
+			so_subscribe( mbox ).event( &a_test_t::evt_seq );
+
+		so_subscribe_self()
+			.event< msg_other >( &a_test_t::evt_other )
+			.event< msg_finish >( &a_test_t::evt_finish );
+	}
+
+	virtual void
+	so_evt_start() override
+	{
+		for( unsigned int i = 0; i != messages_count; ++i )
+		{
+			for( std::size_t m = 0; m != m_mboxes.size(); ++m )
+				so_5::send_delayed< msg_seq >(
+						so_environment(), m_mboxes[ m ], pause, m, i );
+
+			so_5::send_delayed< msg_seq >(
+					so_environment(), m_chain->as_mbox(), pause,
+					m_mboxes.size(), i );
+
+			if( 0 == i % 10 )
+				so_5::send_delayed< msg_other >( *this, pause );
+		}
+
+		so_5::send_delayed< msg_finish >( *this, pause * 8 );
+	}
+
+private :
+	const std::array< so_5::mbox_t, 3 > m_mboxes;
+	const so_5::mchain_t m_chain;
+
+	std::array< unsigned int, 3 > m_received{ {} };
+	unsigned int m_others = 0;
+
+	void
+	evt_seq( const msg_seq & msg )
+	{
+		UT_CHECK_EQ( m_received[ msg.m_mbox ], msg.m_seq );
+
+		++m_received[ msg.m_mbox ];
+	}
+
+	void
+	evt_other()
+	{
+		++m_others;
+	}
+
+	void
+	evt_finish()
+	{
+		for( auto r : m_received )
+			UT_CHECK_EQ( messages_count, r );
+
+		UT_CHECK_EQ( messages_count / 10, m_others );
+
+		unsigned int chain_received = 0;
+		receive( from( m_chain ).no_wait_on_empty(),
+			[&chain_received]( const msg_seq & msg ) {
+				UT_CHECK_EQ( chain_received, msg.m_seq );
+				++chain_received;
+			} );
+		UT_CHECK_EQ( messages_count, chain_received );
+
+		so_deregister_agent_coop_normally();
+	}
+};
+
+void
+run_test(
+	const std::string & name,
+	so_5::timer_thread_factory_t factory )
+{
+	std::cout << name << " -> " << std::flush;
+
+	run_with_time_limit(
+		[&]()
+		{
+			so_5::launch(
+				[]( so_5::environment_t & env ) {
+					env.introduce_coop( []( so_5::coop_t & coop ) {
+							coop.make_agent< a_test_t >();
+						} );
+				},
+				[&]( so_5::environment_params_t & params ) {
+					params.timer_thread( factory );
+				} );
+		},
+		20,
+		name );
+
+	std::cout << "OK" << std::endl;
+}
+
+int
+main()
+{
+	run_test( "timer_wheel", so_5::timer_wheel_factory() );
+	run_test( "timer_list", so_5::timer_list_factory() );
+	run_test( "timer_heap", so_5::timer_heap_factory() );
+	run_test( "timer_hierarchical_wheel",
+			so_5::timer_hierarchical_wheel_factory() );
+
+	return 0;
+}
@@ -15,4 +15,8 @@ MxxRu::Cpp::composite_target {
 	required_prj "#{path}/resend_periodic_via_mhood_to_mchain/prj.ut.rb" 
 	required_prj "#{path}/resend_delayed_via_mhood_to_mchain/prj.ut.rb" 
 	required_prj "#{path}/negative_args/prj.ut.rb" 
+	required_prj "#{path}/hierarchical_wheel/prj.ut.rb" 
+	required_prj "#{path}/batch_delivery/prj.ut.rb" 
+	required_prj "#{path}/pooled_timers/prj.ut.rb" 
+	required_prj "#{path}/timerfd_thread/prj.ut.rb" 
 }
@@ -0,0 +1,165 @@
+/*
+ * A test for hierarchical timer_wheel thread and manager.
+ *
+ * Delayed messages with very different pauses are sent. Small granularity
+ * is used so timers are stored in several levels of the wheel and are
+ * moved between levels. Every message must arrive and must not arrive
+ * earlier than expected. Canceled timers must not arrive at all.
+ */
+
+#include <so_5/all.hpp>
+
+#include <various_helpers_1/time_limited_execution.hpp>
+
+#include <utest_helper_1/h/helper.hpp>
+
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using clock_type = std::chrono::steady_clock;
+
+const auto granularity = std::chrono::microseconds(100);
+
+struct msg_timer final : public so_5::message_t
+{
+	clock_type::time_point m_deadline;
+	bool m_canceled;
+
+	msg_timer( clock_type::time_point deadline, bool canceled )
+		:	m_deadline{ deadline }
+		,	m_canceled{ canceled }
+	{}
+};
+
+struct msg_tick final : public so_5::signal_t {};
+
+struct msg_finish final : public so_5::signal_t {};
+
+class a_test_t final : public so_5::agent_t
+{
+public :
+	a_test_t( context_t ctx )
+		:	so_5::agent_t{ ctx }
+	{
+		so_subscribe_self()
+			.event( &a_test_t::evt_timer )
+			.event< msg_tick >( &a_test_t::evt_tick )
+			.event< msg_finish >( &a_test_t::evt_finish );
+	}
+
+	virtual void
+	so_evt_start() override
+	{
+		// Pauses are selected to get into every level of the wheel and to
+		// be on the borders of levels.
+		const unsigned int pauses_ms[] = {
+				0, 1, 10, 25, 26, 100, 1000, 1637, 1638, 1700, 2000 };
+
+		const auto started_at = clock_type::now();
+		for( int i = 0; i != 10; ++i )
+			for( auto p : pauses_ms )
+			{
+				const auto pause = std::chrono::milliseconds( p + i * 3 );
+
+				so_5::send_delayed< msg_timer >(
+						*this, pause, started_at + pause, false );
+				++m_expected;
+
+				m_canceled.push_back( so_5::send_periodic< msg_timer >(
+						*this, pause, std::chrono::milliseconds::zero(),
+						started_at + pause, true ) );
+			}
+		m_canceled.clear();
+
+		m_tick_timer = so_5::send_periodic< msg_tick >( *this,
+				std::chrono::milliseconds(300),
+				std::chrono::milliseconds(300) );
+
+		// There is a big margin after the last timer. Timers can be
+		// delayed on a loaded machine.
+		so_5::send_delayed< msg_finish >( *this, std::chrono::milliseconds(3500) );
+	}
+
+private :
+	std::vector< so_5::timer_id_t > m_canceled;
+	so_5::timer_id_t m_tick_timer;
+
+	int m_expected = 0;
+	int m_received = 0;
+	int m_ticks = 0;
+
+	void
+	evt_timer( mhood_t< msg_timer > cmd )
+	{
+		UT_CHECK_CONDITION( !cmd->m_canceled );
+		// Rounding to the nearest time step is allowed.
+		UT_CHECK_CONDITION( clock_type::now() + granularity >= cmd->m_deadline );
+
+		++m_received;
+	}
+
+	void
+	evt_tick()
+	{
+		++m_ticks;
+	}
+
+	void
+	evt_finish()
+	{
+		UT_CHECK_EQ( m_expected, m_received );
+		UT_CHECK_CONDITION( m_ticks >= 6 );
+
+		so_deregister_agent_coop_normally();
+	}
+};
+
+void
+run_test(
+	const std::string & name,
+	std::function< void(so_5::environment_params_t &) > params_tuner )
+{
+	std::cout << name << " -> " << std::flush;
+
+	run_with_time_limit(
+		[&]()
+		{
+			so_5::launch(
+				[]( so_5::environment_t & env ) {
+					env.introduce_coop( []( so_5::coop_t & coop ) {
+							coop.make_agent< a_test_t >();
+						} );
+				},
+				params_tuner );
+		},
+		20,
+		name );
+
+	std::cout << "OK" << std::endl;
+}
+
+int
+main()
+{
+	run_test( "timer_thread",
+		[]( so_5::environment_params_t & params ) {
+			params.timer_thread(
+					so_5::timer_hierarchical_wheel_factory( granularity ) );
+		} );
+
+	run_test( "timer_manager",
+		[]( so_5::environment_params_t & params ) {
+			so_5::env_infrastructures::simple_mtsafe::params_t p;
+			p.timer_manager(
+					so_5::timer_hierarchical_wheel_manager_factory( granularity ) );
+
+			params.infrastructure_factory(
+					so_5::env_infrastructures::simple_mtsafe::factory(
+							std::move(p) ) );
+		} );
+
+	return 0;
+}
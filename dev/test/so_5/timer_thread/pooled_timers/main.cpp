@@ -0,0 +1,160 @@
+/*
+ * A test for reuse of timer objects.
+ *
+ * Several threads schedule a lot of delayed messages, some of them are
+ * canceled at once. Memory for timers is reused many times. Every
+ * message which is not canceled must arrive.
+ */
+
+#include <so_5/all.hpp>
+
+#include <various_helpers_1/time_limited_execution.hpp>
+
+#include <utest_helper_1/h/helper.hpp>
+
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+const unsigned int threads_count = 4;
+const unsigned int rounds = 20;
+const unsigned int timers_per_round = 50;
+
+const unsigned int expected_messages =
+		threads_count * rounds * (timers_per_round / 2 + timers_per_round);
+
+struct msg_timer final : public so_5::message_t
+{
+	bool m_canceled;
+
+	msg_timer( bool canceled ) : m_canceled{ canceled } {}
+};
+
+class a_test_t final : public so_5::agent_t
+{
+public :
+	a_test_t( context_t ctx )
+		:	so_5::agent_t{ ctx }
+	{
+		so_subscribe_self().event( &a_test_t::evt_timer );
+	}
+
+	virtual void
+	so_evt_start() override
+	{
+		std::vector< std::thread > threads;
+		m_timers.resize( threads_count );
+		for( auto & timers : m_timers )
+			threads.emplace_back( [this, &timers] {
+					schedule_timers( timers );
+				} );
+
+		for( auto & t : threads )
+			t.join();
+	}
+
+private :
+	std::vector< std::vector< so_5::timer_id_t > > m_timers;
+
+	unsigned int m_received = 0;
+
+	void
+	schedule_timers( std::vector< so_5::timer_id_t > & timers )
+	{
+		const auto pause = std::chrono::milliseconds(1);
+
+		for( unsigned int r = 0; r != rounds; ++r )
+		{
+			for( unsigned int i = 0; i != timers_per_round; ++i )
+			{
+				const bool canceled = 0 != i % 2;
+
+				auto id = so_5::send_periodic< msg_timer >( *this,
+						pause, std::chrono::milliseconds::zero(), canceled );
+				if( canceled )
+					id.release();
+				else
+					timers.push_back( std::move(id) );
+
+				so_5::send_delayed< msg_timer >( *this, pause, false );
+			}
+
+			std::this_thread::sleep_for( pause * 2 );
+		}
+	}
+
+	void
+	evt_timer( const msg_timer & msg )
+	{
+		UT_CHECK_CONDITION( !msg.m_canceled );
+
+		if( expected_messages == ++m_received )
+		{
+			m_timers.clear();
+			so_deregister_agent_coop_normally();
+		}
+	}
+};
+
+void
+run_test(
+	const std::string & name,
+	std::function< void(so_5::environment_params_t &) > params_tuner )
+{
+	std::cout << name << " -> " << std::flush;
+
+	run_with_time_limit(
+		[&]()
+		{
+			so_5::launch(
+				[]( so_5::environment_t & env ) {
+					env.introduce_coop( []( so_5::coop_t & coop ) {
+							coop.make_agent< a_test_t >();
+						} );
+				},
+				params_tuner );
+		},
+		20,
+		name );
+
+	std::cout << "OK" << std::endl;
+}
+
+int
+main()
+{
+	run_test( "timer_wheel",
+		[]( so_5::environment_params_t & params ) {
+			params.timer_thread( so_5::timer_wheel_factory() );
+		} );
+
+	run_test( "timer_list",
+		[]( so_5::environment_params_t & params ) {
+			params.timer_thread( so_5::timer_list_factory() );
+		} );
+
+	run_test( "timer_heap",
+		[]( so_5::environment_params_t & params ) {
+			params.timer_thread( so_5::timer_heap_factory() );
+		} );
+
+	run_test( "timer_hierarchical_wheel",
+		[]( so_5::environment_params_t & params ) {
+			params.timer_thread( so_5::timer_hierarchical_wheel_factory() );
+		} );
+
+	run_test( "timer_wheel_manager",
+		[]( so_5::environment_params_t & params ) {
+			so_5::env_infrastructures::simple_mtsafe::params_t p;
+			p.timer_manager( so_5::timer_wheel_manager_factory() );
+
+			params.infrastructure_factory(
+					so_5::env_infrastructures::simple_mtsafe::factory(
+							std::move(p) ) );
+		} );
+
+	return 0;
+}
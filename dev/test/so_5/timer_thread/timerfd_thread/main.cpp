@@ -0,0 +1,123 @@
+/*
+ * A test for timerfd-based timer thread.
+ *
+ * A periodic message with small period is sent. Delayed messages with
+ * different pauses are sent in such order that a later timer is added
+ * before an earlier one. Every message must arrive, must not arrive
+ * earlier than expected and the thread must be woken up for an earlier
+ * timer.
+ */
+
+#include <so_5/all.hpp>
+
+#include <various_helpers_1/time_limited_execution.hpp>
+
+#include <utest_helper_1/h/helper.hpp>
+
+#include <chrono>
+#include <iostream>
+
+using clock_type = std::chrono::steady_clock;
+
+const auto period = std::chrono::milliseconds(2);
+const unsigned int ticks_count = 100;
+
+struct msg_tick final : public so_5::signal_t {};
+
+struct msg_delayed final : public so_5::message_t
+{
+	clock_type::time_point m_deadline;
+
+	msg_delayed( clock_type::time_point deadline )
+		:	m_deadline{ deadline }
+	{}
+};
+
+class a_test_t final : public so_5::agent_t
+{
+public :
+	a_test_t( context_t ctx )
+		:	so_5::agent_t{ ctx }
+	{
+		so_subscribe_self()
+			.event< msg_tick >( &a_test_t::evt_tick )
+			.event( &a_test_t::evt_delayed );
+	}
+
+	virtual void
+	so_evt_start() override
+	{
+		m_started_at = clock_type::now();
+		m_tick_timer = so_5::send_periodic< msg_tick >( *this, period, period );
+
+		// The latest timer is added at first.
+		for( auto p : { 500, 100, 20, 5, 1 } )
+		{
+			const auto pause = std::chrono::milliseconds( p );
+			so_5::send_delayed< msg_delayed >(
+					*this, pause, clock_type::now() + pause );
+		}
+	}
+
+private :
+	clock_type::time_point m_started_at;
+	so_5::timer_id_t m_tick_timer;
+
+	unsigned int m_ticks = 0;
+	unsigned int m_delayed = 0;
+
+	void
+	evt_tick()
+	{
+		++m_ticks;
+		UT_CHECK_CONDITION(
+				clock_type::now() >= m_started_at + period * m_ticks );
+
+		try_finish();
+	}
+
+	void
+	evt_delayed( const msg_delayed & msg )
+	{
+		const auto now = clock_type::now();
+		UT_CHECK_CONDITION( now >= msg.m_deadline );
+		// A timer must not wait for the previously armed deadline.
+		UT_CHECK_CONDITION( now < msg.m_deadline + std::chrono::milliseconds(50) );
+
+		++m_delayed;
+
+		try_finish();
+	}
+
+	void
+	try_finish()
+	{
+		if( ticks_count <= m_ticks && 5 == m_delayed )
+		{
+			m_tick_timer.release();
+			so_deregister_agent_coop_normally();
+		}
+	}
+};
+
+int
+main()
+{
+	run_with_time_limit(
+		[]()
+		{
+			so_5::launch(
+				[]( so_5::environment_t & env ) {
+					env.introduce_coop( []( so_5::coop_t & coop ) {
+							coop.make_agent< a_test_t >();
+						} );
+				},
+				[]( so_5::environment_params_t & params ) {
+					params.timer_thread( so_5::timer_timerfd_factory() );
+				} );
+		},
+		20,
+		"timerfd timer thread test" );
+
+	return 0;
+}
@@ -127,6 +127,19 @@ main()
 		check_factory( "timer_heap_factory", so_5::timer_heap_factory() );
 		check_factory( "timer_heap_factory(2048)",
 				so_5::timer_heap_factory( 2048 ) );
+		check_factory( "timer_hierarchical_wheel_factory",
+				so_5::timer_hierarchical_wheel_factory() );
+		check_factory( "timer_hierarchical_wheel_factory(1ms)",
+				so_5::timer_hierarchical_wheel_factory(
+						std::chrono::milliseconds(1) ) );
+		check_factory( "timer_timerfd_factory",
+				so_5::timer_timerfd_factory() );
+		check_factory( "timer_sharded_factory(3)",
+				so_5::timer_sharded_factory( 3 ) );
+		check_factory( "timer_sharded_factory(2,by_calling_thread,list)",
+				so_5::timer_sharded_factory( 2,
+						so_5::timer_shard_selector_t::by_calling_thread,
+						so_5::timer_list_factory() ) );
 
 		return 0;
 	}
@@ -65,7 +65,7 @@
  * \since
  * v.1.2.1
  */
-#define TIMERTT_VERSION 1002002u
+#define TIMERTT_VERSION 1002004u
 
 /*!
  * \brief Top-level project's namespace.
@@ -125,6 +125,186 @@ enum class timer_status : unsigned int
 	wait_for_deactivation
 };
 
+//
+// timer_object_pool
+//
+/*!
+ * \brief A pool of memory blocks for timer objects.
+ *
+ * Memory blocks of destroyed timer objects are kept in the pool and
+ * are reused for new timer objects. All blocks acquired from the same
+ * pool must have the same size.
+ *
+ * A block can be returned to the pool from any thread. It is done by
+ * lock-free push to the list of returned blocks. Blocks are taken from
+ * the pool under a mutex. The whole list of returned blocks is grabbed
+ * when the list of free blocks is empty.
+ *
+ * The pool is reference counted. Every acquired block holds a reference,
+ * so the pool lives while there are objects created from it, even if
+ * the owner of the pool is already destroyed.
+ *
+ * \since
+ * v.1.2.4
+ */
+class timer_object_pool
+{
+	//! Header of a free block.
+	struct free_block
+	{
+		free_block * m_next;
+	};
+
+public :
+	//! Type of deleter for std::unique_ptr which removes the reference
+	//! to the pool instead of deletion of it.
+	struct reference_remover
+	{
+		void
+		operator()( timer_object_pool * pool ) const TIMERTT_NOEXCEPT
+		{
+			pool->remove_reference();
+		}
+	};
+
+	//! Type of smart pointer for the owner of the pool.
+	using unique_ptr = std::unique_ptr< timer_object_pool, reference_remover >;
+
+	//! Default count of free blocks to be kept in the pool.
+	static std::size_t
+	default_capacity()
+	{
+		return 4096;
+	}
+
+	//! Create a new pool.
+	static unique_ptr
+	make(
+		//! Max count of free blocks to be kept in the pool.
+		std::size_t capacity = default_capacity() )
+	{
+		return unique_ptr( new timer_object_pool( capacity ) );
+	}
+
+	//! Get a memory block for a new object.
+	/*!
+	 * \note Adds a reference to the pool.
+	 */
+	void *
+	acquire( std::size_t size )
+	{
+		void * block = pop();
+		if( !block )
+			block = ::operator new( size );
+
+		add_reference();
+
+		return block;
+	}
+
+	//! Return a memory block to the pool.
+	/*!
+	 * \note Removes a reference to the pool.
+	 */
+	void
+	release( void * block ) TIMERTT_NOEXCEPT
+	{
+		if( m_free_count.fetch_add( 1, std::memory_order_relaxed ) < m_capacity )
+			push( block );
+		else
+		{
+			m_free_count.fetch_sub( 1, std::memory_order_relaxed );
+			::operator delete( block );
+		}
+
+		remove_reference();
+	}
+
+private :
+	//! Blocks returned to the pool.
+	std::atomic< free_block * > m_returned{ nullptr };
+
+	//! Lock for the list of free blocks.
+	std::mutex m_lock;
+
+	//! Blocks ready to be reused.
+	/*!
+	 * \attention Must be accessed only under m_lock.
+	 */
+	free_block * m_free = nullptr;
+
+	//! Count of blocks in the pool.
+	std::atomic< std::size_t > m_free_count{ 0 };
+
+	//! Max count of free blocks to be kept in the pool.
+	const std::size_t m_capacity;
+
+	//! Reference counter for the pool.
+	std::atomic< std::size_t > m_references{ 1 };
+
+	timer_object_pool( std::size_t capacity )
+		:	m_capacity( capacity )
+	{}
+
+	~timer_object_pool()
+	{
+		delete_blocks( m_free );
+		delete_blocks( m_returned.load( std::memory_order_acquire ) );
+	}
+
+	void
+	add_reference() TIMERTT_NOEXCEPT
+	{
+		m_references.fetch_add( 1, std::memory_order_relaxed );
+	}
+
+	void
+	remove_reference() TIMERTT_NOEXCEPT
+	{
+		if( 1 == m_references.fetch_sub( 1, std::memory_order_acq_rel ) )
+			delete this;
+	}
+
+	static void
+	delete_blocks( free_block * head ) TIMERTT_NOEXCEPT
+	{
+		while( head )
+		{
+			free_block * b = head;
+			head = head->m_next;
+			::operator delete( b );
+		}
+	}
+
+	void
+	push( void * block ) TIMERTT_NOEXCEPT
+	{
+		free_block * b = new( block ) free_block;
+		b->m_next = m_returned.load( std::memory_order_relaxed );
+		while( !m_returned.compare_exchange_weak( b->m_next, b,
+				std::memory_order_release, std::memory_order_relaxed ) )
+			;
+	}
+
+	void *
+	pop()
+	{
+		std::lock_guard< std::mutex > lock{ m_lock };
+
+		if( !m_free )
+			m_free = m_returned.exchange( nullptr, std::memory_order_acquire );
+
+		free_block * b = m_free;
+		if( b )
+		{
+			m_free = b->m_next;
+			m_free_count.fetch_sub( 1, std::memory_order_relaxed );
+		}
+
+		return b;
+	}
+};
+
 } /* namespace details */
 
 /*!
@@ -188,6 +368,16 @@ struct timer_object
 	//! Reference counter for the demand.
 	typename threading_traits< Thread_Safety >::reference_counter_type m_references;
 
+	//! Pool the demand's memory is acquired from.
+	/*!
+	 * Value nullptr means that the demand is created by ordinary new
+	 * or is not allocated dynamically.
+	 *
+	 * \since
+	 * v.1.2.4
+	 */
+	details::timer_object_pool * m_pool = nullptr;
+
 	//! Deafault constructor.
 	inline timer_object()
 	{
@@ -210,6 +400,25 @@ struct timer_object
 	decrement_references( timer_object * t )
 	{
 		if( 0 == --(t->m_references) )
+			destroy( t );
+	}
+
+	//! Destroy the demand and return its memory to the pool.
+	/*!
+	 * \since
+	 * v.1.2.4
+	 */
+	static inline void
+	destroy( timer_object * t )
+	{
+		details::timer_object_pool * pool = t->m_pool;
+		if( pool )
+		{
+			void * block = dynamic_cast< void * >( t );
+			t->~timer_object();
+			pool->release( block );
+		}
+		else
 			delete t;
 	}
 };
@@ -471,6 +680,54 @@ struct default_actor_exception_handler
  */
 typedef std::function< void() > default_timer_action_type;
 
+//
+// timer_action_batch
+//
+/*!
+ * \brief A collector of timer actions which are executed together.
+ *
+ * When several timers elapse at the same time step a timer engine
+ * passes their actions to an object of that type and then calls
+ * flush() before acquiring the engine's lock back. The default
+ * implementation executes every action immediately.
+ *
+ * A specialization for some Timer_Action type can collect actions
+ * in exec() and perform them in flush(), for example to deliver
+ * several actions to the same target at once.
+ *
+ * Specialization must be DefaultConstructible and must have the
+ * following methods:
+ * \code
+ * void exec( Timer_Action & action );
+ * void flush();
+ * \endcode
+ *
+ * \note A reference to an action passed to exec() remains valid until
+ * the end of subsequent flush() call.
+ *
+ * \note If flush() throws then all actions performed before and the
+ * action which has thrown must already be removed from the batch.
+ * The engine handles the exception and calls flush() again for the
+ * rest of the batch.
+ *
+ * \since
+ * v.1.2.4
+ */
+template< typename Timer_Action >
+class timer_action_batch
+{
+public :
+	void
+	exec( Timer_Action & action )
+	{
+		action();
+	}
+
+	void
+	flush()
+	{}
+};
+
 //
 // monotonic_clock
 //
@@ -615,6 +872,18 @@ public:
 	{
 		(*m_action)();
 	}
+
+	//! Pass the action to a batch.
+	/*!
+	 * \since
+	 * v.1.2.4
+	 */
+	template< typename Batch >
+	void
+	exec_in( Batch & batch )
+	{
+		batch.exec( *m_action );
+	}
 };
 
 template<>
@@ -638,6 +907,18 @@ public :
 	{
 		m_action();
 	}
+
+	//! Pass the action to a batch.
+	/*!
+	 * \since
+	 * v.1.2.4
+	 */
+	template< typename Batch >
+	void
+	exec_in( Batch & batch )
+	{
+		batch.exec( m_action );
+	}
 };
 
 //
@@ -779,6 +1060,82 @@ protected :
 	{
 		m_timer_quantities = timer_quantities{};
 	}
+
+	/*!
+	 * \brief Pool of memory blocks for timer objects.
+	 *
+	 * \since
+	 * v.1.2.4
+	 */
+	timer_object_pool::unique_ptr m_timer_pool{ timer_object_pool::make() };
+
+	/*!
+	 * \brief Helper method for creation of a new timer object.
+	 *
+	 * Memory for the object is taken from the engine's pool.
+	 *
+	 * \since
+	 * v.1.2.4
+	 */
+	template< typename Timer_Type >
+	Timer_Type *
+	make_timer_object()
+	{
+		void * block = m_timer_pool->acquire( sizeof( Timer_Type ) );
+
+		Timer_Type * timer = nullptr;
+		try
+		{
+			timer = new( block ) Timer_Type();
+		}
+		catch( ... )
+		{
+			m_timer_pool->release( block );
+			throw;
+		}
+
+		timer->m_pool = m_timer_pool.get();
+
+		return timer;
+	}
+
+	/*!
+	 * \brief Helper method for performing all actions collected
+	 * in a batch.
+	 *
+	 * An exception from an action is handled the same way as
+	 * an exception from an ordinary timer action. The rest of
+	 * the batch is performed after that.
+	 *
+	 * \since
+	 * v.1.2.4
+	 */
+	void
+	flush_action_batch(
+		timer_action_batch< Timer_Action > & batch )
+	{
+		bool completed = false;
+		while( !completed )
+		{
+			try
+			{
+				batch.flush();
+				completed = true;
+			}
+			catch( const std::exception & x )
+			{
+				this->m_exception_handler( x );
+			}
+			catch( ... )
+			{
+				std::ostringstream ss;
+				ss << __FILE__ << "(" << __LINE__
+					<< "): an unknown exception from timer action";
+				this->m_error_logger( ss.str() );
+				std::abort();
+			}
+		}
+	}
 };
 
 //
@@ -902,7 +1259,8 @@ public :
 	timer_object_holder< Thread_Safety >
 	allocate()
 	{
-		return timer_object_holder< Thread_Safety >( new timer_type() );
+		return timer_object_holder< Thread_Safety >(
+				this->template make_timer_object< timer_type >() );
 	}
 
 	//! Activate timer and schedule it for execution.
@@ -1325,35 +1683,909 @@ private :
 	/*!
 	 * \brief Calculate and fill up wheel position for the timer.
 	 *
-	 * timer_type::m_position and timer_type::m_full_rolls_left
-	 * will be set for \a wheel_timer.
+	 * timer_type::m_position and timer_type::m_full_rolls_left
+	 * will be set for \a wheel_timer.
+	 */
+	void
+	set_position_in_the_wheel(
+		//! Timer to modify.
+		timer_type * wheel_timer,
+		//! Timeout for the timer is time steps.
+		unsigned int pause_in_ticks ) const
+	{
+		wheel_timer->m_position =
+				( m_current_position + pause_in_ticks ) % m_wheel_size;
+		wheel_timer->m_full_rolls_left = pause_in_ticks / m_wheel_size;
+	}
+
+	/*!
+	 * \brief Insert timer to the wheel.
+	 *
+	 * If there is a non-empty timer list for the timer wheel position
+	 * the \a wheel_timer will be added to the end of that list.
+	 */
+	void
+	insert_demand_to_wheel( timer_type * wheel_timer )
+	{
+		wheel_item & item = m_wheel[ wheel_timer->m_position ];
+		if( item.m_head )
+		{
+			// There is a list of demands for the wheel position.
+			// New demand must be added to the end of that list.
+			wheel_timer->m_prev = item.m_tail;
+			wheel_timer->m_next = nullptr;
+			item.m_tail->m_next = wheel_timer;
+			item.m_tail = wheel_timer;
+		}
+		else
+		{
+			// There is no list of demands for this wheel position yet.
+			// New list must be started.
+			wheel_timer->m_prev = wheel_timer->m_next = nullptr;
+			item.m_head = wheel_timer;
+			item.m_tail = wheel_timer;
+		}
+	}
+
+	/*!
+	 * \brief Remove timer from the timer_wheel.
+	 */
+	void
+	remove_timer_from_wheel( timer_type * wheel_timer )
+	{
+		if( wheel_timer->m_prev )
+			wheel_timer->m_prev->m_next = wheel_timer->m_next;
+		else
+			m_wheel[ wheel_timer->m_position ].m_head = wheel_timer->m_next;
+
+		if( wheel_timer->m_next )
+			wheel_timer->m_next->m_prev = wheel_timer->m_prev;
+		else
+			m_wheel[ wheel_timer->m_position ].m_tail = wheel_timer->m_prev;
+	}
+
+	/*!
+	 * \brief Detect elapsed timers for the current time step and
+	 * process them all.
+	 *
+	 * Object \a lock will be unlocked and then locked back.
+	 */
+	template< class Unique_Lock >
+	void
+	process_current_wheel_position(
+		Unique_Lock & lock )
+	{
+		timer_type * exec_list_head = make_exec_list();
+
+		if( exec_list_head )
+		{
+			exec_actions( lock, exec_list_head );
+
+			utilize_exec_list( exec_list_head );
+		}
+	}
+
+	/*!
+	 * \brief Make list of elapsed timers to be executed.
+	 */
+	timer_type *
+	make_exec_list()
+	{
+		timer_type * head = nullptr;
+		timer_type * tail = nullptr;
+
+		timer_type * timer = m_wheel[ m_current_position ].m_head;
+		while( timer )
+		{
+			if( timer->m_full_rolls_left )
+			{
+				timer->m_full_rolls_left -= 1;
+				timer = timer->m_next;
+			}
+			else
+			{
+				timer_type * t = timer;
+				timer = timer->m_next;
+
+				remove_timer_from_wheel( t );
+				t->m_status = timer_status::wait_for_execution;
+
+				if( head )
+				{
+					tail->m_next = t;
+					t->m_prev = tail;
+					t->m_next = nullptr;
+					tail = t;
+				}
+				else
+				{
+					head = tail = t;
+					t->m_prev = t->m_next = nullptr;
+				}
+			}
+		}
+
+		return head;
+	}
+
+	/*!
+	 * \brief Execute all active timers from the list.
+	 */
+	template< class Unique_Lock >
+	void
+	exec_actions(
+		//! Object lock.
+		//! This lock will be unlocked before execution of actions
+		//! and locked back after.
+		Unique_Lock & lock,
+		//! Head of execution list.
+		//! Cannot be nullptr.
+		timer_type * head )
+	{
+		lock.unlock();
+
+		timer_action_batch< Timer_Action > batch;
+
+		while( head )
+		{
+			try
+			{
+				// Status of timer can be changed. So it must be checked
+				// just before execution. If timer is waiting for
+				// deregistration it must not be executed.
+				if( timer_status::wait_for_execution == head->m_status )
+					head->m_action.exec_in( batch );
+			}
+			catch( const std::exception & x )
+			{
+				this->m_exception_handler( x );
+			}
+			catch( ... )
+			{
+				std::ostringstream ss;
+				ss << __FILE__ << "(" << __LINE__ 
+					<< "): an unknown exception from timer action";
+				this->m_error_logger( ss.str() );
+				std::abort();
+			}
+
+			head = head->m_next;
+		}
+
+		this->flush_action_batch( batch );
+
+		lock.lock();
+	}
+
+	/*!
+	 * \brief Process list of elapsed timers after execution of
+	 * its actions.
+	 *
+	 * Active periodic timers will be rescheduled. All other timers
+	 * will be deactivated and removed.
+	 */
+	void
+	utilize_exec_list(
+		//! Head of execution list.
+		//! Cannot be null.
+		timer_type * head )
+	{
+		while( head )
+		{
+			timer_type * t = head;
+			head = head->m_next;
+
+			// Actual periodic timer must be rescheduled.
+			if( timer_status::wait_for_execution == t->m_status &&
+					t->m_period )
+			{
+				// Timer is active again.
+				t->m_status = timer_status::active;
+
+				set_position_in_the_wheel( t, t->m_period );
+
+				insert_demand_to_wheel( t );
+			}
+			else
+			{
+				// Timer must be utilized.
+				t->m_status = timer_status::deactivated;
+				this->dec_timer_count( t->kind() );
+				timer_object< Thread_Safety >::decrement_references( t );
+			}
+		}
+	}
+};
+
+//
+// hierarchical_wheel_engine_defaults
+//
+/*!
+ * \brief Container for static method with default values for
+ * hierarchical_wheel engine.
+ *
+ * \since
+ * v.1.2.3
+ */
+struct hierarchical_wheel_engine_defaults
+{
+	//! Default tick duration.
+	inline static monotonic_clock::duration
+	default_granularity() { return std::chrono::milliseconds( 10 ); }
+};
+
+//
+// hierarchical_wheel_engine
+//
+
+/*!
+ * \brief A engine for hierarchical timer wheel mechanism.
+ *
+ * This class uses the hierarchical variant of
+ * <a href="http://www.cs.columbia.edu/~nahum/w6998/papers/ton97-timing-wheels.pdf">timer_wheel</a>
+ * mechanism (scheme 7 from Varghese and Lauck paper).
+ *
+ * There are several wheels (levels). The first level has 256 slots and
+ * every slot of it is one time step. Every slot of the next level is
+ * a full turn of the previous level. Every upper level has 64 slots.
+ * There are five levels, so timers for 2^32 time steps can be stored
+ * without additional full turns. Timers with longer pauses are
+ * placed in the last slot of the upper level and are moved down when
+ * that slot is reached.
+ *
+ * A timer is placed into the lowest level which can hold its pause.
+ * When the first level completes its turn the next slot of the upper
+ * level is processed and all timers from it are moved into lower levels
+ * (cascading). Because of that activation and deactivation of timers are
+ * O(1) operations and every timer is moved between levels no more than
+ * four times.
+ *
+ * Unlike timer_wheel_engine the timers with long pauses are not
+ * rechecked on every turn of the wheel. And a timer thread does not wake
+ * up on time steps for which there are no timers in the first level.
+ * Because of that the pause for a timer is counted from the current time
+ * and is rounded up to the next time step.
+ *
+ * \note Like in timer_wheel_engine actions for elapsed timers are
+ * called when object's lock is unlocked.
+ *
+ * \tparam Thread_Safety Thread-safety indicator.
+ * Must be timertt::thread_safety::unsafe or timertt::thread_safety::safe.
+ *
+ * \tparam Timer_Action type of functor to perform an user-defined
+ * action when timer expires. This must be Moveable and MoveConstructible
+ * type.
+ *
+ * \tparam Error_Logger type of logger for errors detected during
+ * timer thread execution. Interface for error logger is defined
+ * by default_error_logger class.
+ *
+ * \tparam Actor_Exception_Handler type of handler for dealing with
+ * exceptions thrown from timer actors. Interface for exception handler
+ * is defined by default_actor_exception_handler.
+ *
+ * \since
+ * v.1.2.3
+ */
+template<
+	typename Thread_Safety,
+	typename Timer_Action,
+	typename Error_Logger,
+	typename Actor_Exception_Handler >
+class hierarchical_wheel_engine
+	:	public engine_common<
+			Thread_Safety, Timer_Action, Error_Logger, Actor_Exception_Handler >
+{
+	//! An alias for base class.
+	using base_type = engine_common<
+			Thread_Safety, Timer_Action, Error_Logger, Actor_Exception_Handler >;
+
+	struct timer_type;
+
+	//! Type for time step counters.
+	using tick_type = std::uint64_t;
+
+	/*!
+	 * \name Geometry of the wheels.
+	 * \{
+	 */
+	//! Count of bits for slot index in the first level.
+	static const unsigned int first_level_bits = 8;
+	//! Count of bits for slot index in upper levels.
+	static const unsigned int upper_level_bits = 6;
+	//! Count of levels.
+	static const unsigned int levels_count = 5;
+
+	//! Count of slots in the first level.
+	static const unsigned int first_level_size = 1u << first_level_bits;
+	//! Count of slots in an upper level.
+	static const unsigned int upper_level_size = 1u << upper_level_bits;
+	//! Total count of slots in all levels.
+	static const unsigned int total_slots =
+			first_level_size + (levels_count - 1) * upper_level_size;
+
+	//! Count of time steps which can be stored without additional turns.
+	static const tick_type max_ticks_ahead = tick_type(1) <<
+			(first_level_bits + (levels_count - 1) * upper_level_bits);
+
+	//! Count of 64-bit words for occupancy map of the first level.
+	static const unsigned int first_level_map_size = first_level_size / 64;
+	/*!
+	 * \}
+	 */
+
+public :
+	//! Type with default parameters for this engine.
+	using defaults_type = hierarchical_wheel_engine_defaults;
+
+	//! Alias for timer_action type.
+	using timer_action = typename base_type::timer_action;
+
+	//! Alias for scoped timer object.
+	using scoped_timer_object =
+			scoped_timer_object_holder< timer_type >;
+
+	//! Constructor with all parameters.
+	hierarchical_wheel_engine(
+		//! Size of time step for the first level.
+		monotonic_clock::duration granularity,
+		//! An error logger for timer thread.
+		Error_Logger error_logger,
+		//! An actor exception handler for timer thread.
+		Actor_Exception_Handler exception_handler )
+		:	base_type( error_logger, exception_handler )
+		,	m_granularity( granularity )
+	{
+		m_slots.resize( total_slots );
+
+		m_current_tick_border = monotonic_clock::now() + m_granularity;
+	}
+
+	//! Destructor.
+	~hierarchical_wheel_engine()
+	{
+		clear_all();
+	}
+
+	//! Create timer to be activated later.
+	timer_object_holder< Thread_Safety >
+	allocate()
+	{
+		return timer_object_holder< Thread_Safety >(
+				this->template make_timer_object< timer_type >() );
+	}
+
+	//! Activate timer and schedule it for execution.
+	/*!
+	 * \return Value \a true is returned only when the first timer is added to
+	 * the empty wheel.
+	 *
+	 * \throw std::exception If timer thread is not started.
+	 * \throw std::exception If \a timer is already activated.
+	 *
+	 * \tparam Duration_1 actual type which represents time duration.
+	 * \tparam Duration_2 actual type which represents time duration.
+	 */
+	template< class Duration_1, class Duration_2 >
+	bool
+	activate(
+		//! Timer to be activated.
+		timer_object_holder< Thread_Safety > timer,
+		//! Pause for timer execution.
+		Duration_1 pause,
+		//! Repetition period.
+		//! If <tt>Duration_2::zero() == period</tt> then timer will be
+		//! single-shot.
+		Duration_2 period,
+		//! Action for the timer.
+		timer_action action )
+	{
+		auto * wheel_timer = timer.template cast_to< timer_type >();
+		ensure_timer_deactivated( wheel_timer );
+
+		wheel_timer->m_action.assign( std::move(action) );
+
+		const auto wakeup_tick = planned_wakeup_tick();
+
+		// Timer must be taken under control.
+		timer_object< Thread_Safety >::increment_references( wheel_timer );
+		// It is an active timer now.
+		wheel_timer->m_status = timer_status::active;
+
+		perform_insertion_into_wheel( wheel_timer, pause, period );
+
+		// Timer thread must be woken up if the new timer must be
+		// processed before the planned time.
+		return wheel_timer->m_expiration_tick < wakeup_tick;
+	}
+
+	/*!
+	 * \brief Perform an attempt to reschedule a timer.
+	 *
+	 * \note
+	 * See timer_wheel_engine::reschedule() for the details.
+	 *
+	 * \throw std::exception If timer thread is not started.
+	 * \throw std::exception If \a timer is in processing right now.
+	 *
+	 * \tparam Duration_1 actual type which represents time duration.
+	 * \tparam Duration_2 actual type which represents time duration.
+	 */
+	template< class Duration_1, class Duration_2 >
+	bool
+	reschedule(
+		//! Timer to be rescheduled. Must be in activated or deactivated state.
+		timer_object_holder< Thread_Safety > timer,
+		//! Pause for timer execution.
+		Duration_1 pause,
+		//! Repetition period.
+		//! If <tt>Duration_2::zero() == period</tt> then timer will be
+		//! single-shot.
+		Duration_2 period,
+		//! Action for the timer.
+		timer_action action )
+	{
+		auto * wheel_timer = timer.template cast_to< timer_type >();
+		// If timer is deactivated the usual activation logic can be used.
+		if( timer_status::deactivated == wheel_timer->m_status )
+			return this->activate(
+					std::move(timer), pause, period, std::move(action) );
+		else if( timer_status::active != wheel_timer->m_status )
+		{
+			// Timer which is in processing now can't be reactivated.
+			throw std::runtime_error( "timer is in processing now, "
+					"it can't be rescheduled" );
+		}
+
+		// Timer must be removed from the wheel first.
+		this->remove_timer_from_wheel( wheel_timer );
+		this->dec_timer_count( wheel_timer->kind() );
+
+		// If this assigment throws then we must deactivate the timer.
+		try
+		{
+			wheel_timer->m_action.assign( std::move(action) );
+		}
+		catch(...)
+		{
+			wheel_timer->m_status = timer_status::deactivated;
+			timer_object< Thread_Safety >::decrement_references( wheel_timer );
+			// Exception must be rethrown;
+			throw;
+		}
+
+		const auto wakeup_tick = this->planned_wakeup_tick();
+
+		this->perform_insertion_into_wheel( wheel_timer, pause, period );
+
+		return wheel_timer->m_expiration_tick < wakeup_tick;
+	}
+
+	//! Deactivate timer and remove it from the wheel.
+	void
+	deactivate( timer_object_holder< Thread_Safety > timer )
+	{
+		auto wheel_timer = timer.template cast_to< timer_type >();
+		if( timer_status::active == wheel_timer->m_status )
+		{
+			// This is normal active timer. It can be safely
+			// deactivated and destroyed.
+			remove_timer_from_wheel( wheel_timer );
+
+			wheel_timer->m_status = timer_status::deactivated;
+
+			// Release timer object.
+			this->dec_timer_count( wheel_timer->kind() );
+			timer_object< Thread_Safety >::decrement_references( wheel_timer );
+		}
+		else if( timer_status::wait_for_execution == wheel_timer->m_status )
+		{
+			// This timer is in execution list right now.
+			// We can only changed its status.
+			// Final deactivation will be done after execution of
+			// timers actions.
+			wheel_timer->m_status = timer_status::wait_for_deactivation;
+		}
+	}
+
+	/*!
+	 * \brief Build sublist of elapsed timers and process them all.
+	 */
+	template< typename Unique_Lock >
+	void
+	process_expired_timers(
+		//! Object's lock.
+		Unique_Lock & lock )
+	{
+		// Several time steps can be processed at once because the timer
+		// thread sleeps while there is nothing to do in the first level.
+		const auto now = monotonic_clock::now();
+		for(;;)
+		{
+			if( !m_current_tick_processed )
+			{
+				process_current_tick( lock );
+
+				m_current_tick += 1;
+				m_current_tick_processed = true;
+			}
+
+			if( now >= m_current_tick_border )
+			{
+				// Time steps without timers are skipped at once.
+				const auto idle = ticks_to_next_significant_tick();
+				if( idle )
+				{
+					const auto started = ticks_started_before( now );
+					const auto skipped = idle < started ? idle : started;
+
+					m_current_tick += skipped;
+					m_current_tick_border += m_granularity *
+							static_cast< monotonic_clock::rep >( skipped );
+					continue;
+				}
+
+				// A switch to next tick is necessary.
+				m_current_tick_border += m_granularity;
+				m_current_tick_processed = false;
+			}
+			else
+				break;
+		}
+	}
+
+	/*!
+	 * \brief Is empty timer list?
+	 */
+	bool
+	empty() const
+	{
+		return 0 == this->m_timer_quantities.m_single_shot_count &&
+				0 == this->m_timer_quantities.m_periodic_count;
+	}
+
+	/*!
+	 * \brief Get time point of the next timer.
+	 *
+	 * It is the start of the nearest time step which has timers in
+	 * the first level or which requires cascading from upper levels.
+	 *
+	 * \attention Must be called only when \a !empty().
+	 */
+	monotonic_clock::time_point
+	nearest_time_point() const
+	{
+		if( !m_current_tick_processed )
+			return monotonic_clock::now();
+		else
+		{
+			// Tick m_current_tick will be processed at
+			// m_current_tick_border.
+			const auto ticks = ticks_to_next_significant_tick();
+			return m_current_tick_border +
+					m_granularity * static_cast< monotonic_clock::rep >( ticks );
+		}
+	}
+
+	/*!
+	 * \brief Deactivate all timers and cleanup internal data structures.
+	 */
+	void
+	clear_all()
+	{
+		for( auto & item : m_slots )
+		{
+			timer_type * timer = item.m_head;
+			item = wheel_item();
+
+			while( timer )
+			{
+				timer_type * t = timer;
+				timer = timer->m_next;
+
+				t->m_status = timer_status::deactivated;
+				timer_object< Thread_Safety >::decrement_references( t );
+			}
+		}
+
+		m_first_level_map.fill( 0u );
+
+		// For the case of timer_engine restart.
+		this->reset_timer_count();
+		this->m_current_tick_border = monotonic_clock::now() + m_granularity;
+		this->m_current_tick = 0;
+	}
+
+private :
+	//! Type of wheel timer.
+	struct timer_type : public timer_object< Thread_Safety >
+	{
+		//! Status of the timer.
+		typename threading_traits< Thread_Safety >::status_holder_type m_status;
+
+		//! Time step at which timer must be executed.
+		tick_type m_expiration_tick = 0;
+
+		//! Period in ticks.
+		/*!
+		 * Zero means that demand is single shot.
+		 */
+		tick_type m_period = 0;
+
+		//! Index of slot in which timer is stored.
+		unsigned int m_slot = 0;
+
+		//! Timer action.
+		timer_action_holder< timer_action > m_action;
+
+		//! Previous demand in the list.
+		timer_type * m_prev = nullptr;
+		//! Next demand in the list.
+		timer_type * m_next = nullptr;
+
+		timer_type()
+		{
+			m_status = timer_status::deactivated;
+		}
+
+		/*!
+		 * \brief Detect type of the timer (single-shot or periodic).
+		 */
+		timer_kind
+		kind() const
+		{
+			return !m_period ? timer_kind::single_shot : timer_kind::periodic;
+		}
+	};
+
+	//! Type of wheel's item.
+	struct wheel_item
+	{
+		//! Head of the demand's list.
+		timer_type * m_head = nullptr;
+		//! Tail of the demand's list.
+		timer_type * m_tail = nullptr;
+	};
+
+	/*!
+	 * \name Object's attributes.
+	 * \{
+	 */
+	//! Granularity of one time step.
+	const monotonic_clock::duration m_granularity;
+
+	//! The current time step.
+	tick_type m_current_tick = 0;
+
+	//! Right border of the current tick.
+	/*!
+	 * This is the time point at which new tick must be started.
+	 */
+	monotonic_clock::time_point m_current_tick_border;
+
+	//! Has the current tick been processed?
+	bool m_current_tick_processed = false;
+
+	//! Slots of all levels.
+	/*!
+	 * Slots of the first level go first, then slots of the
+	 * second level and so on.
+	 */
+	std::vector< wheel_item > m_slots;
+
+	//! Map of nonempty slots of the first level.
+	std::array< std::uint64_t, first_level_map_size > m_first_level_map{};
+	/*!
+	 * \}
+	 */
+
+	/*!
+	 * \brief Hard check for deactivation state of the timer.
+	 *
+	 * \throw std::runtimer_error if timer is not deactivated.
+	 */
+	static void
+	ensure_timer_deactivated( const timer_type * timer )
+	{
+		if( timer_status::deactivated != timer->m_status )
+			throw std::runtime_error( "timer is not in 'deactivated' state" );
+	}
+
+	//! Count of bits of time step number below the \a level.
+	static unsigned int
+	level_shift( unsigned int level )
+	{
+		return level ? first_level_bits + (level - 1) * upper_level_bits : 0;
+	}
+
+	//! Index of the first slot of the \a level in m_slots.
+	static unsigned int
+	level_offset( unsigned int level )
+	{
+		return level ? first_level_size + (level - 1) * upper_level_size : 0;
+	}
+
+	//! Count of bits for slot index in the \a level.
+	static unsigned int
+	level_bits( unsigned int level )
+	{
+		if( level )
+			return upper_level_bits;
+		return first_level_bits;
+	}
+
+	//! Count of slots in the \a level.
+	static unsigned int
+	level_size( unsigned int level )
+	{
+		return 1u << level_bits( level );
+	}
+
+	/*!
+	 * \brief Start time of m_current_tick.
+	 */
+	monotonic_clock::time_point
+	current_tick_start() const
+	{
+		return m_current_tick_processed ?
+				m_current_tick_border :
+				m_current_tick_border - m_granularity;
+	}
+
+	/*!
+	 * \brief Count of time steps from m_current_tick which started
+	 * before \a now.
+	 *
+	 * \attention Must be called only when m_current_tick is processed
+	 * and \a now is not less than m_current_tick_border.
+	 */
+	tick_type
+	ticks_started_before( monotonic_clock::time_point now ) const
+	{
+		return static_cast< tick_type >(
+				(now - m_current_tick_border) / m_granularity ) + 1;
+	}
+
+	/*!
+	 * \brief Time step at which processing of timers is planned.
+	 *
+	 * A timer thread sleeps until that time step. If a new timer is
+	 * added before it then the timer thread must be woken up.
+	 */
+	tick_type
+	planned_wakeup_tick() const
+	{
+		if( empty() )
+			return ~tick_type(0);
+		else if( !m_current_tick_processed )
+			// Processing is in progress. The next time point will be
+			// recalculated after it.
+			return m_current_tick;
+		else
+			return m_current_tick + ticks_to_next_significant_tick();
+	}
+
+	/*!
+	 * \brief Perform insertion of a timer into wheel data structure.
+	 *
+	 * \note
+	 * This method doesn't change reference count to timer object.
+	 */
+	template< class Duration_1, class Duration_2 >
+	void
+	perform_insertion_into_wheel(
+		//! Timer to be inserted.
+		timer_type * wheel_timer,
+		//! Pause for timer execution.
+		Duration_1 pause,
+		//! Repetition period.
+		//! If <tt>Duration_2::zero() == period</tt> then timer will be
+		//! single-shot.
+		Duration_2 period )
+	{
+		wheel_timer->m_expiration_tick = expiration_tick( pause );
+
+		// Special calculations for the periodic demand.
+		if( monotonic_clock::duration::zero() != period )
+			wheel_timer->m_period = duration_to_ticks( period );
+		else
+			wheel_timer->m_period = 0;
+
+		this->insert_demand_to_wheel( wheel_timer );
+
+		// Count of timers changed.
+		this->inc_timer_count( wheel_timer->kind() );
+	}
+
+	/*!
+	 * \brief Calculate the time step for execution of a new timer.
+	 *
+	 * The time step is calculated from the current time, not from
+	 * m_current_tick. It is because a timer thread doesn't process
+	 * time steps without timers and m_current_tick can be far behind
+	 * the current time. The first time step which starts not earlier
+	 * than the expiration time is selected.
+	 *
+	 * \note Never return m_current_tick or earlier time step.
+	 */
+	template< class Duration >
+	tick_type
+	expiration_tick(
+		//! Pause for timer execution.
+		Duration pause ) const
+	{
+		const auto since_current_tick =
+				monotonic_clock::now() - current_tick_start() +
+				std::chrono::duration_cast< monotonic_clock::duration >( pause );
+
+		tick_type ticks = 1;
+		if( since_current_tick > m_granularity )
+		{
+			const auto g_units = m_granularity.count();
+			ticks = static_cast< tick_type >(
+					(since_current_tick.count() + g_units - 1) / g_units );
+		}
+
+		return m_current_tick + ticks;
+	}
+
+	/*!
+	 * \brief Converion of duration to number of time steps.
+	 *
+	 * \note The same rounding as in timer_wheel_engine is used.
+	 * Never return 0.
+	 *
+	 * \tparam Duration actual type for duration representation.
 	 */
-	void
-	set_position_in_the_wheel(
-		//! Timer to modify.
-		timer_type * wheel_timer,
-		//! Timeout for the timer is time steps.
-		unsigned int pause_in_ticks ) const
+	template< class Duration >
+	tick_type
+	duration_to_ticks(
+		//! Time duration to be converted in time steps count.
+		Duration d ) const
 	{
-		wheel_timer->m_position =
-				( m_current_position + pause_in_ticks ) % m_wheel_size;
-		wheel_timer->m_full_rolls_left = pause_in_ticks / m_wheel_size;
+		auto d_units =
+				std::chrono::duration_cast< monotonic_clock::duration >( d )
+				.count();
+		auto g_units = m_granularity.count();
+
+		tick_type r = d_units > 0 ?
+				static_cast< tick_type >( (d_units + g_units/2) / g_units ) : 0;
+		if( !r )
+			r = 1;
+		return r;
 	}
 
 	/*!
-	 * \brief Insert timer to the wheel.
+	 * \brief Insert timer to the appropriate slot.
 	 *
-	 * If there is a non-empty timer list for the timer wheel position
-	 * the \a wheel_timer will be added to the end of that list.
+	 * The slot is selected by the distance between the current time step
+	 * and the expiration time step of the timer.
 	 */
 	void
 	insert_demand_to_wheel( timer_type * wheel_timer )
 	{
-		wheel_item & item = m_wheel[ wheel_timer->m_position ];
+		tick_type distance =
+				wheel_timer->m_expiration_tick > m_current_tick ?
+				wheel_timer->m_expiration_tick - m_current_tick : 0;
+		// Timers with very long pauses will be placed into the last slot
+		// of the upper level. They will be reinserted after cascading.
+		if( distance >= max_ticks_ahead )
+			distance = max_ticks_ahead - 1;
+
+		const tick_type when = m_current_tick + distance;
+
+		unsigned int level = 0;
+		while( distance >=
+				(tick_type(1) << (level_shift( level ) + level_bits( level ))) )
+			++level;
+
+		const auto index = static_cast< unsigned int >(
+				(when >> level_shift( level )) & (level_size( level ) - 1) );
+		wheel_timer->m_slot = level_offset( level ) + index;
+
+		wheel_item & item = m_slots[ wheel_timer->m_slot ];
 		if( item.m_head )
 		{
-			// There is a list of demands for the wheel position.
-			// New demand must be added to the end of that list.
 			wheel_timer->m_prev = item.m_tail;
 			wheel_timer->m_next = nullptr;
 			item.m_tail->m_next = wheel_timer;
@@ -1361,42 +2593,104 @@ private :
 		}
 		else
 		{
-			// There is no list of demands for this wheel position yet.
-			// New list must be started.
 			wheel_timer->m_prev = wheel_timer->m_next = nullptr;
 			item.m_head = wheel_timer;
 			item.m_tail = wheel_timer;
+
+			if( !level )
+				m_first_level_map[ index / 64 ] |= std::uint64_t(1) << (index % 64);
 		}
 	}
 
 	/*!
-	 * \brief Remove timer from the timer_wheel.
+	 * \brief Remove timer from the slot.
 	 */
 	void
 	remove_timer_from_wheel( timer_type * wheel_timer )
 	{
+		wheel_item & item = m_slots[ wheel_timer->m_slot ];
+
 		if( wheel_timer->m_prev )
 			wheel_timer->m_prev->m_next = wheel_timer->m_next;
 		else
-			m_wheel[ wheel_timer->m_position ].m_head = wheel_timer->m_next;
+			item.m_head = wheel_timer->m_next;
 
 		if( wheel_timer->m_next )
 			wheel_timer->m_next->m_prev = wheel_timer->m_prev;
 		else
-			m_wheel[ wheel_timer->m_position ].m_tail = wheel_timer->m_prev;
+			item.m_tail = wheel_timer->m_prev;
+
+		if( !item.m_head && wheel_timer->m_slot < first_level_size )
+			clear_first_level_map_bit( wheel_timer->m_slot );
+	}
+
+	//! Mark a slot of the first level as empty.
+	void
+	clear_first_level_map_bit( unsigned int index )
+	{
+		m_first_level_map[ index / 64 ] &= ~(std::uint64_t(1) << (index % 64));
 	}
 
 	/*!
-	 * \brief Detect elapsed timers for the current time step and
-	 * process them all.
+	 * \brief Count of time steps from m_current_tick to the nearest
+	 * time step which must be processed.
+	 *
+	 * It is a time step with nonempty slot in the first level or
+	 * the start of the next turn of the first level.
+	 */
+	tick_type
+	ticks_to_next_significant_tick() const
+	{
+		const auto first = static_cast< unsigned int >(
+				m_current_tick & (first_level_size - 1) );
+		if( !first )
+			// Cascading can be necessary.
+			return 0;
+
+		for( unsigned int w = first / 64; w != first_level_map_size; ++w )
+		{
+			auto bits = m_first_level_map[ w ];
+			if( w == first / 64 )
+				bits &= ~std::uint64_t(0) << (first % 64);
+
+			if( bits )
+			{
+				unsigned int index = w * 64;
+				while( !(bits & 1u) )
+				{
+					bits >>= 1;
+					++index;
+				}
+				return index - first;
+			}
+		}
+
+		return first_level_size - first;
+	}
+
+	/*!
+	 * \brief Move timers from upper levels if necessary and process
+	 * elapsed timers from the first level.
 	 *
 	 * Object \a lock will be unlocked and then locked back.
 	 */
 	template< class Unique_Lock >
 	void
-	process_current_wheel_position(
+	process_current_tick(
 		Unique_Lock & lock )
 	{
+		// Upper levels are processed only when the first level
+		// starts new turn.
+		for( unsigned int level = 1; level != levels_count; ++level )
+		{
+			const auto shift = level_shift( level );
+			if( m_current_tick & ((tick_type(1) << shift) - 1) )
+				break;
+
+			cascade( level_offset( level ) + static_cast< unsigned int >(
+					(m_current_tick >> shift) & (upper_level_size - 1) ) );
+		}
+
 		timer_type * exec_list_head = make_exec_list();
 
 		if( exec_list_head )
@@ -1407,44 +2701,43 @@ private :
 		}
 	}
 
+	/*!
+	 * \brief Move all timers from a slot of upper level into lower levels.
+	 */
+	void
+	cascade( unsigned int slot )
+	{
+		timer_type * timer = m_slots[ slot ].m_head;
+		m_slots[ slot ] = wheel_item();
+
+		while( timer )
+		{
+			timer_type * t = timer;
+			timer = timer->m_next;
+
+			insert_demand_to_wheel( t );
+		}
+	}
+
 	/*!
 	 * \brief Make list of elapsed timers to be executed.
+	 *
+	 * All timers from the current slot of the first level are elapsed.
 	 */
 	timer_type *
 	make_exec_list()
 	{
-		timer_type * head = nullptr;
-		timer_type * tail = nullptr;
+		const auto index = static_cast< unsigned int >(
+				m_current_tick & (first_level_size - 1) );
 
-		timer_type * timer = m_wheel[ m_current_position ].m_head;
-		while( timer )
+		timer_type * head = m_slots[ index ].m_head;
+		if( head )
 		{
-			if( timer->m_full_rolls_left )
-			{
-				timer->m_full_rolls_left -= 1;
-				timer = timer->m_next;
-			}
-			else
-			{
-				timer_type * t = timer;
-				timer = timer->m_next;
+			m_slots[ index ] = wheel_item();
+			clear_first_level_map_bit( index );
 
-				remove_timer_from_wheel( t );
+			for( timer_type * t = head; t; t = t->m_next )
 				t->m_status = timer_status::wait_for_execution;
-
-				if( head )
-				{
-					tail->m_next = t;
-					t->m_prev = tail;
-					t->m_next = nullptr;
-					tail = t;
-				}
-				else
-				{
-					head = tail = t;
-					t->m_prev = t->m_next = nullptr;
-				}
-			}
 		}
 
 		return head;
@@ -1466,6 +2759,8 @@ private :
 	{
 		lock.unlock();
 
+		timer_action_batch< Timer_Action > batch;
+
 		while( head )
 		{
 			try
@@ -1474,7 +2769,7 @@ private :
 				// just before execution. If timer is waiting for
 				// deregistration it must not be executed.
 				if( timer_status::wait_for_execution == head->m_status )
-					head->m_action.exec();
+					head->m_action.exec_in( batch );
 			}
 			catch( const std::exception & x )
 			{
@@ -1483,7 +2778,7 @@ private :
 			catch( ... )
 			{
 				std::ostringstream ss;
-				ss << __FILE__ << "(" << __LINE__ 
+				ss << __FILE__ << "(" << __LINE__
 					<< "): an unknown exception from timer action";
 				this->m_error_logger( ss.str() );
 				std::abort();
@@ -1492,6 +2787,8 @@ private :
 			head = head->m_next;
 		}
 
+		this->flush_action_batch( batch );
+
 		lock.lock();
 	}
 
@@ -1520,7 +2817,7 @@ private :
 				// Timer is active again.
 				t->m_status = timer_status::active;
 
-				set_position_in_the_wheel( t, t->m_period );
+				t->m_expiration_tick = m_current_tick + t->m_period;
 
 				insert_demand_to_wheel( t );
 			}
@@ -1654,7 +2951,8 @@ public :
 	timer_object_holder< Thread_Safety >
 	allocate()
 	{
-		return timer_object_holder< Thread_Safety >( new timer_type() );
+		return timer_object_holder< Thread_Safety >(
+				this->template make_timer_object< timer_type >() );
 	}
 
 	//! Activate timer and schedule it for execution.
@@ -2084,6 +3382,8 @@ private :
 	{
 		lock.unlock();
 
+		timer_action_batch< Time_Action > batch;
+
 		while( head )
 		{
 			try
@@ -2092,7 +3392,7 @@ private :
 				// just before execution. If timer is waiting for
 				// deregistration it must not be executed.
 				if( timer_status::wait_for_execution == head->m_status )
-					head->m_action.exec();
+					head->m_action.exec_in( batch );
 			}
 			catch( const std::exception & x )
 			{
@@ -2110,6 +3410,8 @@ private :
 			head = head->m_next;
 		}
 
+		this->flush_action_batch( batch );
+
 		lock.lock();
 	}
 
@@ -2258,7 +3560,8 @@ public :
 	timer_object_holder< Thread_Safety >
 	allocate()
 	{
-		return timer_object_holder< Thread_Safety >( new timer_type() );
+		return timer_object_holder< Thread_Safety >(
+				this->template make_timer_object< timer_type >() );
 	}
 
 	//! Activate timer and schedule it for execution.
@@ -2615,9 +3918,11 @@ private :
 	{
 		lock.unlock();
 
+		timer_action_batch< Timer_Action > batch;
+
 		try
 		{
-			m_timer_in_processing->m_action.exec();
+			m_timer_in_processing->m_action.exec_in( batch );
 		}
 		catch( const std::exception & x )
 		{
@@ -2632,6 +3937,8 @@ private :
 			std::abort();
 		}
 
+		this->flush_action_batch( batch );
+
 		lock.lock();
 	}
 
@@ -3785,6 +5092,188 @@ using default_timer_wheel_thread =
 				default_error_logger,
 				default_actor_exception_handler >;
 
+//
+// hierarchical_wheel_thread_template
+//
+
+/*!
+ * \brief A hierarchical timer wheel thread template.
+ *
+ * \note Please see description of details::hierarchical_wheel_engine for
+ * the details of this timer mechanism.
+ *
+ * \tparam Timer_Action type of functor to perform an user-defined
+ * action when timer expires. This must be Moveable and MoveConstructible
+ * type.
+ *
+ * \tparam Error_Logger type of logger for errors detected during
+ * timer thread execution. Interface for error logger is defined
+ * by default_error_logger class.
+ *
+ * \tparam Actor_Exception_Handler type of handler for dealing with
+ * exceptions thrown from timer actors. Interface for exception handler
+ * is defined by default_actor_exception_handler.
+ *
+ * \since
+ * v.1.2.3
+ */
+template<
+	typename Timer_Action,
+	typename Error_Logger,
+	typename Actor_Exception_Handler >
+class hierarchical_wheel_thread_template
+	: public
+		details::thread_impl_template<
+				details::hierarchical_wheel_engine<
+						::timertt::thread_safety::safe,
+						Timer_Action,
+						Error_Logger,
+						Actor_Exception_Handler > >
+{
+	//! Shorthand for base type.
+	using base_type =
+			details::thread_impl_template<
+					details::hierarchical_wheel_engine<
+							::timertt::thread_safety::safe,
+							Timer_Action,
+							Error_Logger,
+							Actor_Exception_Handler > >;
+
+public :
+	//! Default constructor.
+	hierarchical_wheel_thread_template()
+		:	hierarchical_wheel_thread_template(
+				base_type::default_granularity(),
+				Error_Logger(),
+				Actor_Exception_Handler() )
+	{}
+
+	//! Constructor with granularity parameter.
+	hierarchical_wheel_thread_template(
+		//! Size of time step for the first level.
+		monotonic_clock::duration granularity )
+		:	hierarchical_wheel_thread_template(
+				granularity,
+				Error_Logger(),
+				Actor_Exception_Handler() )
+	{}
+
+	//! Constructor with all parameters.
+	hierarchical_wheel_thread_template(
+		//! Size of time step for the first level.
+		monotonic_clock::duration granularity,
+		//! An error logger for timer thread.
+		Error_Logger error_logger,
+		//! An actor exception handler for timer thread.
+		Actor_Exception_Handler exception_handler )
+		:	base_type(
+				granularity,
+				error_logger,
+				exception_handler )
+	{}
+};
+
+//
+// hierarchical_wheel_manager_template
+//
+
+/*!
+ * \brief A hierarchical timer wheel manager template.
+ *
+ * \note Please see description of details::hierarchical_wheel_engine for
+ * the details of this timer mechanism.
+ *
+ * \tparam Thread_Safety Thread-safety indicator.
+ * Must be timertt::thread_safety::unsafe or timertt::thread_safety::safe.
+ *
+ * \tparam Timer_Action type of functor to perform an user-defined
+ * action when timer expires. This must be Moveable and MoveConstructible
+ * type.
+ *
+ * \tparam Error_Logger type of logger for errors detected during
+ * timer handling. Interface for error logger is defined
+ * by default_error_logger class.
+ *
+ * \tparam Actor_Exception_Handler type of handler for dealing with
+ * exceptions thrown from timer actors. Interface for exception handler
+ * is defined by default_actor_exception_handler.
+ *
+ * \since
+ * v.1.2.3
+ */
+template<
+	typename Thread_Safety,
+	typename Timer_Action = default_timer_action_type,
+	typename Error_Logger = default_error_logger,
+	typename Actor_Exception_Handler = default_actor_exception_handler >
+class hierarchical_wheel_manager_template
+	: public
+		details::manager_impl_template<
+				details::hierarchical_wheel_engine<
+						Thread_Safety,
+						Timer_Action,
+						Error_Logger,
+						Actor_Exception_Handler > >
+{
+	//! Shorthand for base type.
+	using base_type =
+			details::manager_impl_template<
+					details::hierarchical_wheel_engine<
+							Thread_Safety,
+							Timer_Action,
+							Error_Logger,
+							Actor_Exception_Handler > >;
+
+public :
+	//! Default constructor.
+	hierarchical_wheel_manager_template()
+		:	hierarchical_wheel_manager_template(
+				base_type::default_granularity(),
+				Error_Logger(),
+				Actor_Exception_Handler() )
+	{}
+
+	//! Constructor with granularity parameter.
+	hierarchical_wheel_manager_template(
+		//! Size of time step for the first level.
+		monotonic_clock::duration granularity )
+		:	hierarchical_wheel_manager_template(
+				granularity,
+				Error_Logger(),
+				Actor_Exception_Handler() )
+	{}
+
+	//! Constructor with all parameters.
+	hierarchical_wheel_manager_template(
+		//! Size of time step for the first level.
+		monotonic_clock::duration granularity,
+		//! An error logger for timer thread.
+		Error_Logger error_logger,
+		//! An actor exception handler for timer thread.
+		Actor_Exception_Handler exception_handler )
+		:	base_type(
+				granularity,
+				error_logger,
+				exception_handler )
+	{}
+};
+
+//
+// default_hierarchical_wheel_thread
+//
+/*!
+ * \brief Alias for hierarchical_wheel_thread_template with the default
+ * parameters.
+ *
+ * \since
+ * v.1.2.3
+ */
+using default_hierarchical_wheel_thread =
+		hierarchical_wheel_thread_template<
+				default_timer_action_type,
+				default_error_logger,
+				default_actor_exception_handler >;
+
 //
 // timer_list_thread_template
 //